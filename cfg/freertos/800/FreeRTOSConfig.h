@@ -108,6 +108,7 @@
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configUSE_MALLOC_FAILED_HOOK	0
 #define configUSE_APPLICATION_TASK_TAG	1
+#define configUSE_QUEUE_SETS			OS_TASK_LIGHT_ENABLED
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	OS_STATS_ENABLED
 
@@ -28,6 +28,8 @@
 #define HAL_STDIO_TERM_HEIGHT                       24
 #define HAL_STDIO_TERM_WIDTH                        80
 #define HAL_STDIO_BUFF_LEN                          512
+#define HAL_BOOT_CHECKPOINTS_MAX                    40
+#define HAL_BOOT_CHECKPOINT_NAME_LEN                12
 #define drv_stdio_p                                 drv_usart_v[DRV_ID_USART6]
 #define drv_stderr_p
 
@@ -83,6 +85,11 @@
 #define HAL_MEM_INT_CCM_SIZE                        0x10000
 #define HAL_MEM_EXT_SRAM_BASE_ADDRESS               0x60000000
 #define HAL_MEM_EXT_SRAM_SIZE                       0x80000
+//Backup SRAM (enabled by the RTC driver)
+#define HAL_MEM_BKP_SRAM_BASE_ADDRESS               0x40024000
+#define HAL_MEM_BKP_SRAM_SIZE                       0x1000
+//Backup SRAM head is the RTC driver data (Read/Write), the rest is for the OS
+#define HAL_MEM_BKP_SRAM_RTC_SIZE                   0x400
 
 //Enable External SRAM
 #define DATA_IN_ExtSRAM
@@ -91,6 +98,7 @@
 // Memory
 #define HAL_MemSet                                  memset
 #define HAL_MemCmp                                  memcmp
+#define HAL_MemChr                                  memchr
 #define HAL_MemCpy                                  memcpy
 #define HAL_MemMov                                  memmove
 // String
@@ -98,6 +106,7 @@
 #define HAL_StrLen                                  strlen
 #define HAL_StrChr                                  strchr
 #define HAL_StrCmp                                  strcmp
+#define HAL_StrNCmp                                 strncmp
 #define HAL_StrCpy                                  strcpy
 #define HAL_StrCat                                  strcat
 #define HAL_StrToK                                  strtok
@@ -14,11 +14,20 @@
 
 //------------------------------------------------------------------------------
 #define OS_DEBUG_ENABLED                            1
+#define OS_PROFILE_ENABLED                          (OS_DEBUG_ENABLED)
 
 #define OS_IS_PREEMPTIVE                            1
 #define OS_MPU_ENABLED                              0
 #define OS_STATS_ENABLED                            1
 #define OS_TASK_DEADLOCK_TEST_ENABLED               1
+#define OS_TASK_PERIODIC_HIST_LEN                   8
+#define OS_STARTUP_TASKS_MAX                        16
+#define OS_STARTUP_DEPS_MAX                         4
+#define OS_TASK_LIGHT_ENABLED                       1
+#if (OS_TASK_LIGHT_ENABLED)
+#define OS_TASK_LIGHT_EXEC_STACK_SIZE               (OS_STACK_SIZE_MIN * 3)
+#define OS_TASK_LIGHT_EXEC_QUEUE_LEN                64 //Sum of the light tasks stdin lengths.
+#endif //(OS_TASK_LIGHT_ENABLED)
 
 // Timeouts.
 #define OS_TIMEOUT_DEFAULT                          1000U
@@ -98,14 +107,14 @@ static const OS_MemoryDesc memory_cfg_v[] = {
 #define OS_FILE_SYSTEM_READONLY                     0
 #define OS_FILE_SYSTEM_MINIMIZE                     0
 #define OS_FILE_SYSTEM_STRFUNC_EN                   1
-#define OS_FILE_SYSTEM_FASTSEEK                     0
+#define OS_FILE_SYSTEM_FASTSEEK                     1
 #define OS_FILE_SYSTEM_LABEL_EN                     1
 #define OS_FILE_SYSTEM_FORWARD_EN                   0
 #define OS_FILE_SYSTEM_CODEPAGE                     1251
 #define OS_FILE_SYSTEM_STRF_ENCODE                  3
 #define OS_FILE_SYSTEM_REL_PATH                     2
 #define OS_FILE_SYSTEM_MULTI_PART                   0
-#define OS_FILE_SYSTEM_ERASE_SEC_EN                 0
+#define OS_FILE_SYSTEM_ERASE_SEC_EN                 1
 #define OS_FILE_SYSTEM_NO_INFO                      0
 #define OS_FILE_SYSTEM_WORD_ACCESS                  0
 #define OS_FILE_SYSTEM_LOCK                         0
@@ -123,6 +132,91 @@ static const OS_MemoryDesc memory_cfg_v[] = {
 #define OS_FILE_SYSTEM_DIR_DELIM                    '/'
 #define OS_FILE_SYSTEM_SYNC_OBJ                     OS_MutexHd
 #define OS_FILE_SYSTEM_YEAR_BASE                    1980U
+//Fast seek cluster link map (DWORD items).
+#define OS_FILE_SYSTEM_FASTSEEK_TBL_LEN             32
+#define OS_FILE_SYSTEM_FASTSEEK_TBL_LEN_MAX         1024
+#define OS_FILE_SYSTEM_FASTSEEK_MEM                 OS_MEM_RAM_EXT_SRAM
+//FAT scan chunk (sectors). Should be greater than OS_SEC_CACHE_BYPASS_SECTORS.
+#define OS_FILE_SYSTEM_FAT_SCAN_SECTORS             16
+//Line reader buffer (bytes).
+#define OS_FILE_SYSTEM_LINE_BUF_SIZE                512
+//Freed sectors erase batching (queued ranges, minimal erase sectors).
+#define OS_FILE_SYSTEM_ERASE_RANGES_MAX             8
+#define OS_FILE_SYSTEM_ERASE_SECTORS_MIN            64
+//Direct transfers (buffers alignment - DMA burst, sectors per media command, driver bounce buffer sectors).
+#define OS_FILE_SYSTEM_DMA_ALIGN                    16
+#define OS_FILE_SYSTEM_DMA_MEM                      OS_MEM_RAM_EXT_SRAM
+#define OS_FILE_SYSTEM_DIRECT_SECTORS_MAX           128
+#define OS_FILE_SYSTEM_DMA_BOUNCE_SECTORS           8
+//Usage accounting (free clusters validation, directories usage counters).
+#define OS_FILE_SYSTEM_USAGE_ENABLED                1
+#define OS_FILE_SYSTEM_USAGE_DIRS_MAX               8
+#define OS_FILE_SYSTEM_USAGE_DEPTH_MAX              8
+#define OS_FILE_SYSTEM_USAGE_RETRIES                3
+#define OS_FILE_SYSTEM_USAGE_RETRY_MS               100
+
+//Block I/O scheduler
+#define OS_BLK_SCHED_ENABLED                        1
+#define OS_BLK_SCHED_QUEUE_LEN                      8
+#define OS_BLK_SCHED_MERGE_SECTORS_MAX              16
+#define OS_BLK_SCHED_DEADLINE_MS                    50
+#define OS_BLK_SCHED_MEM                            OS_MEM_RAM_EXT_SRAM
+
+//Sector cache
+#define OS_SEC_CACHE_ENABLED                        1
+#define OS_SEC_CACHE_SECTORS                        64
+//OS_SEC_CACHE_HASH_SIZE should be a power of 2.
+#define OS_SEC_CACHE_HASH_SIZE                      32
+#define OS_SEC_CACHE_BYPASS_SECTORS                 8
+#define OS_SEC_CACHE_WT_REGIONS_MAX                 4
+#define OS_SEC_CACHE_FAT_WRITE_THROUGH              0
+#define OS_SEC_CACHE_MEM                            OS_MEM_RAM_EXT_SRAM
+
+//File stream
+#define OS_FILE_STREAM_ENABLED                      1
+#define OS_FILE_STREAM_CLUSTERS                     2
+#define OS_FILE_STREAM_BUF_SIZE_MAX                 0x4000
+#define OS_FILE_STREAM_SEQ_THRESHOLD                2
+#define OS_FILE_STREAM_MEM                          OS_MEM_RAM_EXT_SRAM
+
+//File asynchronous requests
+#define OS_FILE_ASYNC_ENABLED                       1
+
+//File copy (OS_FILE_ASYNC_ENABLED)
+#define OS_FILE_COPY_ENABLED                        1
+#define OS_FILE_COPY_BUFS                           2
+//OS_FILE_COPY_BUF_SIZE should be a multiple of OS_FILE_SYSTEM_SECTOR_SIZE_MAX.
+#define OS_FILE_COPY_BUF_SIZE                       0x8000
+#define OS_FILE_COPY_MEM                            OS_MEM_RAM_EXT_SRAM
+
+//Key-value store
+#define OS_KV_ENABLED                               1
+#define OS_KV_OPEN_MAX                              2
+//OS_KV_BUCKETS should be a power of 2.
+#define OS_KV_BUCKETS                               32
+#define OS_KV_KEY_LEN_MAX                           32
+#define OS_KV_VALUE_LEN_MAX                         256
+//Background compaction threshold (garbage % of the log capacity).
+#define OS_KV_COMPACT_GARBAGE_PCT                   50
+
+//Read-only asset file system (tls/mkromfs/mkromfs.py images)
+#define OS_ROMFS_ENABLED                            1
+
+//File system benchmark suite ('fbench' shell command)
+#define OS_FS_BENCH_ENABLED                         1
+#define OS_FS_BENCH_FILE_SIZE                       0x100000
+#define OS_FS_BENCH_IO_SIZE                         0x1000
+#define OS_FS_BENCH_FILES                           1000
+#define OS_FS_BENCH_OPS                             1000
+#define OS_FS_BENCH_SMALL_SIZE                      64
+#define OS_FS_BENCH_SEEK_READ_SIZE                  16
+#define OS_FS_BENCH_INI_SECTION_KEYS                16
+#define OS_FS_BENCH_KV_KEYS                         32
+#define OS_FS_BENCH_KV_VALUE_SIZE                   32
+//OS_FS_BENCH_KV_CAPACITY should be not less than the kv record max size.
+#define OS_FS_BENCH_KV_CAPACITY                     0x10000
+#define OS_FS_BENCH_PATH_LEN                        64
+#define OS_FS_BENCH_LINE_LEN                        160
 
 //Media
 enum OS_MEDIA_VOL {
@@ -135,6 +229,18 @@ enum OS_MEDIA_VOL {
         OS_MEDIA_VOL_SDCARD,
 #define OS_MEDIA_VOL_SDCARD                         OS_MEDIA_VOL_SDCARD
 
+//        OS_MEDIA_VOL_ROMFS,
+//#define OS_MEDIA_VOL_ROMFS                          OS_MEDIA_VOL_ROMFS
+////Image flash region (the linked romfs_image[] if undefined).
+//#define OS_MEDIA_VOL_ROMFS_ADDRESS                  0x080C0000
+//#define OS_MEDIA_VOL_ROMFS_SIZE                     0x40000
+
+//        OS_MEDIA_VOL_IMAGE,
+//#define OS_MEDIA_VOL_IMAGE                          OS_MEDIA_VOL_IMAGE
+////Image file on the other volume (benchmark media with the injected latency).
+//#define OS_MEDIA_VOL_IMAGE_PATH                     "0:/media.img"
+//#define OS_MEDIA_VOL_IMAGE_SIZE                     0x800000
+
 //        OS_MEDIA_VOL_USBH_FS,
 //#define OS_MEDIA_VOL_USBH_FS                        OS_MEDIA_VOL_USBH_FS
 //
@@ -162,6 +268,7 @@ enum OS_AUDIO_DEV {
 //Network
 //Look in lwip/opt.h for details
 #define OS_NETWORK_ENABLED                          1
+#define OS_NETWORK_TX_SEGMENTS_MAX                  8       // pbuf chain segments gathered by the driver's WriteV.
 
 //Platform specific locking
 #define OS_NETWORK_SYS_LIGHTWEIGHT_PROT             0
@@ -532,6 +639,18 @@ enum OS_NETWORK_ITF {
 #define OS_SETTINGS_VALUE_LEN                       256
 #define OS_SETTINGS_VALUE_DEFAULT                   ""
 #define OS_SETTINGS_FILE_PATH                       "0:/config.ini"
+//Parsed files cache (the writes are flushed by OS_SettingsFlush() or after the delay)
+#define OS_SETTINGS_CACHE_ENABLED                   1
+#define OS_SETTINGS_CACHE_FILES_MAX                 2
+//Keys hash table size (power of 2)
+#define OS_SETTINGS_CACHE_BUCKETS                   32
+//Flush delay since the last write (0 - the explicit flush only)
+#define OS_SETTINGS_CACHE_FLUSH_MS                  2000
+//Binary snapshot of the settings file and the environment (fast boot)
+#define OS_SETTINGS_SNAPSHOT_ENABLED                (OS_SETTINGS_CACHE_ENABLED)
+#define OS_SETTINGS_SNAPSHOT_VERSION                2
+#define OS_SETTINGS_SNAPSHOT_ADDRESS                (HAL_MEM_BKP_SRAM_BASE_ADDRESS + HAL_MEM_BKP_SRAM_RTC_SIZE)
+#define OS_SETTINGS_SNAPSHOT_SIZE                   (HAL_MEM_BKP_SRAM_SIZE - HAL_MEM_BKP_SRAM_RTC_SIZE)
 
 //Shell
 #define OS_SHELL_HEIGHT                             HAL_STDIO_TERM_HEIGHT
@@ -559,6 +678,7 @@ enum OS_NETWORK_ITF {
 #define OS_StrLen                                   HAL_StrLen
 #define OS_StrChr                                   HAL_StrChr
 #define OS_StrCmp                                   HAL_StrCmp
+#define OS_StrNCmp                                  HAL_StrNCmp
 #define OS_StrCpy                                   HAL_StrCpy
 #define OS_StrCat                                   HAL_StrCat
 #define OS_StrToL                                   HAL_StrToL
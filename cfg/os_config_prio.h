@@ -15,6 +15,7 @@
 #define OS_PRIO_TASK_NET                    (120)
 #define OS_PRIO_TASK_AUDIO                  (150)
 #define OS_PRIO_TASK_SHELL                  (10)
+#define OS_PRIO_TASK_LIGHT_EXEC             (90)
 //OS Network daemons
 #define OS_PRIO_TASK_TCPIP                  (190)
 #define OS_PRIO_TASK_SLIP                   (190)
@@ -20,9 +20,28 @@ enum {
     DRV_REQ_STD_UNDEF = 64,
     DRV_REQ_STD_SYNC,
     DRV_REQ_STD_POWER_SET,
+    DRV_REQ_STD_ABORT,          // Drop the submitted request (HAL_DriverRequest*), Complete is not called then.
     DRV_REQ_STD_LAST
 };
 
+/// @brief   Asynchronous transfer request.
+/// @details Driver starts the transfer in SubmitRead/SubmitWrite and returns immediately.
+///          On the transfer end the driver sets the status and calls Complete (from task or ISR).
+///          Complete is not called if the submit function returns an error.
+typedef struct HAL_DriverRequest_ {
+    void*   data_p;
+    Size    size;
+    void*   args_p;
+    Status  status;
+    void    (*Complete)(struct HAL_DriverRequest_* req_p, const Bool is_isr);
+} HAL_DriverRequest;
+
+/// @brief   Scatter-gather segment.
+typedef struct {
+    void*   data_p;
+    Size    size;
+} HAL_DriverSegment;
+
 typedef struct {
     Status  (*Init)(void* args_p);
     Status  (*DeInit)(void* args_p);
@@ -31,6 +50,10 @@ typedef struct {
     Status  (*Read)(void* data_in_p, Size size, void* args_p);
     Status  (*Write)(void* data_out_p, Size size, void* args_p);
     Status  (*IoCtl)(const U32 request_id, void* args_p);
+    Status  (*SubmitRead)(HAL_DriverRequest* req_p);   //Optional.
+    Status  (*SubmitWrite)(HAL_DriverRequest* req_p);  //Optional.
+    Status  (*ReadV)(const HAL_DriverSegment* seg_v, U32 seg_count, void* args_p);  //Optional.
+    Status  (*WriteV)(const HAL_DriverSegment* seg_v, U32 seg_count, void* args_p); //Optional.
 } HAL_DriverItf;
 
 typedef struct {
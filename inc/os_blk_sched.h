@@ -0,0 +1,108 @@
+/***************************************************************************//**
+* @file    os_blk_sched.h
+* @brief   OS Block I/O scheduler.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_BLK_SCHED_H_
+#define _OS_BLK_SCHED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "status.h"
+#include "os_config.h"
+#include "os_driver.h"
+
+//------------------------------------------------------------------------------
+/// @brief   Per-media request queue between the diskio layer and the media driver.
+/// @details Pending requests are dispatched in the ascending LBA order (C-LOOK) and
+///          the adjacent ones of the same direction are merged to the single multi-block transfer.
+///          The oldest request is dispatched first if it waits longer than OS_BLK_SCHED_DEADLINE_MS.
+///          Overlapped requests (one of them is write) are never reordered.
+///          There is no dispatcher task: the first submitter dispatches the queue until it's empty.
+///          The single request to the idle queue goes to the driver directly (no queue round trip).
+typedef void* OS_BlkSchedHd;
+
+#if (OS_BLK_SCHED_ENABLED)
+/**
+* \defgroup OS_BlkSched OS_BlkSched
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Block I/O request.
+typedef struct {
+    void*               data_p;
+    U32                 sector;
+    U32                 count;      ///< Sectors count.
+    Bool                is_write;
+    Status              status;     ///< Out.
+} OS_BlkSchedIo;
+
+/// @brief   Scheduler statistics.
+typedef struct {
+    U32                 requests;   ///< Requests submitted.
+    U32                 dispatches; ///< Driver transfers issued.
+    U32                 merged;     ///< Requests merged to the other ones.
+    U32                 sectors;
+    U32                 depth_max;  ///< Queue depth max (at submit).
+    U32                 depth_sum;  ///< Queue depth sum (at submit).
+    U32                 deadlines;  ///< Requests dispatched by the deadline rule.
+    U32                 errors;
+} OS_BlkSchedStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Create the scheduler.
+/// @param[in]  dhd             Media driver handle.
+/// @param[out] bshd_p          Scheduler handle.
+/// @return     #Status.
+Status          OS_BlkSchedCreate(const OS_DriverHd dhd, OS_BlkSchedHd* bshd_p);
+
+/// @brief      Delete the scheduler.
+/// @param[in]  bshd            Scheduler handle.
+/// @return     #Status.
+Status          OS_BlkSchedDelete(const OS_BlkSchedHd bshd);
+
+/// @brief      Read sectors.
+/// @param[in]  bshd            Scheduler handle.
+/// @param[out] data_in_p       Data buffer.
+/// @param[in]  sector          Start sector (LBA).
+/// @param[in]  count           Sectors count.
+/// @return     #Status.
+Status          OS_BlkSchedRead(const OS_BlkSchedHd bshd, void* data_in_p, const U32 sector, const U32 count);
+
+/// @brief      Write sectors.
+/// @param[in]  bshd            Scheduler handle.
+/// @param[in]  data_out_p      Data buffer.
+/// @param[in]  sector          Start sector (LBA).
+/// @param[in]  count           Sectors count.
+/// @return     #Status.
+Status          OS_BlkSchedWrite(const OS_BlkSchedHd bshd, void* data_out_p, const U32 sector, const U32 count);
+
+/// @brief      Submit the requests batch and wait for the completion.
+/// @param[in]  bshd            Scheduler handle.
+/// @param[in,out] io_v         Requests vector (status is set for every request).
+/// @param[in]  io_count        Requests count.
+/// @return     #Status (the first failed request status).
+Status          OS_BlkSchedBatch(const OS_BlkSchedHd bshd, OS_BlkSchedIo* io_v, const U32 io_count);
+
+/// @brief      Get the scheduler statistics.
+/// @param[in]  bshd            Scheduler handle.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_BlkSchedStatsGet(const OS_BlkSchedHd bshd, OS_BlkSchedStats* stats_p);
+
+/// @brief      Reset the scheduler statistics.
+/// @param[in]  bshd            Scheduler handle.
+/// @return     None.
+void            OS_BlkSchedStatsReset(const OS_BlkSchedHd bshd);
+
+/**@}*/ //OS_BlkSched
+
+#endif // (OS_BLK_SCHED_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_BLK_SCHED_H_
@@ -19,6 +19,7 @@ extern "C" {
 */
 //------------------------------------------------------------------------------
 typedef const void* OS_DriverHd;
+typedef HAL_DriverSegment OS_DriverSegment;
 
 enum { //Bit fields
     OS_DRV_STATE_UNDEF,
@@ -28,6 +29,14 @@ enum { //Bit fields
 };
 typedef U8 OS_DriverState;
 
+/// @brief   Driver locking policy.
+enum {
+    OS_DRV_LOCK_SINGLE,     ///< One lock for all the driver's calls (default).
+    OS_DRV_LOCK_RX_TX,      ///< Separate read and write locks (full-duplex devices).
+    OS_DRV_LOCK_NONE        ///< No locks on read/write (driver is internally safe).
+};                          //   Control calls (init, open, ioctl, etc.) are always exclusive.
+typedef U8 OS_DriverLockPolicy;
+
 typedef struct {
     OS_DriverState      state; //Bit fields.
     OS_PowerState       power;
@@ -38,10 +47,24 @@ typedef struct {
     Status              status_last;
 } OS_DriverStats;
 
+/// @brief   Asynchronous transfer request.
+/// @details The request is owned by the caller and should be valid until the completion.
+///          On completion the callback is called (task or ISR context!) and
+///          the request pointer is sent to the completion queue (item size is sizeof(OS_DriverRequest*)).
+typedef struct OS_DriverRequest_ {
+    HAL_DriverRequest   hal_req;    ///< Should be the first member.
+    OS_DriverHd         dhd;
+    OS_QueueHd          qhd;        ///< Completion queue (optional).
+    void                (*Callback)(struct OS_DriverRequest_* req_p, const Bool is_isr); ///< Completion callback (optional).
+    void*               user_p;
+    Bool                is_write;
+} OS_DriverRequest;
+
 typedef struct {
     ConstStr            name[OS_DRIVER_NAME_LEN];
     HAL_DriverItf*      itf_p;
     OS_PowerPrio        prio_power;
+    OS_DriverLockPolicy lock_policy;
 } OS_DriverConfig;
 
 //------------------------------------------------------------------------------
@@ -96,6 +119,44 @@ Status          OS_DriverRead(const OS_DriverHd dhd, void* data_in_p, U32 size,
 /// @return     #Status.
 Status          OS_DriverWrite(const OS_DriverHd dhd, void* data_out_p, U32 size, void* args_p);
 
+/// @brief      Read data to the segments vector (scatter).
+/// @param[in]  dhd            Driver's handle.
+/// @param[out] seg_v          Segments vector.
+/// @param[in]  seg_count      Segments count.
+/// @param[in]  args_p         Driver's specific input arguments (if present).
+/// @return     #Status.
+/// @note       If the driver has no ReadV, the data is read to the temporary buffer
+///             and copied to the segments.
+Status          OS_DriverReadV(const OS_DriverHd dhd, const OS_DriverSegment* seg_v, U32 seg_count, void* args_p);
+
+/// @brief      Write data from the segments vector (gather).
+/// @param[in]  dhd            Driver's handle.
+/// @param[in]  seg_v          Segments vector.
+/// @param[in]  seg_count      Segments count.
+/// @param[in]  args_p         Driver's specific input arguments (if present).
+/// @return     #Status.
+/// @note       If the driver has no WriteV, the segments are copied to the temporary buffer
+///             and written at once.
+Status          OS_DriverWriteV(const OS_DriverHd dhd, const OS_DriverSegment* seg_v, U32 seg_count, void* args_p);
+
+/// @brief      Submit the asynchronous read request.
+/// @param[in]  dhd            Driver's handle.
+/// @param[in]  req_p          Request (data_p, size, args_p, qhd/Callback, user_p should be set).
+/// @return     #Status.
+/// @note       Driver's mutex is held for the submit only.
+///             If the driver has no SubmitRead, the transfer is done synchronously
+///             and the request is completed before the return.
+Status          OS_DriverReadAsync(const OS_DriverHd dhd, OS_DriverRequest* req_p);
+
+/// @brief      Submit the asynchronous write request.
+/// @param[in]  dhd            Driver's handle.
+/// @param[in]  req_p          Request (data_p, size, args_p, qhd/Callback, user_p should be set).
+/// @return     #Status.
+/// @note       Driver's mutex is held for the submit only.
+///             If the driver has no SubmitWrite, the transfer is done synchronously
+///             and the request is completed before the return.
+Status          OS_DriverWriteAsync(const OS_DriverHd dhd, OS_DriverRequest* req_p);
+
 /// @brief      Input/Output control.
 /// @param[in]  dhd            Driver's handle.
 /// @param[in]  request_id     Driver's request code indentifier.
@@ -124,6 +185,11 @@ ConstStrP       OS_DriverNameGet(const OS_DriverHd dhd);
 /// @return     State name.
 ConstStrP       OS_DriverStateNameGet(const OS_DriverState state);
 
+/// @brief      Get driver's lock policy name.
+/// @param[in]  policy         Driver's lock policy.
+/// @return     Lock policy name.
+ConstStrP       OS_DriverLockPolicyNameGet(const OS_DriverLockPolicy policy);
+
 /// @brief      Get driver by it's name.
 /// @param[in]  name_p         Driver's name.
 /// @return     Driver handle.
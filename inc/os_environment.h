@@ -23,6 +23,7 @@ extern "C" {
 
 //------------------------------------------------------------------------------
 typedef Status (*OS_EnvVariableHandler)(ConstStrP variable_value_p);
+typedef Status (*OS_EnvVariableCallback)(ConstStrP variable_name_p, ConstStrP variable_value_p, void* args_p);
 
 //------------------------------------------------------------------------------
 // System environment variables handlers.
@@ -107,6 +108,27 @@ ConstStrP       OS_EnvVariableGet(ConstStrP variable_name_p);
 Status          OS_EnvVariableSet(ConstStrP variable_name_p, ConstStrP variable_value_p,
                                   const OS_EnvVariableHandler variable_handler_p);
 
+/// @brief      Set the environment variable default value.
+/// @details    The existing (restored) variable value is kept, the handler is applied to it.
+/// @param[in]  variable_name_p     Variable name.
+/// @param[in]  variable_value_p    Variable default value.
+/// @param[in]  variable_handler_p  Variable handler func.
+/// @return     #Status.
+Status          OS_EnvVariableDefaultSet(ConstStrP variable_name_p, ConstStrP variable_value_p,
+                                         const OS_EnvVariableHandler variable_handler_p);
+
+/// @brief      Create the environment variable without the name and value copies.
+/// @param[in]  variable_name_p     Variable name (kept by the caller).
+/// @param[in]  variable_value_p    Variable value (kept by the caller until the next set).
+/// @return     #Status.
+Status          OS_EnvVariableMap(ConstStrP variable_name_p, ConstStrP variable_value_p);
+
+/// @brief      Browse the environment variables.
+/// @param[in]  callback_func_p     Variable callback (the browse stops on error).
+/// @param[in]  args_p              Callback arguments.
+/// @return     #Status.
+Status          OS_EnvVariablesBrowse(const OS_EnvVariableCallback callback_func_p, void* args_p);
+
 /// @brief      Delete the environment variable.
 /// @param[in]  variable_name_p     Variable name.
 /// @return     #Status.
@@ -0,0 +1,140 @@
+/***************************************************************************//**
+* @file    os_file_async.h
+* @brief   OS File asynchronous requests.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_FILE_ASYNC_H_
+#define _OS_FILE_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os_file_system.h"
+#include "os_mailbox.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_ASYNC_ENABLED)
+/**
+* \defgroup OS_FileAsync OS_FileAsync
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Asynchronous file requests served by the file system daemon.
+/// @details The requester (client) posts the request (OS_MSG_FS_ASYNC_REQ) and continues.
+///          The daemon does the request and sends the completion (OS_MSG_FS_ASYNC_DONE)
+///          to the client queue. The client in flight requests count is limited;
+///          high priority clients requests are put to the front of the daemon queue.
+///          The buffers and the file should stay valid until the completion.
+typedef void* OS_FileAsyncClientHd;
+
+enum {
+    OS_FS_ASYNC_OP_UNDEF,
+    OS_FS_ASYNC_OP_OPEN,
+    OS_FS_ASYNC_OP_READ,
+    OS_FS_ASYNC_OP_WRITE,
+    OS_FS_ASYNC_OP_LAST
+};
+typedef U8 OS_FileAsyncOp;
+
+/// @brief   Client config.
+typedef struct {
+    OS_QueueHd          qhd;            ///< Completions queue (OS_NULL - the creator task stdin).
+    U8                  in_flight_max;  ///< Submitted and not completed requests limit.
+    OS_TimeMs           timeout;        ///< Free request slot wait timeout.
+    OS_MessagePrio      prio;           ///< Daemon queue priority.
+} OS_FileAsyncClientConfig;
+
+/// @brief   Request (OS_MSG_FS_ASYNC_REQ message data).
+typedef struct {
+    OS_FileAsyncClientHd chd;
+    OS_FileHd           fhd;
+    void*               data_p;
+    Size                size;
+    U32                 tag;
+    OS_Tick             tick_submit;
+    OS_FileAsyncOp      op;
+    OS_FileOpenMode     op_mode;
+    Str                 path[0];        ///< File path (OS_FS_ASYNC_OP_OPEN).
+} OS_FileAsyncRequest;
+
+/// @brief   Completion (OS_MSG_FS_ASYNC_DONE message data).
+typedef struct {
+    OS_FileAsyncClientHd chd;
+    OS_FileHd           fhd;            ///< File handle (the opened file for OS_FS_ASYNC_OP_OPEN).
+    void*               data_p;
+    Size                size;           ///< Bytes transferred.
+    U32                 tag;            ///< Request tag.
+    OS_TimeMs           latency;        ///< Submit to completion time.
+    Status              status;
+    OS_FileAsyncOp      op;
+} OS_FileAsyncCompletion;
+
+/// @brief   Client statistics.
+typedef struct {
+    U32                 submits;
+    U32                 completions;
+    U32                 errors;
+    U32                 rejects;        ///< No free request slot.
+    U32                 in_flight;
+    U32                 in_flight_peak;
+    OS_TimeMs           latency_max;
+} OS_FileAsyncStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Create the client.
+/// @param[in]  cfg_p           Client config.
+/// @param[out] chd_p           Client handle.
+/// @return     #Status.
+Status          OS_FileAsyncClientCreate(const OS_FileAsyncClientConfig* cfg_p, OS_FileAsyncClientHd* chd_p);
+
+/// @brief      Delete the client (in flight requests are waited).
+/// @param[in]  chd             Client handle.
+/// @return     #Status.
+Status          OS_FileAsyncClientDelete(const OS_FileAsyncClientHd chd);
+
+/// @brief      Open the file.
+/// @param[in]  chd             Client handle.
+/// @param[in]  file_path_p     File path.
+/// @param[in]  op_mode         File open mode.
+/// @param[in]  tag             Request tag.
+/// @return     #Status (S_BUSY if there is no free request slot).
+Status          OS_FileOpenAsync(const OS_FileAsyncClientHd chd, ConstStrP file_path_p, const OS_FileOpenMode op_mode, const U32 tag);
+
+/// @brief      Read the file.
+/// @param[in]  chd             Client handle.
+/// @param[in]  fhd             File handle.
+/// @param[out] data_in_p       Data input buffer.
+/// @param[in]  size            Input buffer size.
+/// @param[in]  tag             Request tag.
+/// @return     #Status (S_BUSY if there is no free request slot).
+Status          OS_FileReadAsync(const OS_FileAsyncClientHd chd, const OS_FileHd fhd, void* data_in_p, const Size size, const U32 tag);
+
+/// @brief      Write the file.
+/// @param[in]  chd             Client handle.
+/// @param[in]  fhd             File handle.
+/// @param[in]  data_out_p      Data output buffer.
+/// @param[in]  size            Output buffer size.
+/// @param[in]  tag             Request tag.
+/// @return     #Status (S_BUSY if there is no free request slot).
+Status          OS_FileWriteAsync(const OS_FileAsyncClientHd chd, const OS_FileHd fhd, void* data_out_p, const Size size, const U32 tag);
+
+/// @brief      Get the client statistics.
+/// @param[in]  chd             Client handle.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_FileAsyncStatsGet(const OS_FileAsyncClientHd chd, OS_FileAsyncStats* stats_p);
+
+/// @brief      Do the request (file system daemon side).
+/// @param[in]  req_p           Request.
+/// @return     None.
+void            OS_FileAsyncRequestDo(const OS_FileAsyncRequest* req_p);
+
+/**@}*/ //OS_FileAsync
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_ASYNC_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_FILE_ASYNC_H_
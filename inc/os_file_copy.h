@@ -0,0 +1,64 @@
+/***************************************************************************//**
+* @file    os_file_copy.h
+* @brief   OS File copy.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_FILE_COPY_H_
+#define _OS_FILE_COPY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os_file_system.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_COPY_ENABLED)
+/**
+* \defgroup OS_FileCopy OS_FileCopy
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Multiple buffered file copy.
+/// @details The source is read by the caller to the next free buffer while the filled buffers
+///          are written to the destination by the file system daemon (OS_FileWriteAsync()).
+///          The reading and the writing overlap if the files are on the different volumes.
+///          The destination is preallocated by the source size.
+///          Stall is a wait for the daemon to complete the oldest buffer write.
+
+/// @brief   Copy config.
+typedef struct {
+    Size                buf_size;       ///< Buffer size (multiple of the sector size, 0 - OS_FILE_COPY_BUF_SIZE).
+    U8                  bufs_count;     ///< Buffers count (>= 2, 0 - OS_FILE_COPY_BUFS).
+    Bool                is_verify;      ///< Read back the destination and compare CRC.
+} OS_FileCopyConfig;
+
+/// @brief   Copy statistics.
+typedef struct {
+    U32                 size;           ///< Copied bytes.
+    U32                 crc;            ///< Source CRC (chained buffers CRC-32).
+    OS_TimeMs           time;           ///< Total time (the verification isn't included).
+    OS_TimeMs           read_ms;        ///< Source reads.
+    OS_TimeMs           stall_ms;       ///< Free buffer waits.
+    OS_TimeMs           flush_ms;       ///< Last writes wait and the destination sync.
+    OS_TimeMs           verify_ms;
+    OS_TimeMs           write_latency_max;
+} OS_FileCopyStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Copy the file.
+/// @param[in]  src_path_p      Source file path.
+/// @param[in]  dst_path_p      Destination file path (created or overwritten, deleted on failure).
+/// @param[in]  cfg_p           Copy config (OS_NULL - default).
+/// @param[out] stats_p         Copy statistics (could be OS_NULL).
+/// @return     #Status (S_INVALID_CRC if the verification fails).
+Status          OS_FileCopy(ConstStrP src_path_p, ConstStrP dst_path_p, const OS_FileCopyConfig* cfg_p, OS_FileCopyStats* stats_p);
+
+/**@}*/ //OS_FileCopy
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_COPY_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_FILE_COPY_H_
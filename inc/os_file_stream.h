@@ -0,0 +1,106 @@
+/***************************************************************************//**
+* @file    os_file_stream.h
+* @brief   OS File stream.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_FILE_STREAM_H_
+#define _OS_FILE_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os_file_system.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_STREAM_ENABLED)
+/**
+* \defgroup OS_FileStream OS_FileStream
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Buffered sequential file access.
+/// @details The stream has two buffers of OS_FILE_STREAM_CLUSTERS clusters (up to OS_FILE_STREAM_BUF_SIZE_MAX).
+///          Read stream: after OS_FILE_STREAM_SEQ_THRESHOLD sequential reads the next buffers
+///          are prefetched by the file system daemon. Random reads go to the file directly.
+///          Write stream: data is collected to the buffer aligned blocks which are written
+///          by the file system daemon while the other buffer is filled.
+///          Stall is a wait for the daemon to complete the buffer.
+typedef void* OS_FileStreamHd;
+
+/// @brief   Stream statistics.
+typedef struct {
+    U32                 reads;      ///< Read calls.
+    U32                 writes;     ///< Write calls.
+    U32                 prefetches; ///< Buffers read by the daemon.
+    U32                 flushes;    ///< Buffers written by the daemon.
+    U32                 direct;     ///< Unbuffered reads.
+    U32                 stalls;
+    U32                 stall_ms;
+    U32                 buf_size;
+} OS_FileStreamStats;
+
+/// @brief   File system daemon job (OS_MSG_FS_STREAM_FILL, OS_MSG_FS_STREAM_FLUSH message data).
+typedef struct {
+    OS_FileStreamHd     shd;
+    U8                  buf_idx;
+} OS_FileStreamJob;
+
+//------------------------------------------------------------------------------
+/// @brief      Open the file stream.
+/// @param[out] shd_p           Stream handle.
+/// @param[in]  file_path_p     File path.
+/// @param[in]  op_mode         File open mode (write stream if OS_FS_FILE_OP_MODE_WRITE is set).
+/// @return     #Status.
+Status          OS_FileStreamOpen(OS_FileStreamHd* shd_p, ConstStrP file_path_p, const OS_FileOpenMode op_mode);
+
+/// @brief      Close the file stream (pending data is written).
+/// @param[in]  shd_p           Stream handle.
+/// @return     #Status.
+Status          OS_FileStreamClose(OS_FileStreamHd* shd_p);
+
+/// @brief      Read the stream.
+/// @param[in]  shd             Stream handle.
+/// @param[out] data_in_p       Data input buffer.
+/// @param[in]  size            Input buffer size.
+/// @param[out] read_size_p     Bytes read (could be OS_NULL).
+/// @return     #Status (S_FS_EOF if nothing was read, S_INVALID_SIZE if the end of file was reached).
+Status          OS_FileStreamRead(const OS_FileStreamHd shd, void* data_in_p, Size size, Size* read_size_p);
+
+/// @brief      Write the stream.
+/// @param[in]  shd             Stream handle.
+/// @param[in]  data_out_p      Data output buffer.
+/// @param[in]  size            Output buffer size.
+/// @return     #Status.
+Status          OS_FileStreamWrite(const OS_FileStreamHd shd, const void* data_out_p, Size size);
+
+/// @brief      Set the stream offset.
+/// @param[in]  shd             Stream handle.
+/// @param[in]  offset          Offset (bytes).
+/// @return     #Status.
+Status          OS_FileStreamSeek(const OS_FileStreamHd shd, const U32 offset);
+
+/// @brief      Write the buffered data and sync the file.
+/// @param[in]  shd             Stream handle.
+/// @return     #Status.
+Status          OS_FileStreamFlush(const OS_FileStreamHd shd);
+
+/// @brief      Get the stream statistics.
+/// @param[in]  shd             Stream handle.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_FileStreamStatsGet(const OS_FileStreamHd shd, OS_FileStreamStats* stats_p);
+
+/// @brief      Do the stream job (file system daemon side).
+/// @param[in]  job_p           Job.
+/// @return     None.
+void            OS_FileStreamJobDo(const OS_FileStreamJob* job_p);
+
+/**@}*/ //OS_FileStream
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_STREAM_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_FILE_STREAM_H_
@@ -14,6 +14,8 @@ extern "C" {
 #include "os_common.h"
 #include "os_driver.h"
 #include "os_time.h"
+#include "os_blk_sched.h"
+#include "os_sec_cache.h"
 
 #if (OS_FILE_SYSTEM_ENABLED)
 /**
@@ -25,6 +27,7 @@ typedef void*   OS_FileSystemMediaHd;
 typedef FATFS*  OS_FileSystemHd;
 typedef FIL*    OS_FileHd;
 typedef DIR*    OS_DirHd;
+typedef void*   OS_FileLineReaderHd;
 
 typedef enum {
     S_FS_UNDEF = S_MODULE,
@@ -58,6 +61,7 @@ typedef enum {
     OS_FS_FAT12,
     OS_FS_FAT16,
     OS_FS_FAT32,
+    OS_FS_ROMFS,
     OS_FS_LAST
 } OS_FileSystemType;
 
@@ -72,6 +76,7 @@ typedef struct {
     Str             name[OS_FILE_SYSTEM_VOLUME_NAME_LEN];
     OS_DriverConfig*drv_cfg_p;
     U8              volume;
+    OS_FileSystemType type;         ///< OS_FS_ROMFS or FAT (any other).
 } OS_FileSystemMediaConfig;
 
 typedef struct {
@@ -118,6 +123,7 @@ enum {
     OS_FS_FILE_OP_MODE_OPEN_EXISTS,
     OS_FS_FILE_OP_MODE_READ,
     OS_FS_FILE_OP_MODE_WRITE,
+    OS_FS_FILE_OP_MODE_FAST_SEEK,       ///< Build the cluster link map (the file size shouldn't grow).
     OS_FS_FILE_OP_MODE_LAST
 };
 typedef U8 OS_FileOpenMode;
@@ -133,6 +139,14 @@ typedef struct {
 #endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
 } OS_FileStats;
 
+/// @brief   Direct transfers statistics.
+typedef struct {
+    U32             transfers;      ///< Direct reads/writes.
+    U32             commands;       ///< Media commands (multiple sectors).
+    U32             sectors;
+    U32             bounces;        ///< Transfers through the FatFs sector buffer.
+} OS_FileDirectStats;
+
 //typedef struct {
 //    OS_FileSystemHd fshd;
 //    U16             id;
@@ -223,6 +237,20 @@ OS_FileSystemMediaHd OS_FileSystemMediaByNameGet(ConstStrP name_p);
 
 U8              OS_FileSystemVolumeGet(const OS_FileSystemMediaHd fs_media_hd);
 
+#if (OS_BLK_SCHED_ENABLED)
+/// @brief      Get media block I/O scheduler.
+/// @param[in]  fs_media_hd     Media handle.
+/// @return     Scheduler handle.
+OS_BlkSchedHd   OS_FileSystemMediaBlkSchedGet(const OS_FileSystemMediaHd fs_media_hd);
+#endif //(OS_BLK_SCHED_ENABLED)
+
+#if (OS_SEC_CACHE_ENABLED)
+/// @brief      Get media sector cache.
+/// @param[in]  fs_media_hd     Media handle.
+/// @return     Cache handle.
+OS_SecCacheHd   OS_FileSystemMediaSecCacheGet(const OS_FileSystemMediaHd fs_media_hd);
+#endif //(OS_SEC_CACHE_ENABLED)
+
 /// @brief      Get media volume label.
 /// @param[in]  fs_media_hd     Media handle.
 /// @param[out] label_p         Media volume label.
@@ -255,6 +283,59 @@ Status          OS_FileSystemVolumeScan(const StrP path_p, OS_FileSystemStats* s
 /// @return     #Status.
 Status          OS_FileSystemClustersFreeGet(const OS_FileSystemMediaHd fs_media_hd, const StrP path_p, U32* clusters_free_count_p);
 
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+/// @brief      Queue the freed sectors erase (FatFs CTRL_ERASE_SECTOR).
+/// @details    The adjacent ranges are merged and erased on the volume sync
+///             (the smallest range is dropped if OS_FILE_SYSTEM_ERASE_RANGES_MAX ranges are queued).
+/// @param[in]  volume          Volume.
+/// @param[in]  sector_start    First sector.
+/// @param[in]  sector_end      Last sector.
+/// @return     #Status.
+Status          OS_FileSystemEraseQueue(const U8 volume, const U32 sector_start, const U32 sector_end);
+
+/// @brief      Exclude the written sectors from the queued erase ranges.
+/// @param[in]  volume          Volume.
+/// @param[in]  sector          First sector.
+/// @param[in]  count           Sectors count.
+/// @return     None.
+void            OS_FileSystemEraseClip(const U8 volume, const U32 sector, const U32 count);
+
+/// @brief      Erase the queued ranges (shorter than OS_FILE_SYSTEM_ERASE_SECTORS_MIN are skipped).
+/// @param[in]  volume          Volume.
+/// @return     #Status.
+Status          OS_FileSystemEraseFlush(const U8 volume);
+
+/// @brief      Erase the volume free clusters runs (TRIM).
+/// @details    The volume is locked while the FAT is scanned and the runs are erased.
+/// @param[in]  fs_media_hd     Media handle.
+/// @param[out] sectors_p       Erased sectors count.
+/// @return     #Status.
+Status          OS_FileSystemTrim(const OS_FileSystemMediaHd fs_media_hd, U32* sectors_p);
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+/// @brief      Get the directory usage.
+/// @details    The first query scans the directory subtree. Next ones are answered from the counters
+///             updated by the file operations (up to OS_FILE_SYSTEM_USAGE_DIRS_MAX directories).
+/// @param[in]  path_p          Directory path.
+/// @param[out] stats_p         File system statistics.
+/// @return     #Status.
+Status          OS_FileSystemUsageGet(ConstStrP path_p, OS_FileSystemStats* stats_p);
+
+/// @brief      Validate the free clusters count and rescan the volume usage.
+/// @details    Called by the file system daemon after the mount (OS_MSG_FS_VOLUME_VALIDATE).
+///             The FAT is counted without the volume lock and the result is dropped
+///             if the FAT was changed meanwhile.
+/// @param[in]  fs_media_hd     Media handle.
+/// @return     #Status.
+Status          OS_FileSystemMediaValidate(const OS_FileSystemMediaHd fs_media_hd);
+
+/// @brief      Write the FSInfo sector (FAT32) and the cached sectors to the media.
+/// @param[in]  fs_media_hd     Media handle.
+/// @return     #Status.
+Status          OS_FileSystemMediaSync(const OS_FileSystemMediaHd fs_media_hd);
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+
 /**
 * \addtogroup OS_FileSystemFilesOps File system files operations.
 * @{
@@ -297,6 +378,40 @@ Status          OS_FileRead(const OS_FileHd fhd, void* data_in_p, Size size);
 /// @return     #Status.
 Status          OS_FileWrite(const OS_FileHd fhd, void* data_out_p, Size size);
 
+/// @brief      Read file directly to the buffer.
+/// @details    The sectors are read by the media commands straight to the buffer (a command per
+///             contiguous clusters run, OS_FILE_SYSTEM_DIRECT_SECTORS_MAX at most).
+///             The file offset and the size should be the sector multiples, the buffer should be
+///             OS_FILE_SYSTEM_DMA_ALIGN aligned (OS_MallocAligned()) and the region should be in the file.
+///             Otherwise the data is read by OS_FileRead() (the transfer is counted as the bounce).
+/// @param[in]  fhd             File handle.
+/// @param[out] data_in_p       Data input buffer.
+/// @param[in]  size            Input buffer size.
+/// @return     #Status.
+Status          OS_FileReadDirect(const OS_FileHd fhd, void* data_in_p, const Size size);
+
+/// @brief      Write file directly from the buffer.
+/// @details    The same requirements as OS_FileReadDirect(). The file isn't expanded by the direct
+///             writes: the region should be allocated (OS_FileAllocate()).
+/// @param[in]  fhd             File handle.
+/// @param[in]  data_out_p      Data output buffer.
+/// @param[in]  size            Output buffer size.
+/// @return     #Status.
+Status          OS_FileWriteDirect(const OS_FileHd fhd, void* data_out_p, const Size size);
+
+/// @brief      Get the direct transfers statistics.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_FileDirectStatsGet(OS_FileDirectStats* stats_p);
+
+/// @brief      Get the media extent of the file start.
+/// @details    Needs the fast seek (the link map is created if the file has no one).
+/// @param[in]  fhd             File handle.
+/// @param[out] sector_p        Media sector (LBA) of the file start.
+/// @param[out] sectors_p       Contiguous sectors count from the file start.
+/// @return     #Status.
+Status          OS_FileExtentGet(const OS_FileHd fhd, U32* sector_p, U32* sectors_p);
+
 /// @brief      Rename file.
 /// @param[in]  name_old_p      Old name path.
 /// @param[in]  name_new_p      New name path.
@@ -315,6 +430,12 @@ Status          OS_FileDateTimeSet(ConstStrP file_path_p, OS_DateTime date_time)
 /// @return     #Status.
 Status          OS_FileAttributesSet(ConstStrP file_path_p, const OS_FileAttrs attrs);
 
+/// @brief      Get file statistics (the file isn't opened).
+/// @param[in]  file_path_p     File path.
+/// @param[in,out] file_stats_p File statistics (long_name_p and long_name_size are the long name buffer).
+/// @return     #Status.
+Status          OS_FileStatsGet(ConstStrP file_path_p, OS_FileStats* file_stats_p);
+
 /// @brief      Get file string.
 /// @param[in]  fhd             File handle.
 /// @param[out] str_p           String.
@@ -322,6 +443,64 @@ Status          OS_FileAttributesSet(ConstStrP file_path_p, const OS_FileAttrs a
 /// @return     #Status.
 Status          OS_FileGetS(const OS_FileHd fhd, StrP str_p, U32 len);
 
+/// @brief      Map the file region (zero-copy read).
+/// @details    The region is valid until OS_FileUnmap(). The file offset isn't changed.
+///             The region in the contiguous clusters run is the media memory (the file writes are visible),
+///             the fragmented region is read to the bounce buffer (the copy at the map time).
+/// @param[in]  fhd             File handle.
+/// @param[in]  offset          Region offset.
+/// @param[in]  size            Region size.
+/// @param[out] data_pp         Region data.
+/// @return     #Status (S_FS_NOT_ENABLED if the file media isn't memory mapped).
+Status          OS_FileMap(const OS_FileHd fhd, const U32 offset, const Size size, const void** data_pp);
+
+/// @brief      Unmap the file region (the bounce buffer is freed).
+/// @param[in]  fhd             File handle.
+/// @param[in]  data_p          Region data.
+/// @return     #Status.
+Status          OS_FileUnmap(const OS_FileHd fhd, const void* data_p);
+
+/// @brief      Create the file line reader.
+/// @details    The file is read by the buffer size blocks, the lines are searched in the buffer.
+///             The reader owns the file offset: use the reader tell/seek only.
+/// @param[in]  fhd             File handle (read mode).
+/// @param[in]  buf_size        Buffer size (0 - OS_FILE_SYSTEM_LINE_BUF_SIZE). Longer lines are read by parts.
+/// @param[out] lrhd_p          Line reader handle.
+/// @return     #Status.
+Status          OS_FileLineReaderCreate(const OS_FileHd fhd, const Size buf_size, OS_FileLineReaderHd* lrhd_p);
+
+/// @brief      Delete the file line reader (the file stays open).
+/// @param[in]  lrhd            Line reader handle.
+/// @return     #Status.
+Status          OS_FileLineReaderDelete(const OS_FileLineReaderHd lrhd);
+
+/// @brief      Read the line (zero-copy).
+/// @details    The line is in the reader buffer and valid until the next reader call.
+///             The line end ("\n" or "\r\n") is replaced by the string end.
+/// @param[in]  lrhd            Line reader handle.
+/// @param[out] line_pp         Line.
+/// @param[out] len_p           Line length.
+/// @return     #Status (S_FS_EOF at the file end).
+Status          OS_FileLineRead(const OS_FileLineReaderHd lrhd, StrP* line_pp, Size* len_p);
+
+/// @brief      Get the line string (OS_FileGetS() compatible: the line end is kept).
+/// @param[in]  lrhd            Line reader handle.
+/// @param[out] str_p           String.
+/// @param[in]  len             String length.
+/// @return     #Status (S_FS_EOF at the file end).
+Status          OS_FileLineGetS(const OS_FileLineReaderHd lrhd, StrP str_p, U32 len);
+
+/// @brief      Get the next line offset.
+/// @param[in]  lrhd            Line reader handle.
+/// @return     Offset.
+U32             OS_FileLineReaderTell(const OS_FileLineReaderHd lrhd);
+
+/// @brief      Set the next line offset.
+/// @param[in]  lrhd            Line reader handle.
+/// @param[in]  offset          Offset.
+/// @return     #Status.
+Status          OS_FileLineReaderSeek(const OS_FileLineReaderHd lrhd, const U32 offset);
+
 /// @brief      Put string to the file.
 /// @param[in]  fhd             File handle.
 /// @param[in]  str_p           String.
@@ -344,6 +523,33 @@ Status          OS_FileLSeek(const OS_FileHd fhd, const U32 offset);
 /// @param[in]  fhd             File handle.
 /// @return     Offset (bytes).
 U32             OS_FileTell(const OS_FileHd fhd);
+
+/// @brief      Get file size.
+/// @param[in]  fhd             File handle.
+/// @return     Size (bytes).
+U32             OS_FileSizeGet(const OS_FileHd fhd);
+
+/// @brief      Flush the cached file data.
+/// @param[in]  fhd             File handle.
+/// @return     #Status.
+Status          OS_FileSync(const OS_FileHd fhd);
+
+/// @brief      Allocate the file space.
+/// @details    The file is expanded to the size (the new data is undefined) and the chain is committed,
+///             so the next writes inside the file don't allocate clusters.
+///             Contiguous: the file should be empty; the free extent is searched in the FAT and
+///             the file writes use the one fragment link map (no FAT access, the file can't grow).
+///             Use OS_FileTruncate() at the end of the written data.
+/// @param[in]  fhd             File handle (write mode).
+/// @param[in]  size            File size.
+/// @param[in]  is_contiguous   Allocate the contiguous extent.
+/// @return     #Status (S_FS_ALLOCATION if there is no space or no contiguous extent).
+Status          OS_FileAllocate(const OS_FileHd fhd, const U32 size, const Bool is_contiguous);
+
+/// @brief      Truncate the file at the current offset.
+/// @param[in]  fhd             File handle.
+/// @return     #Status.
+Status          OS_FileTruncate(const OS_FileHd fhd);
 /**@}*/ //OS_FileSystemFilesOps
 
 /**
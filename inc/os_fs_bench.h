@@ -0,0 +1,93 @@
+/***************************************************************************//**
+* @file    os_fs_bench.h
+* @brief   OS File system benchmark.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_FS_BENCH_H_
+#define _OS_FS_BENCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hal.h"
+#include "os_file_system.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FS_BENCH_ENABLED)
+/**
+* \defgroup OS_FsBench OS_FsBench
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   File system benchmark suite.
+/// @details The scenarios are run through the OS_File* API in the work directory and the results
+///          are written as JSON (the runs on the different media and builds are compared by
+///          tls/fsbench/fsbench_cmp.py). The suite runs on the target only (there is no host port):
+///          the image media volume (OS_MEDIA_VOL_IMAGE) keeps the benchmark volume in a file on the
+///          other volume and injects the per-command latency (DRV_REQ_MEDIA_LATENCY_SET).
+
+/// @brief   Scenarios.
+enum {
+    OS_FS_BENCH_SEQ_WRITE,
+    OS_FS_BENCH_SEQ_READ,
+    OS_FS_BENCH_READ_DIRECT,            ///< OS_FileReadDirect().
+    OS_FS_BENCH_RAND_READ,
+    OS_FS_BENCH_RAND_WRITE,
+    OS_FS_BENCH_SEEK,                   ///< Short reads at the random offsets.
+    OS_FS_BENCH_SEEK_FAST,              ///< The same with the link map (OS_FS_FILE_OP_MODE_FAST_SEEK).
+    OS_FS_BENCH_PREALLOC_NONE,          ///< Streaming write (the clusters are allocated by the writes).
+    OS_FS_BENCH_PREALLOC_CONTIG,        ///< Streaming write to the contiguous preallocated file.
+    OS_FS_BENCH_SMALL_CREATE,
+    OS_FS_BENCH_DIR_LIST,               ///< The small files directory.
+    OS_FS_BENCH_SMALL_DELETE,
+    OS_FS_BENCH_INI_GETS,               ///< INI lines by OS_FileGetS().
+    OS_FS_BENCH_INI_READER,             ///< INI lines by the line reader.
+    OS_FS_BENCH_KV_SET,                 ///< Key-value store updates (file backend).
+    OS_FS_BENCH_ROMFS_LOOKUP,           ///< Asset path lookups.
+    OS_FS_BENCH_LAST
+};
+typedef U8 OS_FsBenchScenario;
+
+/// @brief   Benchmark config.
+typedef struct {
+    ConstStrP           dir_path_p;     ///< Work directory (created, the files are deleted after the run).
+    ConstStrP           json_path_p;    ///< Results file (OS_NULL - stdout).
+    ConstStrP           romfs_path_p;   ///< Asset file for the lookups (OS_NULL - the scenario is skipped).
+    U32                 file_size;      ///< Data file size (0 - OS_FS_BENCH_FILE_SIZE).
+    Size                io_size;        ///< Transfer size (0 - OS_FS_BENCH_IO_SIZE).
+    U32                 files_count;    ///< Small files (directory entries) count (0 - OS_FS_BENCH_FILES).
+    U32                 ops_count;      ///< Random transfers, seeks, INI lines, updates (0 - OS_FS_BENCH_OPS).
+    U32                 seed;           ///< Random offsets seed.
+    DrvMediaLatency     latency;        ///< Injected media latency (the work volume driver should support it).
+} OS_FsBenchConfig;
+
+/// @brief   Scenario result.
+typedef struct {
+    U32                 ops;
+    U32                 bytes;
+    OS_TimeMs           time;
+    OS_TimeMs           latency_max;    ///< The slowest operation.
+    Status              status;         ///< S_FS_NOT_ENABLED - skipped.
+} OS_FsBenchResult;
+
+//------------------------------------------------------------------------------
+/// @brief      Run the benchmark.
+/// @param[in]  cfg_p           Benchmark config.
+/// @param[out] results_v       Results (OS_FS_BENCH_LAST items, could be OS_NULL).
+/// @return     #Status (the first failed scenario status).
+Status          OS_FsBenchRun(const OS_FsBenchConfig* cfg_p, OS_FsBenchResult results_v[]);
+
+/// @brief      Get the scenario name.
+/// @param[in]  scenario        Scenario.
+/// @return     Name (JSON "name").
+ConstStrP       OS_FsBenchNameGet(const OS_FsBenchScenario scenario);
+
+/**@}*/ //OS_FsBench
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FS_BENCH_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_FS_BENCH_H_
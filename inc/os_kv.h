@@ -0,0 +1,119 @@
+/***************************************************************************//**
+* @file    os_kv.h
+* @brief   OS Key-value store.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_KV_H_
+#define _OS_KV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os_file_system.h"
+#include "os_driver.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_KV_ENABLED)
+/**
+* \defgroup OS_Kv OS_Kv
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Log-structured key-value store.
+/// @details The updates are appended to the log as CRC protected records,
+///          the keys index (key -> record offset) is in RAM.
+///          The log is compacted (the live records are copied to the new log)
+///          by the file system daemon if the garbage is grown or in place if the log is full.
+///          The torn records at the log end are dropped by the open (recovery).
+///          Log backends: FAT file or the raw media region (two halves are switched by the compaction).
+typedef void* OS_KvHd;
+
+/// @brief   Store config.
+typedef struct {
+    ConstStrP           file_path_p;    ///< File backend path (OS_NULL - media backend).
+    OS_DriverHd         dhd;            ///< Media backend driver.
+    U32                 sector;         ///< Media backend region first sector.
+    U32                 sectors;        ///< Media backend region size (sectors).
+    U32                 capacity;       ///< File backend log size limit (bytes).
+    Bool                is_sync;        ///< Sync the file backend after every update.
+} OS_KvConfig;
+
+/// @brief   Store statistics.
+typedef struct {
+    U32                 keys;
+    U32                 log_size;       ///< Log size (bytes).
+    U32                 live_size;      ///< Live records size (bytes).
+    U32                 capacity;
+    U32                 appends;
+    U32                 compactions;
+    U32                 dropped;        ///< Dropped (torn) bytes at the open.
+} OS_KvStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Init the key-value stores.
+/// @return     #Status.
+Status          OS_KvInit(void);
+
+/// @brief      Open the store (the log is scanned and recovered).
+/// @param[in]  cfg_p           Store config.
+/// @param[out] kvhd_p          Store handle.
+/// @return     #Status.
+Status          OS_KvOpen(const OS_KvConfig* cfg_p, OS_KvHd* kvhd_p);
+
+/// @brief      Close the store.
+/// @param[in]  kvhd            Store handle.
+/// @return     #Status.
+Status          OS_KvClose(const OS_KvHd kvhd);
+
+/// @brief      Get the value.
+/// @param[in]  kvhd            Store handle.
+/// @param[in]  key_p           Key.
+/// @param[out] value_p         Value buffer.
+/// @param[in,out] size_p       Value buffer size / value size.
+/// @return     #Status (S_NOT_EXISTS if there is no key, S_OVERFLOW if the buffer is small).
+Status          OS_KvGet(const OS_KvHd kvhd, ConstStrP key_p, void* value_p, Size* size_p);
+
+/// @brief      Set the value (one record is appended).
+/// @param[in]  kvhd            Store handle.
+/// @param[in]  key_p           Key (OS_KV_KEY_LEN_MAX).
+/// @param[in]  value_p         Value.
+/// @param[in]  size            Value size (OS_KV_VALUE_LEN_MAX).
+/// @return     #Status (S_OUT_OF_SPACE if the live records don't fit the log).
+Status          OS_KvSet(const OS_KvHd kvhd, ConstStrP key_p, const void* value_p, const Size size);
+
+/// @brief      Delete the key (the delete record is appended).
+/// @param[in]  kvhd            Store handle.
+/// @param[in]  key_p           Key.
+/// @return     #Status (S_NOT_EXISTS if there is no key).
+Status          OS_KvDelete(const OS_KvHd kvhd, ConstStrP key_p);
+
+/// @brief      Sync the log.
+/// @param[in]  kvhd            Store handle.
+/// @return     #Status.
+Status          OS_KvSync(const OS_KvHd kvhd);
+
+/// @brief      Compact the log.
+/// @param[in]  kvhd            Store handle.
+/// @return     #Status.
+Status          OS_KvCompact(const OS_KvHd kvhd);
+
+/// @brief      Get the store statistics.
+/// @param[in]  kvhd            Store handle.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_KvStatsGet(const OS_KvHd kvhd, OS_KvStats* stats_p);
+
+/// @brief      Do the background compaction request (file system daemon side).
+/// @param[in]  kvhd            Store handle (closed stores are skipped).
+/// @return     None.
+void            OS_KvCompactRequestDo(const OS_KvHd kvhd);
+
+/**@}*/ //OS_Kv
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_KV_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_KV_H_
@@ -43,6 +43,7 @@ typedef struct {
 
 #define OS_MemSet   HAL_MemSet
 #define OS_MemCmp   HAL_MemCmp
+#define OS_MemChr   HAL_MemChr
 #define OS_MemCpy   HAL_MemCpy
 #define OS_MemCpy32(dst_p, src_p, size) OS_MemCpy(dst_p, src_p, ((size) * sizeof(U32)))
 #define OS_MemMov   HAL_MemMov
@@ -71,6 +72,25 @@ void            OS_Free(void* addr_p);
 /// @return     None.
 void            OS_FreeEx(void* addr_p, const OS_MemoryPool pool);
 
+/// @brief      Allocate the aligned memory.
+/// @param[in]  size            Allocation size (in bytes).
+/// @param[in]  align           Alignment (power of 2).
+/// @return     Memory pointer.
+/// @details    The DMA buffers: the bursts don't cross the alignment boundaries.
+void*           OS_MallocAligned(const Size size, const Size align);
+
+/// @brief      Allocate the aligned memory by pool.
+/// @param[in]  size            Allocation size (in bytes).
+/// @param[in]  align           Alignment (power of 2).
+/// @param[in]  pool            Memory pool (the DMA buffers shouldn't be in the CCM).
+/// @return     Memory pointer.
+void*           OS_MallocAlignedEx(const Size size, const Size align, const OS_MemoryPool pool);
+
+/// @brief      Free the aligned memory (OS_MallocAligned(), OS_MallocAlignedEx()).
+/// @param[in]  addr_p          Memory address.
+/// @return     None.
+void            OS_FreeAligned(void* addr_p);
+
 /// @brief      Flush memory caches.
 /// @return     None.
 #if defined(CM4F)
@@ -134,6 +154,14 @@ Size            OS_MemoryFreeGet(const OS_MemoryPool pool);
 /// @return     #Status.
 Status          OS_MemoryStatsGet(const OS_MemoryPool pool, OS_MemoryStats* mem_stats_p);
 
+/// @brief      Calculate the memory block CRC-32.
+/// @details    The CRC unit polynomial (0x04C11DB7, initial value 0xFFFFFFFF, 32-bit words),
+///             the software calculation gives the same result if the unit is disabled.
+/// @param[in]  addr_p          Memory block address (32-bit aligned).
+/// @param[in]  size            Memory block size (multiple of 4).
+/// @return     CRC.
+U32             OS_MemCrc32(const void* addr_p, const Size size);
+
 //------------------------------------------------------------------------------
 #ifdef USE_MPU
 /**
@@ -198,6 +198,13 @@ Status          OS_NetworkRead(const OS_NetworkItfHd net_itf_hd, void* data_in_p
 /// @return     #Status.
 Status          OS_NetworkWrite(const OS_NetworkItfHd net_itf_hd, void* data_out_p, Size size);
 
+/// @brief      Write the frame from the segments vector.
+/// @param[in]  net_itf_hd     Network interface handle.
+/// @param[in]  seg_v          Segments vector.
+/// @param[in]  seg_count      Segments count.
+/// @return     #Status.
+Status          OS_NetworkWriteV(const OS_NetworkItfHd net_itf_hd, const OS_DriverSegment* seg_v, U32 seg_count);
+
 /// @brief      Sends data to the currently connected remote IP/port (not applicable for TCP connections).
 /// @param[in]  cfg_p          Driver's config.
 /// @param[out] dhd_p          Driver's handle.
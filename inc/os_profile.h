@@ -0,0 +1,135 @@
+/***************************************************************************//**
+* @file    os_profile.h
+* @brief   OS Profile.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_PROFILE_H_
+#define _OS_PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "status.h"
+#include "os_config.h"
+
+/**
+* \defgroup OS_Profile OS_Profile
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief Profile counter source.
+/// @details Target: DWT core cycles counter (enabled by TIMER_DWT_Init() in HAL_Init_()).
+///          Host:   CLOCK_MONOTONIC nanoseconds (so the same zones can be used in tests).
+#if defined(__ICCARM__)
+#   include "hal.h"
+#   define OS_PROF_CYCLES_GET()         ((OS_ProfileCycles)HAL_CORE_CYCLES)
+#else
+#   ifndef OS_PROFILE_ENABLED
+#   define OS_PROFILE_ENABLED           1
+#   endif // OS_PROFILE_ENABLED
+#   define OS_PROF_CYCLES_GET()         OS_ProfileHostCyclesGet()
+#endif // __ICCARM__
+
+#define OS_PROFILE_HIST_BINS            32      ///< log2 histogram bins (one per U32 bit).
+
+//------------------------------------------------------------------------------
+typedef U32 OS_ProfileCycles;
+
+/// @brief   Profile zone (statically allocated at the place of use).
+typedef struct OS_ProfileZone_ {
+    ConstStrP                   name_p;
+    struct OS_ProfileZone_*     next_p;
+    Bool                        is_linked;
+    U32                         count;
+    OS_ProfileCycles            min;
+    OS_ProfileCycles            max;
+    U64                         sum;
+    U32                         hist_v[OS_PROFILE_HIST_BINS];
+} OS_ProfileZone;
+
+typedef OS_ProfileZone* OS_ProfileZoneHd;
+
+/// @brief   Profile zone statistics.
+typedef struct {
+    ConstStrP                   name_p;
+    U32                         count;
+    OS_ProfileCycles            min;
+    OS_ProfileCycles            max;
+    OS_ProfileCycles            mean;
+    OS_ProfileCycles            p99;    ///< Upper bound of the log2 bin holding the 99th percentile.
+} OS_ProfileZoneStats;
+
+//------------------------------------------------------------------------------
+/// @brief Zone macros.
+/// @details Scoped zone - the statement (block) right after the macro is measured:
+///             OS_PROF_ZONE(disk_read) {
+///                 s = OS_DriverRead(dhd, buf_p, count, &sector);
+///             }
+///          Do not leave the zone block by return/break/goto - the sample will be lost.
+///          Use the OS_PROF_ZONE_BEGIN/OS_PROF_ZONE_END pair for the functions with many exits.
+///          Zone name should be a valid C identifier and unique within the function.
+///          All macros compile to nothing if OS_PROFILE_ENABLED is 0.
+#if (OS_PROFILE_ENABLED)
+#define OS_PROF_ZONE(zone) \
+    static OS_ProfileZone os_prof_zone_##zone = { #zone }; \
+    for (OS_ProfileCycles os_prof_start_##zone = OS_PROF_CYCLES_GET(), os_prof_once_##zone = 1; \
+         os_prof_once_##zone; \
+         os_prof_once_##zone = 0, OS_ProfileZoneAdd(&os_prof_zone_##zone, OS_PROF_CYCLES_GET() - os_prof_start_##zone))
+
+#define OS_PROF_ZONE_BEGIN(zone) \
+    static OS_ProfileZone os_prof_zone_##zone = { #zone }; \
+    const OS_ProfileCycles os_prof_start_##zone = OS_PROF_CYCLES_GET()
+
+#define OS_PROF_ZONE_END(zone) \
+    OS_ProfileZoneAdd(&os_prof_zone_##zone, OS_PROF_CYCLES_GET() - os_prof_start_##zone)
+#else
+#define OS_PROF_ZONE(zone)
+#define OS_PROF_ZONE_BEGIN(zone)
+#define OS_PROF_ZONE_END(zone)
+#endif // (OS_PROFILE_ENABLED)
+
+#if (OS_PROFILE_ENABLED)
+//------------------------------------------------------------------------------
+/// @brief      Add the sample to the zone.
+/// @param[in]  zone_p          Zone.
+/// @param[in]  cycles          Sample (counter ticks).
+/// @return     None.
+/// @note       Registers the zone on the first call. Safe to call from ISR.
+void            OS_ProfileZoneAdd(OS_ProfileZone* zone_p, const OS_ProfileCycles cycles);
+
+/// @brief      Get the zone statistics.
+/// @param[in]  zhd             Zone handle.
+/// @param[out] stats_p         Zone statistics.
+/// @return     #Status.
+Status          OS_ProfileZoneStatsGet(const OS_ProfileZoneHd zhd, OS_ProfileZoneStats* stats_p);
+
+/// @brief      Get the next registered zone.
+/// @param[in]  zhd             Zone handle (OS_NULL - get the first one).
+/// @return     Zone handle.
+OS_ProfileZoneHd OS_ProfileZoneNextGet(const OS_ProfileZoneHd zhd);
+
+/// @brief      Reset statistics of all the registered zones.
+/// @return     None.
+void            OS_ProfileReset(void);
+
+/// @brief      Convert counter ticks to microseconds.
+/// @param[in]  cycles          Counter ticks.
+/// @return     Microseconds.
+U32             OS_ProfileCyclesToUs(const OS_ProfileCycles cycles);
+
+#if !defined(__ICCARM__)
+/// @brief      Get the host monotonic counter.
+/// @return     Counter ticks (ns).
+OS_ProfileCycles OS_ProfileHostCyclesGet(void);
+#endif // __ICCARM__
+
+#endif // (OS_PROFILE_ENABLED)
+
+/**@}*/ //OS_Profile
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_PROFILE_H_
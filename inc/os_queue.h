@@ -20,6 +20,7 @@ extern "C" {
 */
 //------------------------------------------------------------------------------
 typedef void* OS_QueueHd;
+typedef void* OS_QueueSetHd;
 
 typedef struct {
     U16             len;
@@ -99,6 +100,35 @@ U32             OS_QueuesCountGet(void);
 /// @return     Queue handle.
 OS_QueueHd      OS_QueueNextGet(const OS_QueueHd qhd);
 
+#if (OS_TASK_LIGHT_ENABLED)
+/// @brief      Create a queue set.
+/// @param[in]  len             Total length of the member queues.
+/// @param[out] qshd_p          Queue set handle.
+/// @return     #Status.
+Status          OS_QueueSetCreate(const U16 len, OS_QueueSetHd* qshd_p);
+
+/// @brief      Add the queue to the set.
+/// @param[in]  qshd            Queue set handle.
+/// @param[in]  qhd             Queue handle.
+/// @return     #Status.
+/// @note       The queue should be empty.
+Status          OS_QueueSetAdd(const OS_QueueSetHd qshd, const OS_QueueHd qhd);
+
+/// @brief      Remove the queue from the set.
+/// @param[in]  qshd            Queue set handle.
+/// @param[in]  qhd             Queue handle.
+/// @return     #Status.
+/// @note       The queue should be empty.
+Status          OS_QueueSetRemove(const OS_QueueSetHd qshd, const OS_QueueHd qhd);
+
+/// @brief      Wait for the set member queue with an item.
+/// @param[in]  qshd            Queue set handle.
+/// @param[in]  timeout         Waiting timeout.
+/// @return     Queue handle (OS_NULL - timeout or the queue is already deleted).
+/// @note       The item should be received from the returned queue right after the call.
+OS_QueueHd      OS_QueueSetSelect(const OS_QueueSetHd qshd, const OS_TimeMs timeout);
+#endif //(OS_TASK_LIGHT_ENABLED)
+
 /**
 * \addtogroup OS_ISR_Queue ISR specific functions.
 * @{
@@ -0,0 +1,142 @@
+/***************************************************************************//**
+* @file    os_romfs.h
+* @brief   OS Read-only asset file system.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_ROMFS_H_
+#define _OS_ROMFS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os_file_system.h"
+#include "os_driver.h"
+
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_ROMFS_ENABLED)
+/**
+* \defgroup OS_RomFs OS_RomFs
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Read-only asset file system (romfs).
+/// @details The image is built by the host packer (tls/mkromfs/mkromfs.py) and is linked
+///          into the flash or placed on the media. The volume is created by OS_FileSystemMediaCreate()
+///          with the OS_FS_ROMFS type and is accessed by the OS_File* and OS_Directory* API.
+///          The paths are looked up by the perfect hash index (one probe, one compare).
+///          The memory mapped images (DRV_REQ_MEDIA_ADDRESS_GET) are accessed zero-copy (OS_FileMap()),
+///          the others are read by the media sectors.
+///          The functions below are the file system side (OS_File* routing).
+
+/// @brief   Volume statistics.
+typedef struct {
+    U32                 entries;        ///< Files count.
+    U32                 image_size;     ///< Image size (bytes).
+    U32                 index_size;     ///< Index size (bytes).
+    U32                 lookups;
+    U32                 misses;
+    Bool                is_mapped;      ///< Memory mapped image.
+} OS_RomFsStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Mount the volume (the image index is validated).
+/// @param[in]  volume          Volume.
+/// @param[in]  dhd             Media driver.
+/// @param[in]  fshd            Volume file system object (the volume handles owner).
+/// @return     #Status.
+Status          OS_RomFsMount(const U8 volume, const OS_DriverHd dhd, const OS_FileSystemHd fshd);
+
+/// @brief      Unmount the volume.
+/// @param[in]  volume          Volume.
+/// @return     #Status (S_BUSY if there are opened files).
+Status          OS_RomFsUnMount(const U8 volume);
+
+/// @brief      Test the path volume.
+/// @param[in]  path_p          Path (with the volume prefix).
+/// @return     Is on the mounted romfs volume.
+Bool            OS_RomFsPathIs(ConstStrP path_p);
+
+/// @brief      Test the file handle.
+/// @param[in]  fhd             File handle.
+/// @return     Is the romfs file.
+Bool            OS_RomFsFileIs(const OS_FileHd fhd);
+
+/// @brief      Test the directory handle.
+/// @param[in]  dhd             Directory handle.
+/// @return     Is the romfs directory.
+Bool            OS_RomFsDirIs(const OS_DirHd dhd);
+
+/// @brief      Open the file.
+/// @param[in]  fhd             File handle (allocated).
+/// @param[in]  file_path_p     File path.
+/// @param[in]  op_mode         File open mode (read only).
+/// @return     #Status.
+Status          OS_RomFsFileOpen(const OS_FileHd fhd, ConstStrP file_path_p, const OS_FileOpenMode op_mode);
+
+/// @brief      Close the file (the handle isn't freed).
+/// @param[in]  fhd             File handle.
+/// @return     #Status.
+Status          OS_RomFsFileClose(const OS_FileHd fhd);
+
+/// @brief      Read the file.
+/// @param[in]  fhd             File handle.
+/// @param[out] data_in_p       Data input buffer.
+/// @param[in]  size            Input buffer size.
+/// @param[out] bytes_read_p    Read bytes count.
+/// @return     #Status.
+Status          OS_RomFsFileRead(const OS_FileHd fhd, void* data_in_p, const Size size, UInt* bytes_read_p);
+
+/// @brief      Set the file offset (clipped by the file size).
+/// @param[in]  fhd             File handle.
+/// @param[in]  offset          Offset.
+/// @return     #Status.
+Status          OS_RomFsFileLSeek(const OS_FileHd fhd, const U32 offset);
+
+/// @brief      Get the file string.
+/// @param[in]  fhd             File handle.
+/// @param[out] str_p           String.
+/// @param[in]  len             String length.
+/// @return     #Status.
+Status          OS_RomFsFileGetS(const OS_FileHd fhd, StrP str_p, const U32 len);
+
+/// @brief      Map the file region.
+/// @param[in]  fhd             File handle.
+/// @param[in]  offset          Region offset.
+/// @param[in]  size            Region size.
+/// @param[out] data_pp         Region data.
+/// @return     #Status (S_FS_NOT_ENABLED if the image isn't memory mapped).
+Status          OS_RomFsFileMap(const OS_FileHd fhd, const U32 offset, const Size size, const void** data_pp);
+
+/// @brief      Get the file or the directory statistics.
+/// @param[in]  file_path_p     Path.
+/// @param[in,out] file_stats_p File statistics.
+/// @return     #Status.
+Status          OS_RomFsFileStatsGet(ConstStrP file_path_p, OS_FileStats* file_stats_p);
+
+/// @brief      Open the directory.
+/// @param[in]  dhd             Directory handle (allocated).
+/// @param[in]  path_p          Directory path.
+/// @return     #Status.
+Status          OS_RomFsDirectoryOpen(const OS_DirHd dhd, ConstStrP path_p);
+
+/// @brief      Read the directory item.
+/// @param[in]  dhd             Directory handle.
+/// @param[in,out] file_stats_p Item statistics (the empty name at the end).
+/// @return     #Status.
+Status          OS_RomFsDirectoryRead(const OS_DirHd dhd, OS_FileStats* file_stats_p);
+
+/// @brief      Get the volume statistics.
+/// @param[in]  volume          Volume.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_RomFsStatsGet(const U8 volume, OS_RomFsStats* stats_p);
+
+/**@}*/ //OS_RomFs
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_ROMFS_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_ROMFS_H_
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+* @file    os_sec_cache.h
+* @brief   OS Media sector cache.
+* @author  A. Filyanov
+*******************************************************************************/
+#ifndef _OS_SEC_CACHE_H_
+#define _OS_SEC_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "status.h"
+#include "os_config.h"
+#include "os_driver.h"
+#include "os_blk_sched.h"
+
+#if (OS_SEC_CACHE_ENABLED)
+/**
+* \defgroup OS_SecCache OS_SecCache
+* @{
+*/
+//------------------------------------------------------------------------------
+/// @brief   Write-back LRU sector cache between the diskio layer and the media.
+/// @details Lines are single sectors stored in the OS_SEC_CACHE_MEM pool.
+///          Dirty lines are written on eviction and on flush (sync, unmount, power down).
+///          Sectors inside the write-through regions are written to the media immediately.
+///          Transfers longer than OS_SEC_CACHE_BYPASS_SECTORS go to the media directly
+///          and keep the cached copies coherent.
+typedef void* OS_SecCacheHd;
+
+/// @brief   Cache statistics.
+typedef struct {
+    U32                 reads;      ///< Sectors read through the cache.
+    U32                 hits;
+    U32                 writes;     ///< Sectors written through the cache.
+    U32                 write_backs;///< Dirty sectors written to the media.
+    U32                 evictions;
+    U32                 bypasses;   ///< Transfers sent to the media directly.
+    U32                 dirty;      ///< Dirty lines now.
+    U32                 lines;
+} OS_SecCacheStats;
+
+//------------------------------------------------------------------------------
+/// @brief      Create the cache.
+/// @param[in]  dhd             Media driver handle.
+/// @param[in]  bshd            Media scheduler handle (could be OS_NULL).
+/// @param[out] schd_p          Cache handle.
+/// @return     #Status.
+Status          OS_SecCacheCreate(const OS_DriverHd dhd, const OS_BlkSchedHd bshd, OS_SecCacheHd* schd_p);
+
+/// @brief      Delete the cache (dirty lines are lost).
+/// @param[in]  schd            Cache handle.
+/// @return     #Status.
+Status          OS_SecCacheDelete(const OS_SecCacheHd schd);
+
+/// @brief      Read sectors.
+/// @param[in]  schd            Cache handle.
+/// @param[out] data_in_p       Data buffer.
+/// @param[in]  sector          Start sector (LBA).
+/// @param[in]  count           Sectors count.
+/// @return     #Status.
+Status          OS_SecCacheRead(const OS_SecCacheHd schd, void* data_in_p, const U32 sector, const U32 count);
+
+/// @brief      Write sectors.
+/// @param[in]  schd            Cache handle.
+/// @param[in]  data_out_p      Data buffer.
+/// @param[in]  sector          Start sector (LBA).
+/// @param[in]  count           Sectors count.
+/// @return     #Status.
+Status          OS_SecCacheWrite(const OS_SecCacheHd schd, void* data_out_p, const U32 sector, const U32 count);
+
+/// @brief      Write all dirty lines to the media.
+/// @param[in]  schd            Cache handle.
+/// @return     #Status.
+Status          OS_SecCacheFlush(const OS_SecCacheHd schd);
+
+/// @brief      Flush and drop all lines (the lines are kept if the flush fails).
+/// @param[in]  schd            Cache handle.
+/// @return     #Status.
+Status          OS_SecCacheInvalidate(const OS_SecCacheHd schd);
+
+/// @brief      Add the write-through region.
+/// @param[in]  schd            Cache handle.
+/// @param[in]  sector          Start sector (LBA).
+/// @param[in]  count           Sectors count.
+/// @return     #Status.
+Status          OS_SecCacheWriteThroughAdd(const OS_SecCacheHd schd, const U32 sector, const U32 count);
+
+/// @brief      Remove all write-through regions.
+/// @param[in]  schd            Cache handle.
+/// @return     #Status.
+Status          OS_SecCacheWriteThroughClear(const OS_SecCacheHd schd);
+
+/// @brief      Get the cache statistics.
+/// @param[in]  schd            Cache handle.
+/// @param[out] stats_p         Statistics.
+/// @return     #Status.
+Status          OS_SecCacheStatsGet(const OS_SecCacheHd schd, OS_SecCacheStats* stats_p);
+
+/// @brief      Reset the cache statistics.
+/// @param[in]  schd            Cache handle.
+/// @return     None.
+void            OS_SecCacheStatsReset(const OS_SecCacheHd schd);
+
+/**@}*/ //OS_SecCache
+
+#endif // (OS_SEC_CACHE_ENABLED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OS_SEC_CACHE_H_
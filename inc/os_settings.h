@@ -76,6 +76,36 @@ Status          OS_SettingsItemsRead(ConstStrP file_path_p, OS_SettingsItem item
 /// @return     #Status.
 Status          OS_SettingsItemsWrite(ConstStrP file_path_p, OS_SettingsItem items[]);
 
+#if (OS_SETTINGS_CACHE_ENABLED)
+/// @brief      Write the cached changes to the settings file.
+/// @param[in]  file_path_p     Path to the settings file (OS_NULL - all the cached files).
+/// @return     #Status.
+Status          OS_SettingsFlush(ConstStrP file_path_p);
+
+/// @brief      Drop the cached settings file (the not flushed changes are lost).
+/// @param[in]  file_path_p     Path to the settings file (OS_NULL - all the cached files).
+/// @return     #Status.
+Status          OS_SettingsCacheInvalidate(ConstStrP file_path_p);
+
+/// @brief      Flush and drop the cached settings files of the volume.
+/// @details    Called by the volume unmount (the media could be changed before the next mount).
+/// @param[in]  volume          Volume.
+/// @return     #Status (the changes are dropped if the flush fails).
+Status          OS_SettingsCacheVolumeRelease(const U8 volume);
+#endif // (OS_SETTINGS_CACHE_ENABLED)
+
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+/// @brief      Load the settings snapshot (boot).
+/// @details    The environment variables are mapped to the snapshot copy,
+///             the settings file is served from the snapshot until the file is changed.
+/// @return     #Status (the snapshot is missing or invalid - the INI file is parsed).
+Status          OS_SettingsSnapshotLoad(void);
+
+/// @brief      Write the settings snapshot (the environment is changed).
+/// @return     #Status.
+Status          OS_SettingsSnapshotWrite(void);
+#endif // (OS_SETTINGS_SNAPSHOT_ENABLED)
+
 #if (OS_SETTINGS_BROWSE_ENABLED)
 //Status OS_SettingsBrowse(OS_SettingsCallback callback_func_p, );
 #endif // (OS_SETTINGS_BROWSE_ENABLED)
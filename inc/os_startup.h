@@ -12,6 +12,19 @@
 * \defgroup OS_Startup OS_Startup
 * @{
 */
+//------------------------------------------------------------------------------
+#define OS_STARTUP_PRED_NONE        U8_MAX
+
+/// @brief   Startup task timeline item.
+typedef struct {
+    ConstStrP       name_p;
+    U32             start;          ///< Task creation time (us since the startup run).
+    U32             ready;          ///< Task power "on" ack time (us since the startup run).
+    U8              pred;           ///< Index of the dependency that gated the task start.
+    Bool            is_critical;    ///< Is the task on the critical path?
+    Status          status;
+} OS_StartupTimelineItem;
+
 //------------------------------------------------------------------------------
 /// @brief      Init startup.
 /// @return     #Status.
@@ -27,10 +40,32 @@ Status          OS_StartupSystem(void);
 
 /// @brief      Application tasks startup.
 /// @return     #Status.
+/// @details    Independent tasks are created and powered concurrently,
+///             the dependent ones - after all their dependencies are on.
 Status          OS_StartupApplication(void);
 
+/// @brief      Add the task to the startup.
+/// @param[in]  task_cfg_p      Task config.
+/// @return     #Status.
 Status          OS_StartupTaskAdd(const OS_TaskConfig* task_cfg_p);
 
+/// @brief      Add the startup task dependency.
+/// @param[in]  task_cfg_p      Task config.
+/// @param[in]  dep_cfg_p       Config of the task to be started before.
+/// @return     #Status.
+/// @note       Both tasks should be already added to the startup.
+Status          OS_StartupTaskDependencyAdd(const OS_TaskConfig* task_cfg_p, const OS_TaskConfig* dep_cfg_p);
+
+/// @brief      Get the startup timeline items count.
+/// @return     Items count.
+U8              OS_StartupTimelineCountGet(void);
+
+/// @brief      Get the startup timeline item.
+/// @param[in]  idx             Item index.
+/// @param[out] item_p          Timeline item.
+/// @return     #Status.
+Status          OS_StartupTimelineItemGet(const U8 idx, OS_StartupTimelineItem* item_p);
+
 /**@}*/ //OS_Startup
 
 #endif // _OS_STARTUP_H_
\ No newline at end of file
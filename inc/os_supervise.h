@@ -33,7 +33,7 @@ typedef U8 OS_SchedulerState;
 
 /// @brief      Start scheduler.
 /// @return     None.
-#define         OS_SchedulerStart               vTaskStartScheduler
+#define         OS_SchedulerStart()             do { HAL_BOOT_CHECKPOINT("os_sched"); vTaskStartScheduler(); } while (0)
 
 /// @brief      Suspend scheduler.
 /// @return     None.
@@ -28,6 +28,7 @@ extern "C" {
 enum {
     OS_TASK_ATTR_SINGLE,
     OS_TASK_ATTR_RECREATE,
+    OS_TASK_ATTR_LIGHT,     ///< Stackless run-to-completion task (see OS_TaskCreate()).
 //    OS_TASK_ATTR_MPU,
 //    OS_TASK_ATTR_FPU,
     OS_TASK_ATTR_LAST
@@ -78,6 +79,27 @@ typedef struct {
     U8                  stdin_len;
 } OS_TaskConfig;
 
+/// @brief   Periodic task config.
+typedef struct {
+    OS_TimeMs           period;         ///< Release period.
+    OS_TimeMs           deadline;       ///< Relative deadline (0 - equal to the period).
+    OS_TimeMs           budget;         ///< Execution budget (0 - unknown, excluded from the schedulability check).
+} OS_TaskPeriodicConfig;
+
+/// @brief   Periodic task statistics (us).
+typedef struct {
+    OS_TaskPeriodicConfig cfg;
+    U32                 releases;
+    U32                 deadline_misses;
+    U32                 budget_overruns;
+    S32                 jitter_last;    ///< Release jitter (job start - planned release).
+    U32                 jitter_max;     ///< Absolute maximum of the release jitter.
+    U32                 response_last;  ///< Response time (job end - planned release).
+    U32                 response_min;
+    U32                 response_max;
+    U32                 response_hist_v[OS_TASK_PERIODIC_HIST_LEN + 1]; ///< Deadline fractions, the last bin - misses.
+} OS_TaskPeriodicStats;
+
 //------------------------------------------------------------------------------
 /// @brief      Init task.
 /// @param[in]  args_p          Task arguments.
@@ -102,8 +124,45 @@ WEAK static Status  OS_TaskPower(OS_TaskArgs* args_p, const OS_PowerState state)
 /// @param[in]  cfg_p           Task config.
 /// @param[out] thd_p           Task handle.
 /// @return     #Status.
+/// @details    Light task (OS_TASK_ATTR_LIGHT) has no own stack: cfg_p->func_main is called
+///             by the shared executor task each time the task stdin gets an item. It should
+///             receive the message with OS_NO_BLOCK timeout, handle it and return (the call
+///             without a message is possible). Light task should not block and create tasks
+///             synchronously. stack_size and prio_init are ignored.
 Status          OS_TaskCreate(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskHd* thd_p);
 
+/// @brief      Create a task without waiting for the power acks.
+/// @param[in]  args_p          Task arguments.
+/// @param[in]  cfg_p           Task config.
+/// @param[out] thd_p           Task handle.
+/// @return     #Status.
+/// @details    The caller is responsible for sending OS_SIG_PWR (PWR_STARTUP, PWR_ON)
+///             signals to the task and collecting OS_SIG_PWR_ACK replies.
+Status          OS_TaskCreateAsync(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskHd* thd_p);
+
+/// @brief      Create a periodic task.
+/// @param[in]  args_p          Task arguments.
+/// @param[in]  cfg_p           Task config.
+/// @param[in]  per_cfg_p       Periodic config.
+/// @param[out] thd_p           Task handle.
+/// @return     #Status.
+/// @details    cfg_p->func_main is a job: it is called once per release and should return.
+///             Power signals are served between the releases, so the period should be
+///             less than OS_TIMEOUT_POWER. Returns S_OVERFLOW if the total utilisation
+///             of the periodic tasks with budgets exceeds 100%.
+Status          OS_TaskPeriodicCreate(const void* args_p, const OS_TaskConfig* cfg_p,
+                                      const OS_TaskPeriodicConfig* per_cfg_p, OS_TaskHd* thd_p);
+
+/// @brief      Get periodic task statistics.
+/// @param[in]  thd             Task handle.
+/// @param[out] stats_p         Periodic task statistics.
+/// @return     #Status.
+Status          OS_TaskPeriodicStatsGet(const OS_TaskHd thd, OS_TaskPeriodicStats* stats_p);
+
+/// @brief      Get periodic tasks utilisation.
+/// @return     Utilisation (permille) of the periodic tasks with budgets.
+U16             OS_TasksPeriodicUtilizationGet(void);
+
 /// @brief      Delete the task.
 /// @param[in]  thd             Task handle.
 /// @return     #Status.
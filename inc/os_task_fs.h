@@ -13,6 +13,16 @@
 #if (OS_FILE_SYSTEM_ENABLED)
 #define OS_DAEMON_NAME_FS           "FileSysD"
 #define OS_SIG_FSD_READY            OS_SIG_USB_LAST
+
+enum {
+    OS_MSG_FS_STREAM_FILL = OS_MSG_USB_LAST,
+    OS_MSG_FS_STREAM_FLUSH,
+    OS_MSG_FS_VOLUME_VALIDATE,
+    OS_MSG_FS_ASYNC_REQ,
+    OS_MSG_FS_ASYNC_DONE,
+    OS_MSG_FS_KV_COMPACT,
+    OS_MSG_FS_LAST
+};
 #endif //(OS_FILE_SYSTEM_ENABLED)
 
 #endif // _OS_TASK_FS_H_
\ No newline at end of file
@@ -27,7 +27,8 @@ typedef OS_SignalData   OS_TimerId;
 
 enum {
     OS_TIM_ID_UNDEF,
-    OS_TIM_ID_APP           = 0x01,
+    OS_TIM_ID_SETTINGS_FLUSH,
+    OS_TIM_ID_APP,
     OS_TIM_ID_LAST
 };
 
@@ -30,6 +30,14 @@ extern HAL_DriverItf drv_media_sdram;
 extern HAL_DriverItf drv_media_sdcard;
     drv_media_v[DRV_ID_MEDIA_SDCARD]    = &drv_media_sdcard;
 #endif
+#if defined(OS_MEDIA_VOL_ROMFS)
+extern HAL_DriverItf drv_media_romfs;
+    drv_media_v[DRV_ID_MEDIA_ROMFS]     = &drv_media_romfs;
+#endif
+#if defined(OS_MEDIA_VOL_IMAGE)
+extern HAL_DriverItf drv_media_image;
+    drv_media_v[DRV_ID_MEDIA_IMAGE]     = &drv_media_image;
+#endif
 #if defined(OS_MEDIA_VOL_USBH_FS)
 extern HAL_DriverItf drv_media_usbh_fs;
     drv_media_v[DRV_ID_MEDIA_USBH_FS]   = &drv_media_usbh_fs;
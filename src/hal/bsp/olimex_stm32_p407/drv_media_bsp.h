@@ -16,6 +16,12 @@ enum {
 #if defined(OS_MEDIA_VOL_SDCARD)
     DRV_ID_MEDIA_SDCARD = OS_MEDIA_VOL_SDCARD,
 #endif
+#if defined(OS_MEDIA_VOL_ROMFS)
+    DRV_ID_MEDIA_ROMFS  = OS_MEDIA_VOL_ROMFS,
+#endif
+#if defined(OS_MEDIA_VOL_IMAGE)
+    DRV_ID_MEDIA_IMAGE  = OS_MEDIA_VOL_IMAGE,
+#endif
 #if defined(OS_MEDIA_VOL_USBH_FS)
     DRV_ID_MEDIA_USBH_FS = OS_MEDIA_VOL_USBH_FS,
 #endif
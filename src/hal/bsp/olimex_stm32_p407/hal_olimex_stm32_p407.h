@@ -53,6 +53,7 @@ extern int cycles_last;
 #define HAL_DWT_STOPWATCH_STOP          { cycles_diff = HAL_CORE_CYCLES - cycles_last; }
 
 extern U32 SystemCoreClockKHz;
+extern U32 SystemCoreClockMHz;
 ///@brief
 ///@details Example:
 ///         DWT_STOPWATCH_START;
@@ -60,9 +61,29 @@ extern U32 SystemCoreClockKHz;
 ///         DWT_STOPWATCH_STOP;
 ///         D_LOG(D_DEBUG, "%d(ms)", CYCLES_TO_MS(cycles_diff));
 #define CYCLES_TO_MS(cycles)            ((U32)((cycles) / SystemCoreClockKHz))
+#define CYCLES_TO_US(cycles)            ((U32)((cycles) / SystemCoreClockMHz))
+#define MS_TO_CYCLES(ms)                ((U32)((ms) * SystemCoreClockKHz))
 
 #define HAL_IO                          volatile
 
+///@brief   Boot checkpoint.
+///@details Stamps are kept in the retained (not initialized) RAM,
+///         so the previous boot timeline survives the soft reset.
+///         Cycles are counted from TIMER_DWT_Init() in HAL_Init_().
+#define HAL_BOOT_CHECKPOINT(name)       HAL_BootCheckpoint(name)
+
+typedef struct {
+    Str             name[HAL_BOOT_CHECKPOINT_NAME_LEN];
+    U32             cycles;
+} HAL_BootCheckpointItem;
+
+enum {
+    HAL_BOOT_CURRENT,
+    HAL_BOOT_PREVIOUS,
+    HAL_BOOT_LAST
+};
+typedef U8 HAL_Boot;
+
 //-----------------------------------------------------------------------------
 /// @brief      Init HAL.
 /// @return     #Status.
@@ -120,6 +141,33 @@ U32             HAL_SystemCoreClockGet(void);
 /// @return     None.
 void            HAL_StdIoCls(void);
 
+/// @brief      Add the boot checkpoint.
+/// @param[in]  name_p          Checkpoint name (truncated to HAL_BOOT_CHECKPOINT_NAME_LEN - 1).
+/// @return     None.
+/// @note       Checkpoints above HAL_BOOT_CHECKPOINTS_MAX are ignored.
+void            HAL_BootCheckpoint(ConstStrP name_p);
+
+/// @brief      Get the boot checkpoints count.
+/// @param[in]  boot            Boot timeline.
+/// @return     Checkpoints count.
+U8              HAL_BootCheckpointsCountGet(const HAL_Boot boot);
+
+/// @brief      Get the boot checkpoint.
+/// @param[in]  boot            Boot timeline.
+/// @param[in]  idx             Checkpoint index.
+/// @param[out] item_p          Checkpoint.
+/// @return     #Status.
+Status          HAL_BootCheckpointGet(const HAL_Boot boot, const U8 idx, HAL_BootCheckpointItem* item_p);
+
+/// @brief      Get the boots count since the power on.
+/// @return     Boots count.
+U32             HAL_BootCountGet(void);
+
+/// @brief      Get the firmware build identity.
+/// @details    Hash of the version and the build time: differs for every firmware build.
+/// @return     Build id.
+U32             HAL_BuildIdGet(void);
+
 /// @brief      Get device description.
 /// @param[out] dev_desc_p      Device description.
 /// @param[in]  size            Description size.
@@ -73,4 +73,19 @@ Status s = S_UNDEF;
     return s;
 }
 
+/******************************************************************************/
+U32 CRC_Calculate32(const U32* data_p, const Size count)
+{
+U32 crc;
+    // The unit is shared - the calculation is atomic.
+    HAL_CRITICAL_SECTION_ENTER(); {
+        __HAL_CRC_DR_RESET(&crc_hd);
+        for (Size i = 0; i < count; ++i) {
+            crc_hd.Instance->DR = data_p[i];
+        }
+        crc = crc_hd.Instance->DR;
+    } HAL_CRITICAL_SECTION_EXIT();
+    return crc;
+}
+
 #endif //(HAL_CRC_ENABLED)
\ No newline at end of file
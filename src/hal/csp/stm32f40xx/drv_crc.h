@@ -22,6 +22,15 @@ enum {
 //-----------------------------------------------------------------------------
 extern HAL_DriverItf* drv_crc_v[];
 
+//-----------------------------------------------------------------------------
+/// @brief   Calculate CRC-32 by the CRC unit.
+/// @details Polynomial 0x04C11DB7, initial value 0xFFFFFFFF, no reflection,
+///          the words are processed MSB first.
+/// @param[in]  data_p          Data words.
+/// @param[in]  count           Data words count.
+/// @return     CRC.
+U32 CRC_Calculate32(const U32* data_p, const Size count);
+
 #endif //(HAL_CRC_ENABLED)
 
 #endif // _DRV_CRC_H_
\ No newline at end of file
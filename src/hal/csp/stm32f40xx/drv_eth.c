@@ -10,6 +10,7 @@
 #include "os_signal.h"
 #include "os_time.h"
 #include "os_network.h"
+#include "os_profile.h"
 
 #if (HAL_ETH_ENABLED)
 //-----------------------------------------------------------------------------
@@ -17,6 +18,15 @@
 
 #define ETH0_OS_MEM_TYPE                OS_MEM_RAM_INT_SRAM
 
+//-----------------------------------------------------------------------------
+/// @brief   Tx frame gather state (the frame is copied to the Tx DMA descriptors buffers).
+typedef struct {
+    HAL_IO ETH_DMADescTypeDef*  desc_p;
+    U8*                         buffer_p;
+    U32                         buffer_offset;
+    U32                         frame_length;
+} ETH_TxGather;
+
 //-----------------------------------------------------------------------------
 /// @brief   Init ETH.
 /// @return  #Status.
@@ -30,6 +40,10 @@ static Status   ETH_Open(void* args_p);
 static Status   ETH_Close(void* args_p);
 static Status   ETH_DMA_Read(void* data_in_p, Size size, void* args_p);
 static Status   ETH_DMA_Write(void* data_out_p, Size size, void* args_p);
+static Status   ETH_DMA_WriteV(const HAL_DriverSegment* seg_v, U32 seg_count, void* args_p);
+static void     ETH_DMA_TxGatherInit(ETH_TxGather* gather_p);
+static Status   ETH_DMA_TxGather(ETH_TxGather* gather_p, const U8* data_p, U32 size);
+static Status   ETH_DMA_TxFrame(const ETH_TxGather* gather_p, Status s);
 static Status   ETH_IoCtl(const U32 request_id, void* args_p);
 
 //-----------------------------------------------------------------------------
@@ -49,7 +63,8 @@ static HAL_DriverItf drv_eth0 = {
     .Close  = ETH_Close,
     .Read   = ETH_DMA_Read,
     .Write  = ETH_DMA_Write,
-    .IoCtl  = ETH_IoCtl
+    .IoCtl  = ETH_IoCtl,
+    .WriteV = ETH_DMA_WriteV
 };
 
 /*****************************************************************************/
@@ -239,6 +254,7 @@ Status s = S_OK;
     if (HAL_OK != HAL_ETH_GetReceivedFrame_IT(&eth0_hd)) {
         return (s = S_HARDWARE_ERROR);
     }
+    OS_PROF_ZONE_BEGIN(eth_dma_read);
     /* Obtain the size of the packet and put it into the "len" variable. */
     len = eth0_hd.RxFrameInfos.length;
     buffer_p = (U8*)eth0_hd.RxFrameInfos.buffer;
@@ -288,64 +304,53 @@ Status s = S_OK;
         eth0_hd.Instance->DMARPDR = 0;
     }
     *(OS_NetworkBuf**)args_p = p;
+    OS_PROF_ZONE_END(eth_dma_read);
     return s;
 }
 
 /******************************************************************************/
-Status ETH_DMA_Write(void* data_out_p, Size size, void* args_p)
+void ETH_DMA_TxGatherInit(ETH_TxGather* gather_p)
 {
-OS_NetworkBuf* q;
-U8* buffer_p = (U8*)(eth0_hd.TxDesc->Buffer1Addr);
-HAL_IO ETH_DMADescTypeDef *tx_dma_desc;
-U32 frame_length = 0;
-U32 buffer_offset = 0;
-U32 bytes_left_to_copy = 0;
-U32 payload_offset = 0;
-Status s = S_UNDEF;
-
-    tx_dma_desc = eth0_hd.TxDesc;
-    buffer_offset = 0;
-    /* copy frame from pbufs to driver buffers */
-    for (q = data_out_p; q != NULL; q = q->next) {
-        /* Is this buffer available? If not, goto error */
-        if ((U32)RESET != (tx_dma_desc->Status & ETH_DMATXDESC_OWN)) {
-            s = S_BUSY;
-            goto error;
-        }
-        /* Get bytes in current lwIP buffer */
-        bytes_left_to_copy = q->len;
-        payload_offset = 0;
-        /* Check if the length of data to copy is bigger than Tx buffer size*/
-        while ((bytes_left_to_copy + buffer_offset) > ETH_TX_BUF_SIZE) {
-            /* Copy data to Tx buffer*/
-            OS_MemCpy((U8*)((U8*)buffer_p + buffer_offset), (U8*)((U8*)q->payload + payload_offset), (ETH_TX_BUF_SIZE - buffer_offset));
-            /* Point to next descriptor */
-            tx_dma_desc = (ETH_DMADescTypeDef*)(tx_dma_desc->Buffer2NextDescAddr);
-            /* Check if the buffer is available */
-            if ((U32)RESET != (tx_dma_desc->Status & ETH_DMATXDESC_OWN)) {
-                s = S_BUSY;
-                goto error;
-            }
-
-            buffer_p = (U8*)(tx_dma_desc->Buffer1Addr);
+    gather_p->desc_p        = eth0_hd.TxDesc;
+    gather_p->buffer_p      = (U8*)(eth0_hd.TxDesc->Buffer1Addr);
+    gather_p->buffer_offset = 0;
+    gather_p->frame_length  = 0;
+}
 
-            bytes_left_to_copy = bytes_left_to_copy - (ETH_TX_BUF_SIZE - buffer_offset);
-            payload_offset = payload_offset + (ETH_TX_BUF_SIZE - buffer_offset);
-            frame_length = frame_length + (ETH_TX_BUF_SIZE - buffer_offset);
-            buffer_offset = 0;
-        }
-        /* Copy the remaining bytes */
-        OS_MemCpy((U8*)((U8*)buffer_p + buffer_offset), (U8*)((U8*)q->payload + payload_offset), bytes_left_to_copy);
-        buffer_offset = buffer_offset + bytes_left_to_copy;
-        frame_length = frame_length + bytes_left_to_copy;
+/******************************************************************************/
+Status ETH_DMA_TxGather(ETH_TxGather* gather_p, const U8* data_p, U32 size)
+{
+    /* Is this buffer available? If not, goto error */
+    if ((U32)RESET != (gather_p->desc_p->Status & ETH_DMATXDESC_OWN)) { return S_BUSY; }
+    /* Check if the length of data to copy is bigger than Tx buffer size*/
+    while ((size + gather_p->buffer_offset) > ETH_TX_BUF_SIZE) {
+        const U32 chunk_size = ETH_TX_BUF_SIZE - gather_p->buffer_offset;
+        /* Copy data to Tx buffer*/
+        OS_MemCpy(gather_p->buffer_p + gather_p->buffer_offset, data_p, chunk_size);
+        /* Point to next descriptor */
+        gather_p->desc_p = (ETH_DMADescTypeDef*)(gather_p->desc_p->Buffer2NextDescAddr);
+        /* Check if the buffer is available */
+        if ((U32)RESET != (gather_p->desc_p->Status & ETH_DMATXDESC_OWN)) { return S_BUSY; }
+        gather_p->buffer_p = (U8*)(gather_p->desc_p->Buffer1Addr);
+        gather_p->buffer_offset = 0;
+        gather_p->frame_length += chunk_size;
+        data_p += chunk_size;
+        size -= chunk_size;
     }
-    /* Prepare transmit descriptors to give to DMA */
-    if (HAL_OK == HAL_ETH_TransmitFrame(&eth0_hd, frame_length)) {
-        s = S_OK;
-    } else {
-        s = S_HARDWARE_ERROR;
+    /* Copy the remaining bytes */
+    OS_MemCpy(gather_p->buffer_p + gather_p->buffer_offset, data_p, size);
+    gather_p->buffer_offset += size;
+    gather_p->frame_length += size;
+    return S_OK;
+}
+
+/******************************************************************************/
+Status ETH_DMA_TxFrame(const ETH_TxGather* gather_p, Status s)
+{
+    IF_OK(s) {
+        /* Prepare transmit descriptors to give to DMA */
+        s = (HAL_OK == HAL_ETH_TransmitFrame(&eth0_hd, gather_p->frame_length)) ? S_OK : S_HARDWARE_ERROR;
     }
-error:
     /* When Transmit Underflow flag is set, clear it and issue a Transmit Poll Demand to resume transmission */
     if ((U32)RESET != (eth0_hd.Instance->DMASR & ETH_DMASR_TUS)) {
         /* Clear TUS ETHERNET DMA flag */
@@ -356,6 +361,32 @@ error:
     return s;
 }
 
+/******************************************************************************/
+Status ETH_DMA_Write(void* data_out_p, Size size, void* args_p)
+{
+ETH_TxGather gather;
+Status s = S_OK;
+    ETH_DMA_TxGatherInit(&gather);
+    /* copy frame from pbufs to driver buffers */
+    for (const OS_NetworkBuf* q = data_out_p; q != NULL; q = q->next) {
+        IF_STATUS(s = ETH_DMA_TxGather(&gather, (const U8*)q->payload, q->len)) { break; }
+    }
+    return ETH_DMA_TxFrame(&gather, s);
+}
+
+/******************************************************************************/
+Status ETH_DMA_WriteV(const HAL_DriverSegment* seg_v, U32 seg_count, void* args_p)
+{
+ETH_TxGather gather;
+Status s = S_OK;
+    ETH_DMA_TxGatherInit(&gather);
+    /* Gather the segments directly to the Tx DMA descriptors buffers */
+    for (U32 i = 0; i < seg_count; ++i) {
+        IF_STATUS(s = ETH_DMA_TxGather(&gather, (const U8*)seg_v[i].data_p, seg_v[i].size)) { break; }
+    }
+    return ETH_DMA_TxFrame(&gather, s);
+}
+
 /******************************************************************************/
 Status ETH_IoCtl(const U32 request_id, void* args_p)
 {
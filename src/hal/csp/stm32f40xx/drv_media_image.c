@@ -0,0 +1,166 @@
+/**************************************************************************//**
+* @file    drv_media_image.c
+* @brief   Image file media driver.
+* @author  A. Filyanov
+******************************************************************************/
+#include <string.h>
+#include "hal.h"
+#include "diskio.h"
+#include "os_common.h"
+#include "os_debug.h"
+#include "os_driver.h"
+#include "os_memory.h"
+#include "os_task.h"
+#include "os_file_system.h"
+
+#if defined(OS_MEDIA_VOL_IMAGE)
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "drv_m_image"
+
+//-----------------------------------------------------------------------------
+static Status IMAGE_Init_(void* args_p);
+static Status IMAGE_DeInit_(void* args_p);
+static Status IMAGE_Open(void* args_p);
+static Status IMAGE_Close(void* args_p);
+static Status IMAGE_Read(void* data_in_p, Size size, void* args_p);
+static Status IMAGE_Write(void* data_out_p, Size size, void* args_p);
+static Status IMAGE_IoCtl(const U32 request_id, void* args_p);
+
+static Status IMAGE_Transfer(void* data_p, const Size size, const U32 sector, const Bool is_write);
+
+//-----------------------------------------------------------------------------
+// The volume is the image file on the other volume (the benchmark runs with the injected latency).
+static OS_FileHd image_fhd;
+static DrvMediaLatency image_latency;
+
+//-----------------------------------------------------------------------------
+HAL_DriverItf drv_media_image = {
+    .Init   = IMAGE_Init_,
+    .DeInit = IMAGE_DeInit_,
+    .Open   = IMAGE_Open,
+    .Close  = IMAGE_Close,
+    .Read   = IMAGE_Read,
+    .Write  = IMAGE_Write,
+    .IoCtl  = IMAGE_IoCtl
+};
+
+/*****************************************************************************/
+Status IMAGE_Init_(void* args_p)
+{
+Status s;
+    HAL_LOG(D_INFO, "Init: ");
+    if (OS_NULL != image_fhd) { return S_OK; }
+    OS_MemSet(&image_latency, 0, sizeof(image_latency));
+    IF_STATUS(s = OS_FileOpen(&image_fhd, OS_MEDIA_VOL_IMAGE_PATH, BIT(OS_FS_FILE_OP_MODE_OPEN_NEW) |
+                                                                   BIT(OS_FS_FILE_OP_MODE_READ) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+        OS_Free(image_fhd);
+        image_fhd = OS_NULL;
+        return s;
+    }
+    // The new image is expanded to the volume size.
+    if (OS_MEDIA_VOL_IMAGE_SIZE > OS_FileSizeGet(image_fhd)) {
+        IF_STATUS(s = OS_FileAllocate(image_fhd, OS_MEDIA_VOL_IMAGE_SIZE, OS_FALSE)) {
+            OS_FileClose(&image_fhd);
+            image_fhd = OS_NULL;
+        }
+    }
+    return s;
+}
+
+/*****************************************************************************/
+Status IMAGE_DeInit_(void* args_p)
+{
+Status s = S_OK;
+    if (OS_NULL != image_fhd) {
+        s = OS_FileClose(&image_fhd);
+        image_fhd = OS_NULL;
+    }
+    return s;
+}
+
+/*****************************************************************************/
+Status IMAGE_Open(void* args_p)
+{
+    return S_OK;
+}
+
+/*****************************************************************************/
+Status IMAGE_Close(void* args_p)
+{
+    return S_OK;
+}
+
+/******************************************************************************/
+Status IMAGE_Read(void* data_in_p, Size size, void* args_p)
+{
+    if (0 != image_latency.read_ms) {
+        OS_TaskDelay(image_latency.read_ms);
+    }
+    return IMAGE_Transfer(data_in_p, size, *(U32*)args_p, OS_FALSE);
+}
+
+/******************************************************************************/
+Status IMAGE_Write(void* data_out_p, Size size, void* args_p)
+{
+    if (0 != image_latency.write_ms) {
+        OS_TaskDelay(image_latency.write_ms);
+    }
+    return IMAGE_Transfer(data_out_p, size, *(U32*)args_p, OS_TRUE);
+}
+
+/******************************************************************************/
+Status IMAGE_Transfer(void* data_p, const Size size, const U32 sector, const Bool is_write)
+{
+const Size len = OS_FILE_SYSTEM_SECTOR_SIZE_MIN * size;
+Status s;
+    if (OS_NULL == image_fhd) { return S_FS_NOT_READY; }
+    if ((sector + size) > (OS_MEDIA_VOL_IMAGE_SIZE / OS_FILE_SYSTEM_SECTOR_SIZE_MIN)) { return S_INVALID_VALUE; }
+    IF_OK(s = OS_FileLSeek(image_fhd, OS_FILE_SYSTEM_SECTOR_SIZE_MIN * sector)) {
+        s = (OS_TRUE == is_write) ? OS_FileWrite(image_fhd, data_p, len) : OS_FileRead(image_fhd, data_p, len);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status IMAGE_IoCtl(const U32 request_id, void* args_p)
+{
+Status s = S_UNDEF;
+    switch (request_id) {
+        case DRV_REQ_STD_POWER_SET:
+        case CTRL_POWER:
+            s = S_OK;
+            break;
+        case DRV_REQ_STD_SYNC:
+        case CTRL_SYNC:
+            s = (OS_NULL != image_fhd) ? OS_FileSync(image_fhd) : S_OK;
+            break;
+        case DRV_REQ_MEDIA_STATUS_GET:
+            s = (OS_NULL != image_fhd) ? S_OK : S_FS_NOT_READY;
+            break;
+        case DRV_REQ_MEDIA_SECTOR_COUNT_GET:
+        case GET_SECTOR_COUNT:
+            *(U32*)args_p = OS_MEDIA_VOL_IMAGE_SIZE / OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+            s = S_OK;
+            break;
+        case DRV_REQ_MEDIA_SECTOR_SIZE_GET:
+        case GET_SECTOR_SIZE:
+        case DRV_REQ_MEDIA_BLOCK_SIZE_GET:
+        case GET_BLOCK_SIZE:
+            *(U16*)args_p = OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+            s = S_OK;
+            break;
+        case CTRL_ERASE_SECTOR:
+            s = S_OK;
+            break;
+        case DRV_REQ_MEDIA_LATENCY_SET:
+            image_latency = *(DrvMediaLatency*)args_p;
+            s = S_OK;
+            break;
+        default:
+            s = S_FS_UNDEF;
+            break;
+    }
+    return s;
+}
+
+#endif //defined(OS_MEDIA_VOL_IMAGE)
@@ -0,0 +1,128 @@
+/**************************************************************************//**
+* @file    drv_media_romfs.c
+* @brief   Flash romfs image media driver.
+* @author  A. Filyanov
+******************************************************************************/
+#include <string.h>
+#include "hal.h"
+#include "diskio.h"
+#include "os_common.h"
+#include "os_debug.h"
+#include "os_driver.h"
+#include "os_memory.h"
+#include "os_file_system.h"
+
+#if defined(OS_MEDIA_VOL_ROMFS)
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "drv_m_romfs"
+
+//-----------------------------------------------------------------------------
+static Status ROMFS_Init_(void* args_p);
+static Status ROMFS_DeInit_(void* args_p);
+static Status ROMFS_Open(void* args_p);
+static Status ROMFS_Close(void* args_p);
+static Status ROMFS_Read(void* data_in_p, Size size, void* args_p);
+static Status ROMFS_Write(void* data_out_p, Size size, void* args_p);
+static Status ROMFS_IoCtl(const U32 request_id, void* args_p);
+
+//-----------------------------------------------------------------------------
+#if defined(OS_MEDIA_VOL_ROMFS_ADDRESS)
+// The image is programmed to the flash region.
+static const U8* romfs_image_p  = (const U8*)OS_MEDIA_VOL_ROMFS_ADDRESS;
+static const U32 romfs_size     = OS_MEDIA_VOL_ROMFS_SIZE;
+#else
+// The image is linked (mkromfs.py -c romfs_image.c).
+extern const U8 romfs_image[];
+extern const U32 romfs_image_size;
+static const U8* romfs_image_p  = romfs_image;
+#define romfs_size              romfs_image_size
+#endif //defined(OS_MEDIA_VOL_ROMFS_ADDRESS)
+
+//-----------------------------------------------------------------------------
+HAL_DriverItf drv_media_romfs = {
+    .Init   = ROMFS_Init_,
+    .DeInit = ROMFS_DeInit_,
+    .Open   = ROMFS_Open,
+    .Close  = ROMFS_Close,
+    .Read   = ROMFS_Read,
+    .Write  = ROMFS_Write,
+    .IoCtl  = ROMFS_IoCtl
+};
+
+/*****************************************************************************/
+Status ROMFS_Init_(void* args_p)
+{
+    HAL_LOG(D_INFO, "Init: ");
+    return S_OK;
+}
+
+/*****************************************************************************/
+Status ROMFS_DeInit_(void* args_p)
+{
+    return S_OK;
+}
+
+/*****************************************************************************/
+Status ROMFS_Open(void* args_p)
+{
+    return S_OK;
+}
+
+/*****************************************************************************/
+Status ROMFS_Close(void* args_p)
+{
+    return S_OK;
+}
+
+/******************************************************************************/
+Status ROMFS_Read(void* data_in_p, Size size, void* args_p)
+{
+const U32 sector = *(U32*)args_p;
+    if ((sector + size) > (romfs_size / OS_FILE_SYSTEM_SECTOR_SIZE_MIN)) { return S_INVALID_VALUE; }
+    OS_MemCpy(data_in_p, (const void*)(romfs_image_p + (OS_FILE_SYSTEM_SECTOR_SIZE_MIN * sector)),
+              (OS_FILE_SYSTEM_SECTOR_SIZE_MIN * size));
+    return S_OK;
+}
+
+/******************************************************************************/
+Status ROMFS_Write(void* data_out_p, Size size, void* args_p)
+{
+    return S_FS_WRITE_PROTECTED;
+}
+
+/******************************************************************************/
+Status ROMFS_IoCtl(const U32 request_id, void* args_p)
+{
+Status s = S_UNDEF;
+    switch (request_id) {
+        case DRV_REQ_STD_POWER_SET:
+        case CTRL_POWER:
+        case DRV_REQ_STD_SYNC:
+        case CTRL_SYNC:
+        case DRV_REQ_MEDIA_STATUS_GET:
+            s = S_OK;
+            break;
+        case DRV_REQ_MEDIA_SECTOR_COUNT_GET:
+        case GET_SECTOR_COUNT:
+            *(U32*)args_p = romfs_size / OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+            s = S_OK;
+            break;
+        case DRV_REQ_MEDIA_SECTOR_SIZE_GET:
+        case GET_SECTOR_SIZE:
+        case DRV_REQ_MEDIA_BLOCK_SIZE_GET:
+        case GET_BLOCK_SIZE:
+            *(U16*)args_p = OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+            s = S_OK;
+            break;
+        case DRV_REQ_MEDIA_ADDRESS_GET:
+            *(const void**)args_p = (const void*)romfs_image_p;
+            s = S_OK;
+            break;
+        default:
+            s = S_FS_UNDEF;
+            break;
+    }
+    return s;
+}
+
+#endif //defined(OS_MEDIA_VOL_ROMFS)
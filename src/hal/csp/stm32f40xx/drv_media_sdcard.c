@@ -58,6 +58,9 @@ static SD_HandleTypeDef sd_hd;
 static DMA_HandleTypeDef sd_dma_rx_handle;
 static DMA_HandleTypeDef sd_dma_tx_handle;
 static OS_DriverHd drv_led_fs;
+#if (OS_FILE_SYSTEM_WORD_ACCESS)
+static U32 sd_dma_bounces;
+#endif //(OS_FILE_SYSTEM_WORD_ACCESS)
 
 //-----------------------------------------------------------------------------
 HAL_DriverItf drv_media_sdcard = {
@@ -304,17 +307,22 @@ Status s = S_OK;
 //    OS_DriverWrite(drv_led_fs, &state, 1, OS_NULL);
 
 #if (OS_FILE_SYSTEM_WORD_ACCESS)
-    if ((U32)data_in_p & 0x03) { // DMA Alignment failure, do single up to aligned buffer
-        U32* scratch_p = (U32*)OS_Malloc(SD_CARD_BLOCK_SIZE); // Alignment assured
+    if ((U32)data_in_p & (OS_FILE_SYSTEM_DMA_ALIGN - 1)) { // DMA burst alignment failure - read by the aligned buffer.
+        const Size scratch_sectors = MIN(size, OS_FILE_SYSTEM_DMA_BOUNCE_SECTORS);
+        U8* scratch_p = (U8*)OS_MallocAlignedEx(scratch_sectors * HAL_SD_CARD_BLOCK_SIZE, OS_FILE_SYSTEM_DMA_ALIGN,
+                                                OS_FILE_SYSTEM_DMA_MEM);
+        U8* data_in_8p = (U8*)data_in_p;
         if (OS_NULL == scratch_p) { return S_OUT_OF_MEMORY; }
-        while (size--) {
-            U8* data_in_8p = (U8*)data_in_p;
-            IF_STATUS(s = drv_media_sdcard.Read((U8*)scratch_p, 1, &sector)) { break; }
-            OS_MemCpy(data_in_p, scratch_p, SD_CARD_BLOCK_SIZE);
-            data_in_8p += SD_CARD_BLOCK_SIZE;
-            ++sector;
+        ++sd_dma_bounces;
+        while (size) {
+            const Size count = MIN(size, scratch_sectors);
+            IF_STATUS(s = drv_media_sdcard.Read(scratch_p, count, &sector)) { break; }
+            OS_MemCpy(data_in_8p, scratch_p, count * HAL_SD_CARD_BLOCK_SIZE);
+            data_in_8p += count * HAL_SD_CARD_BLOCK_SIZE;
+            sector += count;
+            size -= count;
         }
-        OS_Free(scratch_p);
+        OS_FreeAligned(scratch_p);
         return s;
     }
 #endif // (OS_FILE_SYSTEM_WORD_ACCESS)
@@ -345,17 +353,22 @@ Status s = S_OK;
 //    OS_DriverWrite(drv_led_fs, &state, 1, OS_NULL);
 
 #if (OS_FILE_SYSTEM_WORD_ACCESS)
-    if ((U32)data_out_p & 0x03) { // DMA Alignment failure, do single up to aligned buffer
-        U32* scratch_p = (U32*)OS_Malloc(SD_CARD_BLOCK_SIZE); // Alignment assured
+    if ((U32)data_out_p & (OS_FILE_SYSTEM_DMA_ALIGN - 1)) { // DMA burst alignment failure - write by the aligned buffer.
+        const Size scratch_sectors = MIN(size, OS_FILE_SYSTEM_DMA_BOUNCE_SECTORS);
+        U8* scratch_p = (U8*)OS_MallocAlignedEx(scratch_sectors * HAL_SD_CARD_BLOCK_SIZE, OS_FILE_SYSTEM_DMA_ALIGN,
+                                                OS_FILE_SYSTEM_DMA_MEM);
+        const U8* data_out_8p = (const U8*)data_out_p;
         if (OS_NULL == scratch_p) { return S_OUT_OF_MEMORY; }
-        while (size--) {
-            U8* data_out_8p = (U8*)data_out_p;
-            OS_MemCpy(data_out_p, scratch_p, SD_CARD_BLOCK_SIZE);
-            IF_STATUS(s = drv_media_sdcard.Write((U8*)scratch_p, 1, &sector)) { break; }
-            data_out_8p += SD_CARD_BLOCK_SIZE;
-            ++sector;
+        ++sd_dma_bounces;
+        while (size) {
+            const Size count = MIN(size, scratch_sectors);
+            OS_MemCpy(scratch_p, data_out_8p, count * HAL_SD_CARD_BLOCK_SIZE);
+            IF_STATUS(s = drv_media_sdcard.Write(scratch_p, count, &sector)) { break; }
+            data_out_8p += count * HAL_SD_CARD_BLOCK_SIZE;
+            sector += count;
+            size -= count;
         }
-        OS_Free(scratch_p);
+        OS_FreeAligned(scratch_p);
         return s;
     }
 #endif //(OS_FILE_SYSTEM_WORD_ACCESS)
@@ -465,14 +478,31 @@ Status s = S_UNDEF;
             *(U16*)args_p = HAL_SD_CARD_BLOCK_SIZE;
             s = S_OK;
             break;
+        case DRV_REQ_MEDIA_DMA_BOUNCES_GET:
+#if (OS_FILE_SYSTEM_WORD_ACCESS)
+            *(U32*)args_p = sd_dma_bounces;
+#else
+            *(U32*)args_p = 0; // The byte DMA access - no bounces.
+#endif //(OS_FILE_SYSTEM_WORD_ACCESS)
+            s = S_OK;
+            break;
         case CTRL_ERASE_SECTOR: {
-            //TODO(A. Filyanov) Check SDHC capability!
-            U32 start_sector= ((U32*)args_p)[0] * HAL_SD_CARD_SECTOR_SIZE;
-            U32 end_sector  = ((U32*)args_p)[1] * HAL_SD_CARD_SECTOR_SIZE;
-            if (SD_OK != HAL_SD_Erase(&sd_hd, start_sector, end_sector)) {
-                s = S_FS_UNDEF;
-            } else {
-                s = S_OK;
+            // Byte addresses of the first and the last sectors (HAL converts them to the blocks for SDHC).
+            const U64 start_addr= (U64)((U32*)args_p)[0] * HAL_SD_CARD_SECTOR_SIZE;
+            const U64 end_addr  = (U64)((U32*)args_p)[1] * HAL_SD_CARD_SECTOR_SIZE;
+            const U32 tick_start = HAL_GetTick();
+            // The card should be out of the DMA transfer.
+            s = S_OK;
+            while (SD_TRANSFER_OK != HAL_SD_GetStatus(&sd_hd)) {
+                if ((HAL_GetTick() - tick_start) > HAL_TIMEOUT_DRIVER) {
+                    s = S_FS_TIMEOUT;
+                    break;
+                }
+            }
+            IF_OK(s) {
+                if (SD_OK != HAL_SD_Erase(&sd_hd, start_addr, end_addr)) {
+                    s = S_FS_UNDEF;
+                }
             }
             }
             break;
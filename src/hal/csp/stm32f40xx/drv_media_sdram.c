@@ -210,12 +210,17 @@ Status s = S_UNDEF;
             *(U16*)args_p = OS_MEDIA_VOL_SDRAM_BLOCK_SIZE;
             s = S_OK;
             break;
+        case DRV_REQ_MEDIA_ADDRESS_GET:
+            *(void**)args_p = sdram_fs_p;
+            s = S_OK;
+            break;
         case CTRL_ERASE_SECTOR: {
-            U32 start_sector= ((U32*)args_p)[0] * OS_MEDIA_VOL_SDRAM_BLOCK_SIZE;
-            U32 end_sector  = ((U32*)args_p)[1] * OS_MEDIA_VOL_SDRAM_BLOCK_SIZE;
+            // The first and the last sectors.
+            U32 start_sector= ((U32*)args_p)[0];
+            U32 end_sector  = ((U32*)args_p)[1];
             OS_MemSet((void*)((U8*)sdram_fs_p + (OS_MEDIA_VOL_SDRAM_BLOCK_SIZE * start_sector)),
                       0,
-                      (OS_MEDIA_VOL_SDRAM_BLOCK_SIZE * (end_sector - start_sector)));
+                      (OS_MEDIA_VOL_SDRAM_BLOCK_SIZE * (end_sector - start_sector + 1)));
             }
             s = S_OK;
             break;
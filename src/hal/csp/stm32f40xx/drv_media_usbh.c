@@ -297,7 +297,8 @@ Status s = S_UNDEF;
             }
             break;
         case CTRL_ERASE_SECTOR:
-            s = S_OK;
+            // The MSC class has no UNMAP command.
+            s = S_FS_NOT_ENABLED;
             break;
         default:
             s = S_FS_UNDEF;
@@ -525,7 +526,8 @@ Status s = S_UNDEF;
             }
             break;
         case CTRL_ERASE_SECTOR:
-            s = S_OK;
+            // The MSC class has no UNMAP command.
+            s = S_FS_NOT_ENABLED;
             break;
         default:
             s = S_FS_UNDEF;
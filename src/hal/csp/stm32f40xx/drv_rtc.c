@@ -301,9 +301,11 @@ Status RTC_Read(void* data_in_p, Size size, void* args_p)
 {
 Status s = S_OK;
     __IO U8* sram_bkup_p = (__IO U8*)BKPSRAM_BASE;
+    U8* data_in_8p = (U8*)data_in_p;
+    // The rest of the backup SRAM belongs to the OS.
+    if (HAL_MEM_BKP_SRAM_RTC_SIZE < size) { return S_INVALID_SIZE; }
     /* Read the SRAM Backup Data */
     while (size--) {
-        U8* data_in_8p = (U8*)data_in_p;
         *data_in_8p++ = *sram_bkup_p++;
     }
     return s;
@@ -315,6 +317,9 @@ Status RTC_Write(void* data_out_p, Size size, void* args_p)
 {
 Status s = S_OK;
     __IO U8* sram_bkup_p = (__IO U8*)BKPSRAM_BASE;
+    U8* data_out_8p = (U8*)data_out_p;
+    // The rest of the backup SRAM belongs to the OS.
+    if (HAL_MEM_BKP_SRAM_RTC_SIZE < size) { return S_INVALID_SIZE; }
     {
         U8* data_out_tmp_p  = data_out_p;
         U32 size_tmp        = size;
@@ -326,7 +331,6 @@ Status s = S_OK;
     sram_bkup_p = (__IO U8*)BKPSRAM_BASE;
     /* Check the written Data */
     while (size--) {
-        U8* data_out_8p = (U8*)data_out_p;
         if (*sram_bkup_p++ != *data_out_8p++) { s = S_HARDWARE_ERROR; }
     }
     return s;
@@ -43,6 +43,9 @@ Status s = S_OK;
   */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
+    if (HAL_USART_DEBUG_ITF == huart->Instance) {
+        USART6_DMA_TxComplete(S_OK);
+    }
 }
 
 /******************************************************************************/
@@ -60,5 +63,8 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 /******************************************************************************/
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
+    if ((HAL_USART_DEBUG_ITF == huart->Instance) && (HAL_UART_ERROR_DMA & huart->ErrorCode)) {
+        USART6_DMA_TxComplete(S_HARDWARE_ERROR);
+    }
     HAL_ASSERT(OS_FALSE);
 }
@@ -26,5 +26,6 @@ enum {
 extern HAL_DriverItf* drv_usart_v[];
 
 Status   USART6_DMA_Write(void* data_out_p, Size size, void* args_p);
+void     USART6_DMA_TxComplete(const Status s);
 
 #endif // _DRV_USART_H_
\ No newline at end of file
@@ -27,12 +27,15 @@ static Status   USART6_Write(void* data_out_p, Size size, void* args_p);
 //static Status   USART6_IT_Write(void* data_out_p, Size size, void* args_p);
 static Status   USART6_DMA_Read(void* data_in_p, Size size, void* args_p);
 //static Status   USART6_DMA_Write(void* data_out_p, Size size, void* args_p);
+static Status   USART6_DMA_SubmitWrite(HAL_DriverRequest* req_p);
 static Status   USART6_IoCtl(const U32 request_id, void* args_p);
+static Status   USART6_TxWait(const Bool is_idle);
 
 //------------------------------------------------------------------------------
 static UART_HandleTypeDef   uart_hd;
 static DMA_HandleTypeDef    dma_tx_hd;
 static DMA_HandleTypeDef    dma_rx_hd;
+static HAL_DriverRequest* volatile tx_req_p;
 
 /*static is excluded for stdio*/ HAL_DriverItf drv_usart6 = {
     .Init   = USART6_Init,
@@ -41,7 +44,8 @@ static DMA_HandleTypeDef    dma_rx_hd;
     .Close  = USART6_Close,
     .Read   = USART6_Read,
     .Write  = USART6_Write,
-    .IoCtl  = USART6_IoCtl
+    .IoCtl  = USART6_IoCtl,
+    .SubmitWrite = USART6_DMA_SubmitWrite
 };
 
 /******************************************************************************/
@@ -217,6 +221,8 @@ Status s = S_OK;
 Status USART6_Write(void* data_out_p, Size size, void* args_p)
 {
 Status s = S_OK;
+    // Wait for the submitted transfer.
+    IF_STATUS(s = USART6_TxWait(OS_FALSE)) { return s; }
     if (HAL_OK != HAL_UART_Transmit(&uart_hd, data_out_p, size, HAL_TIMEOUT_DRIVER)) { s = S_HARDWARE_ERROR; }
     return s;
 }
@@ -251,13 +257,66 @@ Status s = S_OK;
     return s;
 }
 
+/******************************************************************************/
+Status USART6_DMA_SubmitWrite(HAL_DriverRequest* req_p)
+{
+Status s = S_OK;
+    if (OS_NULL != tx_req_p) { return S_BUSY; }
+    tx_req_p = req_p;
+    if (HAL_OK != HAL_UART_Transmit_DMA(&uart_hd, req_p->data_p, req_p->size)) {
+        tx_req_p = OS_NULL;
+        s = S_HARDWARE_ERROR;
+    }
+    return s;
+}
+
+/******************************************************************************/
+void USART6_DMA_TxComplete(const Status s)
+{
+HAL_DriverRequest* req_p = tx_req_p;
+    if (OS_NULL == req_p) { return; }
+    tx_req_p = OS_NULL;
+    req_p->status = s;
+    req_p->Complete(req_p, OS_TRUE);
+}
+
+/******************************************************************************/
+// Wait for the submitted transfer end (and the UART idle state).
+Status USART6_TxWait(const Bool is_idle)
+{
+const U32 tick_start = HAL_GetTick();
+    while ((OS_NULL != tx_req_p) ||
+           ((OS_TRUE == is_idle) && (HAL_UART_STATE_READY != HAL_UART_GetState(&uart_hd)))) {
+        if ((HAL_GetTick() - tick_start) > HAL_TIMEOUT_DRIVER) { return S_TIMEOUT; }
+    }
+    return S_OK;
+}
+
 /******************************************************************************/
 Status USART6_IoCtl(const U32 request_id, void* args_p)
 {
 Status s = S_UNDEF;
     switch (request_id) {
         case DRV_REQ_STD_SYNC:
-            while (HAL_UART_STATE_READY != HAL_UART_GetState(&uart_hd)) {};
+            s = USART6_TxWait(OS_TRUE);
+            break;
+        case DRV_REQ_STD_ABORT: {
+            Bool is_aborted = OS_FALSE;
+            // The DMA completion could race the abort.
+            OS_CriticalSectionEnter();
+            if ((OS_NULL != tx_req_p) && (args_p == tx_req_p)) {
+                tx_req_p = OS_NULL;
+                is_aborted = OS_TRUE;
+            }
+            OS_CriticalSectionExit();
+            if (OS_TRUE == is_aborted) {
+                // The buffer is the caller's one - the DMA is stopped before return.
+                HAL_UART_DMAStop(&uart_hd);
+                s = S_OK;
+            } else {
+                s = S_INVALID_VALUE;
+            }
+            }
             break;
         case DRV_REQ_STD_POWER_SET:
             switch (*(OS_PowerState*)args_p) {
@@ -270,8 +329,7 @@ Status s = S_UNDEF;
                 case PWR_STANDBY:
                 case PWR_HIBERNATE:
                 case PWR_SHUTDOWN:
-                    while (HAL_UART_STATE_READY != HAL_UART_GetState(&uart_hd)) {};
-                    s = S_OK;
+                    s = USART6_TxWait(OS_TRUE);
                     break;
                 default:
                     break;
@@ -296,7 +354,10 @@ Status s = S_UNDEF;
 void HAL_USART_DEBUG_IRQ_HANDLER(void);
 void HAL_USART_DEBUG_IRQ_HANDLER(void)
 {
+    // TC interrupt is used by the DMA transmission - only RXNE is the stdin input.
+    const Bool is_rx = (RESET != __HAL_UART_GET_FLAG(&uart_hd, UART_FLAG_RXNE)) ? OS_TRUE : OS_FALSE;
     HAL_UART_IRQHandler(&uart_hd);
+    if (OS_TRUE != is_rx) { return; }
 
     extern OS_QueueHd stdin_qhd;
     const OS_SignalData sig_data = (U16)(HAL_USART_DEBUG_ITF->DR & (U16)0x01FF);
@@ -13,9 +13,17 @@ enum {
     DRV_REQ_MEDIA_SECTOR_COUNT_GET,
     DRV_REQ_MEDIA_SECTOR_SIZE_GET,
     DRV_REQ_MEDIA_BLOCK_SIZE_GET,
+    DRV_REQ_MEDIA_ADDRESS_GET,          // Memory mapped media base address (void*).
+    DRV_REQ_MEDIA_DMA_BOUNCES_GET,      // Transfers through the driver bounce buffer (U32).
+    DRV_REQ_MEDIA_LATENCY_SET,          // Injected per-command latency (DrvMediaLatency).
     DRV_REQ_MEDIA_LAST
 };
 
+typedef struct {
+    U32  read_ms;
+    U32  write_ms;
+} DrvMediaLatency;
+
 //-----------------------------------------------------------------------------
 extern HAL_DriverItf* drv_media_v[];
 
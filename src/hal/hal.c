@@ -11,17 +11,34 @@
 //-----------------------------------------------------------------------------
 #define MDL_NAME    "hal"
 
+#define HAL_BOOT_TIMELINE_MAGIC     0xB0071AE5
+
+//-----------------------------------------------------------------------------
+typedef struct {
+    U8                      count;
+    HAL_BootCheckpointItem  items_v[HAL_BOOT_CHECKPOINTS_MAX];
+} HAL_BootTimeline;
+
+typedef struct {
+    U32                     magic;
+    U32                     boot_count;
+    HAL_BootTimeline        timelines_v[HAL_BOOT_LAST];
+} HAL_BootRetained;
+
 //-----------------------------------------------------------------------------
 volatile HAL_Env hal_env;
 int cycles_diff, cycles_last;
 U32 SystemCoreClockKHz;             ///< Core frequency (KHz).
 U32 SystemCoreClockMHz;             ///< Core frequency (MHz).
 static DeviceState device_state;    ///< Device state.
+static U32 build_id;                ///< Firmware build identity.
+__no_init static HAL_BootRetained hal_boot; ///< Boot timelines (survive the soft reset).
 
 //-----------------------------------------------------------------------------
 /// @brief      Init the device description.
 /// @return     #Status.
 static Status   HAL_DeviceDescriptionInit(void);
+static void     HAL_BootTimelineInit(void);
 static void     SystemClock_Config(void);
 
 /*****************************************************************************/
@@ -38,11 +55,14 @@ Status s = S_OK;
         SystemCoreClockKHz  = SystemCoreClock / KHZ;
         SystemCoreClockMHz  = SystemCoreClockKHz / KHZ;
         TIMER_DWT_Init(); // HAL_LOG depends on this init.
+        HAL_BootTimelineInit();
+        HAL_BOOT_CHECKPOINT("hal_clk");
         // HAL environment init
         hal_env.locale      = LOC_EN;
         hal_env.power       = PWR_ON;
         hal_env.log_level   = HAL_LOG_LEVEL;
         IF_STATUS(s = USART_Init_()) { return s; }
+        HAL_BOOT_CHECKPOINT("hal_stdio");
         hal_env.stdio_p = drv_stdio_p;
         HAL_ASSERT(S_OK == hal_env.stdio_p->Init(OS_NULL));
         HAL_ASSERT(S_OK == hal_env.stdio_p->Open(OS_NULL));
@@ -63,6 +83,7 @@ Status s = S_OK;
         HAL_LOG(D_INFO, "-------------------------------");
         //TODO(A. Filyanov) HAL_CSP_Init(); HAL_MSP_Init()?; HAL_BSP_Init();
         IF_STATUS(s = HAL_BSP_Init()) { return s; }
+        HAL_BOOT_CHECKPOINT("hal_bsp");
         // Enable interrupts.
         HAL_LOG(D_INFO, "-------------------------------");
         // Close and deinit STDIO stream(for init HAL output).
@@ -73,15 +94,91 @@ Status s = S_OK;
     return s;
 }
 
+/*****************************************************************************/
+void HAL_BootTimelineInit(void)
+{
+    if (HAL_BOOT_TIMELINE_MAGIC == hal_boot.magic) {
+        HAL_MemCpy(&hal_boot.timelines_v[HAL_BOOT_PREVIOUS], &hal_boot.timelines_v[HAL_BOOT_CURRENT],
+                   sizeof(hal_boot.timelines_v[HAL_BOOT_PREVIOUS]));
+        if (HAL_BOOT_CHECKPOINTS_MAX < hal_boot.timelines_v[HAL_BOOT_PREVIOUS].count) {
+            hal_boot.timelines_v[HAL_BOOT_PREVIOUS].count = 0;
+        }
+        ++hal_boot.boot_count;
+    } else {
+        // Power on - retained RAM content is undefined.
+        hal_boot.timelines_v[HAL_BOOT_PREVIOUS].count = 0;
+        hal_boot.boot_count = 1;
+        hal_boot.magic = HAL_BOOT_TIMELINE_MAGIC;
+    }
+    hal_boot.timelines_v[HAL_BOOT_CURRENT].count = 0;
+}
+
+/*****************************************************************************/
+void HAL_BootCheckpoint(ConstStrP name_p)
+{
+const U32 cycles = HAL_CORE_CYCLES;
+const U32 primask = __get_PRIMASK();
+HAL_BootTimeline* timeline_p = &hal_boot.timelines_v[HAL_BOOT_CURRENT];
+    __disable_irq();
+    if (HAL_BOOT_CHECKPOINTS_MAX > timeline_p->count) {
+        HAL_BootCheckpointItem* item_p = &timeline_p->items_v[timeline_p->count++];
+        HAL_StrNCpy(item_p->name, name_p, sizeof(item_p->name) - 1);
+        item_p->name[sizeof(item_p->name) - 1] = '\0';
+        item_p->cycles = cycles;
+    }
+    __set_PRIMASK(primask);
+}
+
+/*****************************************************************************/
+U8 HAL_BootCheckpointsCountGet(const HAL_Boot boot)
+{
+    if (HAL_BOOT_LAST <= boot) { return 0; }
+    return hal_boot.timelines_v[boot].count;
+}
+
+/*****************************************************************************/
+Status HAL_BootCheckpointGet(const HAL_Boot boot, const U8 idx, HAL_BootCheckpointItem* item_p)
+{
+    if (OS_NULL == item_p) { return S_INVALID_PTR; }
+    if (HAL_BOOT_LAST <= boot) { return S_INVALID_ARG; }
+    if (hal_boot.timelines_v[boot].count <= idx) { return S_OUT_OF_RANGE; }
+    HAL_MemCpy(item_p, &hal_boot.timelines_v[boot].items_v[idx], sizeof(*item_p));
+    return S_OK;
+}
+
+/*****************************************************************************/
+U32 HAL_BootCountGet(void)
+{
+    return hal_boot.boot_count;
+}
+
 /*****************************************************************************/
 Status HAL_DeviceDescriptionInit(void)
 {
     HAL_MemSet((void*)&device_state, 0x0, sizeof(device_state));
     // Static info description.
     device_state.description.device_description.version = version;
+    {
+        // The version and the build time (FNV-1a).
+        static const char build_time[] = __DATE__ " " __TIME__;
+        const U8* ver_p = (const U8*)&version;
+        build_id = 2166136261U;
+        for (Size i = 0; i < sizeof(version); ++i) {
+            build_id = (build_id ^ ver_p[i]) * 16777619U;
+        }
+        for (Size i = 0; '\0' != build_time[i]; ++i) {
+            build_id = (build_id ^ (U8)build_time[i]) * 16777619U;
+        }
+    }
     return S_OK;
 }
 
+/*****************************************************************************/
+U32 HAL_BuildIdGet(void)
+{
+    return build_id;
+}
+
 /*****************************************************************************/
 Status HAL_DeviceDescriptionGet(DeviceDesc* dev_desc_p, const U16 size)
 {
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+* @file    os_profile.c
+* @brief   OS Profile.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "common.h"
+#include "os_profile.h"
+
+#if (OS_PROFILE_ENABLED)
+#if defined(__ICCARM__)
+#include "hal.h"
+//------------------------------------------------------------------------------
+extern U32 SystemCoreClockMHz;
+
+//------------------------------------------------------------------------------
+// Zones are updated from the tasks and ISRs - mask interrupts instead of OS locks.
+#define OS_PROF_LOCK_DECLARE            U32 os_prof_primask
+#define OS_PROF_LOCK()                  do { os_prof_primask = __get_PRIMASK(); __disable_irq(); } while (0)
+#define OS_PROF_UNLOCK()                __set_PRIMASK(os_prof_primask)
+#define OS_PROF_CLZ(v)                  __CLZ(v)
+#else
+#include <time.h>
+//------------------------------------------------------------------------------
+// Host build is single threaded.
+#define OS_PROF_LOCK_DECLARE
+#define OS_PROF_LOCK()                  do {} while (0)
+#define OS_PROF_UNLOCK()                do {} while (0)
+#define OS_PROF_CLZ(v)                  ((0 == (v)) ? 32 : __builtin_clz(v))
+#endif // __ICCARM__
+
+//------------------------------------------------------------------------------
+static OS_ProfileZone* zones_list_p;
+
+/******************************************************************************/
+static U8 OS_ProfileBinGet(const OS_ProfileCycles cycles);
+INLINE U8 OS_ProfileBinGet(const OS_ProfileCycles cycles)
+{
+    return (1 >= cycles) ? 0 : (U8)(31 - OS_PROF_CLZ(cycles));
+}
+
+/******************************************************************************/
+void OS_ProfileZoneAdd(OS_ProfileZone* zone_p, const OS_ProfileCycles cycles)
+{
+OS_PROF_LOCK_DECLARE;
+    OS_PROF_LOCK();
+    if (OS_TRUE != zone_p->is_linked) {
+        zone_p->next_p      = zones_list_p;
+        zone_p->is_linked   = OS_TRUE;
+        zones_list_p        = zone_p;
+    }
+    if ((0 == zone_p->count) || (cycles < zone_p->min)) {
+        zone_p->min = cycles;
+    }
+    if (cycles > zone_p->max) {
+        zone_p->max = cycles;
+    }
+    zone_p->sum += cycles;
+    ++(zone_p->count);
+    ++(zone_p->hist_v[OS_ProfileBinGet(cycles)]);
+    OS_PROF_UNLOCK();
+}
+
+/******************************************************************************/
+Status OS_ProfileZoneStatsGet(const OS_ProfileZoneHd zhd, OS_ProfileZoneStats* stats_p)
+{
+OS_ProfileZone zone;
+OS_PROF_LOCK_DECLARE;
+    if ((OS_NULL == zhd) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    OS_PROF_LOCK();
+    zone = *zhd;
+    OS_PROF_UNLOCK();
+    stats_p->name_p = zone.name_p;
+    stats_p->count  = zone.count;
+    stats_p->min    = zone.min;
+    stats_p->max    = zone.max;
+    stats_p->mean   = 0;
+    stats_p->p99    = 0;
+    if (zone.count) {
+        const U32 rank = zone.count - (zone.count / 100);
+        U32 cumulative = 0;
+        stats_p->mean = (OS_ProfileCycles)(zone.sum / zone.count);
+        for (U8 i = 0; i < OS_PROFILE_HIST_BINS; ++i) {
+            cumulative += zone.hist_v[i];
+            if (cumulative >= rank) {
+                const OS_ProfileCycles bin_max = (OS_PROFILE_HIST_BINS - 1 == i) ? U32_MAX : ((1UL << (i + 1)) - 1);
+                stats_p->p99 = MIN(bin_max, zone.max);
+                break;
+            }
+        }
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+OS_ProfileZoneHd OS_ProfileZoneNextGet(const OS_ProfileZoneHd zhd)
+{
+    return (OS_NULL == zhd) ? zones_list_p : zhd->next_p;
+}
+
+/******************************************************************************/
+void OS_ProfileReset(void)
+{
+OS_PROF_LOCK_DECLARE;
+    OS_PROF_LOCK();
+    for (OS_ProfileZone* zone_p = zones_list_p; OS_NULL != zone_p; zone_p = zone_p->next_p) {
+        zone_p->count   = 0;
+        zone_p->min     = 0;
+        zone_p->max     = 0;
+        zone_p->sum     = 0;
+        for (U8 i = 0; i < OS_PROFILE_HIST_BINS; ++i) {
+            zone_p->hist_v[i] = 0;
+        }
+    }
+    OS_PROF_UNLOCK();
+}
+
+/******************************************************************************/
+U32 OS_ProfileCyclesToUs(const OS_ProfileCycles cycles)
+{
+#if defined(__ICCARM__)
+    return (cycles / SystemCoreClockMHz);
+#else
+    return (cycles / 1000UL);
+#endif // __ICCARM__
+}
+
+#if !defined(__ICCARM__)
+/******************************************************************************/
+OS_ProfileCycles OS_ProfileHostCyclesGet(void)
+{
+struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (OS_ProfileCycles)((U64)ts.tv_sec * 1000000000ULL + (U64)ts.tv_nsec);
+}
+#endif // __ICCARM__
+
+#endif // (OS_PROFILE_ENABLED)
@@ -53,6 +53,7 @@ const U8 shell_prompt_len = OS_StrLen((char const*)shell_prompt_p);
 const OS_DriverHd drv_log = OS_DriverStdOutGet();
 OS_Message* msg_p;
 Bool is_prompted = OS_FALSE;
+Bool is_boot_done = OS_FALSE;
 //    OS_TaskPrioritySet(OS_THIS_TASK, OS_TASK_PRIO_LOW);
     //Init stdout_qhd before all other tasks and return to the base priority.
     stdout_qhd = OS_TaskStdInGet(OS_THIS_TASK);
@@ -84,6 +85,10 @@ Bool is_prompted = OS_FALSE;
             //If there are no more messages in the input queue - print a shell prompt.
             if (0 == OS_QueueItemsCountGet(stdout_qhd) && (OS_TRUE != is_prompted)) {
                 OS_DriverWrite(drv_log, (void*)shell_prompt_p, shell_prompt_len, OS_NULL);
+                if (OS_TRUE != is_boot_done) {
+                    HAL_BOOT_CHECKPOINT("os_prompt");
+                    is_boot_done = OS_TRUE;
+                }
                 is_prompted = OS_TRUE;
             }
         }
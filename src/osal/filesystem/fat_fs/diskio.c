@@ -11,8 +11,20 @@
 #include "diskio.h"		/* FatFs lower layer API */
 #include "drv_media.h"
 #include "os_file_system.h"
+#include "os_profile.h"
+#include "os_blk_sched.h"
+#include "os_sec_cache.h"
 
 extern OS_DriverHd fs_media_dhd_v[];
+#if (OS_BLK_SCHED_ENABLED)
+extern OS_BlkSchedHd fs_blk_sched_hd_v[];
+#endif //(OS_BLK_SCHED_ENABLED)
+#if (OS_SEC_CACHE_ENABLED)
+extern OS_SecCacheHd fs_sec_cache_hd_v[];
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+extern U32 fs_write_gen_v[];
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
@@ -56,11 +68,19 @@ DRESULT disk_read (
 )
 {
 DRESULT res;
+    OS_PROF_ZONE_BEGIN(disk_read);
+#if (OS_SEC_CACHE_ENABLED)
+    IF_OK(OS_SecCacheRead(fs_sec_cache_hd_v[pdrv], buff, sector, count)) {
+#elif (OS_BLK_SCHED_ENABLED)
+    IF_OK(OS_BlkSchedRead(fs_blk_sched_hd_v[pdrv], buff, sector, count)) {
+#else
     IF_OK(OS_DriverRead(fs_media_dhd_v[pdrv], buff, count, &sector)) {
+#endif //(OS_SEC_CACHE_ENABLED)
         res = RES_OK;
     } else {
         res = RES_ERROR;
     }
+    OS_PROF_ZONE_END(disk_read);
     return res;
 }
 
@@ -79,11 +99,27 @@ DRESULT disk_write (
 )
 {
 DRESULT res;
+    OS_PROF_ZONE_BEGIN(disk_write);
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    // Free clusters validation checks it.
+    fs_write_gen_v[pdrv]++;
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+#if (_USE_ERASE)
+    // The queued erase shouldn't hit the reused sectors.
+    OS_FileSystemEraseClip(pdrv, sector, count);
+#endif //(_USE_ERASE)
+#if (OS_SEC_CACHE_ENABLED)
+    IF_OK(OS_SecCacheWrite(fs_sec_cache_hd_v[pdrv], (void*)buff, sector, count)) {
+#elif (OS_BLK_SCHED_ENABLED)
+    IF_OK(OS_BlkSchedWrite(fs_blk_sched_hd_v[pdrv], (void*)buff, sector, count)) {
+#else
     IF_OK(OS_DriverWrite(fs_media_dhd_v[pdrv], (void*)buff, count, &sector)) {
+#endif //(OS_SEC_CACHE_ENABLED)
         res = RES_OK;
     } else {
         res = RES_ERROR;
     }
+    OS_PROF_ZONE_END(disk_write);
     return res;
 }
 #endif
@@ -101,6 +137,25 @@ DRESULT disk_ioctl (
 )
 {
 DRESULT res;
+#if (_USE_ERASE)
+    // The freed clusters ranges are batched.
+    if (CTRL_ERASE_SECTOR == cmd) {
+        IF_OK(OS_FileSystemEraseQueue(pdrv, ((DWORD*)buff)[0], ((DWORD*)buff)[1])) { return RES_OK; }
+        return RES_ERROR;
+    }
+#endif //(_USE_ERASE)
+#if (OS_SEC_CACHE_ENABLED)
+    if (CTRL_SYNC == cmd) {
+        IF_STATUS(OS_SecCacheFlush(fs_sec_cache_hd_v[pdrv])) { return RES_ERROR; }
+    }
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (_USE_ERASE)
+    // After the cache flush: the deleted files data isn't written over the erased ranges.
+    // The erase is advisory (the media could not support it).
+    if (CTRL_SYNC == cmd) {
+        OS_FileSystemEraseFlush(pdrv);
+    }
+#endif //(_USE_ERASE)
     IF_OK(OS_DriverIoCtl(fs_media_dhd_v[pdrv], cmd, buff)) {
         res = RES_OK;
     } else {
@@ -0,0 +1,445 @@
+/***************************************************************************//**
+* @file    os_blk_sched.c
+* @brief   OS Block I/O scheduler.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_BLK_SCHED_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_mutex.h"
+#include "os_semaphore.h"
+#include "os_supervise.h"
+#include "os_time.h"
+#include "os_blk_sched.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "blk_sched"
+
+#define OS_BLK_SCHED_SLOT_UNDEF     -1
+
+//------------------------------------------------------------------------------
+typedef struct {
+    OS_BlkSchedIo*      io_p;
+    OS_Tick             tick_submit;
+    U32                 seq;        // Submit order.
+    Bool                is_busy;
+    Bool                is_issued;
+    OS_SemaphoreHd      done_shd;
+} OS_BlkSchedSlot;
+
+typedef struct {
+    OS_DriverHd         dhd;
+    OS_MutexHd          mutex;      // Queue protection (is not held during the transfers).
+    OS_SemaphoreHd      free_shd;   // Free slots.
+    U8*                 merge_buf_p;
+    U32                 head;       // Last dispatched transfer end (LBA).
+    U32                 seq;
+    U8                  busy;       // Busy slots (the critical section protects it and the dispatch owner).
+    Bool                is_dispatching;
+    OS_BlkSchedSlot     slots_v[OS_BLK_SCHED_QUEUE_LEN];
+    OS_BlkSchedStats    stats;
+} OS_BlkSchedConfigDyn;
+
+/******************************************************************************/
+static Bool OS_BlkSchedIsPending(const OS_BlkSchedSlot* slot_p);
+INLINE Bool OS_BlkSchedIsPending(const OS_BlkSchedSlot* slot_p)
+{
+    return ((OS_TRUE == slot_p->is_busy) && (OS_TRUE != slot_p->is_issued)) ? OS_TRUE : OS_FALSE;
+}
+
+/******************************************************************************/
+static Bool OS_BlkSchedIsHazard(const OS_BlkSchedIo* a_p, const OS_BlkSchedIo* b_p);
+INLINE Bool OS_BlkSchedIsHazard(const OS_BlkSchedIo* a_p, const OS_BlkSchedIo* b_p)
+{
+    if ((OS_TRUE != a_p->is_write) && (OS_TRUE != b_p->is_write)) { return OS_FALSE; }
+    return ((a_p->sector < (b_p->sector + b_p->count)) &&
+            (b_p->sector < (a_p->sector + a_p->count))) ? OS_TRUE : OS_FALSE;
+}
+
+/******************************************************************************/
+// Get the oldest pending request which should be done before the slot one.
+static S8 OS_BlkSchedConflictGet(const OS_BlkSchedConfigDyn* cfg_dyn_p, const S8 idx);
+S8 OS_BlkSchedConflictGet(const OS_BlkSchedConfigDyn* cfg_dyn_p, const S8 idx)
+{
+const OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[idx];
+S8 conflict = OS_BLK_SCHED_SLOT_UNDEF;
+    for (S8 i = 0; i < OS_BLK_SCHED_QUEUE_LEN; ++i) {
+        const OS_BlkSchedSlot* other_p = &cfg_dyn_p->slots_v[i];
+        if ((i == idx) || (OS_TRUE != OS_BlkSchedIsPending(other_p))) { continue; }
+        if (other_p->seq >= slot_p->seq) { continue; }
+        if (OS_TRUE == OS_BlkSchedIsHazard(slot_p->io_p, other_p->io_p)) {
+            if ((OS_BLK_SCHED_SLOT_UNDEF == conflict) || (other_p->seq < cfg_dyn_p->slots_v[conflict].seq)) {
+                conflict = i;
+            }
+        }
+    }
+    return conflict;
+}
+
+/******************************************************************************/
+static S8 OS_BlkSchedNextGet(OS_BlkSchedConfigDyn* cfg_dyn_p);
+S8 OS_BlkSchedNextGet(OS_BlkSchedConfigDyn* cfg_dyn_p)
+{
+S8 next     = OS_BLK_SCHED_SLOT_UNDEF;
+S8 lowest   = OS_BLK_SCHED_SLOT_UNDEF;
+S8 oldest   = OS_BLK_SCHED_SLOT_UNDEF;
+S8 conflict;
+    for (S8 i = 0; i < OS_BLK_SCHED_QUEUE_LEN; ++i) {
+        const OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[i];
+        if (OS_TRUE != OS_BlkSchedIsPending(slot_p)) { continue; }
+        const U32 sector = slot_p->io_p->sector;
+        if ((OS_BLK_SCHED_SLOT_UNDEF == oldest) || (slot_p->seq < cfg_dyn_p->slots_v[oldest].seq)) {
+            oldest = i;
+        }
+        if ((OS_BLK_SCHED_SLOT_UNDEF == lowest) || (sector < cfg_dyn_p->slots_v[lowest].io_p->sector)) {
+            lowest = i;
+        }
+        if (sector >= cfg_dyn_p->head) {
+            if ((OS_BLK_SCHED_SLOT_UNDEF == next) || (sector < cfg_dyn_p->slots_v[next].io_p->sector)) {
+                next = i;
+            }
+        }
+    }
+    if (OS_BLK_SCHED_SLOT_UNDEF == oldest) { return OS_BLK_SCHED_SLOT_UNDEF; }
+    // C-LOOK: ascending LBA from the head, then wrap to the lowest one.
+    if (OS_BLK_SCHED_SLOT_UNDEF == next) {
+        next = lowest;
+    }
+    // Anti-starvation.
+    if ((next != oldest) &&
+        ((OS_TickCountGet() - cfg_dyn_p->slots_v[oldest].tick_submit) >= OS_MS_TO_TICKS(OS_BLK_SCHED_DEADLINE_MS))) {
+        next = oldest;
+        cfg_dyn_p->stats.deadlines++;
+    }
+    // Keep the submit order of the overlapped requests.
+    while (OS_BLK_SCHED_SLOT_UNDEF != (conflict = OS_BlkSchedConflictGet(cfg_dyn_p, next))) {
+        next = conflict;
+    }
+    return next;
+}
+
+/******************************************************************************/
+static Status OS_BlkSchedTransfer(OS_BlkSchedConfigDyn* cfg_dyn_p, const S8 run_v[], const U8 run_len,
+                                  const U32 sector, const U32 count);
+Status OS_BlkSchedTransfer(OS_BlkSchedConfigDyn* cfg_dyn_p, const S8 run_v[], const U8 run_len,
+                           const U32 sector, const U32 count)
+{
+const OS_BlkSchedIo* io_first_p = cfg_dyn_p->slots_v[run_v[0]].io_p;
+const Bool is_write = io_first_p->is_write;
+U8* data_p = (U8*)io_first_p->data_p;
+U32 lba = sector;
+Bool is_contiguous = OS_TRUE;
+Status s;
+    // Merged requests with the adjacent buffers need no staging.
+    for (U8 i = 1; i < run_len; ++i) {
+        const OS_BlkSchedIo* io_prev_p = cfg_dyn_p->slots_v[run_v[i - 1]].io_p;
+        const OS_BlkSchedIo* io_p = cfg_dyn_p->slots_v[run_v[i]].io_p;
+        if ((U8*)io_p->data_p != ((U8*)io_prev_p->data_p + io_prev_p->count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX)) {
+            is_contiguous = OS_FALSE;
+            break;
+        }
+    }
+    if (OS_TRUE != is_contiguous) {
+        data_p = cfg_dyn_p->merge_buf_p;
+        if (OS_TRUE == is_write) {
+            U8* dst_p = data_p;
+            for (U8 i = 0; i < run_len; ++i) {
+                const OS_BlkSchedIo* io_p = cfg_dyn_p->slots_v[run_v[i]].io_p;
+                OS_MemCpy(dst_p, io_p->data_p, io_p->count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+                dst_p += io_p->count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+            }
+        }
+    }
+    if (OS_TRUE == is_write) {
+        s = OS_DriverWrite(cfg_dyn_p->dhd, data_p, count, &lba);
+    } else {
+        s = OS_DriverRead(cfg_dyn_p->dhd, data_p, count, &lba);
+    }
+    if ((OS_TRUE != is_contiguous) && (OS_TRUE != is_write)) {
+        IF_OK(s) {
+            const U8* src_p = data_p;
+            for (U8 i = 0; i < run_len; ++i) {
+                const OS_BlkSchedIo* io_p = cfg_dyn_p->slots_v[run_v[i]].io_p;
+                OS_MemCpy(io_p->data_p, src_p, io_p->count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+                src_p += io_p->count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+            }
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+// Called with the queue locked. Drains the queue.
+static void OS_BlkSchedDispatch(OS_BlkSchedConfigDyn* cfg_dyn_p);
+void OS_BlkSchedDispatch(OS_BlkSchedConfigDyn* cfg_dyn_p)
+{
+S8 run_v[OS_BLK_SCHED_QUEUE_LEN];
+S8 idx;
+    while (OS_BLK_SCHED_SLOT_UNDEF != (idx = OS_BlkSchedNextGet(cfg_dyn_p))) {
+        const OS_BlkSchedIo* io_p = cfg_dyn_p->slots_v[idx].io_p;
+        const U32 sector = io_p->sector;
+        U32 count = io_p->count;
+        U8 run_len = 0;
+        Bool is_merged;
+        run_v[run_len++] = idx;
+        cfg_dyn_p->slots_v[idx].is_issued = OS_TRUE;
+        // Merge the adjacent requests of the same direction.
+        do {
+            is_merged = OS_FALSE;
+            for (S8 i = 0; i < OS_BLK_SCHED_QUEUE_LEN; ++i) {
+                OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[i];
+                if (OS_TRUE != OS_BlkSchedIsPending(slot_p)) { continue; }
+                if ((slot_p->io_p->is_write != io_p->is_write) ||
+                    (slot_p->io_p->sector != (sector + count)) ||
+                    ((count + slot_p->io_p->count) > OS_BLK_SCHED_MERGE_SECTORS_MAX)) { continue; }
+                if (OS_BLK_SCHED_SLOT_UNDEF != OS_BlkSchedConflictGet(cfg_dyn_p, i)) { continue; }
+                slot_p->is_issued = OS_TRUE;
+                run_v[run_len++] = i;
+                count += slot_p->io_p->count;
+                is_merged = OS_TRUE;
+            }
+        } while (OS_TRUE == is_merged);
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+        const Status s = OS_BlkSchedTransfer(cfg_dyn_p, run_v, run_len, sector, count);
+        OS_MutexLock(cfg_dyn_p->mutex, OS_BLOCK);
+        cfg_dyn_p->head = sector + count;
+        cfg_dyn_p->stats.dispatches++;
+        cfg_dyn_p->stats.merged += run_len - 1;
+        cfg_dyn_p->stats.sectors += count;
+        IF_STATUS(s) {
+            cfg_dyn_p->stats.errors++;
+        }
+        for (U8 i = 0; i < run_len; ++i) {
+            OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[run_v[i]];
+            slot_p->io_p->status = s;
+            OS_SemaphoreUnlock(slot_p->done_shd);
+        }
+    }
+}
+
+/******************************************************************************/
+// The idle queue is bypassed: the single request goes to the driver without the queue round trip.
+static Bool OS_BlkSchedBypass(OS_BlkSchedConfigDyn* cfg_dyn_p, OS_BlkSchedIo* io_p);
+Bool OS_BlkSchedBypass(OS_BlkSchedConfigDyn* cfg_dyn_p, OS_BlkSchedIo* io_p)
+{
+U32 lba = io_p->sector;
+Bool is_idle;
+Bool is_queued;
+    OS_CriticalSectionEnter(); {
+        is_idle = ((0 == cfg_dyn_p->busy) && (OS_TRUE != cfg_dyn_p->is_dispatching)) ? OS_TRUE : OS_FALSE;
+        if (OS_TRUE == is_idle) {
+            // Own the dispatch: the other submitters queue their requests meanwhile.
+            cfg_dyn_p->is_dispatching = OS_TRUE;
+        }
+    }
+    OS_CriticalSectionExit();
+    if (OS_TRUE != is_idle) { return OS_FALSE; }
+    if (OS_TRUE == io_p->is_write) {
+        io_p->status = OS_DriverWrite(cfg_dyn_p->dhd, io_p->data_p, io_p->count, &lba);
+    } else {
+        io_p->status = OS_DriverRead(cfg_dyn_p->dhd, io_p->data_p, io_p->count, &lba);
+    }
+    OS_CriticalSectionEnter(); {
+        cfg_dyn_p->head = io_p->sector + io_p->count;
+        cfg_dyn_p->stats.requests++;
+        cfg_dyn_p->stats.dispatches++;
+        cfg_dyn_p->stats.sectors += io_p->count;
+        cfg_dyn_p->stats.depth_sum++;
+        if (0 == cfg_dyn_p->stats.depth_max) {
+            cfg_dyn_p->stats.depth_max = 1;
+        }
+        IF_STATUS(io_p->status) {
+            cfg_dyn_p->stats.errors++;
+        }
+        is_queued = (0 != cfg_dyn_p->busy) ? OS_TRUE : OS_FALSE;
+        if (OS_TRUE != is_queued) {
+            cfg_dyn_p->is_dispatching = OS_FALSE;
+        }
+    }
+    OS_CriticalSectionExit();
+    if (OS_TRUE == is_queued) {
+        // Drain the requests queued during the transfer.
+        OS_MutexLock(cfg_dyn_p->mutex, OS_BLOCK);
+        OS_BlkSchedDispatch(cfg_dyn_p);
+        cfg_dyn_p->is_dispatching = OS_FALSE;
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return OS_TRUE;
+}
+
+/******************************************************************************/
+Status OS_BlkSchedCreate(const OS_DriverHd dhd, OS_BlkSchedHd* bshd_p)
+{
+Status s = S_OK;
+    if ((OS_NULL == dhd) || (OS_NULL == bshd_p)) { return S_INVALID_PTR; }
+    OS_BlkSchedConfigDyn* cfg_dyn_p = OS_Malloc(sizeof(OS_BlkSchedConfigDyn));
+    if (OS_NULL == cfg_dyn_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(cfg_dyn_p, 0, sizeof(OS_BlkSchedConfigDyn));
+    cfg_dyn_p->dhd = dhd;
+    cfg_dyn_p->merge_buf_p = OS_MallocEx(OS_BLK_SCHED_MERGE_SECTORS_MAX * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_BLK_SCHED_MEM);
+    if (OS_NULL == cfg_dyn_p->merge_buf_p) { s = S_OUT_OF_MEMORY; goto error; }
+    cfg_dyn_p->mutex = OS_MutexCreate();
+    if (OS_NULL == cfg_dyn_p->mutex) { s = S_INVALID_PTR; goto error; }
+    cfg_dyn_p->free_shd = OS_SemaphoreCountingCreate(OS_BLK_SCHED_QUEUE_LEN, OS_BLK_SCHED_QUEUE_LEN);
+    if (OS_NULL == cfg_dyn_p->free_shd) { s = S_INVALID_PTR; goto error; }
+    for (U8 i = 0; i < OS_BLK_SCHED_QUEUE_LEN; ++i) {
+        cfg_dyn_p->slots_v[i].done_shd = OS_SemaphoreBinaryCreate();
+        if (OS_NULL == cfg_dyn_p->slots_v[i].done_shd) { s = S_INVALID_PTR; goto error; }
+    }
+    *bshd_p = (OS_BlkSchedHd)cfg_dyn_p;
+error:
+    IF_STATUS(s) {
+        OS_BlkSchedDelete((OS_BlkSchedHd)cfg_dyn_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_BlkSchedDelete(const OS_BlkSchedHd bshd)
+{
+OS_BlkSchedConfigDyn* cfg_dyn_p = (OS_BlkSchedConfigDyn*)bshd;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    for (U8 i = 0; i < OS_BLK_SCHED_QUEUE_LEN; ++i) {
+        if (OS_NULL != cfg_dyn_p->slots_v[i].done_shd) {
+            OS_SemaphoreDelete(cfg_dyn_p->slots_v[i].done_shd);
+        }
+    }
+    if (OS_NULL != cfg_dyn_p->free_shd) {
+        OS_SemaphoreDelete(cfg_dyn_p->free_shd);
+    }
+    if (OS_NULL != cfg_dyn_p->mutex) {
+        OS_MutexDelete(cfg_dyn_p->mutex);
+    }
+    OS_FreeEx(cfg_dyn_p->merge_buf_p, OS_BLK_SCHED_MEM);
+    OS_Free(cfg_dyn_p);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_BlkSchedBatch(const OS_BlkSchedHd bshd, OS_BlkSchedIo* io_v, const U32 io_count)
+{
+OS_BlkSchedConfigDyn* cfg_dyn_p = (OS_BlkSchedConfigDyn*)bshd;
+S8 own_v[OS_BLK_SCHED_QUEUE_LEN];
+U32 io_idx = 0;
+Status s = S_OK;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == io_v)) { return S_INVALID_PTR; }
+    while (io_idx < io_count) {
+        U8 own_count = 0;
+        Bool is_dispatcher;
+        // Take as many free slots as available (at least one) - the queue is never starved by the partial batches.
+        IF_STATUS(OS_SemaphoreLock(cfg_dyn_p->free_shd, OS_BLOCK)) { return S_TIMEOUT; }
+        ++own_count;
+        while (((io_idx + own_count) < io_count) && (own_count < OS_BLK_SCHED_QUEUE_LEN)) {
+            IF_STATUS(OS_SemaphoreLock(cfg_dyn_p->free_shd, OS_NO_BLOCK)) { break; }
+            ++own_count;
+        }
+        OS_MutexLock(cfg_dyn_p->mutex, OS_BLOCK);
+        for (U8 i = 0, slot_idx = 0; i < own_count; ++i) {
+            while (OS_TRUE == cfg_dyn_p->slots_v[slot_idx].is_busy) { ++slot_idx; }
+            OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[slot_idx];
+            slot_p->io_p        = &io_v[io_idx + i];
+            slot_p->io_p->status= S_IN_PROGRESS;
+            slot_p->tick_submit = OS_TickCountGet();
+            slot_p->seq         = cfg_dyn_p->seq++;
+            slot_p->is_busy     = OS_TRUE;
+            slot_p->is_issued   = OS_FALSE;
+            own_v[i]            = slot_idx;
+            OS_CriticalSectionEnter(); {
+                const U32 depth = ++cfg_dyn_p->busy;
+                cfg_dyn_p->stats.requests++;
+                cfg_dyn_p->stats.depth_sum += depth;
+                if (depth > cfg_dyn_p->stats.depth_max) {
+                    cfg_dyn_p->stats.depth_max = depth;
+                }
+            }
+            OS_CriticalSectionExit();
+        }
+        OS_CriticalSectionEnter(); {
+            is_dispatcher = (OS_TRUE != cfg_dyn_p->is_dispatching) ? OS_TRUE : OS_FALSE;
+            cfg_dyn_p->is_dispatching = OS_TRUE;
+        }
+        OS_CriticalSectionExit();
+        if (OS_TRUE == is_dispatcher) {
+            OS_BlkSchedDispatch(cfg_dyn_p);
+            cfg_dyn_p->is_dispatching = OS_FALSE;
+        }
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+        // Wait for the own requests (dispatched by this or the other task).
+        for (U8 i = 0; i < own_count; ++i) {
+            OS_BlkSchedSlot* slot_p = &cfg_dyn_p->slots_v[own_v[i]];
+            OS_SemaphoreLock(slot_p->done_shd, OS_BLOCK);
+            if ((S_OK == s) && (S_OK != slot_p->io_p->status)) {
+                s = slot_p->io_p->status;
+            }
+            OS_MutexLock(cfg_dyn_p->mutex, OS_BLOCK);
+            slot_p->is_busy     = OS_FALSE;
+            slot_p->is_issued   = OS_FALSE;
+            slot_p->io_p        = OS_NULL;
+            OS_CriticalSectionEnter(); {
+                --cfg_dyn_p->busy;
+            }
+            OS_CriticalSectionExit();
+            OS_MutexUnlock(cfg_dyn_p->mutex);
+            OS_SemaphoreUnlock(cfg_dyn_p->free_shd);
+        }
+        io_idx += own_count;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_BlkSchedRead(const OS_BlkSchedHd bshd, void* data_in_p, const U32 sector, const U32 count)
+{
+OS_BlkSchedIo io = {
+    .data_p     = data_in_p,
+    .sector     = sector,
+    .count      = count,
+    .is_write   = OS_FALSE,
+    .status     = S_UNDEF
+};
+    if (OS_NULL == bshd) { return S_INVALID_PTR; }
+    if (OS_TRUE == OS_BlkSchedBypass((OS_BlkSchedConfigDyn*)bshd, &io)) { return io.status; }
+    return OS_BlkSchedBatch(bshd, &io, 1);
+}
+
+/******************************************************************************/
+Status OS_BlkSchedWrite(const OS_BlkSchedHd bshd, void* data_out_p, const U32 sector, const U32 count)
+{
+OS_BlkSchedIo io = {
+    .data_p     = data_out_p,
+    .sector     = sector,
+    .count      = count,
+    .is_write   = OS_TRUE,
+    .status     = S_UNDEF
+};
+    if (OS_NULL == bshd) { return S_INVALID_PTR; }
+    if (OS_TRUE == OS_BlkSchedBypass((OS_BlkSchedConfigDyn*)bshd, &io)) { return io.status; }
+    return OS_BlkSchedBatch(bshd, &io, 1);
+}
+
+/******************************************************************************/
+Status OS_BlkSchedStatsGet(const OS_BlkSchedHd bshd, OS_BlkSchedStats* stats_p)
+{
+const OS_BlkSchedConfigDyn* cfg_dyn_p = (OS_BlkSchedConfigDyn*)bshd;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    OS_MemCpy(stats_p, &cfg_dyn_p->stats, sizeof(cfg_dyn_p->stats));
+    return S_OK;
+}
+
+/******************************************************************************/
+void OS_BlkSchedStatsReset(const OS_BlkSchedHd bshd)
+{
+OS_BlkSchedConfigDyn* cfg_dyn_p = (OS_BlkSchedConfigDyn*)bshd;
+    if (OS_NULL == cfg_dyn_p) { return; }
+    IF_OK(OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        OS_CriticalSectionEnter(); {
+            OS_MemSet(&cfg_dyn_p->stats, 0, sizeof(cfg_dyn_p->stats));
+        }
+        OS_CriticalSectionExit();
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+}
+
+#endif //(OS_FILE_SYSTEM_ENABLED) && (OS_BLK_SCHED_ENABLED)
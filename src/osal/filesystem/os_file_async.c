@@ -0,0 +1,227 @@
+/***************************************************************************//**
+* @file    os_file_async.c
+* @brief   OS File asynchronous requests.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_ASYNC_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_supervise.h"
+#include "os_semaphore.h"
+#include "os_mailbox.h"
+#include "os_time.h"
+#include "os_task_fs.h"
+#include "os_file_async.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "file_async"
+
+//------------------------------------------------------------------------------
+typedef struct {
+    OS_QueueHd          qhd;        // Completions queue.
+    OS_QueueHd          fsd_qhd;    // Daemon queue.
+    OS_SemaphoreHd      slots_shd;  // Free request slots.
+    OS_FileAsyncClientConfig cfg;
+    OS_FileAsyncStats   stats;
+} OS_FileAsyncConfigDyn;
+
+//------------------------------------------------------------------------------
+static Status OS_FileAsyncSubmit(OS_FileAsyncConfigDyn* cfg_dyn_p, const OS_FileAsyncRequest* req_p, const Size size);
+
+/******************************************************************************/
+Status OS_FileAsyncClientCreate(const OS_FileAsyncClientConfig* cfg_p, OS_FileAsyncClientHd* chd_p)
+{
+    if ((OS_NULL == cfg_p) || (OS_NULL == chd_p)) { return S_INVALID_PTR; }
+    if (0 == cfg_p->in_flight_max) { return S_INVALID_VALUE; }
+    const OS_TaskHd fsd_thd = OS_TaskByNameGet(OS_DAEMON_NAME_FS);
+    if (OS_NULL == fsd_thd) { return S_INVALID_STATE; }
+    OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)OS_Malloc(sizeof(OS_FileAsyncConfigDyn));
+    if (OS_NULL == cfg_dyn_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(cfg_dyn_p, 0, sizeof(OS_FileAsyncConfigDyn));
+    cfg_dyn_p->slots_shd = OS_SemaphoreCountingCreate(cfg_p->in_flight_max, cfg_p->in_flight_max);
+    if (OS_NULL == cfg_dyn_p->slots_shd) {
+        OS_Free(cfg_dyn_p);
+        return S_OUT_OF_MEMORY;
+    }
+    cfg_dyn_p->cfg      = *cfg_p;
+    cfg_dyn_p->qhd      = (OS_NULL != cfg_p->qhd) ? cfg_p->qhd : OS_TaskStdInGet(OS_THIS_TASK);
+    cfg_dyn_p->fsd_qhd  = OS_TaskStdInGet(fsd_thd);
+    *chd_p = (OS_FileAsyncClientHd)cfg_dyn_p;
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_FileAsyncClientDelete(const OS_FileAsyncClientHd chd)
+{
+OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)chd;
+Status s = S_OK;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    // Take all the slots - nothing is in flight then.
+    for (U8 i = 0; i < cfg_dyn_p->cfg.in_flight_max; ++i) {
+        IF_STATUS(s = OS_SemaphoreLock(cfg_dyn_p->slots_shd, OS_TIMEOUT_FS)) {
+            OS_LOG_S(D_WARNING, s);
+            return s;
+        }
+    }
+    OS_SemaphoreDelete(cfg_dyn_p->slots_shd);
+    OS_Free(cfg_dyn_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileAsyncSubmit(OS_FileAsyncConfigDyn* cfg_dyn_p, const OS_FileAsyncRequest* req_p, const Size size)
+{
+Status s;
+    IF_STATUS(OS_SemaphoreLock(cfg_dyn_p->slots_shd, cfg_dyn_p->cfg.timeout)) {
+        OS_CriticalSectionEnter(); {
+            cfg_dyn_p->stats.rejects++;
+        } OS_CriticalSectionExit();
+        return S_BUSY;
+    }
+    OS_CriticalSectionEnter(); {
+        cfg_dyn_p->stats.submits++;
+        cfg_dyn_p->stats.in_flight++;
+        cfg_dyn_p->stats.in_flight_peak = MAX(cfg_dyn_p->stats.in_flight_peak, cfg_dyn_p->stats.in_flight);
+    } OS_CriticalSectionExit();
+    OS_Message* msg_p = OS_MessageCreate(OS_MSG_FS_ASYNC_REQ, (OS_MessageData)req_p, size, cfg_dyn_p->cfg.timeout);
+    if (OS_NULL == msg_p) {
+        s = S_OUT_OF_MEMORY;
+    } else {
+        IF_OK(s = OS_MessageSend(cfg_dyn_p->fsd_qhd, msg_p, cfg_dyn_p->cfg.timeout, cfg_dyn_p->cfg.prio)) {
+            return s;
+        }
+        OS_MessageDelete(msg_p);
+    }
+    // Release the slot - there will be no completion.
+    OS_CriticalSectionEnter(); {
+        cfg_dyn_p->stats.submits--;
+        cfg_dyn_p->stats.in_flight--;
+    } OS_CriticalSectionExit();
+    OS_SemaphoreUnlock(cfg_dyn_p->slots_shd);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileOpenAsync(const OS_FileAsyncClientHd chd, ConstStrP file_path_p, const OS_FileOpenMode op_mode, const U32 tag)
+{
+OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)chd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == file_path_p)) { return S_INVALID_PTR; }
+    // The path is passed inside the message.
+    const Size size = sizeof(OS_FileAsyncRequest) + OS_StrLen((const char*)file_path_p) + 1;
+    if (U16_MAX < size) { return S_INVALID_SIZE; }
+    OS_FileAsyncRequest* req_p = (OS_FileAsyncRequest*)OS_Malloc(size);
+    if (OS_NULL == req_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(req_p, 0, sizeof(OS_FileAsyncRequest));
+    req_p->chd          = chd;
+    req_p->tag          = tag;
+    req_p->op           = OS_FS_ASYNC_OP_OPEN;
+    req_p->op_mode      = op_mode;
+    req_p->tick_submit  = OS_TickCountGet();
+    OS_StrCpy((char*)req_p->path, (const char*)file_path_p);
+    s = OS_FileAsyncSubmit(cfg_dyn_p, req_p, size);
+    OS_Free(req_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileReadAsync(const OS_FileAsyncClientHd chd, const OS_FileHd fhd, void* data_in_p, const Size size, const U32 tag)
+{
+OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)chd;
+OS_FileAsyncRequest req;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == fhd) || (OS_NULL == data_in_p)) { return S_INVALID_PTR; }
+    OS_MemSet(&req, 0, sizeof(req));
+    req.chd         = chd;
+    req.fhd         = fhd;
+    req.data_p      = data_in_p;
+    req.size        = size;
+    req.tag         = tag;
+    req.op          = OS_FS_ASYNC_OP_READ;
+    req.tick_submit = OS_TickCountGet();
+    return OS_FileAsyncSubmit(cfg_dyn_p, &req, sizeof(req));
+}
+
+/******************************************************************************/
+Status OS_FileWriteAsync(const OS_FileAsyncClientHd chd, const OS_FileHd fhd, void* data_out_p, const Size size, const U32 tag)
+{
+OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)chd;
+OS_FileAsyncRequest req;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == fhd) || (OS_NULL == data_out_p)) { return S_INVALID_PTR; }
+    OS_MemSet(&req, 0, sizeof(req));
+    req.chd         = chd;
+    req.fhd         = fhd;
+    req.data_p      = data_out_p;
+    req.size        = size;
+    req.tag         = tag;
+    req.op          = OS_FS_ASYNC_OP_WRITE;
+    req.tick_submit = OS_TickCountGet();
+    return OS_FileAsyncSubmit(cfg_dyn_p, &req, sizeof(req));
+}
+
+/******************************************************************************/
+Status OS_FileAsyncStatsGet(const OS_FileAsyncClientHd chd, OS_FileAsyncStats* stats_p)
+{
+const OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)chd;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    OS_CriticalSectionEnter(); {
+        *stats_p = cfg_dyn_p->stats;
+    } OS_CriticalSectionExit();
+    return S_OK;
+}
+
+/******************************************************************************/
+void OS_FileAsyncRequestDo(const OS_FileAsyncRequest* req_p)
+{
+OS_FileAsyncConfigDyn* cfg_dyn_p = (OS_FileAsyncConfigDyn*)req_p->chd;
+OS_FileAsyncCompletion done;
+    OS_ASSERT_VALUE(OS_NULL != cfg_dyn_p);
+    const OS_QueueHd qhd = cfg_dyn_p->qhd;
+    done.chd    = req_p->chd;
+    done.fhd    = req_p->fhd;
+    done.data_p = req_p->data_p;
+    done.size   = 0;
+    done.tag    = req_p->tag;
+    done.op     = req_p->op;
+    switch (req_p->op) {
+        case OS_FS_ASYNC_OP_OPEN:
+            IF_STATUS(done.status = OS_FileOpen(&done.fhd, req_p->path, req_p->op_mode)) {
+                OS_Free(done.fhd);
+                done.fhd = OS_NULL;
+            }
+            break;
+        case OS_FS_ASYNC_OP_READ:
+        case OS_FS_ASYNC_OP_WRITE: {
+            const U32 offset = OS_FileTell(req_p->fhd);
+            done.status = (OS_FS_ASYNC_OP_READ == req_p->op) ?
+                          OS_FileRead(req_p->fhd, req_p->data_p, req_p->size) :
+                          OS_FileWrite(req_p->fhd, req_p->data_p, req_p->size);
+            done.size = OS_FileTell(req_p->fhd) - offset;
+            }
+            break;
+        default:
+            done.status = S_INVALID_VALUE;
+            break;
+    }
+    done.latency = OS_TICKS_TO_MS(OS_TickCountGet() - req_p->tick_submit);
+    OS_CriticalSectionEnter(); {
+        cfg_dyn_p->stats.completions++;
+        cfg_dyn_p->stats.in_flight--;
+        if (S_OK != done.status) { cfg_dyn_p->stats.errors++; }
+        cfg_dyn_p->stats.latency_max = MAX(cfg_dyn_p->stats.latency_max, done.latency);
+    } OS_CriticalSectionExit();
+    // The slot is free before the client gets the completion (the client could be deleted then).
+    OS_SemaphoreUnlock(cfg_dyn_p->slots_shd);
+    OS_Message* msg_p = OS_MessageCreate(OS_MSG_FS_ASYNC_DONE, (OS_MessageData)&done, sizeof(done), OS_TIMEOUT_FS);
+    if (OS_NULL != msg_p) {
+        IF_STATUS(OS_MessageSend(qhd, msg_p, OS_TIMEOUT_FS, OS_MSG_PRIO_NORMAL)) {
+            OS_MessageDelete(msg_p);
+            OS_LOG(D_WARNING, "Completion lost: op %d, tag %u", done.op, done.tag);
+        }
+    } else {
+        OS_LOG(D_WARNING, "Completion lost: op %d, tag %u", done.op, done.tag);
+    }
+}
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_ASYNC_ENABLED)
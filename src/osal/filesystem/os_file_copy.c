@@ -0,0 +1,207 @@
+/***************************************************************************//**
+* @file    os_file_copy.c
+* @brief   OS File copy.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_COPY_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_queue.h"
+#include "os_mailbox.h"
+#include "os_task.h"
+#include "os_time.h"
+#include "os_task_fs.h"
+#include "os_file_async.h"
+#include "os_file_copy.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "file_copy"
+
+//------------------------------------------------------------------------------
+typedef struct {
+    OS_QueueHd          qhd;        // Completions queue.
+    OS_FileAsyncClientHd chd;
+    U8**                bufs_v;
+    U32                 in_flight;
+    U32                 written;    // Completed writes bytes.
+} FCopy;
+
+//------------------------------------------------------------------------------
+static Status FCopyWait(FCopy* copy_p, OS_TimeMs* wait_ms_p);
+static U32    FCopyCrc(const U32 crc, U8* data_p, const Size size);
+
+/******************************************************************************/
+Status OS_FileCopy(ConstStrP src_path_p, ConstStrP dst_path_p, const OS_FileCopyConfig* cfg_p, OS_FileCopyStats* stats_p)
+{
+const Size buf_size = ((OS_NULL != cfg_p) && (0 != cfg_p->buf_size)) ? cfg_p->buf_size : OS_FILE_COPY_BUF_SIZE;
+const U8 bufs_count = ((OS_NULL != cfg_p) && (0 != cfg_p->bufs_count)) ? cfg_p->bufs_count : OS_FILE_COPY_BUFS;
+const OS_QueueConfig que_cfg = {
+    .len        = bufs_count,
+    .item_size  = sizeof(OS_Message*)
+};
+OS_FileAsyncClientConfig client_cfg;
+OS_FileCopyStats stats;
+OS_FileHd src_fhd = OS_NULL;
+OS_FileHd dst_fhd = OS_NULL;
+FCopy copy;
+U32 size = 0;
+Bool is_leaked = OS_FALSE;
+Status s;
+    if ((OS_NULL == src_path_p) || (OS_NULL == dst_path_p)) { return S_INVALID_PTR; }
+    if ((0 == buf_size) || (0 != (buf_size % OS_FILE_SYSTEM_SECTOR_SIZE_MAX))) { return S_INVALID_SIZE; }
+    if (2 > bufs_count) { return S_INVALID_VALUE; }
+    OS_LOG(D_DEBUG, "File copy: %s -> %s", src_path_p, dst_path_p);
+    OS_MemSet(&stats, 0, sizeof(stats));
+    OS_MemSet(&copy, 0, sizeof(copy));
+    copy.bufs_v = (U8**)OS_Malloc(bufs_count * sizeof(U8*));
+    if (OS_NULL == copy.bufs_v) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(copy.bufs_v, 0, bufs_count * sizeof(U8*));
+    for (U8 i = 0; i < bufs_count; ++i) {
+        copy.bufs_v[i] = (U8*)OS_MallocAlignedEx(buf_size, OS_FILE_SYSTEM_DMA_ALIGN, OS_FILE_COPY_MEM);
+        if (OS_NULL == copy.bufs_v[i]) { s = S_OUT_OF_MEMORY; goto error; }
+    }
+    // The private completions queue: the caller stdin could have the other messages.
+    IF_STATUS(s = OS_QueueCreate(&que_cfg, OS_TaskGet(), &copy.qhd)) { goto error; }
+    client_cfg.qhd          = copy.qhd;
+    client_cfg.in_flight_max= bufs_count;
+    client_cfg.timeout      = OS_TIMEOUT_FS;
+    client_cfg.prio         = OS_MSG_PRIO_NORMAL;
+    IF_STATUS(s = OS_FileAsyncClientCreate(&client_cfg, &copy.chd)) { goto error; }
+    IF_STATUS(s = OS_FileOpen(&src_fhd, src_path_p, BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) {
+        OS_Free(src_fhd);
+        src_fhd = OS_NULL;
+        goto error;
+    }
+    IF_STATUS(s = OS_FileOpen(&dst_fhd, dst_path_p, BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) |
+                                                    BIT(OS_FS_FILE_OP_MODE_READ) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+        OS_Free(dst_fhd);
+        dst_fhd = OS_NULL;
+        goto error;
+    }
+    size = OS_FileSizeGet(src_fhd);
+    const OS_Tick tick_start = OS_TickCountGet();
+    // The chain is allocated once (the writes don't search the free clusters).
+    IF_STATUS(s = OS_FileAllocate(dst_fhd, size, OS_FALSE)) { goto error; }
+    stats.crc = U32_MAX;
+    for (U32 offset = 0, chunk = 0; offset < size; offset += buf_size, ++chunk) {
+        const Size len = MIN(buf_size, size - offset);
+        U8* buf_p = copy.bufs_v[chunk % bufs_count];
+        // The writes complete in order: the oldest one frees the buffer.
+        if (bufs_count <= copy.in_flight) {
+            IF_STATUS(s = FCopyWait(&copy, &stats.stall_ms)) { goto error; }
+        }
+        const OS_Tick tick_read = OS_TickCountGet();
+        // The whole sectors are read by the media commands straight to the buffer.
+        IF_STATUS(s = OS_FileReadDirect(src_fhd, buf_p, len)) { goto error; }
+        stats.read_ms += OS_TICKS_TO_MS(OS_TickCountGet() - tick_read);
+        if ((OS_NULL != cfg_p) && (OS_TRUE == cfg_p->is_verify)) {
+            stats.crc = FCopyCrc(stats.crc, buf_p, len);
+        }
+        IF_STATUS(s = OS_FileWriteAsync(copy.chd, dst_fhd, buf_p, len, chunk)) { goto error; }
+        ++copy.in_flight;
+    }
+    {
+        const OS_Tick tick_flush = OS_TickCountGet();
+        OS_TimeMs wait_ms = 0;
+        while (0 != copy.in_flight) {
+            IF_STATUS(s = FCopyWait(&copy, &wait_ms)) { goto error; }
+        }
+        IF_STATUS(s = OS_FileSync(dst_fhd)) { goto error; }
+        stats.flush_ms = OS_TICKS_TO_MS(OS_TickCountGet() - tick_flush);
+    }
+    stats.time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    // Short write - the volume is full.
+    if (size != copy.written) { s = S_FS_ALLOCATION; goto error; }
+    stats.size = size;
+    if ((OS_NULL != cfg_p) && (OS_TRUE == cfg_p->is_verify)) {
+        const OS_Tick tick_verify = OS_TickCountGet();
+        U32 crc = U32_MAX;
+        IF_STATUS(s = OS_FileLSeek(dst_fhd, 0)) { goto error; }
+        for (U32 offset = 0; offset < size; offset += buf_size) {
+            const Size len = MIN(buf_size, size - offset);
+            IF_STATUS(s = OS_FileReadDirect(dst_fhd, copy.bufs_v[0], len)) { goto error; }
+            crc = FCopyCrc(crc, copy.bufs_v[0], len);
+        }
+        stats.verify_ms = OS_TICKS_TO_MS(OS_TickCountGet() - tick_verify);
+        if (crc != stats.crc) { s = S_INVALID_CRC; }
+    }
+error:
+    // The buffers are in use until the completions.
+    while (0 != copy.in_flight) {
+        const U32 in_flight = copy.in_flight;
+        OS_TimeMs wait_ms = 0;
+        FCopyWait(&copy, &wait_ms);
+        if (in_flight == copy.in_flight) { break; } // No completion.
+    }
+    if (OS_NULL != copy.chd) {
+        OS_FileAsyncStats async_stats;
+        IF_OK(OS_FileAsyncStatsGet(copy.chd, &async_stats)) {
+            stats.write_latency_max = async_stats.latency_max;
+        }
+        if (0 != copy.in_flight) {
+            is_leaked = OS_TRUE;
+        } else IF_STATUS(OS_FileAsyncClientDelete(copy.chd)) {
+            is_leaked = OS_TRUE;
+        }
+    }
+    if (OS_NULL != src_fhd) {
+        OS_FileClose(&src_fhd);
+    }
+    if (OS_TRUE == is_leaked) {
+        // The FS daemon could still use the requests: the queue, the destination and the buffers are leaked.
+        OS_LOG(D_WARNING, "File copy: %u writes in flight, resources leaked", copy.in_flight);
+    } else {
+        if (OS_NULL != copy.qhd) {
+            OS_QueueDelete(copy.qhd);
+        }
+        if (OS_NULL != dst_fhd) {
+            OS_FileClose(&dst_fhd);
+            // The destination is allocated to the full size - the partial copy is dropped.
+            IF_STATUS(s) { OS_FileDelete(dst_path_p); }
+        }
+        for (U8 i = 0; i < bufs_count; ++i) {
+            OS_FreeAligned(copy.bufs_v[i]);
+        }
+        OS_Free(copy.bufs_v);
+    }
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+    if (OS_NULL != stats_p) { *stats_p = stats; }
+    return s;
+}
+
+/******************************************************************************/
+// Wait for the oldest write completion.
+Status FCopyWait(FCopy* copy_p, OS_TimeMs* wait_ms_p)
+{
+OS_Message* msg_p;
+Status s;
+    const OS_Tick tick_start = OS_TickCountGet();
+    IF_STATUS(s = OS_MessageReceive(copy_p->qhd, &msg_p, OS_TIMEOUT_FS)) { return s; }
+    *wait_ms_p += OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    if (OS_MSG_FS_ASYNC_DONE == msg_p->id) {
+        const OS_FileAsyncCompletion* done_p = (const OS_FileAsyncCompletion*)&(msg_p->data[0]);
+        --copy_p->in_flight;
+        copy_p->written += done_p->size;
+        s = done_p->status;
+    } else {
+        s = S_INVALID_MESSAGE;
+    }
+    OS_MessageDelete(msg_p);
+    return s;
+}
+
+/******************************************************************************/
+// The buffers CRC chain (OS_MemCrc32() takes the whole words - the tail is zero padded).
+U32 FCopyCrc(const U32 crc, U8* data_p, const Size size)
+{
+const Size size_aligned = (size + sizeof(U32) - 1) & ~(sizeof(U32) - 1);
+U32 crc_v[2];
+    OS_MemSet(&data_p[size], 0, size_aligned - size);
+    crc_v[0] = crc;
+    crc_v[1] = OS_MemCrc32(data_p, size_aligned);
+    return OS_MemCrc32(crc_v, sizeof(crc_v));
+}
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_COPY_ENABLED)
@@ -0,0 +1,391 @@
+/***************************************************************************//**
+* @file    os_file_stream.c
+* @brief   OS File stream.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FILE_STREAM_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_semaphore.h"
+#include "os_mailbox.h"
+#include "os_time.h"
+#include "os_task_fs.h"
+#include "os_file_stream.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "file_stream"
+
+#define OS_FILE_STREAM_BUFS         2
+#define OS_FILE_STREAM_BUF_UNDEF    -1
+
+//------------------------------------------------------------------------------
+typedef struct {
+    U8*                 data_p;
+    U32                 offset;     // File offset of the buffer data.
+    Size                len;        // Read: valid data length; write: collected data length.
+    Status              status;
+    Bool                is_valid;   // Read data is valid.
+    Bool                is_pending; // Job is submitted and it's completion isn't taken yet.
+    volatile Bool       is_busy;    // Job is in progress.
+    OS_SemaphoreHd      done_shd;
+} OS_FileStreamBuf;
+
+typedef struct {
+    OS_FileHd           fhd;
+    OS_TaskHd           fsd_thd;
+    OS_QueueHd          fsd_qhd;
+    OS_FileStreamBuf    buf_v[OS_FILE_STREAM_BUFS];
+    Size                buf_size;
+    U32                 pos;
+    U32                 seq_end;    // Previous read end.
+    U32                 seq_count;
+    U8                  buf_curr;   // Write buffer.
+    Bool                is_write;
+    OS_FileStreamStats  stats;
+} OS_FileStreamConfigDyn;
+
+/******************************************************************************/
+static Status OS_FileStreamWait(OS_FileStreamConfigDyn* cfg_dyn_p, const U8 idx);
+Status OS_FileStreamWait(OS_FileStreamConfigDyn* cfg_dyn_p, const U8 idx)
+{
+OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[idx];
+    if (OS_TRUE != buf_p->is_pending) { return buf_p->status; }
+    if (OS_TRUE == buf_p->is_busy) {
+        const OS_Tick tick_start = OS_TickCountGet();
+        cfg_dyn_p->stats.stalls++;
+        OS_SemaphoreLock(buf_p->done_shd, OS_BLOCK);
+        cfg_dyn_p->stats.stall_ms += OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    } else {
+        OS_SemaphoreLock(buf_p->done_shd, OS_BLOCK);
+    }
+    buf_p->is_pending = OS_FALSE;
+    return buf_p->status;
+}
+
+/******************************************************************************/
+static Status OS_FileStreamWaitAll(OS_FileStreamConfigDyn* cfg_dyn_p);
+Status OS_FileStreamWaitAll(OS_FileStreamConfigDyn* cfg_dyn_p)
+{
+Status s = S_OK;
+    for (U8 i = 0; i < OS_FILE_STREAM_BUFS; ++i) {
+        const Status s_buf = OS_FileStreamWait(cfg_dyn_p, i);
+        if (S_OK == s) { s = s_buf; }
+    }
+    return s;
+}
+
+/******************************************************************************/
+// Pass the buffer job to the file system daemon or do it here if it isn't possible.
+static void OS_FileStreamSubmit(OS_FileStreamConfigDyn* cfg_dyn_p, const U8 idx, const U32 offset, const Bool is_sync);
+void OS_FileStreamSubmit(OS_FileStreamConfigDyn* cfg_dyn_p, const U8 idx, const U32 offset, const Bool is_sync)
+{
+OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[idx];
+const OS_FileStreamJob job = {
+    .shd        = (OS_FileStreamHd)cfg_dyn_p,
+    .buf_idx    = idx
+};
+    buf_p->offset       = offset;
+    buf_p->is_valid     = OS_FALSE;
+    buf_p->is_pending   = OS_TRUE;
+    buf_p->is_busy      = OS_TRUE;
+    if (OS_TRUE == cfg_dyn_p->is_write) {
+        cfg_dyn_p->stats.flushes++;
+    } else {
+        cfg_dyn_p->stats.prefetches++;
+    }
+    if ((OS_TRUE != is_sync) && (OS_NULL != cfg_dyn_p->fsd_qhd) && (OS_TaskGet() != cfg_dyn_p->fsd_thd)) {
+        const OS_MessageId msg_id = (OS_TRUE == cfg_dyn_p->is_write) ? OS_MSG_FS_STREAM_FLUSH : OS_MSG_FS_STREAM_FILL;
+        OS_Message* msg_p = OS_MessageCreate(msg_id, (OS_MessageData)&job, sizeof(job), OS_NO_BLOCK);
+        if (OS_NULL != msg_p) {
+            IF_OK(OS_MessageSend(cfg_dyn_p->fsd_qhd, msg_p, OS_NO_BLOCK, OS_MSG_PRIO_NORMAL)) { return; }
+            OS_MessageDelete(msg_p);
+        }
+    }
+    // The file is accessed here - the other buffer job should be done.
+    OS_FileStreamWait(cfg_dyn_p, idx ^ 1);
+    OS_FileStreamJobDo(&job);
+}
+
+/******************************************************************************/
+void OS_FileStreamJobDo(const OS_FileStreamJob* job_p)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)job_p->shd;
+OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[job_p->buf_idx];
+Status s = S_OK;
+    if (OS_TRUE == cfg_dyn_p->is_write) {
+        if (0 != buf_p->len) {
+            IF_OK(s = OS_FileLSeek(cfg_dyn_p->fhd, buf_p->offset)) {
+                s = OS_FileWrite(cfg_dyn_p->fhd, buf_p->data_p, buf_p->len);
+            }
+        }
+        buf_p->len = 0;
+    } else {
+        const U32 file_size = OS_FileSizeGet(cfg_dyn_p->fhd);
+        buf_p->len = (buf_p->offset < file_size) ? MIN(cfg_dyn_p->buf_size, file_size - buf_p->offset) : 0;
+        if (0 != buf_p->len) {
+            IF_OK(s = OS_FileLSeek(cfg_dyn_p->fhd, buf_p->offset)) {
+                s = OS_FileRead(cfg_dyn_p->fhd, buf_p->data_p, buf_p->len);
+            }
+        }
+        buf_p->is_valid = (S_OK == s) ? OS_TRUE : OS_FALSE;
+    }
+    buf_p->status  = s;
+    buf_p->is_busy = OS_FALSE;
+    // The stream could be closed right after that.
+    OS_SemaphoreUnlock(buf_p->done_shd);
+}
+
+/******************************************************************************/
+static S8 OS_FileStreamBufLookup(const OS_FileStreamConfigDyn* cfg_dyn_p, const U32 pos);
+S8 OS_FileStreamBufLookup(const OS_FileStreamConfigDyn* cfg_dyn_p, const U32 pos)
+{
+    for (U8 i = 0; i < OS_FILE_STREAM_BUFS; ++i) {
+        const OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[i];
+        if ((OS_TRUE != buf_p->is_pending) && (OS_TRUE != buf_p->is_valid)) { continue; }
+        if ((pos >= buf_p->offset) && (pos < (buf_p->offset + cfg_dyn_p->buf_size))) {
+            return i;
+        }
+    }
+    return OS_FILE_STREAM_BUF_UNDEF;
+}
+
+/******************************************************************************/
+static Status OS_FileStreamWriteOut(OS_FileStreamConfigDyn* cfg_dyn_p);
+Status OS_FileStreamWriteOut(OS_FileStreamConfigDyn* cfg_dyn_p)
+{
+Status s;
+const U8 idx = cfg_dyn_p->buf_curr;
+    IF_STATUS(s = OS_FileStreamWaitAll(cfg_dyn_p)) { return s; }
+    if (0 != cfg_dyn_p->buf_v[idx].len) {
+        OS_FileStreamSubmit(cfg_dyn_p, idx, cfg_dyn_p->buf_v[idx].offset, OS_TRUE);
+        s = OS_FileStreamWait(cfg_dyn_p, idx);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamOpen(OS_FileStreamHd* shd_p, ConstStrP file_path_p, const OS_FileOpenMode op_mode)
+{
+Status s;
+    if ((OS_NULL == shd_p) || (OS_NULL == file_path_p)) { return S_INVALID_PTR; }
+    OS_FileStreamConfigDyn* cfg_dyn_p = OS_Malloc(sizeof(OS_FileStreamConfigDyn));
+    if (OS_NULL == cfg_dyn_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(cfg_dyn_p, 0, sizeof(OS_FileStreamConfigDyn));
+    IF_STATUS(s = OS_FileOpen(&cfg_dyn_p->fhd, file_path_p, op_mode)) {
+        OS_Free(cfg_dyn_p->fhd);
+        cfg_dyn_p->fhd = OS_NULL;
+        goto error;
+    }
+    cfg_dyn_p->is_write = BIT_TEST(op_mode, BIT(OS_FS_FILE_OP_MODE_WRITE)) ? OS_TRUE : OS_FALSE;
+    {
+        // Cluster aligned buffers (the romfs files have no clusters).
+        const Size cluster_size = MAX(cfg_dyn_p->fhd->fs->csize, 1) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+        Size buf_size = cluster_size * OS_FILE_STREAM_CLUSTERS;
+        if (OS_FILE_STREAM_BUF_SIZE_MAX < buf_size) {
+            buf_size = (OS_FILE_STREAM_BUF_SIZE_MAX / cluster_size) * cluster_size;
+            if (0 == buf_size) {
+                buf_size = (OS_FILE_STREAM_BUF_SIZE_MAX / OS_FILE_SYSTEM_SECTOR_SIZE_MAX) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+            }
+        }
+        cfg_dyn_p->buf_size = buf_size;
+        cfg_dyn_p->stats.buf_size = buf_size;
+    }
+    for (U8 i = 0; i < OS_FILE_STREAM_BUFS; ++i) {
+        OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[i];
+        buf_p->data_p = OS_MallocEx(cfg_dyn_p->buf_size, OS_FILE_STREAM_MEM);
+        if (OS_NULL == buf_p->data_p) { s = S_OUT_OF_MEMORY; goto error; }
+        buf_p->done_shd = OS_SemaphoreBinaryCreate();
+        if (OS_NULL == buf_p->done_shd) { s = S_INVALID_PTR; goto error; }
+        buf_p->status = S_OK;
+    }
+    cfg_dyn_p->fsd_thd = OS_TaskByNameGet(OS_DAEMON_NAME_FS);
+    if (OS_NULL != cfg_dyn_p->fsd_thd) {
+        cfg_dyn_p->fsd_qhd = OS_TaskStdInGet(cfg_dyn_p->fsd_thd);
+    }
+    cfg_dyn_p->pos      = OS_FileTell(cfg_dyn_p->fhd);
+    cfg_dyn_p->seq_end  = cfg_dyn_p->pos;
+    *shd_p = (OS_FileStreamHd)cfg_dyn_p;
+    return s;
+error:
+    if (OS_NULL != cfg_dyn_p->fhd) {
+        OS_FileClose(&cfg_dyn_p->fhd);
+    }
+    for (U8 i = 0; i < OS_FILE_STREAM_BUFS; ++i) {
+        OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[i];
+        if (OS_NULL != buf_p->done_shd) {
+            OS_SemaphoreDelete(buf_p->done_shd);
+        }
+        OS_FreeEx(buf_p->data_p, OS_FILE_STREAM_MEM);
+    }
+    OS_Free(cfg_dyn_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamClose(OS_FileStreamHd* shd_p)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p;
+Status s;
+Status s_close;
+    if (OS_NULL == shd_p) { return S_INVALID_PTR; }
+    cfg_dyn_p = (OS_FileStreamConfigDyn*)*shd_p;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    if (OS_TRUE == cfg_dyn_p->is_write) {
+        s = OS_FileStreamWriteOut(cfg_dyn_p);
+    } else {
+        // Prefetch results are not needed.
+        OS_FileStreamWaitAll(cfg_dyn_p);
+        s = S_OK;
+    }
+    OS_LOG(D_DEBUG, "Stream close: buf %u, stalls %u (%u ms)",
+           cfg_dyn_p->buf_size, cfg_dyn_p->stats.stalls, cfg_dyn_p->stats.stall_ms);
+    IF_STATUS(s_close = OS_FileClose(&cfg_dyn_p->fhd)) {
+        if (S_OK == s) { s = s_close; }
+    }
+    for (U8 i = 0; i < OS_FILE_STREAM_BUFS; ++i) {
+        OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[i];
+        OS_SemaphoreDelete(buf_p->done_shd);
+        OS_FreeEx(buf_p->data_p, OS_FILE_STREAM_MEM);
+    }
+    OS_Free(cfg_dyn_p);
+    *shd_p = OS_NULL;
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamRead(const OS_FileStreamHd shd, void* data_in_p, Size size, Size* read_size_p)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)shd;
+U8* data_p = (U8*)data_in_p;
+Size done = 0;
+Status s = S_OK;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+    if (OS_TRUE == cfg_dyn_p->is_write) { return S_INVALID_STATE; }
+    cfg_dyn_p->stats.reads++;
+    if (cfg_dyn_p->pos == cfg_dyn_p->seq_end) {
+        ++cfg_dyn_p->seq_count;
+    } else {
+        cfg_dyn_p->seq_count = 0;
+    }
+    while (done < size) {
+        const S8 idx = OS_FileStreamBufLookup(cfg_dyn_p, cfg_dyn_p->pos);
+        if (OS_FILE_STREAM_BUF_UNDEF == idx) {
+            IF_STATUS(s = OS_FileStreamWaitAll(cfg_dyn_p)) { break; }
+            if (OS_FILE_STREAM_SEQ_THRESHOLD > cfg_dyn_p->seq_count) {
+                // Random access - read the file directly.
+                const U32 file_size = OS_FileSizeGet(cfg_dyn_p->fhd);
+                const Size len = (cfg_dyn_p->pos < file_size) ? MIN(size - done, file_size - cfg_dyn_p->pos) : 0;
+                if (0 == len) { break; }
+                IF_STATUS(s = OS_FileLSeek(cfg_dyn_p->fhd, cfg_dyn_p->pos)) { break; }
+                IF_STATUS(s = OS_FileRead(cfg_dyn_p->fhd, data_p + done, len)) { break; }
+                cfg_dyn_p->stats.direct++;
+                cfg_dyn_p->pos += len;
+                done += len;
+                break;
+            }
+            // Sequential access - prefetch both buffers from the current offset.
+            OS_FileStreamSubmit(cfg_dyn_p, 0, cfg_dyn_p->pos, OS_FALSE);
+            OS_FileStreamSubmit(cfg_dyn_p, 1, cfg_dyn_p->pos + cfg_dyn_p->buf_size, OS_FALSE);
+            continue;
+        }
+        OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[idx];
+        IF_STATUS(s = OS_FileStreamWait(cfg_dyn_p, idx)) { break; }
+        const U32 buf_end = buf_p->offset + buf_p->len;
+        if (cfg_dyn_p->pos >= buf_end) { break; } // End of file.
+        const Size len = MIN(size - done, buf_end - cfg_dyn_p->pos);
+        OS_MemCpy(data_p + done, buf_p->data_p + (cfg_dyn_p->pos - buf_p->offset), len);
+        cfg_dyn_p->pos += len;
+        done += len;
+        if (cfg_dyn_p->pos == (buf_p->offset + cfg_dyn_p->buf_size)) {
+            // The buffer is consumed - prefetch the data next to the other one.
+            OS_FileStreamSubmit(cfg_dyn_p, idx, buf_p->offset + (cfg_dyn_p->buf_size * OS_FILE_STREAM_BUFS), OS_FALSE);
+        }
+    }
+    cfg_dyn_p->seq_end = cfg_dyn_p->pos;
+    if (OS_NULL != read_size_p) {
+        *read_size_p = done;
+    }
+    if (S_OK == s) {
+        if ((0 == done) && (0 != size)) {
+            s = S_FS_EOF;
+        } else if (size != done) {
+            s = S_INVALID_SIZE;
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamWrite(const OS_FileStreamHd shd, const void* data_out_p, Size size)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)shd;
+const U8* data_p = (const U8*)data_out_p;
+Status s = S_OK;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+    if (OS_TRUE != cfg_dyn_p->is_write) { return S_INVALID_STATE; }
+    cfg_dyn_p->stats.writes++;
+    while (0 != size) {
+        const U8 idx = cfg_dyn_p->buf_curr;
+        OS_FileStreamBuf* buf_p = &cfg_dyn_p->buf_v[idx];
+        IF_STATUS(s = OS_FileStreamWait(cfg_dyn_p, idx)) {
+            buf_p->status = S_OK; // Reported once.
+            break;
+        }
+        if (0 == buf_p->len) {
+            buf_p->offset = cfg_dyn_p->pos;
+        }
+        // Blocks are aligned to the buffer size.
+        const Size limit = cfg_dyn_p->buf_size - (buf_p->offset % cfg_dyn_p->buf_size);
+        const Size len = MIN(size, limit - buf_p->len);
+        OS_MemCpy(buf_p->data_p + buf_p->len, data_p, len);
+        buf_p->len += len;
+        cfg_dyn_p->pos += len;
+        data_p += len;
+        size -= len;
+        if (limit == buf_p->len) {
+            OS_FileStreamSubmit(cfg_dyn_p, idx, buf_p->offset, OS_FALSE);
+            cfg_dyn_p->buf_curr = idx ^ 1;
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamSeek(const OS_FileStreamHd shd, const U32 offset)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)shd;
+Status s = S_OK;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    if (OS_TRUE == cfg_dyn_p->is_write) {
+        IF_STATUS(s = OS_FileStreamWriteOut(cfg_dyn_p)) { return s; }
+    }
+    cfg_dyn_p->pos = offset;
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamFlush(const OS_FileStreamHd shd)
+{
+OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)shd;
+Status s = S_OK;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    if (OS_TRUE == cfg_dyn_p->is_write) {
+        IF_OK(s = OS_FileStreamWriteOut(cfg_dyn_p)) {
+            s = OS_FileSync(cfg_dyn_p->fhd);
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileStreamStatsGet(const OS_FileStreamHd shd, OS_FileStreamStats* stats_p)
+{
+const OS_FileStreamConfigDyn* cfg_dyn_p = (OS_FileStreamConfigDyn*)shd;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    OS_MemCpy(stats_p, &cfg_dyn_p->stats, sizeof(cfg_dyn_p->stats));
+    return S_OK;
+}
+
+#endif //(OS_FILE_SYSTEM_ENABLED) && (OS_FILE_STREAM_ENABLED)
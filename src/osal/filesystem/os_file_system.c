@@ -11,10 +11,18 @@
 #include "diskio.h"
 #include "os_debug.h"
 #include "os_memory.h"
+#include "os_supervise.h"
 #include "os_driver.h"
 #include "os_list.h"
 #include "os_time.h"
+#include "os_blk_sched.h"
+#include "os_sec_cache.h"
+#include "os_mailbox.h"
+#include "os_task_fs.h"
 #include "os_file_system.h"
+#include "os_kv.h"
+#include "os_romfs.h"
+#include "os_settings.h"
 
 //-----------------------------------------------------------------------------
 #define MDL_NAME            "file_system"
@@ -27,8 +35,57 @@ typedef struct {
     Str             volume[OS_FILE_SYSTEM_VOLUME_STR_LEN];
     OS_DriverHd     dhd;
     OS_FileSystemHd fshd;
+    OS_FileSystemType type;
 } OS_FileSystemMediaConfigDyn;
 
+// Buffered line reader.
+typedef struct {
+    OS_FileHd       fhd;
+    U32             offset;     // File offset of the buffer start.
+    Size            head;       // Next line start.
+    Size            tail;       // Buffered data end.
+    Size            size;
+    Size            cut;        // The line end replaced by the string end.
+    Str             cut_c;
+    Bool            is_cut;
+    Str             buf[1];     // Buffer (size + 1 for the line end).
+} FLineReader;
+
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+// Directory subtree usage counters.
+typedef struct {
+    OS_FileSystemStats  stats;
+    U32                 hash;       // Absolute path hash.
+    OS_Tick             tick;       // Last access (LRU).
+    U8                  volume;
+    Bool                is_valid;
+} FUsageDir;
+
+// File handle with the usage accounting data.
+typedef struct {
+    FIL                 fil;        // Should be the first member (OS_FileHd).
+    U32                 size;       // Accounted size.
+    U8                  volume;
+    U8                  depth;      // Parents count.
+    U32                 hash_v[OS_FILE_SYSTEM_USAGE_DEPTH_MAX];
+} FFile;
+
+// FSInfo sector layout.
+#define FSI_LEAD_SIG        0
+#define FSI_STRUC_SIG       484
+#define FSI_FREE_COUNT      488
+#define FSI_NXT_FREE        492
+#define FSI_55AA            510
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+// Queued erase range (the sectors are inclusive).
+typedef struct {
+    U32                 start;
+    U32                 end;
+} FEraseRange;
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+
 //------------------------------------------------------------------------------
 //static void FDirTranslate(const DIR* dir_p, OS_DirHd dhd);
 static OS_DateTime  FDateTimeTranslate(const WORD date, const WORD time);
@@ -38,11 +95,51 @@ static DWORD        FDateTimeConvert(const OS_DateTime date_time);
 static BYTE         FAttributesConvert(const OS_FileAttrs attrs);
 static Status       FResultTranslate(const FRESULT r);
 static Status       VolumeCheck(const S8 volume);
+#if (OS_FILE_SYSTEM_FASTSEEK)
+static Status       FLinkMapCreate(const OS_FileHd fhd);
+static U32          FLinkMapRunGet(const DWORD* tbl_p, const U32 cluster_first, const U32 cluster_last);
+static U32          FLinkMapSectorGet(const FATFS* fs_p, const DWORD* tbl_p, const U32 offset, U32* sectors_p);
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+static Status       FDirectTransfer(const OS_FileHd fhd, U8* data_p, const Size size, const Bool is_write);
+static Status       FMediaRegionGet(const FATFS* fs_p, U8** base_pp, U32* size_p);
+static Status       FFatScan(FATFS* fs_p, const U32 run_len, U32* clusters_free_p, U32* run_start_p);
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+static Status       FEraseFlush(const U8 volume);
+static Status       FClustersErase(FATFS* fs_p, const U32 cluster, const U32 clusters, U32* sectors_p);
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+static U8           FUsagePathHash(ConstStrP path_p, U32 hash_v[], U8* volume_p);
+static void         FUsageApply(const U32 hash_v[], const U8 count, const U8 volume,
+                                const S32 files, const S32 dirs, const S32 bytes);
+static void         FUsageUpdate(ConstStrP path_p, const S32 files, const S32 dirs, const S32 bytes);
+static void         FUsageInvalidate(const U8 volume);
+static void         FUsageFileSync(FFile* file_p);
+static Status       FClustersFreeCount(FATFS* fs_p);
+static void         FValidateRequest(const U8 volume);
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 
 //------------------------------------------------------------------------------
 static OS_List os_fs_list;
 static OS_MutexHd os_fs_mutex;
 OS_DriverHd fs_media_dhd_v[OS_FILE_SYSTEM_VOLUMES_MAX];
+#if (OS_BLK_SCHED_ENABLED)
+OS_BlkSchedHd fs_blk_sched_hd_v[OS_FILE_SYSTEM_VOLUMES_MAX];
+#endif //(OS_BLK_SCHED_ENABLED)
+#if (OS_SEC_CACHE_ENABLED)
+OS_SecCacheHd fs_sec_cache_hd_v[OS_FILE_SYSTEM_VOLUMES_MAX];
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+U32 fs_write_gen_v[OS_FILE_SYSTEM_VOLUMES_MAX]; // diskio writes generation.
+static U32 fs_usage_gen_v[OS_FILE_SYSTEM_VOLUMES_MAX]; // Usage changes generation.
+static FUsageDir fs_usage_dirs_v[OS_FILE_SYSTEM_USAGE_DIRS_MAX];
+static OS_MutexHd fs_usage_mutex;
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+static FEraseRange fs_erase_ranges_v[OS_FILE_SYSTEM_VOLUMES_MAX][OS_FILE_SYSTEM_ERASE_RANGES_MAX];
+static U8 fs_erase_count_v[OS_FILE_SYSTEM_VOLUMES_MAX];
+static OS_MutexHd fs_erase_mutex;
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+static OS_FileDirectStats fs_direct_stats;
 
 const StatusItem status_fs_v[] = {
 //file system
@@ -93,6 +190,27 @@ Status s = S_UNDEF;
     OS_ListInit(&os_fs_list);
     if (OS_TRUE != OS_ListIsInitialised(&os_fs_list)) { return S_INVALID_VALUE; }
     OS_MemSet(fs_media_dhd_v, 0, sizeof(fs_media_dhd_v));
+#if (OS_BLK_SCHED_ENABLED)
+    OS_MemSet(fs_blk_sched_hd_v, 0, sizeof(fs_blk_sched_hd_v));
+#endif //(OS_BLK_SCHED_ENABLED)
+#if (OS_SEC_CACHE_ENABLED)
+    OS_MemSet(fs_sec_cache_hd_v, 0, sizeof(fs_sec_cache_hd_v));
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    fs_usage_mutex = OS_MutexCreate();
+    if (OS_NULL == fs_usage_mutex) { return S_INVALID_PTR; }
+    OS_MemSet(fs_write_gen_v, 0, sizeof(fs_write_gen_v));
+    OS_MemSet(fs_usage_gen_v, 0, sizeof(fs_usage_gen_v));
+    OS_MemSet(fs_usage_dirs_v, 0, sizeof(fs_usage_dirs_v));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+    fs_erase_mutex = OS_MutexCreate();
+    if (OS_NULL == fs_erase_mutex) { return S_INVALID_PTR; }
+    OS_MemSet(fs_erase_count_v, 0, sizeof(fs_erase_count_v));
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+#if (OS_KV_ENABLED)
+    IF_STATUS(s = OS_KvInit()) { return s; }
+#endif //(OS_KV_ENABLED)
 s = S_OK;
     return s;
 }
@@ -125,18 +243,50 @@ Status s = S_UNDEF;
         OS_ListItemDelete(item_l_p);
         return S_OUT_OF_MEMORY;
     }
+    // Unmounted (fs_type == 0).
+    OS_MemSet(cfg_dyn_p->fshd, 0, sizeof(FATFS));
     IF_STATUS(s = OS_DriverCreate(cfg_p->drv_cfg_p, &cfg_dyn_p->dhd)) {
         OS_Free(cfg_dyn_p->fshd);
         OS_Free(cfg_dyn_p);
         OS_ListItemDelete(item_l_p);
         return s;
     }
+#if (OS_BLK_SCHED_ENABLED)
+    IF_STATUS(s = OS_BlkSchedCreate(cfg_dyn_p->dhd, &fs_blk_sched_hd_v[cfg_p->volume])) {
+        OS_DriverDelete(cfg_dyn_p->dhd);
+        OS_Free(cfg_dyn_p->fshd);
+        OS_Free(cfg_dyn_p);
+        OS_ListItemDelete(item_l_p);
+        return s;
+    }
+#endif //(OS_BLK_SCHED_ENABLED)
+#if (OS_SEC_CACHE_ENABLED)
+    {
+#if (OS_BLK_SCHED_ENABLED)
+        const OS_BlkSchedHd bshd = fs_blk_sched_hd_v[cfg_p->volume];
+#else
+        const OS_BlkSchedHd bshd = OS_NULL;
+#endif //(OS_BLK_SCHED_ENABLED)
+        IF_STATUS(s = OS_SecCacheCreate(cfg_dyn_p->dhd, bshd, &fs_sec_cache_hd_v[cfg_p->volume])) {
+#if (OS_BLK_SCHED_ENABLED)
+            OS_BlkSchedDelete(fs_blk_sched_hd_v[cfg_p->volume]);
+            fs_blk_sched_hd_v[cfg_p->volume] = OS_NULL;
+#endif //(OS_BLK_SCHED_ENABLED)
+            OS_DriverDelete(cfg_dyn_p->dhd);
+            OS_Free(cfg_dyn_p->fshd);
+            OS_Free(cfg_dyn_p);
+            OS_ListItemDelete(item_l_p);
+            return s;
+        }
+    }
+#endif //(OS_SEC_CACHE_ENABLED)
     fs_media_dhd_v[cfg_p->volume] = cfg_dyn_p->dhd;
     cfg_dyn_p->volume[0]= cfg_p->volume + '0';
     cfg_dyn_p->volume[1]= OS_FILE_SYSTEM_DRV_DELIM;
     cfg_dyn_p->volume[2]= OS_FILE_SYSTEM_DIR_DELIM;
     cfg_dyn_p->volume[3]= '\0'; //EOL
     OS_StrNCpy(cfg_dyn_p->name, (const char*)cfg_p->name, sizeof(cfg_dyn_p->name));
+    cfg_dyn_p->type = cfg_p->type;
     OS_ListItemValueSet(item_l_p, (OS_Value)cfg_dyn_p);
     OS_ListItemOwnerSet(item_l_p, (OS_Owner)cfg_p->volume);
     if (OS_NULL != fs_media_hd_p) {
@@ -149,6 +299,14 @@ Status s = S_UNDEF;
 //error:
     IF_STATUS(s) {
         Status s_drv;
+#if (OS_SEC_CACHE_ENABLED)
+        OS_SecCacheDelete(fs_sec_cache_hd_v[cfg_p->volume]);
+        fs_sec_cache_hd_v[cfg_p->volume] = OS_NULL;
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (OS_BLK_SCHED_ENABLED)
+        OS_BlkSchedDelete(fs_blk_sched_hd_v[cfg_p->volume]);
+        fs_blk_sched_hd_v[cfg_p->volume] = OS_NULL;
+#endif //(OS_BLK_SCHED_ENABLED)
         IF_STATUS(s_drv = OS_DriverDelete(cfg_dyn_p->dhd)) { s = s_drv; }
         OS_Free(cfg_dyn_p->fshd);
         OS_Free(cfg_dyn_p);
@@ -167,6 +325,14 @@ Status s = S_UNDEF;
         OS_FileSystemMediaConfigDyn* cfg_dyn_p = (OS_FileSystemMediaConfigDyn*)OS_ListItemValueGet(item_l_p);
         const U8 volume = (U8)OS_ListItemOwnerGet(item_l_p);
         fs_media_dhd_v[volume] = OS_NULL;
+#if (OS_SEC_CACHE_ENABLED)
+        OS_SecCacheDelete(fs_sec_cache_hd_v[volume]);
+        fs_sec_cache_hd_v[volume] = OS_NULL;
+#endif //(OS_SEC_CACHE_ENABLED)
+#if (OS_BLK_SCHED_ENABLED)
+        OS_BlkSchedDelete(fs_blk_sched_hd_v[volume]);
+        fs_blk_sched_hd_v[volume] = OS_NULL;
+#endif //(OS_BLK_SCHED_ENABLED)
         s = OS_DriverDelete(cfg_dyn_p->dhd);
         OS_Free(cfg_dyn_p->fshd);
         OS_Free(cfg_dyn_p);
@@ -202,6 +368,17 @@ Status s;
     OS_LOG(D_DEBUG, "FS media deinit: %s", OS_FileSystemMediaNameGet(fs_media_hd));
     const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
     const OS_DriverHd drv_media_hd = cfg_dyn_p->dhd;
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    // Write back before the media power down.
+    IF_STATUS(s = OS_FileSystemMediaSync(fs_media_hd)) {
+        OS_LOG_S(D_WARNING, s);
+    }
+#elif (OS_SEC_CACHE_ENABLED)
+    // Write back before the media power down.
+    IF_STATUS(s = OS_SecCacheFlush(OS_FileSystemMediaSecCacheGet(fs_media_hd))) {
+        OS_LOG_S(D_WARNING, s);
+    }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
     IF_STATUS(s = OS_DriverIoCtl(drv_media_hd, DRV_REQ_STD_SYNC, OS_NULL)) {
         OS_LOG_S(D_WARNING, s);
     }
@@ -279,6 +456,9 @@ const BYTE fpart_rule = (OS_FS_PART_RULE_FDISK == part_rule) ? 0 :
     OS_LOG(D_DEBUG, "FS make: %s, rule: %d, size: %u", OS_FileSystemMediaNameGet(fs_media_hd), part_rule, size);
     if (U8_MAX == fpart_rule) { return S_FS_INVALID_PARAMETER; }
     const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    FUsageInvalidate(OS_FileSystemVolumeGet(fs_media_hd));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
     return FResultTranslate(f_mkfs((const char*)cfg_dyn_p->volume, fpart_rule, size));
 }
 #endif // (OS_FILE_SYSTEM_MAKE_ENABLED)
@@ -298,7 +478,29 @@ Status OS_FileSystemMount(const OS_FileSystemMediaHd fs_media_hd, void* args_p)
     if (!BIT_TEST(stats.state, BIT(OS_DRV_STATE_IS_OPEN))) {
         IF_STATUS(s = OS_DriverOpen(cfg_dyn_p->dhd, args_p)) { return s; }
     }
-    return FResultTranslate(f_mount(cfg_dyn_p->fshd, (const char*)cfg_dyn_p->volume, 1));
+#if (OS_ROMFS_ENABLED)
+    if (OS_FS_ROMFS == cfg_dyn_p->type) {
+        return OS_RomFsMount(OS_FileSystemVolumeGet(fs_media_hd), cfg_dyn_p->dhd, cfg_dyn_p->fshd);
+    }
+#endif //(OS_ROMFS_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    FUsageInvalidate(OS_FileSystemVolumeGet(fs_media_hd));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+    IF_STATUS(s = FResultTranslate(f_mount(cfg_dyn_p->fshd, (const char*)cfg_dyn_p->volume, 1))) { return s; }
+#if (OS_SEC_CACHE_ENABLED) && (OS_SEC_CACHE_FAT_WRITE_THROUGH)
+    {
+        const FATFS* fs_p = cfg_dyn_p->fshd;
+        IF_STATUS(s = OS_SecCacheWriteThroughAdd(OS_FileSystemMediaSecCacheGet(fs_media_hd),
+                                                 fs_p->fatbase, fs_p->fsize * fs_p->n_fats)) {
+            OS_LOG_S(D_WARNING, s);
+        }
+    }
+#endif //(OS_SEC_CACHE_ENABLED) && (OS_SEC_CACHE_FAT_WRITE_THROUGH)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    // Free clusters count and the usage counters are validated by the daemon.
+    FValidateRequest(OS_FileSystemVolumeGet(fs_media_hd));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+    return s;
 }
 
 /******************************************************************************/
@@ -309,7 +511,27 @@ Status OS_FileSystemUnMount(const OS_FileSystemMediaHd fs_media_hd)
     const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
     OS_DriverStats stats;
     Status s;
+#if (OS_SETTINGS_ENABLED) && (OS_SETTINGS_CACHE_ENABLED)
+    // The cached changes are written to this media only.
+    IF_STATUS(s = OS_SettingsCacheVolumeRelease(OS_FileSystemVolumeGet(fs_media_hd))) { OS_LOG_S(D_WARNING, s); }
+#endif //(OS_SETTINGS_ENABLED) && (OS_SETTINGS_CACHE_ENABLED)
+#if (OS_ROMFS_ENABLED)
+    if (OS_FS_ROMFS == cfg_dyn_p->type) {
+        IF_STATUS(s = OS_RomFsUnMount(OS_FileSystemVolumeGet(fs_media_hd))) { return s; }
+    } else
+#endif //(OS_ROMFS_ENABLED)
     IF_STATUS(s = FResultTranslate(f_mount(OS_NULL, (const char*)cfg_dyn_p->volume, 1))) { return s; }
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    FUsageInvalidate(OS_FileSystemVolumeGet(fs_media_hd));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+#if (OS_SEC_CACHE_ENABLED)
+    {
+        // Media could be changed before the next mount.
+        const OS_SecCacheHd schd = OS_FileSystemMediaSecCacheGet(fs_media_hd);
+        IF_STATUS(s = OS_SecCacheInvalidate(schd)) { OS_LOG_S(D_WARNING, s); }
+        OS_SecCacheWriteThroughClear(schd);
+    }
+#endif //(OS_SEC_CACHE_ENABLED)
     IF_STATUS(s = OS_DriverStatsGet(cfg_dyn_p->dhd, &stats)) { return s; }
     if (BIT_TEST(stats.state, BIT(OS_DRV_STATE_IS_OPEN))) {
         IF_STATUS(s = OS_DriverClose(cfg_dyn_p->dhd, OS_NULL)) { return s; }
@@ -325,6 +547,26 @@ U8 OS_FileSystemVolumeGet(const OS_FileSystemMediaHd fs_media_hd)
     return (U8)OS_ListItemOwnerGet(item_l_p);
 }
 
+#if (OS_BLK_SCHED_ENABLED)
+/******************************************************************************/
+OS_BlkSchedHd OS_FileSystemMediaBlkSchedGet(const OS_FileSystemMediaHd fs_media_hd)
+{
+const U8 volume = OS_FileSystemVolumeGet(fs_media_hd);
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return OS_NULL; }
+    return fs_blk_sched_hd_v[volume];
+}
+#endif //(OS_BLK_SCHED_ENABLED)
+
+#if (OS_SEC_CACHE_ENABLED)
+/******************************************************************************/
+OS_SecCacheHd OS_FileSystemMediaSecCacheGet(const OS_FileSystemMediaHd fs_media_hd)
+{
+const U8 volume = OS_FileSystemVolumeGet(fs_media_hd);
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return OS_NULL; }
+    return fs_sec_cache_hd_v[volume];
+}
+#endif //(OS_SEC_CACHE_ENABLED)
+
 /******************************************************************************/
 //S8 OS_FileSystemVolumeByNameGet(ConstStrP name_p)
 //{
@@ -369,6 +611,19 @@ Status s = S_UNDEF;
     const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
     FATFS* fs_p = cfg_dyn_p->fshd;
     OS_MemSet(stats_p, 0x0, sizeof(OS_FileSystemVolumeStats));
+#if (OS_ROMFS_ENABLED)
+    if (OS_FS_ROMFS == cfg_dyn_p->type) {
+        OS_RomFsStats romfs_stats;
+        IF_STATUS(s = OS_RomFsStatsGet(OS_FileSystemVolumeGet(fs_media_hd), &romfs_stats)) { return s; }
+        stats_p->media_name_p           = (StrP)cfg_dyn_p->name;
+        stats_p->type                   = OS_FS_ROMFS;
+        stats_p->cluster_size           = OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+        stats_p->clusters_count         = romfs_stats.image_size / OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+        stats_p->root_dir_items_count   = romfs_stats.entries;
+        stats_p->base_data              = romfs_stats.index_size / OS_FILE_SYSTEM_SECTOR_SIZE_MIN;
+        return s;
+    }
+#endif //(OS_ROMFS_ENABLED)
     {
     DWORD clusters_count;
         IF_STATUS(s = FResultTranslate(f_chdrive((const char*)cfg_dyn_p->volume))) { return s; }
@@ -404,6 +659,160 @@ Status OS_FileSystemClustersFreeGet(const OS_FileSystemMediaHd fs_media_hd, cons
     return FResultTranslate(f_getfree((const char*)path_p, (DWORD*)clusters_free_count_p, (FATFS**)&cfg_dyn_p->fshd));
 }
 
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+/******************************************************************************/
+Status OS_FileSystemEraseQueue(const U8 volume, const U32 sector_start, const U32 sector_end)
+{
+FEraseRange* ranges_p;
+U32 start = sector_start;
+U32 end = sector_end;
+Status s = S_OK;
+    if ((OS_FILE_SYSTEM_VOLUMES_MAX <= volume) || (sector_start > sector_end)) { return S_INVALID_VALUE; }
+    IF_STATUS(s = OS_MutexLock(fs_erase_mutex, OS_TIMEOUT_FS)) { return s; }
+    ranges_p = fs_erase_ranges_v[volume];
+    // Merge the adjacent and the overlapped ranges (the merged one is checked again).
+    for (U8 i = 0; i < fs_erase_count_v[volume];) {
+        if ((start <= (ranges_p[i].end + 1)) && (ranges_p[i].start <= (end + 1))) {
+            start = MIN(start, ranges_p[i].start);
+            end   = MAX(end, ranges_p[i].end);
+            ranges_p[i] = ranges_p[--fs_erase_count_v[volume]];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+    if (OS_FILE_SYSTEM_ERASE_RANGES_MAX <= fs_erase_count_v[volume]) {
+        // Called by FatFs before the FAT and the directory are synced - no erase here.
+        // The smallest range is dropped (the not erased free clusters are safe).
+        U8 min_idx = 0;
+        for (U8 i = 1; i < fs_erase_count_v[volume]; ++i) {
+            if ((ranges_p[i].end - ranges_p[i].start) < (ranges_p[min_idx].end - ranges_p[min_idx].start)) {
+                min_idx = i;
+            }
+        }
+        if ((end - start) > (ranges_p[min_idx].end - ranges_p[min_idx].start)) {
+            ranges_p[min_idx].start = start;
+            ranges_p[min_idx].end   = end;
+        }
+    } else {
+        ranges_p[fs_erase_count_v[volume]].start = start;
+        ranges_p[fs_erase_count_v[volume]].end   = end;
+        fs_erase_count_v[volume]++;
+    }
+    OS_MutexUnlock(fs_erase_mutex);
+    return s;
+}
+
+/******************************************************************************/
+void OS_FileSystemEraseClip(const U8 volume, const U32 sector, const U32 count)
+{
+const U32 last = sector + count - 1;
+FEraseRange* ranges_p;
+    // The writes and the queue are under the volume lock.
+    if ((0 == count) || (0 == fs_erase_count_v[volume])) { return; }
+    IF_STATUS(OS_MutexLock(fs_erase_mutex, OS_TIMEOUT_FS)) {
+        // Nothing is erased rather than the written data.
+        fs_erase_count_v[volume] = 0;
+        return;
+    }
+    ranges_p = fs_erase_ranges_v[volume];
+    for (U8 i = 0; i < fs_erase_count_v[volume];) {
+        FEraseRange* range_p = &ranges_p[i];
+        if ((sector > range_p->end) || (last < range_p->start)) { ++i; continue; }
+        const Bool is_head = (range_p->start < sector) ? OS_TRUE : OS_FALSE;
+        const Bool is_tail = (range_p->end > last) ? OS_TRUE : OS_FALSE;
+        if ((OS_TRUE == is_head) && (OS_TRUE == is_tail)) {
+            // The tail takes a free slot (or isn't erased).
+            if (OS_FILE_SYSTEM_ERASE_RANGES_MAX > fs_erase_count_v[volume]) {
+                ranges_p[fs_erase_count_v[volume]].start = last + 1;
+                ranges_p[fs_erase_count_v[volume]].end   = range_p->end;
+                fs_erase_count_v[volume]++;
+            }
+            range_p->end = sector - 1;
+        } else if (OS_TRUE == is_head) {
+            range_p->end = sector - 1;
+        } else if (OS_TRUE == is_tail) {
+            range_p->start = last + 1;
+        } else {
+            *range_p = ranges_p[--fs_erase_count_v[volume]];
+            continue;
+        }
+        ++i;
+    }
+    OS_MutexUnlock(fs_erase_mutex);
+}
+
+/******************************************************************************/
+Status OS_FileSystemEraseFlush(const U8 volume)
+{
+Status s;
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return S_INVALID_VALUE; }
+    if (0 == fs_erase_count_v[volume]) { return S_OK; }
+    IF_STATUS(s = OS_MutexLock(fs_erase_mutex, OS_TIMEOUT_FS)) { return s; }
+    s = FEraseFlush(volume);
+    OS_MutexUnlock(fs_erase_mutex);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileSystemTrim(const OS_FileSystemMediaHd fs_media_hd, U32* sectors_p)
+{
+DWORD clusters_free;
+BYTE* buf_p;
+Status s;
+    OS_ASSERT_VALUE(OS_NULL != fs_media_hd);
+    if (OS_NULL == sectors_p) { return S_INVALID_PTR; }
+    OS_LOG(D_DEBUG, "FS trim: %s", OS_FileSystemMediaNameGet(fs_media_hd));
+    const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
+    FATFS* fs_p = cfg_dyn_p->fshd;
+    *sectors_p = 0;
+#if (OS_ROMFS_ENABLED)
+    if (OS_FS_ROMFS == cfg_dyn_p->type) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
+    // The volume is mounted by the first access.
+    IF_STATUS(s = FResultTranslate(f_getfree((const char*)cfg_dyn_p->volume, &clusters_free, &fs_p))) { return s; }
+    if (FS_FAT12 == fs_p->fs_type) { return S_FS_INVALID_PARAMETER; }
+    const U32 entry_size = (FS_FAT32 == fs_p->fs_type) ? 4 : 2;
+    const U32 fat_sectors = (fs_p->n_fatent * entry_size + OS_FILE_SYSTEM_SECTOR_SIZE_MAX - 1) / OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+    U32 cluster = 0;
+    U32 run = 0;
+    U32 run_cluster = 0;
+    buf_p = (BYTE*)OS_Malloc(OS_FILE_SYSTEM_FAT_SCAN_SECTORS * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+    if (OS_NULL == buf_p) { return S_OUT_OF_MEMORY; }
+    if (!ff_req_grant(fs_p->sobj)) {
+        OS_Free(buf_p);
+        return S_FS_TIMEOUT;
+    }
+    // The deleted files data in the sector cache shouldn't be written over the erased runs.
+    if (RES_OK != disk_ioctl(fs_p->drv, CTRL_SYNC, OS_NULL)) { s = S_FS_MEDIA_FAULT; }
+    for (U32 sector = 0; (S_OK == s) && (sector < fat_sectors); sector += OS_FILE_SYSTEM_FAT_SCAN_SECTORS) {
+        const U32 count = MIN(OS_FILE_SYSTEM_FAT_SCAN_SECTORS, fat_sectors - sector);
+        if (RES_OK != disk_read(fs_p->drv, buf_p, fs_p->fatbase + sector, count)) { s = S_FS_MEDIA_FAULT; break; }
+        // The FatFs window has the last FAT sector version.
+        if ((fs_p->winsect >= (fs_p->fatbase + sector)) && (fs_p->winsect < (fs_p->fatbase + sector + count))) {
+            OS_MemCpy(buf_p + (fs_p->winsect - fs_p->fatbase - sector) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX,
+                      fs_p->win, OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+        }
+        for (U32 i = 0; (i < (count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX)) && (cluster < fs_p->n_fatent); i += entry_size, ++cluster) {
+            if (2 > cluster) { continue; }
+            const U32 entry = (4 == entry_size) ? (LD_DWORD(buf_p + i) & 0x0FFFFFFF) : LD_WORD(buf_p + i);
+            if (0 == entry) {
+                if (0 == run++) { run_cluster = cluster; }
+            } else if (0 != run) {
+                IF_STATUS(s = FClustersErase(fs_p, run_cluster, run, sectors_p)) { break; }
+                run = 0;
+            }
+        }
+    }
+    if ((S_OK == s) && (0 != run)) {
+        s = FClustersErase(fs_p, run_cluster, run, sectors_p);
+    }
+    ff_rel_grant(fs_p->sobj);
+    OS_Free(buf_p);
+    return s;
+}
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+
 /******************************************************************************/
 Status OS_FileSystemVolumeScan(const StrP path_p, OS_FileSystemStats* stats_p)
 {
@@ -431,7 +840,8 @@ Status s = S_UNDEF;
 #endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
         if (BIT_TEST(stats_file.attrs, BIT(OS_FS_FILE_ATTR_DIR))) {
             // Guard relative directories.
-            if (OS_NULL != OS_StrChr((const char*)file_name_p, '.')) { continue; }
+            if (('.' == file_name_p[0]) &&
+                (('\0' == file_name_p[1]) || (('.' == file_name_p[1]) && ('\0' == file_name_p[2])))) { continue; }
             stats_p->dirs_count++;
             *(path_p + path_len) = OS_FILE_SYSTEM_DIR_DELIM;
             OS_StrCpy((char*)(path_p + path_len + 1), (const char*)file_name_p);
@@ -451,6 +861,125 @@ error:
     return s;
 }
 
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+/******************************************************************************/
+Status OS_FileSystemUsageGet(ConstStrP path_p, OS_FileSystemStats* stats_p)
+{
+U32 hash_v[OS_FILE_SYSTEM_USAGE_DEPTH_MAX];
+U32 hash = 0;
+U32 gen = 0;
+U8 volume;
+StrP scan_path_p;
+Status s;
+    if ((OS_NULL == path_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    const U8 depth = FUsagePathHash(path_p, hash_v, &volume);
+    // Deeper directories aren't cached.
+    const Bool is_cached = ((0 < depth) && (OS_FILE_SYSTEM_USAGE_DEPTH_MAX >= depth));
+    if (OS_TRUE == is_cached) {
+        hash = hash_v[depth - 1];
+        IF_STATUS(s = OS_MutexLock(fs_usage_mutex, OS_TIMEOUT_FS)) { return s; }
+        for (U8 i = 0; i < OS_FILE_SYSTEM_USAGE_DIRS_MAX; ++i) {
+            FUsageDir* dir_p = &fs_usage_dirs_v[i];
+            if ((OS_TRUE == dir_p->is_valid) && (volume == dir_p->volume) && (hash == dir_p->hash)) {
+                dir_p->tick = OS_TickCountGet();
+                *stats_p = dir_p->stats;
+                OS_MutexUnlock(fs_usage_mutex);
+                return S_OK;
+            }
+        }
+        gen = fs_usage_gen_v[volume];
+        OS_MutexUnlock(fs_usage_mutex);
+    }
+    OS_LOG(D_DEBUG, "FS usage scan: %s", path_p);
+    scan_path_p = (StrP)OS_Malloc(OS_FILE_SYSTEM_LONG_NAMES_LEN * 2);
+    if (OS_NULL == scan_path_p) { return S_OUT_OF_MEMORY; }
+    OS_StrNCpy((char*)scan_path_p, (const char*)path_p, OS_FILE_SYSTEM_LONG_NAMES_LEN);
+    scan_path_p[OS_FILE_SYSTEM_LONG_NAMES_LEN] = '\0'; //EOL
+    OS_MemSet(stats_p, 0, sizeof(OS_FileSystemStats));
+    s = OS_FileSystemVolumeScan(scan_path_p, stats_p);
+    OS_Free(scan_path_p);
+    if ((S_OK == s) && (OS_TRUE == is_cached)) {
+        IF_OK(OS_MutexLock(fs_usage_mutex, OS_TIMEOUT_FS)) {
+            // The scan result is dropped if the volume was changed meanwhile.
+            if (gen == fs_usage_gen_v[volume]) {
+                FUsageDir* dir_p = &fs_usage_dirs_v[0];
+                for (U8 i = 1; (OS_TRUE == dir_p->is_valid) && (i < OS_FILE_SYSTEM_USAGE_DIRS_MAX); ++i) {
+                    FUsageDir* dir_next_p = &fs_usage_dirs_v[i];
+                    if ((OS_TRUE != dir_next_p->is_valid) || (dir_next_p->tick < dir_p->tick)) {
+                        dir_p = dir_next_p;
+                    }
+                }
+                dir_p->stats    = *stats_p;
+                dir_p->hash     = hash;
+                dir_p->volume   = volume;
+                dir_p->tick     = OS_TickCountGet();
+                dir_p->is_valid = OS_TRUE;
+            }
+            OS_MutexUnlock(fs_usage_mutex);
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileSystemMediaValidate(const OS_FileSystemMediaHd fs_media_hd)
+{
+Str root_path[OS_FILE_SYSTEM_VOLUME_STR_LEN];
+OS_FileSystemStats stats;
+Status s = S_UNDEF;
+    OS_ASSERT_VALUE(OS_NULL != fs_media_hd);
+    OS_LOG(D_DEBUG, "FS validate: %s", OS_FileSystemMediaNameGet(fs_media_hd));
+    const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
+    FATFS* fs_p = cfg_dyn_p->fshd;
+    if (0 == fs_p->fs_type) { return S_FS_UNMOUNTED; }
+    for (U8 i = 0; i < OS_FILE_SYSTEM_USAGE_RETRIES; ++i) {
+        if (S_BUSY != (s = FClustersFreeCount(fs_p))) { break; }
+        OS_TaskDelay(OS_FILE_SYSTEM_USAGE_RETRY_MS);
+    }
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+    FUsageInvalidate(OS_FileSystemVolumeGet(fs_media_hd));
+    OS_StrNCpy((char*)root_path, (const char*)cfg_dyn_p->volume, sizeof(root_path));
+    IF_STATUS(s = OS_FileSystemUsageGet(root_path, &stats)) { OS_LOG_S(D_WARNING, s); }
+    return OS_FileSystemMediaSync(fs_media_hd);
+}
+
+/******************************************************************************/
+Status OS_FileSystemMediaSync(const OS_FileSystemMediaHd fs_media_hd)
+{
+Status s = S_OK;
+    OS_ASSERT_VALUE(OS_NULL != fs_media_hd);
+    const OS_FileSystemMediaConfigDyn* cfg_dyn_p = OS_FileSystemMediaConfigDynGet(fs_media_hd);
+    FATFS* fs_p = cfg_dyn_p->fshd;
+    // FatFs writes FSInfo on the file sync only; the volume could have no opened files.
+    if ((FS_FAT32 == fs_p->fs_type) && (1 == fs_p->fsi_flag)) {
+        BYTE* fsi_p = (BYTE*)OS_Malloc(OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+        if (OS_NULL == fsi_p) { return S_OUT_OF_MEMORY; }
+        if (ff_req_grant(fs_p->sobj)) {
+            OS_MemSet(fsi_p, 0, OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+            ST_DWORD(fsi_p + FSI_LEAD_SIG,   0x41615252);
+            ST_DWORD(fsi_p + FSI_STRUC_SIG,  0x61417272);
+            ST_DWORD(fsi_p + FSI_FREE_COUNT, fs_p->free_clust);
+            ST_DWORD(fsi_p + FSI_NXT_FREE,   fs_p->last_clust);
+            ST_WORD( fsi_p + FSI_55AA,       0xAA55);
+            if (RES_OK == disk_write(fs_p->drv, fsi_p, fs_p->volbase + 1, 1)) {
+                fs_p->fsi_flag = 0;
+            } else {
+                s = S_FS_MEDIA_FAULT;
+            }
+            ff_rel_grant(fs_p->sobj);
+        } else {
+            s = S_FS_TIMEOUT;
+        }
+        OS_Free(fsi_p);
+        IF_STATUS(s) { return s; }
+    }
+    if (RES_OK != disk_ioctl(OS_FileSystemVolumeGet(fs_media_hd), CTRL_SYNC, OS_NULL)) {
+        s = S_FS_MEDIA_FAULT;
+    }
+    return s;
+}
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+
 /******************************************************************************/
 Status OS_FileCreate(OS_FileHd*fhd_p, ConstStrP file_path_p, const OS_FileOpenMode op_mode)
 {
@@ -464,19 +993,95 @@ OS_FileOpenMode op_mode_create = op_mode;
 Status OS_FileDelete(ConstStrP file_path_p)
 {
     OS_LOG(D_DEBUG, "File delete: %s", file_path_p);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(file_path_p)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    {
+    FILINFO file_info;
+    Status s;
+#if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
+        file_info.lfname = OS_NULL;
+        file_info.lfsize = 0;
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+        IF_STATUS(s = FResultTranslate(f_stat((const char*)file_path_p, &file_info))) { return s; }
+        IF_OK(s = FResultTranslate(f_unlink((const char*)file_path_p))) {
+            if (BIT_TEST(file_info.fattrib, AM_DIR)) {
+                FUsageUpdate(file_path_p, 0, -1, 0);
+            } else {
+                FUsageUpdate(file_path_p, -1, 0, -(S32)file_info.fsize);
+            }
+        }
+        return s;
+    }
+#else
     return FResultTranslate(f_unlink((const char*)file_path_p));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 }
 
 /******************************************************************************/
 Status OS_FileOpen(OS_FileHd*fhd_p, ConstStrP file_path_p, const OS_FileOpenMode op_mode)
 {
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+*fhd_p = OS_Malloc(sizeof(FFile));
+Bool is_new = BIT_TEST(op_mode, (OS_FileOpenMode)BIT(OS_FS_FILE_OP_MODE_CREATE_NEW)) ? OS_TRUE : OS_FALSE;
+U32 size_old = 0;
+#else
 *fhd_p = OS_Malloc(sizeof(FIL));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 const OS_FileHd fhd = *fhd_p;
 Status s;
     if (OS_NULL == fhd) { return S_OUT_OF_MEMORY; }
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    fhd->cltbl = OS_NULL;
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(file_path_p)) {
+        s = OS_RomFsFileOpen(fhd, file_path_p, op_mode);
+        OS_LOG(D_DEBUG, "File open : 0x%X %s", fhd, file_path_p);
+        IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+        return s;
+    }
+#endif //(OS_ROMFS_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    // The file could be created or truncated by the open.
+    if (BIT_TEST(op_mode, (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_OPEN_NEW)))) {
+        FILINFO file_info;
+#if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
+        file_info.lfname = OS_NULL;
+        file_info.lfsize = 0;
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+        const FRESULT r = f_stat((const char*)file_path_p, &file_info);
+        if (FR_NO_FILE == r) {
+            is_new = OS_TRUE;
+        } else if (FR_OK == r) {
+            size_old = file_info.fsize;
+        }
+    }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
     s = FResultTranslate(f_open(fhd, (const char*)file_path_p, FOpenModeConvert(op_mode)));
     OS_LOG(D_DEBUG, "File open : 0x%X %s", fhd, file_path_p);
-    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); return s; }
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    {
+        FFile* file_p = (FFile*)fhd;
+        const U8 depth = FUsagePathHash(file_path_p, file_p->hash_v, &file_p->volume);
+        // The counters follow the directory entry size.
+        file_p->size = f_size(fhd);
+        file_p->depth = (0 < depth) ? MIN(depth - 1, OS_FILE_SYSTEM_USAGE_DEPTH_MAX) : 0;
+        if (OS_TRUE == is_new) {
+            FUsageApply(file_p->hash_v, file_p->depth, file_p->volume, 1, 0, (S32)file_p->size);
+        } else if (file_p->size != size_old) {
+            FUsageApply(file_p->hash_v, file_p->depth, file_p->volume, 0, 0, (S32)(file_p->size - size_old));
+        }
+    }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    if (BIT_TEST(op_mode, (OS_FileOpenMode)BIT(OS_FS_FILE_OP_MODE_FAST_SEEK))) {
+        // The file is still usable without the map.
+        IF_STATUS(FLinkMapCreate(fhd)) { OS_LOG(D_WARNING, "Fast seek map fail: %s", file_path_p); }
+    }
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
     return s;
 }
 
@@ -484,8 +1089,23 @@ Status s;
 Status OS_FileClose(OS_FileHd* fhd_p)
 {
 const OS_FileHd fhd = *fhd_p;
+Status s;
     OS_LOG(D_DEBUG, "File close: 0x%X", fhd);
-Status s = FResultTranslate(f_close(fhd));
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) {
+        s = OS_RomFsFileClose(fhd);
+        OS_Free(fhd);
+        *fhd_p = OS_NULL;
+        return s;
+    }
+#endif //(OS_ROMFS_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    FUsageFileSync((FFile*)fhd);
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+    s = FResultTranslate(f_close(fhd));
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    OS_FreeEx(fhd->cltbl, OS_FILE_SYSTEM_FASTSEEK_MEM);
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
     OS_Free(fhd);
     *fhd_p = OS_NULL;
     return s;
@@ -495,8 +1115,14 @@ Status s = FResultTranslate(f_close(fhd));
 Status OS_FileRead(const OS_FileHd fhd, void* data_in_p, Size size)
 {
 UInt bytes_read;
+Status s;
     OS_LOG(D_DEBUG, "File read: 0x%X", fhd);
-Status s = FResultTranslate(f_read(fhd, data_in_p, size, &bytes_read));
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) {
+        s = OS_RomFsFileRead(fhd, data_in_p, size, &bytes_read);
+    } else
+#endif //(OS_ROMFS_ENABLED)
+    s = FResultTranslate(f_read(fhd, data_in_p, size, &bytes_read));
     if (0 == bytes_read) {
         s = S_FS_EOF;
     } else if (size != bytes_read) {
@@ -510,6 +1136,9 @@ Status OS_FileWrite(const OS_FileHd fhd, void* data_out_p, Size size)
 {
 UInt bytes_written;
     OS_LOG(D_DEBUG, "File write: 0x%X", fhd);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
 Status s = FResultTranslate(f_write(fhd, data_out_p, size, &bytes_written));
     if (bytes_written != size) {
         s = S_INVALID_SIZE;
@@ -517,11 +1146,99 @@ Status s = FResultTranslate(f_write(fhd, data_out_p, size, &bytes_written));
     return s;
 }
 
+/******************************************************************************/
+Status OS_FileReadDirect(const OS_FileHd fhd, void* data_in_p, const Size size)
+{
+    OS_LOG(D_DEBUG, "File read direct: 0x%X", fhd);
+    return FDirectTransfer(fhd, (U8*)data_in_p, size, OS_FALSE);
+}
+
+/******************************************************************************/
+Status OS_FileWriteDirect(const OS_FileHd fhd, void* data_out_p, const Size size)
+{
+    OS_LOG(D_DEBUG, "File write direct: 0x%X", fhd);
+    return FDirectTransfer(fhd, (U8*)data_out_p, size, OS_TRUE);
+}
+
+/******************************************************************************/
+Status OS_FileDirectStatsGet(OS_FileDirectStats* stats_p)
+{
+    if (OS_NULL == stats_p) { return S_INVALID_PTR; }
+    OS_CriticalSectionEnter(); {
+        *stats_p = fs_direct_stats;
+    }
+    OS_CriticalSectionExit();
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_FileExtentGet(const OS_FileHd fhd, U32* sector_p, U32* sectors_p)
+{
+#if (OS_FILE_SYSTEM_FASTSEEK)
+FATFS* fs_p;
+Status s = S_OK;
+    if ((OS_NULL == fhd) || (OS_NULL == sector_p) || (OS_NULL == sectors_p)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return S_UNSUPPORTED; }
+#endif //(OS_ROMFS_ENABLED)
+    fs_p = fhd->fs;
+    if (OS_NULL == fs_p) { return S_FS_OBJECT_INVALID; }
+    if (0 == f_size(fhd)) { return S_INVALID_SIZE; }
+    const Bool is_map_temp = (OS_NULL == fhd->cltbl) ? OS_TRUE : OS_FALSE;
+    if (OS_TRUE == is_map_temp) {
+        const U32 offset = f_tell(fhd);
+        IF_STATUS(s = FLinkMapCreate(fhd)) { return s; }
+        // Keep the file pointer.
+        s = FResultTranslate(f_lseek(fhd, offset));
+    }
+    IF_OK(s) {
+        *sector_p = FLinkMapSectorGet(fs_p, fhd->cltbl, 0, sectors_p);
+        if (0 == *sectors_p) { s = S_FS_OBJECT_INVALID; }
+    }
+    if (OS_TRUE == is_map_temp) {
+        OS_FreeEx(fhd->cltbl, OS_FILE_SYSTEM_FASTSEEK_MEM);
+        fhd->cltbl = OS_NULL;
+    }
+    return s;
+#else
+    return S_UNSUPPORTED;
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+}
+
 /******************************************************************************/
 Status OS_FileRename(ConstStrP name_old_p, ConstStrP name_new_p)
 {
     OS_LOG(D_DEBUG, "File rename: %s -> %s", name_old_p, name_new_p);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(name_old_p)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    {
+    FILINFO file_info;
+    Status s;
+#if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
+        file_info.lfname = OS_NULL;
+        file_info.lfsize = 0;
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+        IF_STATUS(s = FResultTranslate(f_stat((const char*)name_old_p, &file_info))) { return s; }
+        IF_OK(s = FResultTranslate(f_rename((const char*)name_old_p, (const char*)name_new_p))) {
+            if (BIT_TEST(file_info.fattrib, AM_DIR)) {
+                // The subtree usage is unknown here.
+                U32 hash_v[OS_FILE_SYSTEM_USAGE_DEPTH_MAX];
+                U8 volume;
+                if (0 < FUsagePathHash(name_old_p, hash_v, &volume)) {
+                    FUsageInvalidate(volume);
+                }
+            } else {
+                FUsageUpdate(name_old_p, -1, 0, -(S32)file_info.fsize);
+                FUsageUpdate(name_new_p,  1, 0,  (S32)file_info.fsize);
+            }
+        }
+        return s;
+    }
+#else
     return FResultTranslate(f_rename((const char*)name_old_p, (const char*)name_new_p));
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 }
 
 /******************************************************************************/
@@ -533,6 +1250,9 @@ const DWORD fattime = FDateTimeConvert(date_time);
     file_info.fdate = (fattime >> 16) & 0xFFFF;
     file_info.ftime = fattime & 0xFFFF;
     OS_LOG(D_DEBUG, "File date/time set: %s", file_path_p);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(file_path_p)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
     return FResultTranslate(f_utime((const char*)file_path_p, &file_info));
 }
 
@@ -540,12 +1260,41 @@ const DWORD fattime = FDateTimeConvert(date_time);
 Status OS_FileAttributesSet(ConstStrP file_path_p, const OS_FileAttrs attrs)
 {
     OS_LOG(D_DEBUG, "File attrs set: %s", file_path_p);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(file_path_p)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
     return FResultTranslate(f_chmod((const char*)file_path_p, FAttributesConvert(attrs), (BYTE)~0U));
 }
 
+/******************************************************************************/
+Status OS_FileStatsGet(ConstStrP file_path_p, OS_FileStats* file_stats_p)
+{
+FILINFO file_info;
+    OS_LOG(D_DEBUG, "File stats get: %s", file_path_p);
+    if ((OS_NULL == file_path_p) || (OS_NULL == file_stats_p)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(file_path_p)) { return OS_RomFsFileStatsGet(file_path_p, file_stats_p); }
+#endif //(OS_ROMFS_ENABLED)
+#if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
+    file_info.lfname = (char*)file_stats_p->long_name_p;
+    file_info.lfsize = file_stats_p->long_name_size;
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    Status s = FResultTranslate(f_stat((const char*)file_path_p, &file_info));
+    IF_OK(s) {
+        OS_MemCpy(file_stats_p->name, file_info.fname, sizeof(file_stats_p->name));
+        file_stats_p->size          = file_info.fsize;
+        file_stats_p->date_time     = FDateTimeTranslate(file_info.fdate, file_info.ftime);
+        file_stats_p->attrs         = FAttributeTranslate(file_info.fattrib);
+    }
+    return s;
+}
+
 /******************************************************************************/
 Status OS_FileGetS(const OS_FileHd fhd, StrP str_p, U32 len)
 {
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return OS_RomFsFileGetS(fhd, str_p, len); }
+#endif //(OS_ROMFS_ENABLED)
     if (str_p != (StrP)f_gets((char*)str_p, len, fhd)) {
         if (f_eof(fhd)) {
             return S_FS_EOF;
@@ -558,6 +1307,243 @@ Status OS_FileGetS(const OS_FileHd fhd, StrP str_p, U32 len)
     return S_OK;
 }
 
+/******************************************************************************/
+Status OS_FileMap(const OS_FileHd fhd, const U32 offset, const Size size, const void** data_pp)
+{
+FATFS* fs_p;
+U8* base_p;
+U32 region_size;
+Status s;
+    OS_LOG(D_DEBUG, "File map: 0x%X %u %u", fhd, offset, size);
+    if ((OS_NULL == fhd) || (OS_NULL == data_pp)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return OS_RomFsFileMap(fhd, offset, size, data_pp); }
+#endif //(OS_ROMFS_ENABLED)
+    fs_p = fhd->fs;
+    if (OS_NULL == fs_p) { return S_FS_OBJECT_INVALID; }
+    if ((0 == size) || (offset > f_size(fhd)) || (size > (f_size(fhd) - offset))) { return S_INVALID_SIZE; }
+    IF_STATUS(s = FMediaRegionGet(fs_p, &base_p, &region_size)) { return s; }
+    // The media memory should have the file data (FatFs and the sector cache buffers are written back).
+    if (fhd->flag & FA_WRITE) {
+        IF_STATUS(s = OS_FileSync(fhd)) { return s; }
+    }
+    if (RES_OK != disk_ioctl(fs_p->drv, CTRL_SYNC, OS_NULL)) { return S_FS_MEDIA_FAULT; }
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    {
+        const U32 cluster_size = fs_p->csize * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+        const Bool is_map_temp = (OS_NULL == fhd->cltbl) ? OS_TRUE : OS_FALSE;
+        U32 cluster = 0;
+        // The temporary link map isn't kept: it blocks the file expansion.
+        if ((OS_FALSE == is_map_temp) || (S_OK == FLinkMapCreate(fhd))) {
+            cluster = FLinkMapRunGet(fhd->cltbl, offset / cluster_size, (offset + size - 1) / cluster_size);
+            if (OS_TRUE == is_map_temp) {
+                OS_FreeEx(fhd->cltbl, OS_FILE_SYSTEM_FASTSEEK_MEM);
+                fhd->cltbl = OS_NULL;
+            }
+        }
+        if (0 != cluster) {
+            const U32 address = (fs_p->database + (cluster - 2) * fs_p->csize) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX +
+                                (offset % cluster_size);
+            if ((address < region_size) && (size <= (region_size - address))) {
+                *data_pp = (const void*)(base_p + address);
+                return S_OK;
+            }
+        }
+    }
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+    // The region is fragmented - read it to the bounce buffer.
+    OS_LOG(D_DEBUG, "File map bounce: 0x%X", fhd);
+    void* data_p = OS_Malloc(size);
+    if (OS_NULL == data_p) { return S_OUT_OF_MEMORY; }
+    const U32 offset_old = f_tell(fhd);
+    UInt bytes_read = 0;
+    IF_OK(s = FResultTranslate(f_lseek(fhd, offset))) {
+        IF_OK(s = FResultTranslate(f_read(fhd, data_p, size, &bytes_read))) {
+            if (size != bytes_read) { s = S_FS_EOF; }
+        }
+    }
+    const Status s_seek = FResultTranslate(f_lseek(fhd, offset_old));
+    IF_OK(s) { s = s_seek; }
+    IF_STATUS(s) {
+        OS_Free(data_p);
+        return s;
+    }
+    *data_pp = (const void*)data_p;
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_FileUnmap(const OS_FileHd fhd, const void* data_p)
+{
+U8* base_p;
+U32 region_size;
+    OS_LOG(D_DEBUG, "File unmap: 0x%X", fhd);
+    if ((OS_NULL == fhd) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    // The mapped regions are the image memory.
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return S_OK; }
+#endif //(OS_ROMFS_ENABLED)
+    if (OS_NULL == fhd->fs) { return S_FS_OBJECT_INVALID; }
+    IF_OK(FMediaRegionGet(fhd->fs, &base_p, &region_size)) {
+        if (((const U8*)data_p >= base_p) && ((const U8*)data_p < (base_p + region_size))) { return S_OK; }
+    }
+    // The bounce buffer.
+    OS_Free((void*)data_p);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_FileLineReaderCreate(const OS_FileHd fhd, const Size buf_size, OS_FileLineReaderHd* lrhd_p)
+{
+const Size size = (0 != buf_size) ? buf_size : OS_FILE_SYSTEM_LINE_BUF_SIZE;
+    if ((OS_NULL == fhd) || (OS_NULL == lrhd_p)) { return S_INVALID_PTR; }
+    FLineReader* reader_p = (FLineReader*)OS_Malloc(sizeof(FLineReader) + size);
+    if (OS_NULL == reader_p) { return S_OUT_OF_MEMORY; }
+    reader_p->fhd   = fhd;
+    reader_p->offset= f_tell(fhd);
+    reader_p->head  = 0;
+    reader_p->tail  = 0;
+    reader_p->size  = size;
+    reader_p->is_cut= OS_FALSE;
+    *lrhd_p = (OS_FileLineReaderHd)reader_p;
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_FileLineReaderDelete(const OS_FileLineReaderHd lrhd)
+{
+    if (OS_NULL == lrhd) { return S_INVALID_PTR; }
+    OS_Free(lrhd);
+    return S_OK;
+}
+
+/******************************************************************************/
+static Status FLineFind(FLineReader* reader_p, const Size len_max, Size* len_p);
+Status FLineFind(FLineReader* reader_p, const Size len_max, Size* len_p)
+{
+    if (OS_TRUE == reader_p->is_cut) {
+        // Restore the previous line end (the offset could be set back).
+        reader_p->buf[reader_p->cut] = reader_p->cut_c;
+        reader_p->is_cut = OS_FALSE;
+    }
+    for (;;) {
+        const Size len = MIN(reader_p->tail - reader_p->head, len_max);
+        // memchr() is word-wise in the C library.
+        const Str* eol_p = (const Str*)OS_MemChr(&reader_p->buf[reader_p->head], '\n', len);
+        if (OS_NULL != eol_p) {
+            *len_p = (Size)(eol_p - &reader_p->buf[reader_p->head]) + 1;
+            return S_OK;
+        }
+        if (len == len_max) {
+            // The line is longer than the requested length - return the part.
+            *len_p = len;
+            return S_OK;
+        }
+        // Move the line start to the buffer start and refill.
+        if (0 != reader_p->head) {
+            OS_MemMov(&reader_p->buf[0], &reader_p->buf[reader_p->head], reader_p->tail - reader_p->head);
+            reader_p->offset+= reader_p->head;
+            reader_p->tail  -= reader_p->head;
+            reader_p->head   = 0;
+        }
+        if (reader_p->tail == reader_p->size) {
+            // The line is longer than the buffer - return the part.
+            *len_p = MIN(reader_p->tail, len_max);
+            return S_OK;
+        }
+        UInt bytes_read;
+        Status s;
+#if (OS_ROMFS_ENABLED)
+        // The romfs handle isn't FatFs one.
+        if (OS_TRUE == OS_RomFsFileIs(reader_p->fhd)) {
+            s = OS_RomFsFileRead(reader_p->fhd, &reader_p->buf[reader_p->tail],
+                                 reader_p->size - reader_p->tail, &bytes_read);
+        } else
+#endif //(OS_ROMFS_ENABLED)
+        s = FResultTranslate(f_read(reader_p->fhd, &reader_p->buf[reader_p->tail],
+                                    reader_p->size - reader_p->tail, &bytes_read));
+        IF_STATUS(s) { return s; }
+        if (0 == bytes_read) {
+            // The last line without the line end.
+            *len_p = reader_p->tail - reader_p->head;
+            return (0 != *len_p) ? S_OK : S_FS_EOF;
+        }
+        reader_p->tail += bytes_read;
+    }
+}
+
+/******************************************************************************/
+Status OS_FileLineRead(const OS_FileLineReaderHd lrhd, StrP* line_pp, Size* len_p)
+{
+FLineReader* reader_p = (FLineReader*)lrhd;
+Size len;
+Status s;
+    if ((OS_NULL == reader_p) || (OS_NULL == line_pp) || (OS_NULL == len_p)) { return S_INVALID_PTR; }
+    IF_OK(s = FLineFind(reader_p, reader_p->size, &len)) {
+        StrP line_p = &reader_p->buf[reader_p->head];
+        reader_p->head += len;
+        // Cut the line end in place (the next line starts after it).
+        if ((0 < len) && ('\n' == line_p[len - 1])) {
+            --len;
+            if ((0 < len) && ('\r' == line_p[len - 1])) { --len; }
+        }
+        reader_p->cut   = (Size)(&line_p[len] - &reader_p->buf[0]);
+        reader_p->cut_c = line_p[len];
+        reader_p->is_cut= OS_TRUE;
+        line_p[len] = '\0'; //EOL
+        *line_pp = line_p;
+        *len_p = len;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileLineGetS(const OS_FileLineReaderHd lrhd, StrP str_p, U32 len)
+{
+FLineReader* reader_p = (FLineReader*)lrhd;
+Size line_len;
+Status s;
+    if ((OS_NULL == reader_p) || (OS_NULL == str_p)) { return S_INVALID_PTR; }
+    if (2 > len) { return S_INVALID_SIZE; }
+    IF_OK(s = FLineFind(reader_p, MIN(len - 1, reader_p->size), &line_len)) {
+        OS_MemCpy(str_p, &reader_p->buf[reader_p->head], line_len);
+        str_p[line_len] = '\0'; //EOL
+        reader_p->head += line_len;
+    }
+    return s;
+}
+
+/******************************************************************************/
+U32 OS_FileLineReaderTell(const OS_FileLineReaderHd lrhd)
+{
+const FLineReader* reader_p = (FLineReader*)lrhd;
+    if (OS_NULL == reader_p) { return 0; }
+    return reader_p->offset + reader_p->head;
+}
+
+/******************************************************************************/
+Status OS_FileLineReaderSeek(const OS_FileLineReaderHd lrhd, const U32 offset)
+{
+FLineReader* reader_p = (FLineReader*)lrhd;
+Status s;
+    if (OS_NULL == reader_p) { return S_INVALID_PTR; }
+    if (OS_TRUE == reader_p->is_cut) {
+        reader_p->buf[reader_p->cut] = reader_p->cut_c;
+        reader_p->is_cut = OS_FALSE;
+    }
+    if ((offset >= reader_p->offset) && (offset <= (reader_p->offset + reader_p->tail))) {
+        // Inside the buffer.
+        reader_p->head = offset - reader_p->offset;
+        return S_OK;
+    }
+    IF_OK(s = OS_FileLSeek(reader_p->fhd, offset)) {
+        reader_p->offset= offset;
+        reader_p->head  = 0;
+        reader_p->tail  = 0;
+    }
+    return s;
+}
+
 /******************************************************************************/
 Status OS_FilePutS(const OS_FileHd fhd, StrP str_p)
 {
@@ -579,6 +1565,9 @@ Status OS_FilePutC(const OS_FileHd fhd, U8 chr)
 /******************************************************************************/
 Status OS_FileLSeek(const OS_FileHd fhd, const U32 offset)
 {
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return OS_RomFsFileLSeek(fhd, offset); }
+#endif //(OS_ROMFS_ENABLED)
     return FResultTranslate(f_lseek(fhd, (DWORD)offset));
 }
 
@@ -589,11 +1578,101 @@ U32 OS_FileTell(const OS_FileHd fhd)
     return (f_tell(fhd));
 }
 
+/******************************************************************************/
+U32 OS_FileSizeGet(const OS_FileHd fhd)
+{
+    return (f_size(fhd));
+}
+
+/******************************************************************************/
+Status OS_FileSync(const OS_FileHd fhd)
+{
+#if (OS_ROMFS_ENABLED)
+    // Nothing to write back.
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return S_OK; }
+#endif //(OS_ROMFS_ENABLED)
+Status s = FResultTranslate(f_sync(fhd));
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    IF_OK(s) { FUsageFileSync((FFile*)fhd); }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileAllocate(const OS_FileHd fhd, const U32 size, const Bool is_contiguous)
+{
+FATFS* fs_p = fhd->fs;
+const U32 offset = f_tell(fhd);
+Status s;
+    OS_LOG(D_DEBUG, "File allocate: 0x%X %u", fhd, size);
+    if (OS_NULL == fs_p) { return S_FS_OBJECT_INVALID; }
+    if (!(fhd->flag & FA_WRITE)) { return S_FS_ACCESS_DENIED; }
+    if (size <= f_size(fhd)) { return S_OK; }
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    // The link map blocks the file expansion.
+    OS_FreeEx(fhd->cltbl, OS_FILE_SYSTEM_FASTSEEK_MEM);
+    fhd->cltbl = OS_NULL;
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+    if (OS_TRUE == is_contiguous) {
+        const U32 cluster_size = fs_p->csize * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+        const U32 clusters = (size + cluster_size - 1) / cluster_size;
+        U32 run_start;
+        // Only the new chain could be placed to the found extent.
+        if (0 != fhd->sclust) { return S_INVALID_STATE; }
+        IF_STATUS(s = FFatScan(fs_p, clusters, OS_NULL, &run_start)) { return s; }
+        if (0 == run_start) { return S_FS_ALLOCATION; }
+        // create_chain() searches from the last allocated cluster.
+        if (!ff_req_grant(fs_p->sobj)) { return S_FS_TIMEOUT; }
+        fs_p->last_clust = run_start - 1;
+        ff_rel_grant(fs_p->sobj);
+    }
+    // The write mode seek beyond the end expands the file (stops if the volume is full).
+    IF_STATUS(s = FResultTranslate(f_lseek(fhd, size))) { return s; }
+    const Bool is_full = (size != f_tell(fhd)) ? OS_TRUE : OS_FALSE;
+    IF_STATUS(s = FResultTranslate(f_lseek(fhd, offset))) { return s; }
+    // Commit the chain and the directory entry.
+    IF_STATUS(s = OS_FileSync(fhd)) { return s; }
+    if (OS_TRUE == is_full) { return S_FS_ALLOCATION; }
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    if (OS_TRUE == is_contiguous) {
+        // One fragment map: the writes inside the file don't access the FAT.
+        DWORD* tbl_p = (DWORD*)OS_MallocEx(4 * sizeof(DWORD), OS_FILE_SYSTEM_FASTSEEK_MEM);
+        if (OS_NULL == tbl_p) { return S_OK; }
+        tbl_p[0] = 4;
+        fhd->cltbl = tbl_p;
+        if (FR_OK != f_lseek(fhd, CREATE_LINKMAP)) {
+            // The extent was taken by a concurrent allocation (the space is reserved anyway).
+            fhd->cltbl = OS_NULL;
+            OS_FreeEx(tbl_p, OS_FILE_SYSTEM_FASTSEEK_MEM);
+            s = S_FS_ALLOCATION;
+        }
+    }
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+    return s;
+}
+
+/******************************************************************************/
+Status OS_FileTruncate(const OS_FileHd fhd)
+{
+    OS_LOG(D_DEBUG, "File truncate: 0x%X", fhd);
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
+    return FResultTranslate(f_truncate(fhd));
+}
+
 /******************************************************************************/
 Status OS_DirectoryCreate(ConstStrP path_p)
 {
     OS_LOG(D_DEBUG, "Dir create: %s", path_p);
-    return FResultTranslate(f_mkdir((const char*)path_p));
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(path_p)) { return S_FS_WRITE_PROTECTED; }
+#endif //(OS_ROMFS_ENABLED)
+Status s = FResultTranslate(f_mkdir((const char*)path_p));
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    IF_OK(s) { FUsageUpdate(path_p, 0, 1, 0); }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+    return s;
 }
 
 /******************************************************************************/
@@ -606,6 +1685,9 @@ Status OS_DirectoryDelete(ConstStrP path_p)
 /******************************************************************************/
 Status OS_DirectoryOpen(OS_DirHd dhd, StrP path_p)
 {
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsPathIs(path_p)) { return OS_RomFsDirectoryOpen(dhd, path_p); }
+#endif //(OS_ROMFS_ENABLED)
 Status s = FResultTranslate(f_opendir(dhd, (const char*)path_p));
     //FDirTranslate(&dir, dhd_p);
     OS_LOG(D_DEBUG, "Dir open: 0x%X %s", dhd, path_p);
@@ -618,6 +1700,9 @@ Status OS_DirectoryRead(OS_DirHd dhd, OS_FileStats* file_stats_p)
 FILINFO file_info;
     OS_LOG(D_DEBUG, "Dir read: 0x%X", dhd);
     if ((OS_NULL == dhd) || (OS_NULL == file_stats_p)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    if (OS_TRUE == OS_RomFsDirIs(dhd)) { return OS_RomFsDirectoryRead(dhd, file_stats_p); }
+#endif //(OS_ROMFS_ENABLED)
 #if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
     file_info.lfname = (char*)file_stats_p->long_name_p;
     file_info.lfsize = file_stats_p->long_name_size;
@@ -837,4 +1922,422 @@ Status VolumeCheck(const S8 volume)
     return S_OK;
 }
 
+#if (OS_FILE_SYSTEM_FASTSEEK)
+/******************************************************************************/
+Status FLinkMapCreate(const OS_FileHd fhd)
+{
+DWORD len = OS_FILE_SYSTEM_FASTSEEK_TBL_LEN;
+FRESULT r;
+    do {
+        DWORD* tbl_p = (DWORD*)OS_MallocEx(len * sizeof(DWORD), OS_FILE_SYSTEM_FASTSEEK_MEM);
+        if (OS_NULL == tbl_p) { return S_OUT_OF_MEMORY; }
+        tbl_p[0] = len;
+        fhd->cltbl = tbl_p;
+        r = f_lseek(fhd, CREATE_LINKMAP);
+        if (FR_OK != r) {
+            // The required table length is returned in the first item.
+            len = tbl_p[0];
+            fhd->cltbl = OS_NULL;
+            OS_FreeEx(tbl_p, OS_FILE_SYSTEM_FASTSEEK_MEM);
+            if (OS_FILE_SYSTEM_FASTSEEK_TBL_LEN_MAX < len) { return S_FS_ALLOCATION; }
+        }
+    } while (FR_NOT_ENOUGH_CORE == r);
+    return FResultTranslate(r);
+}
+
+/******************************************************************************/
+// Returns the cluster of cluster_first if the clusters up to cluster_last are in the same fragment (0 - aren't).
+// The link map is the size and the (clusters count, start cluster) pairs list terminated by 0.
+U32 FLinkMapRunGet(const DWORD* tbl_p, const U32 cluster_first, const U32 cluster_last)
+{
+U32 fragment_first = 0;
+    for (tbl_p++; 0 != tbl_p[0]; tbl_p += 2) {
+        const U32 fragment_end = fragment_first + tbl_p[0];
+        if (cluster_first < fragment_end) {
+            if (cluster_last >= fragment_end) { return 0; }
+            return tbl_p[1] + (cluster_first - fragment_first);
+        }
+        fragment_first = fragment_end;
+    }
+    return 0;
+}
+
+/******************************************************************************/
+// Returns the media sector of the file offset and the contiguous sectors up to the fragment end (0 - not mapped).
+U32 FLinkMapSectorGet(const FATFS* fs_p, const DWORD* tbl_p, const U32 offset, U32* sectors_p)
+{
+const U32 cluster_size = fs_p->csize * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+const U32 cluster_idx = offset / cluster_size;
+const U32 sector_offset = (offset % cluster_size) / OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+U32 fragment_first = 0;
+    *sectors_p = 0;
+    for (tbl_p++; 0 != tbl_p[0]; tbl_p += 2) {
+        const U32 fragment_end = fragment_first + tbl_p[0];
+        if (cluster_idx < fragment_end) {
+            const U32 cluster = tbl_p[1] + (cluster_idx - fragment_first);
+            *sectors_p = (fragment_end - cluster_idx) * fs_p->csize - sector_offset;
+            return fs_p->database + (cluster - 2) * fs_p->csize + sector_offset;
+        }
+        fragment_first = fragment_end;
+    }
+    return 0;
+}
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+
+/******************************************************************************/
+// Transfer the whole sectors between the buffer and the media bypassing the FatFs sector buffer.
+Status FDirectTransfer(const OS_FileHd fhd, U8* data_p, const Size size, const Bool is_write)
+{
+FATFS* fs_p;
+U32 offset;
+U32 done = 0;
+Status s = S_OK;
+    if ((OS_NULL == fhd) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+#if (OS_ROMFS_ENABLED)
+    // The image reads are the memory copies.
+    if (OS_TRUE == OS_RomFsFileIs(fhd)) {
+        if (OS_TRUE == is_write) { return S_FS_WRITE_PROTECTED; }
+        return OS_FileRead(fhd, data_p, size);
+    }
+#endif //(OS_ROMFS_ENABLED)
+    fs_p = fhd->fs;
+    if (OS_NULL == fs_p) { return S_FS_OBJECT_INVALID; }
+    if (!(fhd->flag & ((OS_TRUE == is_write) ? FA_WRITE : FA_READ))) { return S_FS_ACCESS_DENIED; }
+    if (0 == size) { return S_INVALID_SIZE; }
+    offset = f_tell(fhd);
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    if ((0 == ((U32)data_p & (OS_FILE_SYSTEM_DMA_ALIGN - 1))) &&
+        (0 == (offset % OS_FILE_SYSTEM_SECTOR_SIZE_MAX)) && (0 == (size % OS_FILE_SYSTEM_SECTOR_SIZE_MAX)) &&
+        (size <= (f_size(fhd) - offset))) {
+        const Bool is_map_temp = (OS_NULL == fhd->cltbl) ? OS_TRUE : OS_FALSE;
+        // The file buffer sector is written back (the direct reads could cover it).
+        if (fhd->flag & FA__DIRTY) {
+            IF_STATUS(s = OS_FileSync(fhd)) { return s; }
+        }
+        // The temporary link map isn't kept: it blocks the file expansion.
+        if ((OS_FALSE == is_map_temp) || (S_OK == FLinkMapCreate(fhd))) {
+            U32 commands = 0;
+            if (!ff_req_grant(fs_p->sobj)) {
+                s = S_FS_TIMEOUT;
+            } else {
+                while (done < size) {
+                    U32 sectors;
+                    const U32 sector = FLinkMapSectorGet(fs_p, fhd->cltbl, offset + done, &sectors);
+                    if (0 == sectors) { s = S_FS_OBJECT_INVALID; break; }
+                    const U32 count = MIN(MIN(sectors, (size - done) / OS_FILE_SYSTEM_SECTOR_SIZE_MAX),
+                                          OS_FILE_SYSTEM_DIRECT_SECTORS_MAX);
+                    U8* chunk_p = data_p + done;
+                    const DRESULT r = (OS_TRUE == is_write) ? disk_write(fs_p->drv, chunk_p, sector, count) :
+                                                              disk_read(fs_p->drv, chunk_p, sector, count);
+                    if (RES_OK != r) { s = S_FS_TRANSFER_FAIL; break; }
+                    // The file buffer sector is overwritten (FatFs f_write() does the same).
+                    if ((OS_TRUE == is_write) && ((fhd->dsect - sector) < count)) {
+                        OS_MemCpy(fhd->buf, chunk_p + (fhd->dsect - sector) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX,
+                                  OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+                    }
+                    done += count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+                    ++commands;
+                }
+                if ((OS_TRUE == is_write) && (0 != done)) {
+                    fhd->flag |= FA__WRITTEN;
+                }
+                ff_rel_grant(fs_p->sobj);
+            }
+            // The fast seek (the map is still set) doesn't walk FAT.
+            const Status s_seek = FResultTranslate(f_lseek(fhd, offset + done));
+            IF_OK(s) { s = s_seek; }
+            if (OS_TRUE == is_map_temp) {
+                OS_FreeEx(fhd->cltbl, OS_FILE_SYSTEM_FASTSEEK_MEM);
+                fhd->cltbl = OS_NULL;
+            }
+            OS_CriticalSectionEnter(); {
+                ++fs_direct_stats.transfers;
+                fs_direct_stats.commands += commands;
+                fs_direct_stats.sectors += done / OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+            }
+            OS_CriticalSectionExit();
+            IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+            return s;
+        }
+    }
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+    // Partial sectors, unaligned buffer, the file expansion or the link map isn't available.
+    OS_LOG(D_DEBUG, "File direct bounce: 0x%X", fhd);
+    OS_CriticalSectionEnter(); {
+        ++fs_direct_stats.bounces;
+    }
+    OS_CriticalSectionExit();
+    return (OS_TRUE == is_write) ? OS_FileWrite(fhd, data_p, size) : OS_FileRead(fhd, data_p, size);
+}
+
+/******************************************************************************/
+// Get the memory mapped media region (DRV_REQ_MEDIA_ADDRESS_GET).
+Status FMediaRegionGet(const FATFS* fs_p, U8** base_pp, U32* size_p)
+{
+const OS_DriverHd dhd = fs_media_dhd_v[fs_p->drv];
+U32 sectors;
+Status s;
+    if (OS_NULL == dhd) { return S_FS_UNMOUNTED; }
+    IF_STATUS(OS_DriverIoCtl(dhd, DRV_REQ_MEDIA_ADDRESS_GET, (void*)base_pp)) { return S_FS_NOT_ENABLED; }
+    IF_STATUS(s = OS_DriverIoCtl(dhd, DRV_REQ_MEDIA_SECTOR_COUNT_GET, &sectors)) { return s; }
+    *size_p = sectors * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+    return S_OK;
+}
+
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+/******************************************************************************/
+// Erase the queued ranges (fs_erase_mutex is locked).
+Status FEraseFlush(const U8 volume)
+{
+const OS_DriverHd dhd = fs_media_dhd_v[volume];
+const FEraseRange* ranges_p = fs_erase_ranges_v[volume];
+Status s = S_OK;
+    for (U8 i = 0; (OS_NULL != dhd) && (i < fs_erase_count_v[volume]); ++i) {
+        DWORD range_v[2] = { ranges_p[i].start, ranges_p[i].end };
+        // Short ranges aren't worth the erase command.
+        if (OS_FILE_SYSTEM_ERASE_SECTORS_MIN > (range_v[1] - range_v[0] + 1)) { continue; }
+        IF_STATUS(s = OS_DriverIoCtl(dhd, CTRL_ERASE_SECTOR, range_v)) { break; }
+    }
+    fs_erase_count_v[volume] = 0;
+    return s;
+}
+
+/******************************************************************************/
+Status FClustersErase(FATFS* fs_p, const U32 cluster, const U32 clusters, U32* sectors_p)
+{
+const U32 sectors = clusters * fs_p->csize;
+DWORD range_v[2];
+Status s;
+    if (OS_FILE_SYSTEM_ERASE_SECTORS_MIN > sectors) { return S_OK; }
+    range_v[0] = fs_p->database + (cluster - 2) * fs_p->csize;
+    range_v[1] = range_v[0] + sectors - 1;
+    IF_STATUS(s = OS_DriverIoCtl(fs_media_dhd_v[fs_p->drv], CTRL_ERASE_SECTOR, range_v)) { return s; }
+    *sectors_p += sectors;
+    return s;
+}
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+
+/******************************************************************************/
+// Scan FAT16/FAT32 without the volume lock.
+// clusters_free_p - free clusters count (could be OS_NULL - the scan stops on the first run found).
+// run_start_p     - the first cluster of the first free run of run_len clusters (0 - not found).
+Status FFatScan(FATFS* fs_p, const U32 run_len, U32* clusters_free_p, U32* run_start_p)
+{
+const U32 entry_size = (FS_FAT32 == fs_p->fs_type) ? 4 : 2;
+const U32 fat_sectors = (fs_p->n_fatent * entry_size + OS_FILE_SYSTEM_SECTOR_SIZE_MAX - 1) / OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+U32 clusters_free = 0;
+U32 cluster = 0;
+U32 run = 0;
+U32 run_cluster = 0;
+BYTE* buf_p;
+Status s = S_OK;
+    if (FS_FAT12 == fs_p->fs_type) { return S_FS_INVALID_PARAMETER; }
+    *run_start_p = 0;
+    buf_p = (BYTE*)OS_Malloc(OS_FILE_SYSTEM_FAT_SCAN_SECTORS * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+    if (OS_NULL == buf_p) { return S_OUT_OF_MEMORY; }
+    // Long reads bypass the sector cache and see its dirty lines.
+    for (U32 sector = 0; sector < fat_sectors; sector += OS_FILE_SYSTEM_FAT_SCAN_SECTORS) {
+        const U32 count = MIN(OS_FILE_SYSTEM_FAT_SCAN_SECTORS, fat_sectors - sector);
+        if (RES_OK != disk_read(fs_p->drv, buf_p, fs_p->fatbase + sector, count)) { s = S_FS_MEDIA_FAULT; break; }
+        for (U32 i = 0; (i < (count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX)) && (cluster < fs_p->n_fatent); i += entry_size, ++cluster) {
+            if (2 > cluster) { continue; }
+            const U32 entry = (4 == entry_size) ? (LD_DWORD(buf_p + i) & 0x0FFFFFFF) : LD_WORD(buf_p + i);
+            if (0 == entry) {
+                ++clusters_free;
+                if (0 == run++) { run_cluster = cluster; }
+                if ((0 == *run_start_p) && (0 != run_len) && (run_len <= run)) {
+                    *run_start_p = run_cluster;
+                    if (OS_NULL == clusters_free_p) { goto done; }
+                }
+            } else {
+                run = 0;
+            }
+        }
+    }
+done:
+    OS_Free(buf_p);
+    if (OS_NULL != clusters_free_p) { *clusters_free_p = clusters_free; }
+    return s;
+}
+
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+/******************************************************************************/
+static U32 FUsageHashStep(const U32 hash, Str c);
+INLINE U32 FUsageHashStep(const U32 hash, Str c)
+{
+    // FAT names are case insensitive.
+    if (('a' <= c) && ('z' >= c)) { c -= ('a' - 'A'); }
+    return (hash ^ (U8)c) * 16777619U; //FNV-1a
+}
+
+/******************************************************************************/
+// Returns the absolute path prefixes count (volume root is the first, 0 - the path isn't tracked).
+// Only OS_FILE_SYSTEM_USAGE_DEPTH_MAX prefix hashes are stored.
+U8 FUsagePathHash(ConstStrP path_p, U32 hash_v[], U8* volume_p)
+{
+StrP abs_path_p = OS_NULL;
+ConstStrP p = path_p;
+U32 hash = 2166136261U;
+U8 depth = 0;
+    if (OS_NULL == OS_StrChr((const char*)path_p, OS_FILE_SYSTEM_DRV_DELIM)) {
+        // Relative path - prepend the current directory (or the current drive).
+        const Size len = OS_FILE_SYSTEM_LONG_NAMES_LEN * 2;
+        abs_path_p = (StrP)OS_Malloc(len);
+        if (OS_NULL == abs_path_p) { return 0; }
+        if (FR_OK != f_getcwd((char*)abs_path_p, len)) { goto error; }
+        if (OS_FILE_SYSTEM_DIR_DELIM == *path_p) {
+            StrP delim_p = (StrP)OS_StrChr((const char*)abs_path_p, OS_FILE_SYSTEM_DRV_DELIM);
+            if (OS_NULL == delim_p) { goto error; }
+            *(delim_p + 1) = '\0'; //EOL
+        }
+        if ((OS_StrLen((const char*)abs_path_p) + OS_StrLen((const char*)path_p) + 2) > len) { goto error; }
+        OS_StrCat((char*)abs_path_p, "/");
+        OS_StrCat((char*)abs_path_p, (const char*)path_p);
+        p = abs_path_p;
+    }
+    if (('0' > *p) || ((OS_FILE_SYSTEM_VOLUMES_MAX + '0') <= *p)) { goto error; }
+    *volume_p = *p - '0';
+    while (OS_FILE_SYSTEM_DRV_DELIM != *p) { hash = FUsageHashStep(hash, *p++); }
+    hash = FUsageHashStep(hash, *p++);
+    hash_v[depth++] = hash;
+    while ('\0' != *p) {
+        ConstStrP name_p;
+        while (OS_FILE_SYSTEM_DIR_DELIM == *p) { ++p; }
+        name_p = p;
+        while (('\0' != *p) && (OS_FILE_SYSTEM_DIR_DELIM != *p)) { ++p; }
+        const Size name_len = p - name_p;
+        if (0 == name_len) { break; }
+        if ((1 == name_len) && ('.' == name_p[0])) { continue; }
+        if ((2 == name_len) && ('.' == name_p[0]) && ('.' == name_p[1])) {
+            if (OS_FILE_SYSTEM_USAGE_DEPTH_MAX < depth) { depth = 0; break; }
+            if (1 < depth) { --depth; }
+            hash = hash_v[depth - 1];
+            continue;
+        }
+        hash = FUsageHashStep(hash, OS_FILE_SYSTEM_DIR_DELIM);
+        while (name_p != p) { hash = FUsageHashStep(hash, *name_p++); }
+        if (OS_FILE_SYSTEM_USAGE_DEPTH_MAX > depth) {
+            hash_v[depth] = hash;
+        }
+        if (U8_MAX == ++depth) { depth = 0; break; }
+    }
+    OS_Free(abs_path_p);
+    return depth;
+error:
+    OS_Free(abs_path_p);
+    return 0;
+}
+
+/******************************************************************************/
+void FUsageApply(const U32 hash_v[], const U8 count, const U8 volume,
+                 const S32 files, const S32 dirs, const S32 bytes)
+{
+    IF_OK(OS_MutexLock(fs_usage_mutex, OS_TIMEOUT_FS)) {
+        // Drop the concurrent scans.
+        fs_usage_gen_v[volume]++;
+        for (U8 i = 0; i < OS_FILE_SYSTEM_USAGE_DIRS_MAX; ++i) {
+            FUsageDir* dir_p = &fs_usage_dirs_v[i];
+            if ((OS_TRUE != dir_p->is_valid) || (volume != dir_p->volume)) { continue; }
+            for (U8 j = 0; j < count; ++j) {
+                if (hash_v[j] == dir_p->hash) {
+                    dir_p->stats.files_count     += (U32)files;
+                    dir_p->stats.dirs_count      += (U32)dirs;
+                    dir_p->stats.files_total_size+= (U32)bytes;
+                    break;
+                }
+            }
+        }
+        OS_MutexUnlock(fs_usage_mutex);
+    } else {
+        FUsageInvalidate(volume);
+    }
+}
+
+/******************************************************************************/
+// Update the usage of the object parents.
+void FUsageUpdate(ConstStrP path_p, const S32 files, const S32 dirs, const S32 bytes)
+{
+U32 hash_v[OS_FILE_SYSTEM_USAGE_DEPTH_MAX];
+U8 volume;
+const U8 depth = FUsagePathHash(path_p, hash_v, &volume);
+    if (0 < depth) {
+        FUsageApply(hash_v, MIN(depth - 1, OS_FILE_SYSTEM_USAGE_DEPTH_MAX), volume, files, dirs, bytes);
+    }
+}
+
+/******************************************************************************/
+void FUsageInvalidate(const U8 volume)
+{
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return; }
+    OS_MutexLock(fs_usage_mutex, OS_BLOCK);
+    fs_usage_gen_v[volume]++;
+    for (U8 i = 0; i < OS_FILE_SYSTEM_USAGE_DIRS_MAX; ++i) {
+        if (volume == fs_usage_dirs_v[i].volume) {
+            fs_usage_dirs_v[i].is_valid = OS_FALSE;
+        }
+    }
+    OS_MutexUnlock(fs_usage_mutex);
+}
+
+/******************************************************************************/
+void FUsageFileSync(FFile* file_p)
+{
+    if (OS_NULL == file_p->fil.fs) { return; } // Isn't opened.
+    const U32 size = f_size(&file_p->fil);
+    if (size != file_p->size) {
+        FUsageApply(file_p->hash_v, file_p->depth, file_p->volume, 0, 0, (S32)(size - file_p->size));
+        file_p->size = size;
+    }
+}
+
+/******************************************************************************/
+// Count the free clusters without the volume lock.
+Status FClustersFreeCount(FATFS* fs_p)
+{
+U32 clusters_free;
+U32 run_start;
+U32 gen;
+Status s;
+    if (FS_FAT12 == fs_p->fs_type) {
+        // Small FAT - count it under the lock.
+        DWORD clusters_count;
+        FATFS* fs_cnt_p;
+        const Str path[] = { fs_p->drv + '0', OS_FILE_SYSTEM_DRV_DELIM, '\0' };
+        if (fs_p->free_clust <= (fs_p->n_fatent - 2)) { return S_OK; }
+        return FResultTranslate(f_getfree(path, &clusters_count, &fs_cnt_p));
+    }
+    if (!ff_req_grant(fs_p->sobj)) { return S_FS_TIMEOUT; }
+    gen = fs_write_gen_v[fs_p->drv];
+    ff_rel_grant(fs_p->sobj);
+    IF_STATUS(s = FFatScan(fs_p, 0, &clusters_free, &run_start)) { return s; }
+    if (!ff_req_grant(fs_p->sobj)) { return S_FS_TIMEOUT; }
+    // FAT was written or the FatFs window holds the modified FAT sector.
+    if ((gen != fs_write_gen_v[fs_p->drv]) ||
+        (fs_p->wflag && ((fs_p->winsect - fs_p->fatbase) < (fs_p->fsize * fs_p->n_fats)))) {
+        s = S_BUSY;
+    } else if (fs_p->free_clust != clusters_free) {
+        OS_LOG(D_DEBUG, "Free clusters: %u -> %u", fs_p->free_clust, clusters_free);
+        fs_p->free_clust = clusters_free;
+        // Written to FSInfo on the next sync.
+        if (FS_FAT32 == fs_p->fs_type) { fs_p->fsi_flag = 1; }
+    }
+    ff_rel_grant(fs_p->sobj);
+    return s;
+}
+
+/******************************************************************************/
+void FValidateRequest(const U8 volume)
+{
+const OS_TaskHd fsd_thd = OS_TaskByNameGet(OS_DAEMON_NAME_FS);
+    // Without the daemon the counters are validated on the first query.
+    if (OS_NULL == fsd_thd) { return; }
+    OS_Message* msg_p = OS_MessageCreate(OS_MSG_FS_VOLUME_VALIDATE, (OS_MessageData)&volume, sizeof(volume), OS_NO_BLOCK);
+    if (OS_NULL != msg_p) {
+        IF_STATUS(OS_MessageSend(OS_TaskStdInGet(fsd_thd), msg_p, OS_NO_BLOCK, OS_MSG_PRIO_NORMAL)) {
+            OS_MessageDelete(msg_p);
+        }
+    }
+}
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
+
 #endif // (OS_FILE_SYSTEM_ENABLED)
\ No newline at end of file
@@ -0,0 +1,635 @@
+/***************************************************************************//**
+* @file    os_fs_bench.c
+* @brief   OS File system benchmark.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_FS_BENCH_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_driver.h"
+#include "os_time.h"
+#include "os_kv.h"
+#include "os_fs_bench.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "fs_bench"
+#undef  MDL_STATUS_ITEMS
+#define MDL_STATUS_ITEMS    &status_fs_v[0]
+
+//------------------------------------------------------------------------------
+typedef struct {
+    OS_FsBenchConfig    cfg;
+    U8*                 buf_p;      // Transfer buffer (io_size).
+    OS_FileHd           json_fhd;
+    Status              json_status;
+    U32                 rand;       // Random offsets generator state.
+    Str                 path[OS_FS_BENCH_PATH_LEN];
+    Str                 line[OS_FS_BENCH_LINE_LEN];
+} FBench;
+
+typedef Status (*FBenchFunc)(FBench* bench_p, OS_FsBenchResult* result_p);
+
+typedef struct {
+    ConstStrP           name_p;
+    FBenchFunc          func;
+} FBenchScenario;
+
+//------------------------------------------------------------------------------
+static Status FBenchSeqWrite(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchSeqRead(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchReadDirect(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchRandRead(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchRandWrite(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchSeek(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchSeekFast(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchPreallocNone(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchPreallocContig(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchSmallCreate(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchDirList(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchSmallDelete(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchIniGetS(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchIniReader(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchKvSet(FBench* bench_p, OS_FsBenchResult* result_p);
+static Status FBenchRomFsLookup(FBench* bench_p, OS_FsBenchResult* result_p);
+
+static Status FBenchRead(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_direct);
+static Status FBenchRandom(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_write);
+static Status FBenchSeekRead(FBench* bench_p, OS_FsBenchResult* result_p, const OS_FileOpenMode op_mode);
+static Status FBenchStream(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_prealloc);
+static Status FBenchOpen(FBench* bench_p, ConstStrP name_p, const OS_FileOpenMode op_mode, OS_FileHd* fhd_p);
+static StrP   FBenchPath(FBench* bench_p, ConstStrP name_p);
+static StrP   FBenchSmallPath(FBench* bench_p, const U32 idx);
+static Status FBenchIniCreate(FBench* bench_p);
+static U32    FBenchRand(FBench* bench_p);
+static void   FBenchOp(OS_FsBenchResult* result_p, const OS_Tick tick_op, const Size bytes);
+static void   FBenchPut(FBench* bench_p, ConstStrP str_p);
+static void   FBenchJsonWrite(FBench* bench_p, const OS_FsBenchResult results_v[]);
+
+//------------------------------------------------------------------------------
+extern const StatusItem status_fs_v[];
+extern OS_DriverHd fs_media_dhd_v[];
+
+static const FBenchScenario bench_scenarios_v[OS_FS_BENCH_LAST] = {
+    { "seq_write",      FBenchSeqWrite          },
+    { "seq_read",       FBenchSeqRead           },
+    { "read_direct",    FBenchReadDirect        },
+    { "rand_read",      FBenchRandRead          },
+    { "rand_write",     FBenchRandWrite         },
+    { "seek",           FBenchSeek              },
+    { "seek_fast",      FBenchSeekFast          },
+    { "prealloc_none",  FBenchPreallocNone      },
+    { "prealloc_contig",FBenchPreallocContig    },
+    { "small_create",   FBenchSmallCreate       },
+    { "dir_list",       FBenchDirList           },
+    { "small_delete",   FBenchSmallDelete       },
+    { "ini_gets",       FBenchIniGetS           },
+    { "ini_reader",     FBenchIniReader         },
+    { "kv_set",         FBenchKvSet             },
+    { "romfs_lookup",   FBenchRomFsLookup       },
+};
+
+/******************************************************************************/
+Status OS_FsBenchRun(const OS_FsBenchConfig* cfg_p, OS_FsBenchResult results_v[])
+{
+const Bool is_latency = ((0 != cfg_p->latency.read_ms) || (0 != cfg_p->latency.write_ms)) ? OS_TRUE : OS_FALSE;
+OS_FsBenchResult* bench_results_p;
+OS_DriverHd dhd = OS_NULL;
+FBench* bench_p;
+Status s = S_OK;
+    if ((OS_NULL == cfg_p) || (OS_NULL == cfg_p->dir_path_p)) { return S_INVALID_PTR; }
+    bench_p = (FBench*)OS_Malloc(sizeof(FBench));
+    if (OS_NULL == bench_p) { return S_OUT_OF_MEMORY; }
+    bench_results_p = (OS_FsBenchResult*)OS_Malloc(OS_FS_BENCH_LAST * sizeof(OS_FsBenchResult));
+    if (OS_NULL == bench_results_p) { OS_Free(bench_p); return S_OUT_OF_MEMORY; }
+    OS_MemSet(bench_p, 0, sizeof(FBench));
+    OS_MemSet(bench_results_p, 0, OS_FS_BENCH_LAST * sizeof(OS_FsBenchResult));
+    bench_p->cfg = *cfg_p;
+    if (0 == bench_p->cfg.file_size)    { bench_p->cfg.file_size    = OS_FS_BENCH_FILE_SIZE; }
+    if (0 == bench_p->cfg.io_size)      { bench_p->cfg.io_size      = OS_FS_BENCH_IO_SIZE; }
+    if (0 == bench_p->cfg.files_count)  { bench_p->cfg.files_count  = OS_FS_BENCH_FILES; }
+    if (0 == bench_p->cfg.ops_count)    { bench_p->cfg.ops_count    = OS_FS_BENCH_OPS; }
+    bench_p->rand = bench_p->cfg.seed;
+    // The whole transfers only (the random offsets are the transfer size multiples).
+    if ((bench_p->cfg.file_size < bench_p->cfg.io_size) || (0 != (bench_p->cfg.file_size % bench_p->cfg.io_size))) {
+        s = S_INVALID_SIZE;
+        goto error;
+    }
+    bench_p->buf_p = (U8*)OS_MallocAlignedEx(bench_p->cfg.io_size, OS_FILE_SYSTEM_DMA_ALIGN, OS_FILE_SYSTEM_DMA_MEM);
+    if (OS_NULL == bench_p->buf_p) { s = S_OUT_OF_MEMORY; goto error; }
+    for (Size i = 0; i < bench_p->cfg.io_size; ++i) {
+        bench_p->buf_p[i] = (U8)i;
+    }
+    // The work volume media ("N:/dir").
+    if ((OS_NULL != OS_StrChr((const char*)bench_p->cfg.dir_path_p, OS_FILE_SYSTEM_DRV_DELIM)) &&
+        ((U8)(bench_p->cfg.dir_path_p[0] - '0') < OS_FILE_SYSTEM_VOLUMES_MAX)) {
+        dhd = fs_media_dhd_v[bench_p->cfg.dir_path_p[0] - '0'];
+    }
+    if (OS_TRUE == is_latency) {
+        if (OS_NULL == dhd) { s = S_FS_MEDIA_INVALID; goto error; }
+        IF_STATUS(s = OS_DriverIoCtl(dhd, DRV_REQ_MEDIA_LATENCY_SET, &bench_p->cfg.latency)) {
+            s = S_FS_NOT_ENABLED;
+            goto error;
+        }
+    }
+    // The directory could be left by the interrupted run.
+    IF_STATUS(s = OS_DirectoryCreate(bench_p->cfg.dir_path_p)) {
+        if (S_FS_OBJECT_EXISTS != s) { goto error; }
+        s = S_OK;
+    }
+    for (OS_FsBenchScenario scenario = 0; scenario < OS_FS_BENCH_LAST; ++scenario) {
+        OS_FsBenchResult* result_p = &bench_results_p[scenario];
+        OS_LOG(D_DEBUG, "FS bench: %s", bench_scenarios_v[scenario].name_p);
+        result_p->status = bench_scenarios_v[scenario].func(bench_p, result_p);
+        IF_STATUS(result_p->status) {
+            if (S_FS_NOT_ENABLED == result_p->status) { continue; }
+            OS_LOG(D_WARNING, "FS bench %s: %s", bench_scenarios_v[scenario].name_p,
+                   StatusStringGet(result_p->status, MDL_STATUS_ITEMS));
+            IF_OK(s) { s = result_p->status; }
+        }
+    }
+    OS_FileDelete(FBenchPath(bench_p, "seq.bin"));
+    OS_DirectoryDelete(bench_p->cfg.dir_path_p);
+    if (OS_NULL != bench_p->cfg.json_path_p) {
+        IF_STATUS(bench_p->json_status = OS_FileOpen(&bench_p->json_fhd, bench_p->cfg.json_path_p,
+                                                     BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+            OS_Free(bench_p->json_fhd);
+            bench_p->json_fhd = OS_NULL;
+        }
+    }
+    IF_OK(bench_p->json_status) {
+        FBenchJsonWrite(bench_p, bench_results_p);
+    }
+    if (OS_NULL != bench_p->json_fhd) {
+        OS_FileClose(&bench_p->json_fhd);
+    }
+    IF_OK(s) { s = bench_p->json_status; }
+    if (OS_NULL != results_v) {
+        OS_MemCpy(results_v, bench_results_p, OS_FS_BENCH_LAST * sizeof(OS_FsBenchResult));
+    }
+error:
+    if (OS_TRUE == is_latency) {
+        const DrvMediaLatency latency = { 0 };
+        if (OS_NULL != dhd) { OS_DriverIoCtl(dhd, DRV_REQ_MEDIA_LATENCY_SET, (void*)&latency); }
+    }
+    OS_FreeAligned(bench_p->buf_p);
+    OS_Free(bench_results_p);
+    OS_Free(bench_p);
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+    return s;
+}
+
+/******************************************************************************/
+ConstStrP OS_FsBenchNameGet(const OS_FsBenchScenario scenario)
+{
+    if (OS_FS_BENCH_LAST <= scenario) { return OS_NULL; }
+    return bench_scenarios_v[scenario].name_p;
+}
+
+/******************************************************************************/
+Status FBenchSeqWrite(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "seq.bin", BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE), &fhd)) {
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 offset = 0; offset < bench_p->cfg.file_size; offset += bench_p->cfg.io_size) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileWrite(fhd, bench_p->buf_p, bench_p->cfg.io_size)) { break; }
+        FBenchOp(result_p, tick_op, bench_p->cfg.io_size);
+    }
+    // The data is on the media.
+    IF_OK(s) { s = OS_FileSync(fhd); }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchSeqRead(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchRead(bench_p, result_p, OS_FALSE);
+}
+
+/******************************************************************************/
+Status FBenchReadDirect(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchRead(bench_p, result_p, OS_TRUE);
+}
+
+/******************************************************************************/
+Status FBenchRandRead(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchRandom(bench_p, result_p, OS_FALSE);
+}
+
+/******************************************************************************/
+Status FBenchRandWrite(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchRandom(bench_p, result_p, OS_TRUE);
+}
+
+/******************************************************************************/
+Status FBenchSeek(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchSeekRead(bench_p, result_p, BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ));
+}
+
+/******************************************************************************/
+Status FBenchSeekFast(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    return FBenchSeekRead(bench_p, result_p, BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ) |
+                                             BIT(OS_FS_FILE_OP_MODE_FAST_SEEK));
+#else
+    return S_FS_NOT_ENABLED;
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+}
+
+/******************************************************************************/
+Status FBenchPreallocNone(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchStream(bench_p, result_p, OS_FALSE);
+}
+
+/******************************************************************************/
+Status FBenchPreallocContig(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+    return FBenchStream(bench_p, result_p, OS_TRUE);
+}
+
+/******************************************************************************/
+Status FBenchSmallCreate(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = OS_DirectoryCreate(FBenchPath(bench_p, "small"))) {
+        if (S_FS_OBJECT_EXISTS != s) { return s; }
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 i = 0; i < bench_p->cfg.files_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileOpen(&fhd, FBenchSmallPath(bench_p, i),
+                                  BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+            OS_Free(fhd);
+            break;
+        }
+        s = OS_FileWrite(fhd, bench_p->buf_p, MIN(OS_FS_BENCH_SMALL_SIZE, bench_p->cfg.io_size));
+        OS_FileClose(&fhd);
+        IF_STATUS(s) { break; }
+        FBenchOp(result_p, tick_op, MIN(OS_FS_BENCH_SMALL_SIZE, bench_p->cfg.io_size));
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchDirList(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+OS_DirHd dhd = (OS_DirHd)OS_Malloc(sizeof(DIR));
+OS_FileStats stats;
+Status s;
+    if (OS_NULL == dhd) { return S_OUT_OF_MEMORY; }
+#if OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    // The names are short.
+    stats.long_name_p   = bench_p->line;
+    stats.long_name_size= sizeof(bench_p->line);
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    const OS_Tick tick_start = OS_TickCountGet();
+    IF_OK(s = OS_DirectoryOpen(dhd, FBenchPath(bench_p, "small"))) {
+        while (1) {
+            const OS_Tick tick_op = OS_TickCountGet();
+            IF_STATUS(s = OS_DirectoryRead(dhd, &stats)) { break; }
+            if (OS_ASCII_EOL == stats.name[0]) { break; }
+            FBenchOp(result_p, tick_op, 0);
+        }
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_Free(dhd);
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchSmallDelete(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+Status s = S_OK;
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 i = 0; i < bench_p->cfg.files_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileDelete(FBenchSmallPath(bench_p, i))) { break; }
+        FBenchOp(result_p, tick_op, 0);
+    }
+    IF_OK(s) { s = OS_DirectoryDelete(FBenchPath(bench_p, "small")); }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchIniGetS(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchIniCreate(bench_p)) { return s; }
+    IF_STATUS(s = FBenchOpen(bench_p, "bench.ini", BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ), &fhd)) {
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    while (1) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileGetS(fhd, bench_p->line, sizeof(bench_p->line))) { break; }
+        FBenchOp(result_p, tick_op, OS_StrLen((const char*)bench_p->line));
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    if (S_FS_EOF == s) { s = S_OK; }
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchIniReader(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+OS_FileLineReaderHd lrhd;
+OS_FileHd fhd;
+StrP line_p;
+Size len;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "bench.ini", BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ), &fhd)) {
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    IF_OK(s = OS_FileLineReaderCreate(fhd, 0, &lrhd)) {
+        while (1) {
+            const OS_Tick tick_op = OS_TickCountGet();
+            IF_STATUS(s = OS_FileLineRead(lrhd, &line_p, &len)) { break; }
+            // The line end is cut.
+            FBenchOp(result_p, tick_op, len + 1);
+        }
+        OS_FileLineReaderDelete(lrhd);
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    if (S_FS_EOF == s) { s = S_OK; }
+    IF_OK(s) { s = OS_FileDelete(FBenchPath(bench_p, "bench.ini")); }
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchKvSet(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+#if (OS_KV_ENABLED)
+const OS_KvConfig kv_cfg = {
+    .file_path_p    = FBenchPath(bench_p, "bench.kv"),
+    .capacity       = OS_FS_BENCH_KV_CAPACITY,
+    .is_sync        = OS_FALSE
+};
+OS_KvHd kvhd;
+Status s;
+    IF_STATUS(s = OS_KvOpen(&kv_cfg, &kvhd)) { return s; }
+    const OS_Tick tick_start = OS_TickCountGet();
+    // The keys are updated round-robin (the compaction is the part of the cost).
+    for (U32 i = 0; i < bench_p->cfg.ops_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        snprintf((char*)bench_p->line, sizeof(bench_p->line), "key%02u", i % OS_FS_BENCH_KV_KEYS);
+        OS_MemCpy(bench_p->buf_p, &i, sizeof(i));
+        IF_STATUS(s = OS_KvSet(kvhd, bench_p->line, bench_p->buf_p, OS_FS_BENCH_KV_VALUE_SIZE)) { break; }
+        FBenchOp(result_p, tick_op, OS_FS_BENCH_KV_VALUE_SIZE);
+    }
+    IF_OK(s) { s = OS_KvSync(kvhd); }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_KvClose(kvhd);
+    OS_FileDelete(kv_cfg.file_path_p);
+    return s;
+#else
+    return S_FS_NOT_ENABLED;
+#endif //(OS_KV_ENABLED)
+}
+
+/******************************************************************************/
+Status FBenchRomFsLookup(FBench* bench_p, OS_FsBenchResult* result_p)
+{
+#if (OS_ROMFS_ENABLED)
+OS_FileStats stats;
+Status s = S_OK;
+    if (OS_NULL == bench_p->cfg.romfs_path_p) { return S_FS_NOT_ENABLED; }
+#if OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    stats.long_name_p   = bench_p->line;
+    stats.long_name_size= sizeof(bench_p->line);
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 i = 0; i < bench_p->cfg.ops_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileStatsGet(bench_p->cfg.romfs_path_p, &stats)) { break; }
+        FBenchOp(result_p, tick_op, 0);
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    return s;
+#else
+    return S_FS_NOT_ENABLED;
+#endif //(OS_ROMFS_ENABLED)
+}
+
+/******************************************************************************/
+Status FBenchRead(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_direct)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "seq.bin", BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ), &fhd)) {
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 offset = 0; offset < bench_p->cfg.file_size; offset += bench_p->cfg.io_size) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = (OS_TRUE == is_direct) ? OS_FileReadDirect(fhd, bench_p->buf_p, bench_p->cfg.io_size) :
+                                               OS_FileRead(fhd, bench_p->buf_p, bench_p->cfg.io_size)) { break; }
+        FBenchOp(result_p, tick_op, bench_p->cfg.io_size);
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchRandom(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_write)
+{
+const U32 blocks = bench_p->cfg.file_size / bench_p->cfg.io_size;
+const OS_FileOpenMode op_mode = BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ) |
+                                ((OS_TRUE == is_write) ? BIT(OS_FS_FILE_OP_MODE_WRITE) : 0);
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "seq.bin", op_mode, &fhd)) { return s; }
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 i = 0; i < bench_p->cfg.ops_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileLSeek(fhd, (FBenchRand(bench_p) % blocks) * bench_p->cfg.io_size)) { break; }
+        IF_STATUS(s = (OS_TRUE == is_write) ? OS_FileWrite(fhd, bench_p->buf_p, bench_p->cfg.io_size) :
+                                              OS_FileRead(fhd, bench_p->buf_p, bench_p->cfg.io_size)) { break; }
+        FBenchOp(result_p, tick_op, bench_p->cfg.io_size);
+    }
+    if (OS_TRUE == is_write) {
+        IF_OK(s) { s = OS_FileSync(fhd); }
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    return s;
+}
+
+/******************************************************************************/
+// Short reads at the random offsets (the backward seeks walk the cluster chain from the file start).
+Status FBenchSeekRead(FBench* bench_p, OS_FsBenchResult* result_p, const OS_FileOpenMode op_mode)
+{
+const U32 range = bench_p->cfg.file_size - OS_FS_BENCH_SEEK_READ_SIZE;
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "seq.bin", op_mode, &fhd)) { return s; }
+    const OS_Tick tick_start = OS_TickCountGet();
+    for (U32 i = 0; i < bench_p->cfg.ops_count; ++i) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileLSeek(fhd, FBenchRand(bench_p) % MAX(1, range))) { break; }
+        IF_STATUS(s = OS_FileRead(fhd, bench_p->buf_p, OS_FS_BENCH_SEEK_READ_SIZE)) { break; }
+        FBenchOp(result_p, tick_op, OS_FS_BENCH_SEEK_READ_SIZE);
+    }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    return s;
+}
+
+/******************************************************************************/
+// Streaming write: the latency max is the cluster allocation spikes.
+Status FBenchStream(FBench* bench_p, OS_FsBenchResult* result_p, const Bool is_prealloc)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "stream.bin", BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE), &fhd)) {
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    if (OS_TRUE == is_prealloc) {
+        s = OS_FileAllocate(fhd, bench_p->cfg.file_size, OS_TRUE);
+    }
+    for (U32 offset = 0; (S_OK == s) && (offset < bench_p->cfg.file_size); offset += bench_p->cfg.io_size) {
+        const OS_Tick tick_op = OS_TickCountGet();
+        IF_STATUS(s = OS_FileWrite(fhd, bench_p->buf_p, bench_p->cfg.io_size)) { break; }
+        FBenchOp(result_p, tick_op, bench_p->cfg.io_size);
+    }
+    IF_OK(s) { s = OS_FileSync(fhd); }
+    result_p->time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+    OS_FileClose(&fhd);
+    IF_OK(s) { s = OS_FileDelete(FBenchPath(bench_p, "stream.bin")); }
+    return s;
+}
+
+/******************************************************************************/
+Status FBenchOpen(FBench* bench_p, ConstStrP name_p, const OS_FileOpenMode op_mode, OS_FileHd* fhd_p)
+{
+Status s;
+    IF_STATUS(s = OS_FileOpen(fhd_p, FBenchPath(bench_p, name_p), op_mode)) {
+        OS_Free(*fhd_p);
+        *fhd_p = OS_NULL;
+    }
+    return s;
+}
+
+/******************************************************************************/
+StrP FBenchPath(FBench* bench_p, ConstStrP name_p)
+{
+    snprintf((char*)bench_p->path, sizeof(bench_p->path), "%s/%s", bench_p->cfg.dir_path_p, name_p);
+    return bench_p->path;
+}
+
+/******************************************************************************/
+StrP FBenchSmallPath(FBench* bench_p, const U32 idx)
+{
+    snprintf((char*)bench_p->path, sizeof(bench_p->path), "%s/small/f%05u.txt", bench_p->cfg.dir_path_p, idx);
+    return bench_p->path;
+}
+
+/******************************************************************************/
+// The settings file: a section per OS_FS_BENCH_INI_SECTION_KEYS keys.
+Status FBenchIniCreate(FBench* bench_p)
+{
+OS_FileHd fhd;
+Status s;
+    IF_STATUS(s = FBenchOpen(bench_p, "bench.ini", BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE), &fhd)) {
+        return s;
+    }
+    for (U32 i = 0; i < bench_p->cfg.ops_count; ++i) {
+        if (0 == (i % OS_FS_BENCH_INI_SECTION_KEYS)) {
+            snprintf((char*)bench_p->line, sizeof(bench_p->line), "[section%u]\n", i / OS_FS_BENCH_INI_SECTION_KEYS);
+        } else {
+            snprintf((char*)bench_p->line, sizeof(bench_p->line), "key%u=value %u ; comment\n", i, i * 7);
+        }
+        IF_STATUS(s = OS_FilePutS(fhd, bench_p->line)) { break; }
+    }
+    OS_FileClose(&fhd);
+    return s;
+}
+
+/******************************************************************************/
+// Random offsets (LCG): the same seed gives the same access pattern.
+U32 FBenchRand(FBench* bench_p)
+{
+    bench_p->rand = bench_p->rand * 1664525UL + 1013904223UL;
+    return (bench_p->rand >> 8);
+}
+
+/******************************************************************************/
+// Account the operation started at tick_op.
+void FBenchOp(OS_FsBenchResult* result_p, const OS_Tick tick_op, const Size bytes)
+{
+const OS_TimeMs latency = OS_TICKS_TO_MS(OS_TickCountGet() - tick_op);
+    ++result_p->ops;
+    result_p->bytes += bytes;
+    result_p->latency_max = MAX(result_p->latency_max, latency);
+}
+
+/******************************************************************************/
+void FBenchPut(FBench* bench_p, ConstStrP str_p)
+{
+    if (OS_NULL != bench_p->json_fhd) {
+        IF_OK(bench_p->json_status) {
+            bench_p->json_status = OS_FilePutS(bench_p->json_fhd, (StrP)str_p);
+        }
+    } else {
+        printf("%s", str_p);
+    }
+}
+
+/******************************************************************************/
+void FBenchJsonWrite(FBench* bench_p, const OS_FsBenchResult results_v[])
+{
+const OS_FsBenchConfig* cfg_p = &bench_p->cfg;
+StrP line_p = bench_p->line;
+const Size line_size = sizeof(bench_p->line);
+    FBenchPut(bench_p, "{\n  \"suite\": \"fsbench\",\n");
+    snprintf((char*)line_p, line_size, "  \"dir\": \"%s\",\n", cfg_p->dir_path_p);
+    FBenchPut(bench_p, line_p);
+    snprintf((char*)line_p, line_size,
+             "  \"config\": { \"file_size\": %u, \"io_size\": %u, \"files\": %u, \"ops\": %u, \"seed\": %u,",
+             cfg_p->file_size, cfg_p->io_size, cfg_p->files_count, cfg_p->ops_count, cfg_p->seed);
+    FBenchPut(bench_p, line_p);
+    snprintf((char*)line_p, line_size, " \"latency_read_ms\": %u, \"latency_write_ms\": %u },\n  \"results\": [",
+             cfg_p->latency.read_ms, cfg_p->latency.write_ms);
+    FBenchPut(bench_p, line_p);
+    for (OS_FsBenchScenario scenario = 0; scenario < OS_FS_BENCH_LAST; ++scenario) {
+        const OS_FsBenchResult* result_p = &results_v[scenario];
+        const U32 time = MAX(1, result_p->time);
+        snprintf((char*)line_p, line_size, "%s\n    { \"name\": \"%s\", \"status\": \"%s\", \"ops\": %u, \"bytes\": %u,",
+                 (0 == scenario) ? "" : ",", bench_scenarios_v[scenario].name_p,
+                 (S_OK == result_p->status) ? "ok" :
+                 (S_FS_NOT_ENABLED == result_p->status) ? "skipped" : StatusStringGet(result_p->status, MDL_STATUS_ITEMS),
+                 result_p->ops, result_p->bytes);
+        FBenchPut(bench_p, line_p);
+        snprintf((char*)line_p, line_size, " \"ms\": %u, \"kb_s\": %u, \"ops_s\": %u, \"latency_max_ms\": %u }",
+                 result_p->time,
+                 (U32)(((U64)result_p->bytes * 1000) / ((U64)time * 1024)),
+                 (U32)(((U64)result_p->ops * 1000) / time),
+                 result_p->latency_max);
+        FBenchPut(bench_p, line_p);
+    }
+    FBenchPut(bench_p, "\n  ]\n}\n");
+}
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_FS_BENCH_ENABLED)
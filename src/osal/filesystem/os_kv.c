@@ -0,0 +1,727 @@
+/***************************************************************************//**
+* @file    os_kv.c
+* @brief   OS Key-value store.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_KV_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_mutex.h"
+#include "os_mailbox.h"
+#include "os_task.h"
+#include "os_task_fs.h"
+#include "os_kv.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "kv"
+
+//------------------------------------------------------------------------------
+#define KV_LOG_MAGIC        0x474C564BUL    // "KVLG"
+#define KV_LOG_VERSION      1
+#define KV_REC_MAGIC        0x564B          // "KV"
+#define KV_REC_ALIGN(size)  (((size) + 3UL) & ~3UL)
+#define KV_REC_SIZE(key_len, value_len) KV_REC_ALIGN(sizeof(KvRecordHeader) + (key_len) + (value_len))
+#define KV_REC_SIZE_MAX     KV_REC_SIZE(OS_KV_KEY_LEN_MAX, OS_KV_VALUE_LEN_MAX)
+#define KV_SECTOR_SIZE      OS_FILE_SYSTEM_SECTOR_SIZE_MAX
+#define KV_SECTOR_UNDEF     U32_MAX
+
+enum {
+    KV_REC_DELETED,
+};
+
+// Log header (the log start).
+typedef struct {
+    U32                 magic;
+    U16                 version;
+    U16                 gen;        // Generation (incremented by the compaction).
+    U32                 reserved;
+    U32                 crc;
+} KvLogHeader;
+
+// Record header (followed by the key, the value and the padding to 4 bytes).
+typedef struct {
+    U16                 magic;
+    U16                 gen;        // The log generation (the stale records are rejected).
+    U16                 value_len;
+    U8                  key_len;
+    U8                  flags;
+    U32                 crc;        // The whole record CRC (the field is 0).
+} KvRecordHeader;
+
+// Keys index entry.
+typedef struct KvEntry {
+    struct KvEntry*     next_p;
+    U32                 hash;
+    U32                 offset;     // Record offset.
+    U16                 value_len;
+    U8                  key_len;
+    Str                 key[1];
+} KvEntry;
+
+typedef struct {
+    OS_FileHd           fhd;        // File backend.
+    U32                 sector;     // Media backend log first sector.
+} KvLog;
+
+typedef struct {
+    OS_KvConfig         cfg;
+    StrP                path_p;
+    StrP                tmp_path_p;
+    KvLog               log;
+    KvEntry*            bucket_v[OS_KV_BUCKETS];
+    U32                 end;        // Log end offset.
+    U32                 live;       // Live records size.
+    U32                 capacity;
+    U32                 half_sectors;
+    U32                 sec_idx;    // Media backend buffered sector.
+    U16                 gen;
+    U8                  half;       // Media backend active half.
+    Bool                is_compact_pending;
+    OS_KvStats          stats;
+    U32                 rec_buf[KV_REC_SIZE_MAX / sizeof(U32)];
+    U32                 sec_buf[KV_SECTOR_SIZE / sizeof(U32)];
+} OS_KvConfigDyn;
+
+//------------------------------------------------------------------------------
+static U32          KvHash(ConstStrP key_p, const Size len);
+static KvEntry*     KvEntryFind(OS_KvConfigDyn* cfg_dyn_p, ConstStrP key_p, const U8 key_len, const U32 hash, KvEntry*** link_ppp);
+static Status       KvIndexApply(OS_KvConfigDyn* cfg_dyn_p, const KvRecordHeader* rec_hdr_p, ConstStrP key_p, const U32 offset);
+static void         KvIndexFree(OS_KvConfigDyn* cfg_dyn_p);
+static Status       KvRead(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U32 offset, void* data_p, Size size);
+static Status       KvWrite(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U32 offset, const void* data_p, Size size);
+static Status       KvLogHeaderRead(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U16* gen_p);
+static Status       KvLogHeaderWrite(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, const U16 gen);
+static Status       KvLogOpen(OS_KvConfigDyn* cfg_dyn_p);
+static Status       KvLogScan(OS_KvConfigDyn* cfg_dyn_p);
+static Status       KvRecordAppend(OS_KvConfigDyn* cfg_dyn_p, ConstStrP key_p, const U8 key_len,
+                                   const void* value_p, const U16 value_len, const U8 flags);
+static Status       KvCompact(OS_KvConfigDyn* cfg_dyn_p);
+static void         KvCompactSchedule(OS_KvConfigDyn* cfg_dyn_p);
+static ConstStrP    KvPathNoDrive(ConstStrP path_p);
+
+//------------------------------------------------------------------------------
+static OS_KvConfigDyn*  kv_v[OS_KV_OPEN_MAX];
+static OS_MutexHd       kv_mutex;
+
+/******************************************************************************/
+Status OS_KvInit(void)
+{
+    OS_MemSet(kv_v, 0, sizeof(kv_v));
+    kv_mutex = OS_MutexCreate();
+    if (OS_NULL == kv_mutex) { return S_INVALID_PTR; }
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_KvOpen(const OS_KvConfig* cfg_p, OS_KvHd* kvhd_p)
+{
+OS_KvConfigDyn* cfg_dyn_p;
+Size slot;
+Status s;
+    if ((OS_NULL == cfg_p) || (OS_NULL == kvhd_p)) { return S_INVALID_PTR; }
+    if (OS_NULL == cfg_p->file_path_p) {
+        if (OS_NULL == cfg_p->dhd) { return S_INVALID_PTR; }
+        if (2 > cfg_p->sectors) { return S_INVALID_SIZE; }
+    } else if (KV_REC_SIZE_MAX > cfg_p->capacity) { return S_INVALID_SIZE; }
+    cfg_dyn_p = (OS_KvConfigDyn*)OS_Malloc(sizeof(OS_KvConfigDyn));
+    if (OS_NULL == cfg_dyn_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(cfg_dyn_p, 0, sizeof(OS_KvConfigDyn));
+    cfg_dyn_p->cfg      = *cfg_p;
+    cfg_dyn_p->sec_idx  = KV_SECTOR_UNDEF;
+    if (OS_NULL != cfg_p->file_path_p) {
+        // The compaction writes the temp file ("~" appended to the path) and renames it.
+        const Size path_len = OS_StrLen((const char*)cfg_p->file_path_p) + 1;
+        cfg_dyn_p->path_p = (StrP)OS_Malloc(path_len * 2 + 1);
+        if (OS_NULL == cfg_dyn_p->path_p) { s = S_OUT_OF_MEMORY; goto error; }
+        cfg_dyn_p->tmp_path_p = cfg_dyn_p->path_p + path_len;
+        OS_MemCpy(cfg_dyn_p->path_p, cfg_p->file_path_p, path_len);
+        OS_MemCpy(cfg_dyn_p->tmp_path_p, cfg_p->file_path_p, path_len - 1);
+        cfg_dyn_p->tmp_path_p[path_len - 1] = '~';
+        cfg_dyn_p->tmp_path_p[path_len] = '\0'; //EOL
+        cfg_dyn_p->cfg.file_path_p = cfg_dyn_p->path_p;
+        cfg_dyn_p->capacity = cfg_p->capacity;
+    } else {
+        cfg_dyn_p->half_sectors = cfg_p->sectors / 2;
+        cfg_dyn_p->capacity = cfg_dyn_p->half_sectors * KV_SECTOR_SIZE;
+    }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (slot = 0; slot < OS_KV_OPEN_MAX; ++slot) {
+            if (OS_NULL == kv_v[slot]) { break; }
+        }
+        if (OS_KV_OPEN_MAX == slot) {
+            s = S_OVERFLOW;
+        } else {
+            IF_OK(s = KvLogOpen(cfg_dyn_p)) {
+                IF_OK(s = KvLogScan(cfg_dyn_p)) {
+                    kv_v[slot] = cfg_dyn_p;
+                }
+            }
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+    IF_OK(s) {
+        OS_LOG(D_DEBUG, "Kv open: keys %u, log %u/%u, dropped %u", cfg_dyn_p->stats.keys,
+               cfg_dyn_p->end, cfg_dyn_p->capacity, cfg_dyn_p->stats.dropped);
+        *kvhd_p = (OS_KvHd)cfg_dyn_p;
+        return s;
+    }
+error:
+    OS_LOG_S(D_WARNING, s);
+    if (OS_NULL != cfg_dyn_p->log.fhd) { OS_FileClose(&cfg_dyn_p->log.fhd); }
+    KvIndexFree(cfg_dyn_p);
+    OS_Free(cfg_dyn_p->path_p);
+    OS_Free(cfg_dyn_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvClose(const OS_KvHd kvhd)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        // The pending compaction request is skipped then.
+        for (Size i = 0; i < OS_KV_OPEN_MAX; ++i) {
+            if (cfg_dyn_p == kv_v[i]) { kv_v[i] = OS_NULL; }
+        }
+        if (OS_NULL != cfg_dyn_p->log.fhd) {
+            s = OS_FileClose(&cfg_dyn_p->log.fhd);
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+    KvIndexFree(cfg_dyn_p);
+    OS_Free(cfg_dyn_p->path_p);
+    OS_Free(cfg_dyn_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvGet(const OS_KvHd kvhd, ConstStrP key_p, void* value_p, Size* size_p)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == key_p) || (OS_NULL == size_p)) { return S_INVALID_PTR; }
+    const Size key_len = OS_StrLen((const char*)key_p);
+    if ((0 == key_len) || (OS_KV_KEY_LEN_MAX < key_len)) { return S_INVALID_SIZE; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        KvEntry** link_pp;
+        const KvEntry* entry_p = KvEntryFind(cfg_dyn_p, key_p, (U8)key_len, KvHash(key_p, key_len), &link_pp);
+        if (OS_NULL == entry_p) {
+            s = S_NOT_EXISTS;
+        } else if (*size_p < entry_p->value_len) {
+            *size_p = entry_p->value_len;
+            s = S_OVERFLOW;
+        } else {
+            *size_p = entry_p->value_len;
+            if (0 != entry_p->value_len) {
+                if (OS_NULL == value_p) {
+                    s = S_INVALID_PTR;
+                } else {
+                    s = KvRead(cfg_dyn_p, &cfg_dyn_p->log, entry_p->offset + sizeof(KvRecordHeader) + key_len,
+                               value_p, entry_p->value_len);
+                }
+            }
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvSet(const OS_KvHd kvhd, ConstStrP key_p, const void* value_p, const Size size)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == key_p)) { return S_INVALID_PTR; }
+    if ((0 != size) && (OS_NULL == value_p)) { return S_INVALID_PTR; }
+    const Size key_len = OS_StrLen((const char*)key_p);
+    if ((0 == key_len) || (OS_KV_KEY_LEN_MAX < key_len) || (OS_KV_VALUE_LEN_MAX < size)) { return S_INVALID_SIZE; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        s = KvRecordAppend(cfg_dyn_p, key_p, (U8)key_len, value_p, (U16)size, 0);
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvDelete(const OS_KvHd kvhd, ConstStrP key_p)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == key_p)) { return S_INVALID_PTR; }
+    const Size key_len = OS_StrLen((const char*)key_p);
+    if ((0 == key_len) || (OS_KV_KEY_LEN_MAX < key_len)) { return S_INVALID_SIZE; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        KvEntry** link_pp;
+        if (OS_NULL == KvEntryFind(cfg_dyn_p, key_p, (U8)key_len, KvHash(key_p, key_len), &link_pp)) {
+            s = S_NOT_EXISTS;
+        } else {
+            s = KvRecordAppend(cfg_dyn_p, key_p, (U8)key_len, OS_NULL, 0, BIT(KV_REC_DELETED));
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvSync(const OS_KvHd kvhd)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        // The media backend is written through.
+        if (OS_NULL != cfg_dyn_p->cfg.file_path_p) {
+            s = (OS_NULL != cfg_dyn_p->log.fhd) ? OS_FileSync(cfg_dyn_p->log.fhd) : S_INVALID_STATE;
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvCompact(const OS_KvHd kvhd)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        s = KvCompact(cfg_dyn_p);
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_KvStatsGet(const OS_KvHd kvhd, OS_KvStats* stats_p)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        *stats_p = cfg_dyn_p->stats;
+        stats_p->log_size   = cfg_dyn_p->end;
+        stats_p->live_size  = cfg_dyn_p->live;
+        stats_p->capacity   = cfg_dyn_p->capacity;
+        OS_MutexUnlock(kv_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+void OS_KvCompactRequestDo(const OS_KvHd kvhd)
+{
+OS_KvConfigDyn* cfg_dyn_p = (OS_KvConfigDyn*)kvhd;
+Status s;
+    IF_OK(s = OS_MutexLock(kv_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (Size i = 0; i < OS_KV_OPEN_MAX; ++i) {
+            if (cfg_dyn_p == kv_v[i]) {
+                cfg_dyn_p->is_compact_pending = OS_FALSE;
+                IF_STATUS(s = KvCompact(cfg_dyn_p)) { OS_LOG_S(D_WARNING, s); }
+                break;
+            }
+        }
+        OS_MutexUnlock(kv_mutex);
+    }
+}
+
+/******************************************************************************/
+U32 KvHash(ConstStrP key_p, const Size len)
+{
+U32 hash = 2166136261U;
+    for (Size i = 0; i < len; ++i) {
+        hash = (hash ^ (U8)key_p[i]) * 16777619U; //FNV-1a
+    }
+    return hash;
+}
+
+/******************************************************************************/
+KvEntry* KvEntryFind(OS_KvConfigDyn* cfg_dyn_p, ConstStrP key_p, const U8 key_len, const U32 hash, KvEntry*** link_ppp)
+{
+KvEntry** link_pp = &cfg_dyn_p->bucket_v[hash & (OS_KV_BUCKETS - 1)];
+    while (OS_NULL != *link_pp) {
+        KvEntry* entry_p = *link_pp;
+        if ((hash == entry_p->hash) && (key_len == entry_p->key_len) && !OS_MemCmp(entry_p->key, key_p, key_len)) {
+            break;
+        }
+        link_pp = &entry_p->next_p;
+    }
+    *link_ppp = link_pp;
+    return *link_pp;
+}
+
+/******************************************************************************/
+Status KvIndexApply(OS_KvConfigDyn* cfg_dyn_p, const KvRecordHeader* rec_hdr_p, ConstStrP key_p, const U32 offset)
+{
+const U32 hash = KvHash(key_p, rec_hdr_p->key_len);
+KvEntry** link_pp;
+KvEntry* entry_p = KvEntryFind(cfg_dyn_p, key_p, rec_hdr_p->key_len, hash, &link_pp);
+    if (OS_NULL != entry_p) {
+        cfg_dyn_p->live -= KV_REC_SIZE(entry_p->key_len, entry_p->value_len);
+        if (BIT_TEST(rec_hdr_p->flags, BIT(KV_REC_DELETED))) {
+            *link_pp = entry_p->next_p;
+            OS_Free(entry_p);
+            cfg_dyn_p->stats.keys--;
+            return S_OK;
+        }
+    } else {
+        if (BIT_TEST(rec_hdr_p->flags, BIT(KV_REC_DELETED))) { return S_OK; }
+        entry_p = (KvEntry*)OS_Malloc(sizeof(KvEntry) + rec_hdr_p->key_len);
+        if (OS_NULL == entry_p) { return S_OUT_OF_MEMORY; }
+        OS_MemCpy(entry_p->key, key_p, rec_hdr_p->key_len);
+        entry_p->key_len= rec_hdr_p->key_len;
+        entry_p->hash   = hash;
+        entry_p->next_p = OS_NULL;
+        *link_pp = entry_p;
+        cfg_dyn_p->stats.keys++;
+    }
+    entry_p->offset     = offset;
+    entry_p->value_len  = rec_hdr_p->value_len;
+    cfg_dyn_p->live    += KV_REC_SIZE(entry_p->key_len, entry_p->value_len);
+    return S_OK;
+}
+
+/******************************************************************************/
+void KvIndexFree(OS_KvConfigDyn* cfg_dyn_p)
+{
+    for (Size i = 0; i < OS_KV_BUCKETS; ++i) {
+        KvEntry* entry_p = cfg_dyn_p->bucket_v[i];
+        while (OS_NULL != entry_p) {
+            KvEntry* next_p = entry_p->next_p;
+            OS_Free(entry_p);
+            entry_p = next_p;
+        }
+        cfg_dyn_p->bucket_v[i] = OS_NULL;
+    }
+    cfg_dyn_p->stats.keys = 0;
+    cfg_dyn_p->live = 0;
+}
+
+/******************************************************************************/
+Status KvRead(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U32 offset, void* data_p, Size size)
+{
+U8* dst_p = (U8*)data_p;
+Status s = S_OK;
+    if (OS_NULL != cfg_dyn_p->cfg.file_path_p) {
+        if (OS_NULL == log_p->fhd) { return S_INVALID_STATE; }
+        IF_OK(s = OS_FileLSeek(log_p->fhd, offset)) {
+            s = OS_FileRead(log_p->fhd, data_p, size);
+        }
+        return s;
+    }
+    while (0 != size) {
+        U32 sector = log_p->sector + (offset / KV_SECTOR_SIZE);
+        const U32 pos = offset % KV_SECTOR_SIZE;
+        const Size len = MIN(size, KV_SECTOR_SIZE - pos);
+        if (sector != cfg_dyn_p->sec_idx) {
+            cfg_dyn_p->sec_idx = KV_SECTOR_UNDEF;
+            IF_STATUS(s = OS_DriverRead(cfg_dyn_p->cfg.dhd, cfg_dyn_p->sec_buf, 1, &sector)) { break; }
+            cfg_dyn_p->sec_idx = log_p->sector + (offset / KV_SECTOR_SIZE);
+        }
+        OS_MemCpy(dst_p, (U8*)cfg_dyn_p->sec_buf + pos, len);
+        dst_p  += len;
+        offset += len;
+        size   -= len;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status KvWrite(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U32 offset, const void* data_p, Size size)
+{
+const U8* src_p = (const U8*)data_p;
+Status s = S_OK;
+    if (OS_NULL != cfg_dyn_p->cfg.file_path_p) {
+        if (OS_NULL == log_p->fhd) { return S_INVALID_STATE; }
+        IF_OK(s = OS_FileLSeek(log_p->fhd, offset)) {
+            s = OS_FileWrite(log_p->fhd, (void*)data_p, size);
+        }
+        return s;
+    }
+    // Media: the sector is updated in the buffer and written through.
+    while (0 != size) {
+        const U32 sector_idx = log_p->sector + (offset / KV_SECTOR_SIZE);
+        const U32 pos = offset % KV_SECTOR_SIZE;
+        const Size len = MIN(size, KV_SECTOR_SIZE - pos);
+        U32 sector = sector_idx;
+        if ((sector_idx != cfg_dyn_p->sec_idx) && (KV_SECTOR_SIZE != len)) {
+            cfg_dyn_p->sec_idx = KV_SECTOR_UNDEF;
+            IF_STATUS(s = OS_DriverRead(cfg_dyn_p->cfg.dhd, cfg_dyn_p->sec_buf, 1, &sector)) { break; }
+            sector = sector_idx;
+        }
+        OS_MemCpy((U8*)cfg_dyn_p->sec_buf + pos, src_p, len);
+        cfg_dyn_p->sec_idx = sector_idx;
+        IF_STATUS(s = OS_DriverWrite(cfg_dyn_p->cfg.dhd, cfg_dyn_p->sec_buf, 1, &sector)) {
+            cfg_dyn_p->sec_idx = KV_SECTOR_UNDEF;
+            break;
+        }
+        src_p  += len;
+        offset += len;
+        size   -= len;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status KvLogHeaderRead(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, U16* gen_p)
+{
+KvLogHeader hdr;
+Status s;
+    IF_OK(s = KvRead(cfg_dyn_p, log_p, 0, &hdr, sizeof(hdr))) {
+        const U32 crc = hdr.crc;
+        hdr.crc = 0;
+        if ((KV_LOG_MAGIC != hdr.magic) || (KV_LOG_VERSION != hdr.version) || (crc != OS_MemCrc32(&hdr, sizeof(hdr)))) {
+            s = S_INVALID_CRC;
+        } else {
+            *gen_p = hdr.gen;
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status KvLogHeaderWrite(OS_KvConfigDyn* cfg_dyn_p, const KvLog* log_p, const U16 gen)
+{
+KvLogHeader hdr;
+    OS_MemSet(&hdr, 0, sizeof(hdr));
+    hdr.magic   = KV_LOG_MAGIC;
+    hdr.version = KV_LOG_VERSION;
+    hdr.gen     = gen;
+    hdr.crc     = OS_MemCrc32(&hdr, sizeof(hdr));
+    return KvWrite(cfg_dyn_p, log_p, 0, &hdr, sizeof(hdr));
+}
+
+/******************************************************************************/
+Status KvLogOpen(OS_KvConfigDyn* cfg_dyn_p)
+{
+const OS_FileOpenMode op_mode = BIT(OS_FS_FILE_OP_MODE_READ) | BIT(OS_FS_FILE_OP_MODE_WRITE);
+Status s = S_OK;
+    if (OS_NULL == cfg_dyn_p->cfg.file_path_p) {
+        // Media: the valid half with the latest generation.
+        U16 gen_v[2];
+        Bool is_valid_v[2];
+        for (U8 half = 0; half < 2; ++half) {
+            const KvLog log = { .fhd = OS_NULL, .sector = cfg_dyn_p->cfg.sector + half * cfg_dyn_p->half_sectors };
+            is_valid_v[half] = (S_OK == KvLogHeaderRead(cfg_dyn_p, &log, &gen_v[half])) ? OS_TRUE : OS_FALSE;
+        }
+        if ((OS_TRUE == is_valid_v[0]) && (OS_TRUE == is_valid_v[1])) {
+            cfg_dyn_p->half = (0 < (S16)(gen_v[1] - gen_v[0])) ? 1 : 0;
+        } else {
+            cfg_dyn_p->half = (OS_TRUE == is_valid_v[1]) ? 1 : 0;
+        }
+        cfg_dyn_p->log.sector = cfg_dyn_p->cfg.sector + cfg_dyn_p->half * cfg_dyn_p->half_sectors;
+        if (OS_TRUE == is_valid_v[cfg_dyn_p->half]) {
+            cfg_dyn_p->gen = gen_v[cfg_dyn_p->half];
+            return S_OK;
+        }
+        cfg_dyn_p->gen = 1;
+        return KvLogHeaderWrite(cfg_dyn_p, &cfg_dyn_p->log, cfg_dyn_p->gen);
+    }
+    // File: finish the interrupted compaction.
+    IF_STATUS(OS_FileOpen(&cfg_dyn_p->log.fhd, cfg_dyn_p->path_p, op_mode | BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS))) {
+        OS_Free(cfg_dyn_p->log.fhd);
+        cfg_dyn_p->log.fhd = OS_NULL;
+        // The temp file is complete if the log is deleted.
+        if (S_OK == OS_FileRename(cfg_dyn_p->tmp_path_p, KvPathNoDrive(cfg_dyn_p->path_p))) {
+            OS_LOG(D_DEBUG, "Kv compaction recovered: %s", cfg_dyn_p->path_p);
+        }
+        IF_STATUS(s = OS_FileOpen(&cfg_dyn_p->log.fhd, cfg_dyn_p->path_p, op_mode | BIT(OS_FS_FILE_OP_MODE_OPEN_NEW))) {
+            OS_Free(cfg_dyn_p->log.fhd);
+            cfg_dyn_p->log.fhd = OS_NULL;
+            return s;
+        }
+    } else {
+        // The log is complete - the temp file is incomplete.
+        OS_FileDelete(cfg_dyn_p->tmp_path_p);
+    }
+    if ((sizeof(KvLogHeader) > OS_FileSizeGet(cfg_dyn_p->log.fhd)) ||
+        (S_OK != KvLogHeaderRead(cfg_dyn_p, &cfg_dyn_p->log, &cfg_dyn_p->gen))) {
+        cfg_dyn_p->gen = 1;
+        IF_STATUS(s = KvLogHeaderWrite(cfg_dyn_p, &cfg_dyn_p->log, cfg_dyn_p->gen)) { return s; }
+        IF_STATUS(s = OS_FileTruncate(cfg_dyn_p->log.fhd)) { return s; }
+        s = OS_FileSync(cfg_dyn_p->log.fhd);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status KvLogScan(OS_KvConfigDyn* cfg_dyn_p)
+{
+KvRecordHeader* rec_hdr_p = (KvRecordHeader*)cfg_dyn_p->rec_buf;
+const U32 limit = (OS_NULL != cfg_dyn_p->cfg.file_path_p) ? OS_FileSizeGet(cfg_dyn_p->log.fhd) : cfg_dyn_p->capacity;
+U32 offset = sizeof(KvLogHeader);
+Status s = S_OK;
+    // Replay the records up to the first invalid (torn) one.
+    while ((offset + sizeof(KvRecordHeader)) <= limit) {
+        IF_STATUS(KvRead(cfg_dyn_p, &cfg_dyn_p->log, offset, rec_hdr_p, sizeof(KvRecordHeader))) { break; }
+        if ((KV_REC_MAGIC != rec_hdr_p->magic) || (cfg_dyn_p->gen != rec_hdr_p->gen) ||
+            (0 == rec_hdr_p->key_len) || (OS_KV_KEY_LEN_MAX < rec_hdr_p->key_len) ||
+            (OS_KV_VALUE_LEN_MAX < rec_hdr_p->value_len)) { break; }
+        const U32 size = KV_REC_SIZE(rec_hdr_p->key_len, rec_hdr_p->value_len);
+        if ((offset + size) > limit) { break; }
+        IF_STATUS(KvRead(cfg_dyn_p, &cfg_dyn_p->log, offset, rec_hdr_p, size)) { break; }
+        const U32 crc = rec_hdr_p->crc;
+        rec_hdr_p->crc = 0;
+        if (crc != OS_MemCrc32(rec_hdr_p, size)) { break; }
+        IF_STATUS(s = KvIndexApply(cfg_dyn_p, rec_hdr_p, (ConstStrP)(rec_hdr_p + 1), offset)) { return s; }
+        offset += size;
+    }
+    cfg_dyn_p->end = offset;
+    if ((OS_NULL != cfg_dyn_p->cfg.file_path_p) && (offset < limit)) {
+        // Drop the torn tail.
+        cfg_dyn_p->stats.dropped = limit - offset;
+        IF_OK(s = OS_FileLSeek(cfg_dyn_p->log.fhd, offset)) {
+            IF_OK(s = OS_FileTruncate(cfg_dyn_p->log.fhd)) {
+                s = OS_FileSync(cfg_dyn_p->log.fhd);
+            }
+        }
+        OS_LOG(D_WARNING, "Kv log tail dropped: %u bytes", cfg_dyn_p->stats.dropped);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status KvRecordAppend(OS_KvConfigDyn* cfg_dyn_p, ConstStrP key_p, const U8 key_len,
+                      const void* value_p, const U16 value_len, const U8 flags)
+{
+KvRecordHeader* rec_hdr_p = (KvRecordHeader*)cfg_dyn_p->rec_buf;
+const U32 size = KV_REC_SIZE(key_len, value_len);
+Status s;
+    if ((cfg_dyn_p->end + size) > cfg_dyn_p->capacity) {
+        // The log is full - compact in place.
+        IF_STATUS(s = KvCompact(cfg_dyn_p)) { return s; }
+        if ((cfg_dyn_p->end + size) > cfg_dyn_p->capacity) { return S_OUT_OF_SPACE; }
+    }
+    OS_MemSet(rec_hdr_p, 0, size);
+    rec_hdr_p->magic    = KV_REC_MAGIC;
+    rec_hdr_p->gen      = cfg_dyn_p->gen;
+    rec_hdr_p->value_len= value_len;
+    rec_hdr_p->key_len  = key_len;
+    rec_hdr_p->flags    = flags;
+    OS_MemCpy((U8*)(rec_hdr_p + 1), key_p, key_len);
+    if (0 != value_len) {
+        OS_MemCpy((U8*)(rec_hdr_p + 1) + key_len, value_p, value_len);
+    }
+    rec_hdr_p->crc      = OS_MemCrc32(rec_hdr_p, size);
+    IF_STATUS(s = KvWrite(cfg_dyn_p, &cfg_dyn_p->log, cfg_dyn_p->end, rec_hdr_p, size)) { return s; }
+    if ((OS_NULL != cfg_dyn_p->cfg.file_path_p) && (OS_TRUE == cfg_dyn_p->cfg.is_sync)) {
+        IF_STATUS(s = OS_FileSync(cfg_dyn_p->log.fhd)) { return s; }
+    }
+    IF_STATUS(s = KvIndexApply(cfg_dyn_p, rec_hdr_p, key_p, cfg_dyn_p->end)) { return s; }
+    cfg_dyn_p->end += size;
+    cfg_dyn_p->stats.appends++;
+    KvCompactSchedule(cfg_dyn_p);
+    return s;
+}
+
+/******************************************************************************/
+Status KvCompact(OS_KvConfigDyn* cfg_dyn_p)
+{
+const Bool is_file = (OS_NULL != cfg_dyn_p->cfg.file_path_p) ? OS_TRUE : OS_FALSE;
+KvRecordHeader* rec_hdr_p = (KvRecordHeader*)cfg_dyn_p->rec_buf;
+const U16 gen = (U16)(cfg_dyn_p->gen + 1);
+KvLog log = { .fhd = OS_NULL, .sector = 0 };
+U32 offset = sizeof(KvLogHeader);
+Status s;
+    if (OS_TRUE == is_file) {
+        if (OS_NULL == cfg_dyn_p->log.fhd) { return S_INVALID_STATE; }
+        IF_STATUS(s = OS_FileOpen(&log.fhd, cfg_dyn_p->tmp_path_p,
+                                  (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE)))) {
+            OS_Free(log.fhd);
+            return s;
+        }
+    } else {
+        // The other half is invalid until its header is written.
+        const KvLogHeader hdr_zero = { 0 };
+        log.sector = cfg_dyn_p->cfg.sector + (cfg_dyn_p->half ^ 1) * cfg_dyn_p->half_sectors;
+        IF_STATUS(s = KvWrite(cfg_dyn_p, &log, 0, &hdr_zero, sizeof(hdr_zero))) { return s; }
+    }
+    // Copy the live records.
+    for (Size i = 0; i < OS_KV_BUCKETS; ++i) {
+        for (const KvEntry* entry_p = cfg_dyn_p->bucket_v[i]; OS_NULL != entry_p; entry_p = entry_p->next_p) {
+            const U32 size = KV_REC_SIZE(entry_p->key_len, entry_p->value_len);
+            IF_STATUS(s = KvRead(cfg_dyn_p, &cfg_dyn_p->log, entry_p->offset, rec_hdr_p, size)) { goto error; }
+            rec_hdr_p->gen = gen;
+            rec_hdr_p->crc = 0;
+            rec_hdr_p->crc = OS_MemCrc32(rec_hdr_p, size);
+            IF_STATUS(s = KvWrite(cfg_dyn_p, &log, offset, rec_hdr_p, size)) { goto error; }
+            offset += size;
+        }
+    }
+    // Commit: the media half header or the file rename.
+    IF_STATUS(s = KvLogHeaderWrite(cfg_dyn_p, &log, gen)) { goto error; }
+    if (OS_TRUE == is_file) {
+        IF_STATUS(s = OS_FileClose(&log.fhd)) { goto error; }
+        OS_FileClose(&cfg_dyn_p->log.fhd);
+        IF_OK(s = OS_FileDelete(cfg_dyn_p->path_p)) {
+            s = OS_FileRename(cfg_dyn_p->tmp_path_p, KvPathNoDrive(cfg_dyn_p->path_p));
+        }
+        // The log is reopened anyway (the open recovers the interrupted rename).
+        IF_STATUS(OS_FileOpen(&cfg_dyn_p->log.fhd, cfg_dyn_p->path_p,
+                              (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ) |
+                                                BIT(OS_FS_FILE_OP_MODE_WRITE)))) {
+            OS_Free(cfg_dyn_p->log.fhd);
+            cfg_dyn_p->log.fhd = OS_NULL;
+            if (S_OK == s) { s = S_INVALID_STATE; }
+        }
+        IF_STATUS(s) {
+            OS_LOG_S(D_WARNING, s);
+            return s;
+        }
+    } else {
+        cfg_dyn_p->half ^= 1;
+        cfg_dyn_p->log = log;
+    }
+    // The same order as the copy.
+    offset = sizeof(KvLogHeader);
+    for (Size i = 0; i < OS_KV_BUCKETS; ++i) {
+        for (KvEntry* entry_p = cfg_dyn_p->bucket_v[i]; OS_NULL != entry_p; entry_p = entry_p->next_p) {
+            entry_p->offset = offset;
+            offset += KV_REC_SIZE(entry_p->key_len, entry_p->value_len);
+        }
+    }
+    cfg_dyn_p->gen = gen;
+    cfg_dyn_p->end = offset;
+    cfg_dyn_p->stats.compactions++;
+    OS_LOG(D_DEBUG, "Kv compacted: log %u/%u", cfg_dyn_p->end, cfg_dyn_p->capacity);
+    return s;
+error:
+    OS_LOG_S(D_WARNING, s);
+    if (OS_TRUE == is_file) {
+        if (OS_NULL != log.fhd) { OS_FileClose(&log.fhd); }
+        OS_FileDelete(cfg_dyn_p->tmp_path_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+void KvCompactSchedule(OS_KvConfigDyn* cfg_dyn_p)
+{
+const U32 garbage = cfg_dyn_p->end - sizeof(KvLogHeader) - cfg_dyn_p->live;
+    if (OS_TRUE == cfg_dyn_p->is_compact_pending) { return; }
+    if (((U64)garbage * 100) < ((U64)cfg_dyn_p->capacity * OS_KV_COMPACT_GARBAGE_PCT)) { return; }
+    // The file system daemon does the background compaction.
+    const OS_TaskHd fsd_thd = OS_TaskByNameGet(OS_DAEMON_NAME_FS);
+    if (OS_NULL == fsd_thd) { return; }
+    const OS_KvHd kvhd = (OS_KvHd)cfg_dyn_p;
+    OS_Message* msg_p = OS_MessageCreate(OS_MSG_FS_KV_COMPACT, (OS_MessageData)&kvhd, sizeof(kvhd), OS_NO_BLOCK);
+    if (OS_NULL == msg_p) { return; }
+    IF_OK(OS_MessageSend(OS_TaskStdInGet(fsd_thd), msg_p, OS_NO_BLOCK, OS_MSG_PRIO_NORMAL)) {
+        cfg_dyn_p->is_compact_pending = OS_TRUE;
+    } else {
+        OS_MessageDelete(msg_p);
+    }
+}
+
+/******************************************************************************/
+ConstStrP KvPathNoDrive(ConstStrP path_p)
+{
+    // f_rename() does not allow drive letters in the destination path.
+    ConstStrP delim_p = (ConstStrP)OS_StrChr((const char*)path_p, OS_FILE_SYSTEM_DRV_DELIM);
+    return (OS_NULL == delim_p) ? path_p : (delim_p + 1);
+}
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_KV_ENABLED)
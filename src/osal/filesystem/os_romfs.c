@@ -0,0 +1,597 @@
+/***************************************************************************//**
+* @file    os_romfs.c
+* @brief   OS Read-only asset file system.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_ROMFS_ENABLED)
+
+#include "diskio.h"
+#include "drv_media.h"
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_mutex.h"
+#include "os_romfs.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "romfs"
+
+//------------------------------------------------------------------------------
+// Image layout. Should match tls/mkromfs/mkromfs.py.
+#define ROMFS_MAGIC         0x53464D52UL    // "RMFS"
+#define ROMFS_VERSION       1
+#define ROMFS_SLOT_DIRECT   BIT(31)         // Single key bucket: the slot is in the displacement.
+#define ROMFS_SECTOR_SIZE   OS_FILE_SYSTEM_SECTOR_SIZE_MIN
+#define ROMFS_SECTORS_MAX   128             // disk_read() sectors count limit.
+#define ROMFS_SECTOR_UNDEF  U32_MAX
+
+// Image header (the image start).
+typedef struct {
+    U32                 magic;
+    U16                 version;
+    U16                 align;      // Files data alignment.
+    U32                 size;       // Image size.
+    U32                 entries;    // Files count.
+    U32                 buckets;    // Displacements count.
+    U32                 seed;       // Buckets hash seed.
+    U32                 index_size; // Header, displacements, entries, slots and paths size.
+    U32                 crc;        // Index CRC (without the header).
+} RomFsHeader;
+
+// File entry (the entries are sorted by the path).
+typedef struct {
+    U32                 path;       // Path offset.
+    U32                 data;       // Data offset.
+    U32                 size;
+    U32                 date_time;  // FAT date (high half) and time.
+} RomFsEntry;
+
+typedef struct {
+    RomFsHeader         header;
+    OS_FileSystemHd     fshd;
+    const U8*           image_p;    // Memory mapped image.
+    const U8*           index_p;    // Image index (mapped or loaded).
+    const U32*          disp_p;
+    const RomFsEntry*   entries_p;
+    const U32*          slots_p;
+    U8*                 sec_buf_p;  // Media image sector buffer.
+    U32                 sec_idx;    // Buffered sector.
+    OS_MutexHd          mutex;      // Sector buffer protection.
+    U32                 files;      // Opened files count.
+    U32                 lookups;
+    U32                 misses;
+    U8                  volume;
+} RomFs;
+
+//------------------------------------------------------------------------------
+// FIL members usage by the romfs files:
+// fs - the volume file system object (isn't mounted by FatFs, so FatFs rejects the handle),
+// fptr, fsize - as FatFs, sclust - entry index, clust - data offset.
+// DIR members usage: sclust - next entry index, clust - range end, sect - path prefix length.
+
+//------------------------------------------------------------------------------
+static U32          RomFsHash(ConstStrP path_p, const Size len, const U32 seed);
+static RomFs*       RomFsByFsGet(const FATFS* fs_p);
+static RomFs*       RomFsPathParse(ConstStrP path_p, ConstStrP* rel_path_pp, Size* len_p);
+static ConstStrP    RomFsPathGet(const RomFs* romfs_p, const U32 idx);
+static U32          RomFsLookup(RomFs* romfs_p, ConstStrP path_p, const Size len);
+static S32          RomFsPrefixCmp(ConstStrP path_p, ConstStrP prefix_p, const Size len);
+static void         RomFsRangeGet(const RomFs* romfs_p, ConstStrP prefix_p, const Size len, U32* begin_p, U32* end_p);
+static Status       RomFsRead(RomFs* romfs_p, U32 offset, void* data_in_p, Size size);
+static Status       RomFsIndexCheck(const RomFs* romfs_p);
+static void         RomFsStatsFill(const RomFsEntry* entry_p, ConstStrP name_p, const Size len,
+                                   const Bool is_dir, OS_FileStats* file_stats_p);
+static void         RomFsFree(RomFs* romfs_p);
+
+//------------------------------------------------------------------------------
+static RomFs* romfs_v[OS_FILE_SYSTEM_VOLUMES_MAX];
+
+/******************************************************************************/
+Status OS_RomFsMount(const U8 volume, const OS_DriverHd dhd, const OS_FileSystemHd fshd)
+{
+void* image_p = OS_NULL;
+Status s;
+    OS_LOG(D_DEBUG, "Mount: %d", volume);
+    if ((OS_NULL == dhd) || (OS_NULL == fshd)) { return S_INVALID_PTR; }
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return S_INVALID_VALUE; }
+    if (OS_NULL != romfs_v[volume]) { return S_INVALID_STATE; }
+    RomFs* romfs_p = (RomFs*)OS_Malloc(sizeof(RomFs));
+    if (OS_NULL == romfs_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(romfs_p, 0, sizeof(RomFs));
+    romfs_p->volume = volume;
+    romfs_p->fshd   = fshd;
+    romfs_p->sec_idx= ROMFS_SECTOR_UNDEF;
+    IF_OK(OS_DriverIoCtl(dhd, DRV_REQ_MEDIA_ADDRESS_GET, &image_p)) {
+        romfs_p->image_p = (const U8*)image_p;
+    } else {
+        // The image is read by the sectors.
+        romfs_p->sec_buf_p = (U8*)OS_Malloc(ROMFS_SECTOR_SIZE);
+        romfs_p->mutex = OS_MutexCreate();
+        if ((OS_NULL == romfs_p->sec_buf_p) || (OS_NULL == romfs_p->mutex)) { s = S_OUT_OF_MEMORY; goto error; }
+    }
+    IF_STATUS(s = RomFsRead(romfs_p, 0, &romfs_p->header, sizeof(RomFsHeader))) { goto error; }
+    {
+        const RomFsHeader* header_p = &romfs_p->header;
+        const U32 tables_size = sizeof(RomFsHeader) + header_p->buckets * sizeof(U32) +
+                                header_p->entries * (sizeof(RomFsEntry) + sizeof(U32));
+        if ((ROMFS_MAGIC != header_p->magic) || (ROMFS_VERSION != header_p->version)) {
+            s = S_FS_NO_FILESYSTEM;
+            goto error;
+        }
+        if ((0 == header_p->entries) || (0 == header_p->buckets) ||
+            (tables_size > header_p->index_size) || (header_p->index_size > header_p->size) ||
+            (header_p->index_size % sizeof(U32))) {
+            s = S_INVALID_SIZE;
+            goto error;
+        }
+        if (OS_NULL != romfs_p->image_p) {
+            romfs_p->index_p = romfs_p->image_p;
+        } else {
+            U8* index_p = (U8*)OS_Malloc(header_p->index_size);
+            if (OS_NULL == index_p) { s = S_OUT_OF_MEMORY; goto error; }
+            romfs_p->index_p = index_p;
+            IF_STATUS(s = RomFsRead(romfs_p, 0, index_p, header_p->index_size)) { goto error; }
+        }
+        if (header_p->crc != OS_MemCrc32(romfs_p->index_p + sizeof(RomFsHeader),
+                                         header_p->index_size - sizeof(RomFsHeader))) {
+            s = S_INVALID_CRC;
+            goto error;
+        }
+        romfs_p->disp_p     = (const U32*)(romfs_p->index_p + sizeof(RomFsHeader));
+        romfs_p->entries_p  = (const RomFsEntry*)(romfs_p->disp_p + header_p->buckets);
+        romfs_p->slots_p    = (const U32*)(romfs_p->entries_p + header_p->entries);
+    }
+    IF_STATUS(s = RomFsIndexCheck(romfs_p)) { goto error; }
+    // Unmounted by FatFs (the romfs handles mark).
+    OS_MemSet(fshd, 0, sizeof(FATFS));
+    OS_CriticalSectionEnter(); {
+        romfs_v[volume] = romfs_p;
+    } OS_CriticalSectionExit();
+    OS_LOG(D_DEBUG, "Mounted: %u files, %u bytes%s", romfs_p->header.entries, romfs_p->header.size,
+           (OS_NULL != romfs_p->image_p) ? ", mapped" : "");
+    return s;
+error:
+    OS_LOG_S(D_WARNING, s);
+    RomFsFree(romfs_p);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_RomFsUnMount(const U8 volume)
+{
+RomFs* romfs_p;
+    OS_LOG(D_DEBUG, "Unmount: %d", volume);
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return S_INVALID_VALUE; }
+    OS_CriticalSectionEnter(); {
+        romfs_p = romfs_v[volume];
+        if ((OS_NULL != romfs_p) && (0 == romfs_p->files)) {
+            romfs_v[volume] = OS_NULL;
+        }
+    } OS_CriticalSectionExit();
+    if (OS_NULL == romfs_p) { return S_FS_UNMOUNTED; }
+    if (OS_NULL != romfs_v[volume]) { return S_BUSY; }
+    RomFsFree(romfs_p);
+    return S_OK;
+}
+
+/******************************************************************************/
+void RomFsFree(RomFs* romfs_p)
+{
+    if (romfs_p->index_p != romfs_p->image_p) {
+        OS_Free((void*)romfs_p->index_p);
+    }
+    if (OS_NULL != romfs_p->mutex) {
+        OS_MutexDelete(romfs_p->mutex);
+    }
+    OS_Free(romfs_p->sec_buf_p);
+    OS_Free(romfs_p);
+}
+
+/******************************************************************************/
+Bool OS_RomFsPathIs(ConstStrP path_p)
+{
+ConstStrP rel_path_p;
+Size len;
+    return (OS_NULL != RomFsPathParse(path_p, &rel_path_p, &len)) ? OS_TRUE : OS_FALSE;
+}
+
+/******************************************************************************/
+Bool OS_RomFsFileIs(const OS_FileHd fhd)
+{
+    if (OS_NULL == fhd) { return OS_FALSE; }
+    return (OS_NULL != RomFsByFsGet(fhd->fs)) ? OS_TRUE : OS_FALSE;
+}
+
+/******************************************************************************/
+Bool OS_RomFsDirIs(const OS_DirHd dhd)
+{
+    if (OS_NULL == dhd) { return OS_FALSE; }
+    return (OS_NULL != RomFsByFsGet(dhd->fs)) ? OS_TRUE : OS_FALSE;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileOpen(const OS_FileHd fhd, ConstStrP file_path_p, const OS_FileOpenMode op_mode)
+{
+ConstStrP rel_path_p;
+Size len;
+    OS_LOG(D_DEBUG, "File open: %s", file_path_p);
+    if (OS_NULL == fhd) { return S_INVALID_PTR; }
+    fhd->fs = OS_NULL;
+    if (op_mode & (BIT(OS_FS_FILE_OP_MODE_CREATE_NEW) | BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) |
+                   BIT(OS_FS_FILE_OP_MODE_OPEN_NEW) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+        return S_FS_WRITE_PROTECTED;
+    }
+    RomFs* romfs_p = RomFsPathParse(file_path_p, &rel_path_p, &len);
+    if (OS_NULL == romfs_p) { return S_FS_NOT_ENABLED; }
+    const U32 idx = RomFsLookup(romfs_p, rel_path_p, len);
+    if (U32_MAX == idx) { return S_FS_FILE_NOT_FOUND; }
+    const RomFsEntry* entry_p = &romfs_p->entries_p[idx];
+    fhd->id     = 0;
+    fhd->flag   = FA_READ;
+    fhd->err    = 0;
+    fhd->fptr   = 0;
+    fhd->fsize  = entry_p->size;
+    fhd->sclust = idx;
+    fhd->clust  = entry_p->data;
+    fhd->dsect  = 0;
+    OS_CriticalSectionEnter(); {
+        romfs_p->files++;
+        fhd->fs = romfs_p->fshd;
+    } OS_CriticalSectionExit();
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileClose(const OS_FileHd fhd)
+{
+    if (OS_NULL == fhd) { return S_INVALID_PTR; }
+    RomFs* romfs_p = RomFsByFsGet(fhd->fs);
+    if (OS_NULL == romfs_p) { return S_FS_OBJECT_INVALID; }
+    OS_CriticalSectionEnter(); {
+        romfs_p->files--;
+        fhd->fs = OS_NULL;
+    } OS_CriticalSectionExit();
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileRead(const OS_FileHd fhd, void* data_in_p, const Size size, UInt* bytes_read_p)
+{
+Status s;
+    *bytes_read_p = 0;
+    RomFs* romfs_p = RomFsByFsGet(fhd->fs);
+    if (OS_NULL == romfs_p) { return S_FS_OBJECT_INVALID; }
+    const Size count = MIN(size, fhd->fsize - fhd->fptr);
+    if (0 == count) { return S_OK; }
+    IF_OK(s = RomFsRead(romfs_p, fhd->clust + fhd->fptr, data_in_p, count)) {
+        fhd->fptr += count;
+        *bytes_read_p = count;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileLSeek(const OS_FileHd fhd, const U32 offset)
+{
+    if (OS_NULL == RomFsByFsGet(fhd->fs)) { return S_FS_OBJECT_INVALID; }
+    // Read mode: the file isn't expanded.
+    fhd->fptr = MIN(offset, fhd->fsize);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileGetS(const OS_FileHd fhd, StrP str_p, const U32 len)
+{
+U32 i = 0;
+Status s = S_OK;
+    if ((OS_NULL == str_p) || (0 == len)) { return S_INVALID_ARG; }
+    while ((i + 1) < len) {
+        Str c;
+        UInt bytes_read;
+        IF_STATUS(s = OS_RomFsFileRead(fhd, &c, 1, &bytes_read)) { break; }
+        if (0 == bytes_read) { break; }
+        str_p[i++] = c;
+        if ('\n' == c) { break; }
+    }
+    str_p[i] = '\0';
+    IF_STATUS(s) { return s; }
+    return (0 == i) ? S_FS_EOF : S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileMap(const OS_FileHd fhd, const U32 offset, const Size size, const void** data_pp)
+{
+    if ((OS_NULL == fhd) || (OS_NULL == data_pp)) { return S_INVALID_PTR; }
+    const RomFs* romfs_p = RomFsByFsGet(fhd->fs);
+    if (OS_NULL == romfs_p) { return S_FS_OBJECT_INVALID; }
+    if (OS_NULL == romfs_p->image_p) { return S_FS_NOT_ENABLED; }
+    if ((offset > fhd->fsize) || (size > (fhd->fsize - offset))) { return S_INVALID_SIZE; }
+    *data_pp = (const void*)(romfs_p->image_p + fhd->clust + offset);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsFileStatsGet(ConstStrP file_path_p, OS_FileStats* file_stats_p)
+{
+ConstStrP rel_path_p;
+Size len;
+U32 begin, end;
+    if ((OS_NULL == file_path_p) || (OS_NULL == file_stats_p)) { return S_INVALID_PTR; }
+    RomFs* romfs_p = RomFsPathParse(file_path_p, &rel_path_p, &len);
+    if (OS_NULL == romfs_p) { return S_FS_NOT_ENABLED; }
+    // The name is the last path item.
+    ConstStrP name_p = rel_path_p + len;
+    while ((name_p != rel_path_p) && (OS_FILE_SYSTEM_DIR_DELIM != *(name_p - 1))) { --name_p; }
+    const U32 idx = RomFsLookup(romfs_p, rel_path_p, len);
+    if (U32_MAX != idx) {
+        RomFsStatsFill(&romfs_p->entries_p[idx], name_p, len - (name_p - rel_path_p), OS_FALSE, file_stats_p);
+        return S_OK;
+    }
+    // Directories aren't in the index: the path is the items prefix.
+    RomFsRangeGet(romfs_p, rel_path_p, len, &begin, &end);
+    if (begin == end) { return S_FS_FILE_NOT_FOUND; }
+    RomFsStatsFill(&romfs_p->entries_p[begin], name_p, len - (name_p - rel_path_p), OS_TRUE, file_stats_p);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsDirectoryOpen(const OS_DirHd dhd, ConstStrP path_p)
+{
+ConstStrP rel_path_p;
+Size len;
+U32 begin, end;
+    OS_LOG(D_DEBUG, "Dir open: %s", path_p);
+    if (OS_NULL == dhd) { return S_INVALID_PTR; }
+    RomFs* romfs_p = RomFsPathParse(path_p, &rel_path_p, &len);
+    if (OS_NULL == romfs_p) { return S_FS_NOT_ENABLED; }
+    RomFsRangeGet(romfs_p, rel_path_p, len, &begin, &end);
+    if ((0 != len) && (begin == end)) { return S_FS_PATH_NOT_FOUND; }
+    dhd->fs     = romfs_p->fshd;
+    dhd->id     = 0;
+    dhd->index  = 0;
+    dhd->sclust = begin;
+    dhd->clust  = end;
+    dhd->sect   = (0 != len) ? (len + 1) : 0; // The prefix with the delimiter.
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsDirectoryRead(const OS_DirHd dhd, OS_FileStats* file_stats_p)
+{
+    if ((OS_NULL == dhd) || (OS_NULL == file_stats_p)) { return S_INVALID_PTR; }
+    const RomFs* romfs_p = RomFsByFsGet(dhd->fs);
+    if (OS_NULL == romfs_p) { return S_FS_OBJECT_INVALID; }
+    if (dhd->sclust >= dhd->clust) {
+        // The directory end.
+        RomFsStatsFill(OS_NULL, "", 0, OS_FALSE, file_stats_p);
+        return S_OK;
+    }
+    const U32 idx = dhd->sclust;
+    ConstStrP name_p = RomFsPathGet(romfs_p, idx) + dhd->sect;
+    ConstStrP delim_p = (ConstStrP)OS_StrChr((const char*)name_p, OS_FILE_SYSTEM_DIR_DELIM);
+    if (OS_NULL == delim_p) {
+        RomFsStatsFill(&romfs_p->entries_p[idx], name_p, OS_StrLen((const char*)name_p), OS_FALSE, file_stats_p);
+        dhd->sclust++;
+    } else {
+        // The subdirectory items are contiguous: skip them.
+        const Size len = delim_p - name_p + 1;
+        U32 next = idx + 1;
+        while ((next < dhd->clust) &&
+               !OS_StrNCmp((const char*)(RomFsPathGet(romfs_p, next) + dhd->sect), (const char*)name_p, len)) {
+            ++next;
+        }
+        RomFsStatsFill(&romfs_p->entries_p[idx], name_p, len - 1, OS_TRUE, file_stats_p);
+        dhd->sclust = next;
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_RomFsStatsGet(const U8 volume, OS_RomFsStats* stats_p)
+{
+    if (OS_NULL == stats_p) { return S_INVALID_PTR; }
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return S_INVALID_VALUE; }
+    const RomFs* romfs_p = romfs_v[volume];
+    if (OS_NULL == romfs_p) { return S_FS_UNMOUNTED; }
+    stats_p->entries    = romfs_p->header.entries;
+    stats_p->image_size = romfs_p->header.size;
+    stats_p->index_size = romfs_p->header.index_size;
+    stats_p->lookups    = romfs_p->lookups;
+    stats_p->misses     = romfs_p->misses;
+    stats_p->is_mapped  = (OS_NULL != romfs_p->image_p) ? OS_TRUE : OS_FALSE;
+    return S_OK;
+}
+
+/******************************************************************************/
+U32 RomFsHash(ConstStrP path_p, const Size len, const U32 seed)
+{
+U32 hash = 2166136261UL ^ seed; // FNV-1a with the seeded basis.
+    for (Size i = 0; i < len; ++i) {
+        hash ^= (U8)path_p[i];
+        hash *= 16777619UL;
+    }
+    // Finalizer (the low bits are used by the modulo).
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BUL;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35UL;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/******************************************************************************/
+RomFs* RomFsByFsGet(const FATFS* fs_p)
+{
+    // FatFs mounted objects are skipped fast.
+    if ((OS_NULL == fs_p) || (0 != fs_p->fs_type)) { return OS_NULL; }
+    for (U8 i = 0; i < OS_FILE_SYSTEM_VOLUMES_MAX; ++i) {
+        RomFs* romfs_p = romfs_v[i];
+        if ((OS_NULL != romfs_p) && (fs_p == romfs_p->fshd)) { return romfs_p; }
+    }
+    return OS_NULL;
+}
+
+/******************************************************************************/
+RomFs* RomFsPathParse(ConstStrP path_p, ConstStrP* rel_path_pp, Size* len_p)
+{
+    if (OS_NULL == path_p) { return OS_NULL; }
+    // The volume prefix is required (the current volume is FatFs).
+    if (('0' > path_p[0]) || ('9' < path_p[0]) || (OS_FILE_SYSTEM_DRV_DELIM != path_p[1])) { return OS_NULL; }
+    const U8 volume = path_p[0] - '0';
+    if (OS_FILE_SYSTEM_VOLUMES_MAX <= volume) { return OS_NULL; }
+    RomFs* romfs_p = romfs_v[volume];
+    if (OS_NULL == romfs_p) { return OS_NULL; }
+    ConstStrP rel_path_p = path_p + 2;
+    while (OS_FILE_SYSTEM_DIR_DELIM == *rel_path_p) { ++rel_path_p; }
+    Size len = OS_StrLen((const char*)rel_path_p);
+    while ((0 < len) && (OS_FILE_SYSTEM_DIR_DELIM == rel_path_p[len - 1])) { --len; }
+    *rel_path_pp = rel_path_p;
+    *len_p = len;
+    return romfs_p;
+}
+
+/******************************************************************************/
+ConstStrP RomFsPathGet(const RomFs* romfs_p, const U32 idx)
+{
+    return (ConstStrP)(romfs_p->index_p + romfs_p->entries_p[idx].path);
+}
+
+/******************************************************************************/
+U32 RomFsLookup(RomFs* romfs_p, ConstStrP path_p, const Size len)
+{
+const RomFsHeader* header_p = &romfs_p->header;
+    romfs_p->lookups++;
+    const U32 disp = romfs_p->disp_p[RomFsHash(path_p, len, header_p->seed) % header_p->buckets];
+    const U32 slot = (disp & ROMFS_SLOT_DIRECT) ? (disp & ~ROMFS_SLOT_DIRECT) :
+                                                  (RomFsHash(path_p, len, disp) % header_p->entries);
+    const U32 idx = romfs_p->slots_p[slot];
+    // The perfect hash maps the foreign paths too: one compare.
+    ConstStrP entry_path_p = RomFsPathGet(romfs_p, idx);
+    if (OS_StrNCmp((const char*)entry_path_p, (const char*)path_p, len) || ('\0' != entry_path_p[len])) {
+        romfs_p->misses++;
+        return U32_MAX;
+    }
+    return idx;
+}
+
+/******************************************************************************/
+S32 RomFsPrefixCmp(ConstStrP path_p, ConstStrP prefix_p, const Size len)
+{
+    if (0 == len) { return 0; } // Root.
+    const S32 r = OS_StrNCmp((const char*)path_p, (const char*)prefix_p, len);
+    if (0 != r) { return r; }
+    return (S32)(U8)path_p[len] - (S32)(U8)OS_FILE_SYSTEM_DIR_DELIM;
+}
+
+/******************************************************************************/
+void RomFsRangeGet(const RomFs* romfs_p, ConstStrP prefix_p, const Size len, U32* begin_p, U32* end_p)
+{
+U32 lo = 0;
+U32 hi = romfs_p->header.entries;
+    // The sorted paths with the "prefix/" start are contiguous.
+    while (lo < hi) {
+        const U32 mid = lo + (hi - lo) / 2;
+        if (0 > RomFsPrefixCmp(RomFsPathGet(romfs_p, mid), prefix_p, len)) { lo = mid + 1; } else { hi = mid; }
+    }
+    *begin_p = lo;
+    hi = romfs_p->header.entries;
+    while (lo < hi) {
+        const U32 mid = lo + (hi - lo) / 2;
+        if (0 >= RomFsPrefixCmp(RomFsPathGet(romfs_p, mid), prefix_p, len)) { lo = mid + 1; } else { hi = mid; }
+    }
+    *end_p = lo;
+}
+
+/******************************************************************************/
+Status RomFsRead(RomFs* romfs_p, U32 offset, void* data_in_p, Size size)
+{
+U8* data_p = (U8*)data_in_p;
+Status s = S_OK;
+    if (OS_NULL != romfs_p->image_p) {
+        OS_MemCpy(data_p, romfs_p->image_p + offset, size);
+        return s;
+    }
+    while (0 < size) {
+        const U32 sector = offset / ROMFS_SECTOR_SIZE;
+        const Size sector_offset = offset % ROMFS_SECTOR_SIZE;
+        Size chunk;
+        if ((0 == sector_offset) && (ROMFS_SECTOR_SIZE <= size)) {
+            // Whole sectors are read to the buffer directly.
+            const U32 count = MIN(size / ROMFS_SECTOR_SIZE, ROMFS_SECTORS_MAX);
+            if (RES_OK != disk_read(romfs_p->volume, data_p, sector, count)) { return S_FS_MEDIA_FAULT; }
+            chunk = count * ROMFS_SECTOR_SIZE;
+        } else {
+            chunk = MIN(size, ROMFS_SECTOR_SIZE - sector_offset);
+            IF_STATUS(s = OS_MutexLock(romfs_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) { return s; }
+            if (sector != romfs_p->sec_idx) {
+                if (RES_OK == disk_read(romfs_p->volume, romfs_p->sec_buf_p, sector, 1)) {
+                    romfs_p->sec_idx = sector;
+                } else {
+                    romfs_p->sec_idx = ROMFS_SECTOR_UNDEF;
+                    s = S_FS_MEDIA_FAULT;
+                }
+            }
+            IF_OK(s) {
+                OS_MemCpy(data_p, romfs_p->sec_buf_p + sector_offset, chunk);
+            }
+            OS_MutexUnlock(romfs_p->mutex);
+            IF_STATUS(s) { return s; }
+        }
+        data_p += chunk;
+        offset += chunk;
+        size   -= chunk;
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status RomFsIndexCheck(const RomFs* romfs_p)
+{
+const RomFsHeader* header_p = &romfs_p->header;
+    // The lookups don't check the offsets then.
+    for (U32 i = 0; i < header_p->entries; ++i) {
+        const RomFsEntry* entry_p = &romfs_p->entries_p[i];
+        if ((header_p->index_size <= entry_p->path) ||
+            (header_p->size < entry_p->data) || (entry_p->size > (header_p->size - entry_p->data)) ||
+            (header_p->entries <= romfs_p->slots_p[i])) {
+            return S_INVALID_VALUE;
+        }
+    }
+    // The paths are terminated inside the index.
+    if ('\0' != romfs_p->index_p[header_p->index_size - 1]) { return S_INVALID_VALUE; }
+    return S_OK;
+}
+
+/******************************************************************************/
+void RomFsStatsFill(const RomFsEntry* entry_p, ConstStrP name_p, const Size len,
+                    const Bool is_dir, OS_FileStats* file_stats_p)
+{
+const Size name_len = MIN(len, sizeof(file_stats_p->name) - 1);
+    OS_MemCpy(file_stats_p->name, name_p, name_len);
+    file_stats_p->name[name_len] = '\0';
+#if defined(OS_FILE_SYSTEM_LONG_NAMES_ENABLED)
+    // FatFs way: the long name is set if the name doesn't fit the short one.
+    if ((OS_NULL != file_stats_p->long_name_p) && (0 < file_stats_p->long_name_size)) {
+        const Size long_len = (name_len < len) ? MIN(len, file_stats_p->long_name_size - 1) : 0;
+        OS_MemCpy(file_stats_p->long_name_p, name_p, long_len);
+        file_stats_p->long_name_p[long_len] = '\0';
+    }
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    file_stats_p->size  = ((OS_NULL != entry_p) && (OS_FALSE == is_dir)) ? entry_p->size : 0;
+    file_stats_p->attrs = BIT(OS_FS_FILE_ATTR_RDO);
+    if (OS_TRUE == is_dir) {
+        BIT_SET(file_stats_p->attrs, BIT(OS_FS_FILE_ATTR_DIR));
+    }
+    OS_MemSet(&file_stats_p->date_time, 0, sizeof(file_stats_p->date_time));
+    if (OS_NULL != entry_p) {
+        const U32 date_time = entry_p->date_time;
+        file_stats_p->date_time.year    = BF_GET(date_time, 25, 7) + OS_FILE_SYSTEM_YEAR_BASE;
+        file_stats_p->date_time.month   = BF_GET(date_time, 21, 4);
+        file_stats_p->date_time.day     = BF_GET(date_time, 16, 5);
+        file_stats_p->date_time.hours   = BF_GET(date_time, 11, 5);
+        file_stats_p->date_time.minutes = BF_GET(date_time, 5,  6);
+        file_stats_p->date_time.seconds = BF_GET(date_time, 0,  5) * 2;
+    }
+}
+
+#endif // (OS_FILE_SYSTEM_ENABLED) && (OS_ROMFS_ENABLED)
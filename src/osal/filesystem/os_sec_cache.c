@@ -0,0 +1,480 @@
+/***************************************************************************//**
+* @file    os_sec_cache.c
+* @brief   OS Media sector cache.
+* @author  A. Filyanov
+*******************************************************************************/
+#include "os_config.h"
+#if (OS_FILE_SYSTEM_ENABLED) && (OS_SEC_CACHE_ENABLED)
+
+#include "os_debug.h"
+#include "os_memory.h"
+#include "os_mutex.h"
+#include "os_sec_cache.h"
+
+//-----------------------------------------------------------------------------
+#define MDL_NAME            "sec_cache"
+
+#define OS_SEC_CACHE_LINE_UNDEF     -1
+#define OS_SEC_CACHE_HASH_GET(sector)   ((sector) & (OS_SEC_CACHE_HASH_SIZE - 1))
+
+//------------------------------------------------------------------------------
+typedef struct {
+    U32                 sector;
+    S16                 hash_next;
+    S16                 lru_prev;   // To the more recently used.
+    S16                 lru_next;   // To the less recently used.
+    Bool                is_valid;
+    Bool                is_dirty;
+} OS_SecCacheLine;
+
+typedef struct {
+    U32                 sector;
+    U32                 count;
+} OS_SecCacheRegion;
+
+typedef struct {
+    OS_DriverHd         dhd;
+    OS_BlkSchedHd       bshd;
+    OS_MutexHd          mutex;
+    U8*                 data_p;     // Lines data.
+    S16                 lru_head;   // Most recently used.
+    S16                 lru_tail;   // Least recently used.
+    S16                 hash_v[OS_SEC_CACHE_HASH_SIZE];
+    OS_SecCacheLine     lines_v[OS_SEC_CACHE_SECTORS];
+    OS_SecCacheRegion   wt_v[OS_SEC_CACHE_WT_REGIONS_MAX];
+    OS_SecCacheStats    stats;
+} OS_SecCacheConfigDyn;
+
+/******************************************************************************/
+static U8* OS_SecCacheLineDataGet(const OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx);
+INLINE U8* OS_SecCacheLineDataGet(const OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx)
+{
+    return cfg_dyn_p->data_p + (idx * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+}
+
+/******************************************************************************/
+static Status OS_SecCacheMediaRead(const OS_SecCacheConfigDyn* cfg_dyn_p, void* data_in_p, const U32 sector, const U32 count);
+Status OS_SecCacheMediaRead(const OS_SecCacheConfigDyn* cfg_dyn_p, void* data_in_p, const U32 sector, const U32 count)
+{
+#if (OS_BLK_SCHED_ENABLED)
+    if (OS_NULL != cfg_dyn_p->bshd) {
+        return OS_BlkSchedRead(cfg_dyn_p->bshd, data_in_p, sector, count);
+    }
+#endif //(OS_BLK_SCHED_ENABLED)
+    U32 lba = sector;
+    return OS_DriverRead(cfg_dyn_p->dhd, data_in_p, count, &lba);
+}
+
+/******************************************************************************/
+static Status OS_SecCacheMediaWrite(const OS_SecCacheConfigDyn* cfg_dyn_p, void* data_out_p, const U32 sector, const U32 count);
+Status OS_SecCacheMediaWrite(const OS_SecCacheConfigDyn* cfg_dyn_p, void* data_out_p, const U32 sector, const U32 count)
+{
+#if (OS_BLK_SCHED_ENABLED)
+    if (OS_NULL != cfg_dyn_p->bshd) {
+        return OS_BlkSchedWrite(cfg_dyn_p->bshd, data_out_p, sector, count);
+    }
+#endif //(OS_BLK_SCHED_ENABLED)
+    U32 lba = sector;
+    return OS_DriverWrite(cfg_dyn_p->dhd, data_out_p, count, &lba);
+}
+
+/******************************************************************************/
+static S16 OS_SecCacheLineFind(const OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector);
+S16 OS_SecCacheLineFind(const OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector)
+{
+S16 idx = cfg_dyn_p->hash_v[OS_SEC_CACHE_HASH_GET(sector)];
+    while (OS_SEC_CACHE_LINE_UNDEF != idx) {
+        if (sector == cfg_dyn_p->lines_v[idx].sector) { break; }
+        idx = cfg_dyn_p->lines_v[idx].hash_next;
+    }
+    return idx;
+}
+
+/******************************************************************************/
+static void OS_SecCacheHashRemove(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx);
+void OS_SecCacheHashRemove(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx)
+{
+S16* link_p = &cfg_dyn_p->hash_v[OS_SEC_CACHE_HASH_GET(cfg_dyn_p->lines_v[idx].sector)];
+    while (OS_SEC_CACHE_LINE_UNDEF != *link_p) {
+        if (idx == *link_p) {
+            *link_p = cfg_dyn_p->lines_v[idx].hash_next;
+            break;
+        }
+        link_p = &cfg_dyn_p->lines_v[*link_p].hash_next;
+    }
+    cfg_dyn_p->lines_v[idx].hash_next = OS_SEC_CACHE_LINE_UNDEF;
+}
+
+/******************************************************************************/
+static void OS_SecCacheLineTouch(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx);
+void OS_SecCacheLineTouch(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx)
+{
+OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[idx];
+    if (idx == cfg_dyn_p->lru_head) { return; }
+    // Unlink.
+    cfg_dyn_p->lines_v[line_p->lru_prev].lru_next = line_p->lru_next;
+    if (OS_SEC_CACHE_LINE_UNDEF != line_p->lru_next) {
+        cfg_dyn_p->lines_v[line_p->lru_next].lru_prev = line_p->lru_prev;
+    } else {
+        cfg_dyn_p->lru_tail = line_p->lru_prev;
+    }
+    // Push to the head.
+    line_p->lru_prev = OS_SEC_CACHE_LINE_UNDEF;
+    line_p->lru_next = cfg_dyn_p->lru_head;
+    cfg_dyn_p->lines_v[cfg_dyn_p->lru_head].lru_prev = idx;
+    cfg_dyn_p->lru_head = idx;
+}
+
+/******************************************************************************/
+static Status OS_SecCacheLineWriteBack(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx);
+Status OS_SecCacheLineWriteBack(OS_SecCacheConfigDyn* cfg_dyn_p, const S16 idx)
+{
+OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[idx];
+Status s = S_OK;
+    if ((OS_TRUE == line_p->is_valid) && (OS_TRUE == line_p->is_dirty)) {
+        IF_OK(s = OS_SecCacheMediaWrite(cfg_dyn_p, OS_SecCacheLineDataGet(cfg_dyn_p, idx), line_p->sector, 1)) {
+            line_p->is_dirty = OS_FALSE;
+            cfg_dyn_p->stats.write_backs++;
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+// Get the least recently used line and bind it to the sector (the line data is undefined).
+static S16 OS_SecCacheLineAlloc(OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector, Status* s_p);
+S16 OS_SecCacheLineAlloc(OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector, Status* s_p)
+{
+const S16 idx = cfg_dyn_p->lru_tail;
+OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[idx];
+    IF_STATUS(*s_p = OS_SecCacheLineWriteBack(cfg_dyn_p, idx)) { return OS_SEC_CACHE_LINE_UNDEF; }
+    if (OS_TRUE == line_p->is_valid) {
+        OS_SecCacheHashRemove(cfg_dyn_p, idx);
+        cfg_dyn_p->stats.evictions++;
+    }
+    const U8 hash = OS_SEC_CACHE_HASH_GET(sector);
+    line_p->sector      = sector;
+    line_p->is_valid    = OS_TRUE;
+    line_p->is_dirty    = OS_FALSE;
+    line_p->hash_next   = cfg_dyn_p->hash_v[hash];
+    cfg_dyn_p->hash_v[hash] = idx;
+    OS_SecCacheLineTouch(cfg_dyn_p, idx);
+    return idx;
+}
+
+/******************************************************************************/
+static Bool OS_SecCacheIsWriteThrough(const OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector);
+Bool OS_SecCacheIsWriteThrough(const OS_SecCacheConfigDyn* cfg_dyn_p, const U32 sector)
+{
+    for (U8 i = 0; i < OS_SEC_CACHE_WT_REGIONS_MAX; ++i) {
+        const OS_SecCacheRegion* region_p = &cfg_dyn_p->wt_v[i];
+        if ((sector >= region_p->sector) && (sector < (region_p->sector + region_p->count))) {
+            return OS_TRUE;
+        }
+    }
+    return OS_FALSE;
+}
+
+/******************************************************************************/
+static void OS_SecCacheReset(OS_SecCacheConfigDyn* cfg_dyn_p);
+void OS_SecCacheReset(OS_SecCacheConfigDyn* cfg_dyn_p)
+{
+    for (S16 i = 0; i < OS_SEC_CACHE_HASH_SIZE; ++i) {
+        cfg_dyn_p->hash_v[i] = OS_SEC_CACHE_LINE_UNDEF;
+    }
+    for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+        OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[i];
+        line_p->sector      = 0;
+        line_p->is_valid    = OS_FALSE;
+        line_p->is_dirty    = OS_FALSE;
+        line_p->hash_next   = OS_SEC_CACHE_LINE_UNDEF;
+        line_p->lru_prev    = i - 1;
+        line_p->lru_next    = ((OS_SEC_CACHE_SECTORS - 1) == i) ? OS_SEC_CACHE_LINE_UNDEF : (i + 1);
+    }
+    cfg_dyn_p->lru_head = 0;
+    cfg_dyn_p->lru_tail = OS_SEC_CACHE_SECTORS - 1;
+}
+
+/******************************************************************************/
+Status OS_SecCacheCreate(const OS_DriverHd dhd, const OS_BlkSchedHd bshd, OS_SecCacheHd* schd_p)
+{
+Status s = S_OK;
+    if ((OS_NULL == dhd) || (OS_NULL == schd_p)) { return S_INVALID_PTR; }
+    OS_SecCacheConfigDyn* cfg_dyn_p = OS_Malloc(sizeof(OS_SecCacheConfigDyn));
+    if (OS_NULL == cfg_dyn_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(cfg_dyn_p, 0, sizeof(OS_SecCacheConfigDyn));
+    cfg_dyn_p->dhd  = dhd;
+    cfg_dyn_p->bshd = bshd;
+    cfg_dyn_p->data_p = OS_MallocEx(OS_SEC_CACHE_SECTORS * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_SEC_CACHE_MEM);
+    if (OS_NULL == cfg_dyn_p->data_p) { s = S_OUT_OF_MEMORY; goto error; }
+    cfg_dyn_p->mutex = OS_MutexCreate();
+    if (OS_NULL == cfg_dyn_p->mutex) { s = S_INVALID_PTR; goto error; }
+    OS_SecCacheReset(cfg_dyn_p);
+    *schd_p = (OS_SecCacheHd)cfg_dyn_p;
+error:
+    IF_STATUS(s) {
+        OS_SecCacheDelete((OS_SecCacheHd)cfg_dyn_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheDelete(const OS_SecCacheHd schd)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    if (OS_NULL != cfg_dyn_p->mutex) {
+        OS_MutexDelete(cfg_dyn_p->mutex);
+    }
+    OS_FreeEx(cfg_dyn_p->data_p, OS_SEC_CACHE_MEM);
+    OS_Free(cfg_dyn_p);
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_SecCacheRead(const OS_SecCacheHd schd, void* data_in_p, const U32 sector, const U32 count)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+U8* data_p = (U8*)data_in_p;
+Status s = S_OK;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+    IF_STATUS(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) { return s; }
+    if (OS_SEC_CACHE_BYPASS_SECTORS < count) {
+        cfg_dyn_p->stats.bypasses++;
+        IF_OK(s = OS_SecCacheMediaRead(cfg_dyn_p, data_p, sector, count)) {
+            // The dirty lines are newer than the media.
+            for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+                const OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[i];
+                if ((OS_TRUE == line_p->is_dirty) && (line_p->sector >= sector) && (line_p->sector < (sector + count))) {
+                    OS_MemCpy(data_p + (line_p->sector - sector) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX,
+                              OS_SecCacheLineDataGet(cfg_dyn_p, i), OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+                }
+            }
+        }
+        goto exit;
+    }
+    cfg_dyn_p->stats.reads += count;
+    for (U32 i = 0; i < count;) {
+        S16 idx = OS_SecCacheLineFind(cfg_dyn_p, sector + i);
+        if (OS_SEC_CACHE_LINE_UNDEF != idx) {
+            OS_MemCpy(data_p + i * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_SecCacheLineDataGet(cfg_dyn_p, idx), OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+            OS_SecCacheLineTouch(cfg_dyn_p, idx);
+            cfg_dyn_p->stats.hits++;
+            ++i;
+            continue;
+        }
+        // Read the whole missed run at once and fill the lines from the user buffer.
+        U32 run = 1;
+        while (((i + run) < count) && (OS_SEC_CACHE_LINE_UNDEF == OS_SecCacheLineFind(cfg_dyn_p, sector + i + run))) {
+            ++run;
+        }
+        IF_STATUS(s = OS_SecCacheMediaRead(cfg_dyn_p, data_p + i * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, sector + i, run)) { goto exit; }
+        for (U32 j = 0; j < run; ++j, ++i) {
+            idx = OS_SecCacheLineAlloc(cfg_dyn_p, sector + i, &s);
+            if (OS_SEC_CACHE_LINE_UNDEF == idx) { goto exit; }
+            OS_MemCpy(OS_SecCacheLineDataGet(cfg_dyn_p, idx), data_p + i * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+        }
+    }
+exit:
+    OS_MutexUnlock(cfg_dyn_p->mutex);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheWrite(const OS_SecCacheHd schd, void* data_out_p, const U32 sector, const U32 count)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+U8* data_p = (U8*)data_out_p;
+Status s = S_OK;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == data_p)) { return S_INVALID_PTR; }
+    IF_STATUS(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) { return s; }
+    if (OS_SEC_CACHE_BYPASS_SECTORS < count) {
+        cfg_dyn_p->stats.bypasses++;
+        IF_OK(s = OS_SecCacheMediaWrite(cfg_dyn_p, data_p, sector, count)) {
+            // Refresh the cached copies.
+            for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+                OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[i];
+                if ((OS_TRUE == line_p->is_valid) && (line_p->sector >= sector) && (line_p->sector < (sector + count))) {
+                    OS_MemCpy(OS_SecCacheLineDataGet(cfg_dyn_p, i),
+                              data_p + (line_p->sector - sector) * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+                    line_p->is_dirty = OS_FALSE;
+                }
+            }
+        }
+        goto exit;
+    }
+    cfg_dyn_p->stats.writes += count;
+    for (U32 i = 0; i < count; ++i) {
+        const U32 lba = sector + i;
+        S16 idx = OS_SecCacheLineFind(cfg_dyn_p, lba);
+        if (OS_SEC_CACHE_LINE_UNDEF != idx) {
+            OS_SecCacheLineTouch(cfg_dyn_p, idx);
+            cfg_dyn_p->stats.hits++;
+        } else {
+            idx = OS_SecCacheLineAlloc(cfg_dyn_p, lba, &s);
+            if (OS_SEC_CACHE_LINE_UNDEF == idx) { goto exit; }
+        }
+        U8* line_data_p = OS_SecCacheLineDataGet(cfg_dyn_p, idx);
+        OS_MemCpy(line_data_p, data_p + i * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+        if (OS_TRUE == OS_SecCacheIsWriteThrough(cfg_dyn_p, lba)) {
+            IF_STATUS(s = OS_SecCacheMediaWrite(cfg_dyn_p, line_data_p, lba, 1)) {
+                // Keep the line consistent with the media.
+                OS_SecCacheHashRemove(cfg_dyn_p, idx);
+                cfg_dyn_p->lines_v[idx].is_valid = OS_FALSE;
+                goto exit;
+            }
+            cfg_dyn_p->lines_v[idx].is_dirty = OS_FALSE;
+        } else {
+            cfg_dyn_p->lines_v[idx].is_dirty = OS_TRUE;
+        }
+    }
+exit:
+    OS_MutexUnlock(cfg_dyn_p->mutex);
+    return s;
+}
+
+/******************************************************************************/
+static Status OS_SecCacheFlushLocked(OS_SecCacheConfigDyn* cfg_dyn_p);
+Status OS_SecCacheFlushLocked(OS_SecCacheConfigDyn* cfg_dyn_p)
+{
+Status s = S_OK;
+#if (OS_BLK_SCHED_ENABLED)
+    // Let the scheduler sort and merge the dirty lines.
+    if (OS_NULL != cfg_dyn_p->bshd) {
+        OS_BlkSchedIo* io_v = OS_Malloc(OS_SEC_CACHE_SECTORS * sizeof(OS_BlkSchedIo));
+        S16 line_v[OS_SEC_CACHE_SECTORS];
+        U32 io_count = 0;
+        if (OS_NULL != io_v) {
+            for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+                const OS_SecCacheLine* line_p = &cfg_dyn_p->lines_v[i];
+                if ((OS_TRUE != line_p->is_valid) || (OS_TRUE != line_p->is_dirty)) { continue; }
+                OS_BlkSchedIo* io_p = &io_v[io_count];
+                io_p->data_p    = OS_SecCacheLineDataGet(cfg_dyn_p, i);
+                io_p->sector    = line_p->sector;
+                io_p->count     = 1;
+                io_p->is_write  = OS_TRUE;
+                line_v[io_count++] = i;
+            }
+            s = OS_BlkSchedBatch(cfg_dyn_p->bshd, io_v, io_count);
+            for (U32 i = 0; i < io_count; ++i) {
+                IF_OK(io_v[i].status) {
+                    cfg_dyn_p->lines_v[line_v[i]].is_dirty = OS_FALSE;
+                    cfg_dyn_p->stats.write_backs++;
+                }
+            }
+            OS_Free(io_v);
+            return s;
+        }
+    }
+#endif //(OS_BLK_SCHED_ENABLED)
+    for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+        Status s_line;
+        IF_STATUS(s_line = OS_SecCacheLineWriteBack(cfg_dyn_p, i)) { s = s_line; }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheFlush(const OS_SecCacheHd schd)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) {
+        s = OS_SecCacheFlushLocked(cfg_dyn_p);
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheInvalidate(const OS_SecCacheHd schd)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) {
+        // The dirty lines aren't dropped unwritten.
+        IF_OK(s = OS_SecCacheFlushLocked(cfg_dyn_p)) {
+            OS_SecCacheReset(cfg_dyn_p);
+        }
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheWriteThroughAdd(const OS_SecCacheHd schd, const U32 sector, const U32 count)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    if (0 == count) { return S_INVALID_ARG; }
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) {
+        s = S_OVERFLOW;
+        for (U8 i = 0; i < OS_SEC_CACHE_WT_REGIONS_MAX; ++i) {
+            OS_SecCacheRegion* region_p = &cfg_dyn_p->wt_v[i];
+            if (0 == region_p->count) {
+                region_p->sector= sector;
+                region_p->count = count;
+                s = S_OK;
+                break;
+            }
+        }
+        // Already dirty lines of the region go to the media now.
+        IF_OK(s) {
+            for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+                const U32 lba = cfg_dyn_p->lines_v[i].sector;
+                if ((lba >= sector) && (lba < (sector + count))) {
+                    IF_STATUS(s = OS_SecCacheLineWriteBack(cfg_dyn_p, i)) { break; }
+                }
+            }
+        }
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheWriteThroughClear(const OS_SecCacheHd schd)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+Status s;
+    if (OS_NULL == cfg_dyn_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_FS)) {
+        OS_MemSet(cfg_dyn_p->wt_v, 0, sizeof(cfg_dyn_p->wt_v));
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SecCacheStatsGet(const OS_SecCacheHd schd, OS_SecCacheStats* stats_p)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+Status s;
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        OS_MemCpy(stats_p, &cfg_dyn_p->stats, sizeof(cfg_dyn_p->stats));
+        stats_p->dirty = 0;
+        stats_p->lines = OS_SEC_CACHE_SECTORS;
+        for (S16 i = 0; i < OS_SEC_CACHE_SECTORS; ++i) {
+            if (OS_TRUE == cfg_dyn_p->lines_v[i].is_dirty) { stats_p->dirty++; }
+        }
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+void OS_SecCacheStatsReset(const OS_SecCacheHd schd)
+{
+OS_SecCacheConfigDyn* cfg_dyn_p = (OS_SecCacheConfigDyn*)schd;
+    if (OS_NULL == cfg_dyn_p) { return; }
+    IF_OK(OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        OS_MemSet(&cfg_dyn_p->stats, 0, sizeof(cfg_dyn_p->stats));
+        OS_MutexUnlock(cfg_dyn_p->mutex);
+    }
+}
+
+#endif //(OS_FILE_SYSTEM_ENABLED) && (OS_SEC_CACHE_ENABLED)
@@ -13,6 +13,11 @@
 #include "os_driver.h"
 #include "os_mailbox.h"
 #include "os_file_system.h"
+#include "os_file_stream.h"
+#include "os_file_async.h"
+#include "os_kv.h"
+#include "os_settings.h"
+#include "os_timer.h"
 #include "os_task_fs.h"
 #include "os_task_usb.h"
 
@@ -29,6 +34,12 @@ typedef struct {
 #if defined(OS_MEDIA_VOL_SDCARD)
     OS_FileSystemMediaHd    fs_media_sdcard_hd;
 #endif //defined(OS_MEDIA_VOL_SDCARD)
+#if defined(OS_MEDIA_VOL_ROMFS)
+    OS_FileSystemMediaHd    fs_media_romfs_hd;
+#endif //defined(OS_MEDIA_VOL_ROMFS)
+#if defined(OS_MEDIA_VOL_IMAGE)
+    OS_FileSystemMediaHd    fs_media_image_hd;
+#endif //defined(OS_MEDIA_VOL_IMAGE)
 #if defined(OS_MEDIA_VOL_USBH_FS)
     OS_FileSystemMediaHd    fs_media_usbh_fs_hd;
 #endif //defined(OS_MEDIA_VOL_USBH_FS)
@@ -48,7 +59,7 @@ const OS_TaskConfig task_fs_cfg = {
     .prio_init      = OS_PRIO_TASK_FS,
     .prio_power     = OS_PRIO_PWR_TASK_FS,
     .storage_size   = sizeof(TaskStorage),
-    .stack_size     = OS_STACK_SIZE_MIN,
+    .stack_size     = OS_STACK_SIZE_MIN * 2,
     .stdin_len      = OS_STDIN_LEN
 };
 
@@ -98,6 +109,37 @@ Status s = S_OK;
         IF_STATUS(s = OS_FileSystemMediaCreate(&fs_media_cfg, &(tstor_p->fs_media_sdcard_hd))) { return s; }
     }
 #endif //defined(OS_MEDIA_VOL_SDCARD)
+#if defined(OS_MEDIA_VOL_ROMFS)
+    {
+        OS_DriverConfig drv_cfg = {
+            .name       = "M_ROMFS",
+            .itf_p      = drv_media_v[DRV_ID_MEDIA_ROMFS],
+            .prio_power = OS_PWR_PRIO_DEFAULT
+        };
+        const OS_FileSystemMediaConfig fs_media_cfg = {
+            .name       = "Assets",
+            .drv_cfg_p  = &drv_cfg,
+            .volume     = OS_MEDIA_VOL_ROMFS,
+            .type       = OS_FS_ROMFS
+        };
+        IF_STATUS(s = OS_FileSystemMediaCreate(&fs_media_cfg, &(tstor_p->fs_media_romfs_hd))) { return s; }
+    }
+#endif //defined(OS_MEDIA_VOL_ROMFS)
+#if defined(OS_MEDIA_VOL_IMAGE)
+    {
+        OS_DriverConfig drv_cfg = {
+            .name       = "M_IMAGE",
+            .itf_p      = drv_media_v[DRV_ID_MEDIA_IMAGE],
+            .prio_power = OS_PWR_PRIO_DEFAULT
+        };
+        const OS_FileSystemMediaConfig fs_media_cfg = {
+            .name       = "Image",
+            .drv_cfg_p  = &drv_cfg,
+            .volume     = OS_MEDIA_VOL_IMAGE
+        };
+        IF_STATUS(s = OS_FileSystemMediaCreate(&fs_media_cfg, &(tstor_p->fs_media_image_hd))) { return s; }
+    }
+#endif //defined(OS_MEDIA_VOL_IMAGE)
 #if defined(OS_MEDIA_VOL_USBH_FS)
     {
         OS_DriverConfig drv_cfg = {
@@ -183,6 +225,14 @@ const OS_QueueHd stdin_qhd = OS_TaskStdInGet(OS_THIS_TASK);
                     switch (sig_id) {
                         case OS_SIG_TASK_DISCONNECT:
                             break;
+#if (OS_SETTINGS_CACHE_ENABLED)
+                        case OS_SIG_TIMER:
+                            if (OS_TIM_ID_SETTINGS_FLUSH == OS_SIGNAL_TIMER_ID_GET(msg_p)) {
+                                Status s;
+                                IF_STATUS(s = OS_SettingsFlush(OS_NULL)) { OS_LOG_S(D_WARNING, s); }
+                            }
+                            break;
+#endif //(OS_SETTINGS_CACHE_ENABLED)
                         default:
                             OS_LOG_S(D_DEBUG, S_INVALID_SIGNAL);
                             break;
@@ -191,6 +241,31 @@ const OS_QueueHd stdin_qhd = OS_TaskStdInGet(OS_THIS_TASK);
 //                }
 //#endif //defined(OS_MEDIA_VOL_USBH_FS) || defined(OS_MEDIA_VOL_USBH_HS)
             } else {
+#if (OS_FILE_STREAM_ENABLED)
+                if ((OS_MSG_FS_STREAM_FILL == msg_p->id) || (OS_MSG_FS_STREAM_FLUSH == msg_p->id)) {
+                    OS_FileStreamJobDo((OS_FileStreamJob*)&(msg_p->data));
+                }
+#endif //(OS_FILE_STREAM_ENABLED)
+#if (OS_FILE_ASYNC_ENABLED)
+                if (OS_MSG_FS_ASYNC_REQ == msg_p->id) {
+                    OS_FileAsyncRequestDo((OS_FileAsyncRequest*)&(msg_p->data));
+                }
+#endif //(OS_FILE_ASYNC_ENABLED)
+#if (OS_KV_ENABLED)
+                if (OS_MSG_FS_KV_COMPACT == msg_p->id) {
+                    OS_KvCompactRequestDo(*(OS_KvHd*)&(msg_p->data));
+                }
+#endif //(OS_KV_ENABLED)
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+                if (OS_MSG_FS_VOLUME_VALIDATE == msg_p->id) {
+                    const U8 volume = *(U8*)&(msg_p->data);
+                    const OS_FileSystemMediaHd fs_media_hd = OS_FileSystemMediaByVolumeGet(volume);
+                    if (OS_NULL != fs_media_hd) {
+                        Status s;
+                        IF_STATUS(s = OS_FileSystemMediaValidate(fs_media_hd)) { OS_LOG_S(D_WARNING, s); }
+                    }
+                }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
 #if defined(OS_MEDIA_VOL_USBH_FS) || defined(OS_MEDIA_VOL_USBH_HS)
                 if ((OS_MSG_USB_CONNECT == msg_p->id) || (OS_MSG_USB_DISCONNECT == msg_p->id)) {
                     OS_FileSystemMediaHd fs_media_usb_hd;
@@ -259,15 +334,48 @@ Status s = S_OK;
                 }
             }
 #endif //defined(OS_MEDIA_VOL_SDCARD)
+#if defined(OS_MEDIA_VOL_ROMFS)
+            // The assets are always mounted (read only).
+            IF_STATUS(s = OS_FileSystemMediaInit(tstor_p->fs_media_romfs_hd, &(tstor_p->drv_led_fs))) { goto error; }
+            IF_STATUS(s = OS_FileSystemMount(tstor_p->fs_media_romfs_hd, OS_NULL)) { goto error; }
+#endif //defined(OS_MEDIA_VOL_ROMFS)
+#if defined(OS_MEDIA_VOL_IMAGE)
+            // The image file is on the other volume (could be not mounted).
+            IF_OK(OS_FileSystemMediaInit(tstor_p->fs_media_image_hd, &(tstor_p->drv_led_fs))) {
+                if (!OS_StrCmp(OS_EnvVariableGet("media_automount"), "on")) {
+                    if (S_FS_NO_FILESYSTEM == OS_FileSystemMount(tstor_p->fs_media_image_hd, OS_NULL)) {
+                        IF_OK(OS_FileSystemMake(tstor_p->fs_media_image_hd, OS_FS_PART_RULE_SFD, 0)) {
+                        }
+                    }
+                }
+            } else { OS_LOG(D_WARNING, "Image media init failed: %s", OS_MEDIA_VOL_IMAGE_PATH); }
+#endif //defined(OS_MEDIA_VOL_IMAGE)
             break;
         case PWR_STOP:
         case PWR_SHUTDOWN:
+#if (OS_SETTINGS_CACHE_ENABLED)
+            // The delayed flush timer could be pending.
+            {
+                const Status s_flush = OS_SettingsFlush(OS_NULL);
+                IF_STATUS(s_flush) { OS_LOG_S(D_WARNING, s_flush); }
+            }
+#endif //(OS_SETTINGS_CACHE_ENABLED)
+#if defined(OS_MEDIA_VOL_IMAGE)
+            // The image file is on the other volume - closed before that media deinit.
+            {
+                const Status s_image = OS_FileSystemMediaDeInit(tstor_p->fs_media_image_hd);
+                IF_STATUS(s_image) { OS_LOG_S(D_WARNING, s_image); }
+            }
+#endif //defined(OS_MEDIA_VOL_IMAGE)
 #if defined(OS_MEDIA_VOL_SDRAM)
             IF_STATUS(s = OS_FileSystemMediaDeInit(tstor_p->fs_media_sdram_hd)){ goto error; }
 #endif //defined(OS_MEDIA_VOL_SDRAM)
 #if defined(OS_MEDIA_VOL_SDCARD)
             IF_STATUS(s = OS_FileSystemMediaDeInit(tstor_p->fs_media_sdcard_hd)) { goto error; }
 #endif //defined(OS_MEDIA_VOL_SDCARD)
+#if defined(OS_MEDIA_VOL_ROMFS)
+            IF_STATUS(s = OS_FileSystemMediaDeInit(tstor_p->fs_media_romfs_hd)) { goto error; }
+#endif //defined(OS_MEDIA_VOL_ROMFS)
 #if defined(OS_MEDIA_VOL_USBH_FS)
             IF_STATUS(s = OS_FileSystemMediaDeInit(tstor_p->fs_media_usbh_fs_hd)) { goto error; }
 #endif //defined(OS_MEDIA_VOL_USBH_FS)
@@ -12,6 +12,13 @@
 #include "os_mutex.h"
 #include "os_memory.h"
 
+//------------------------------------------------------------------------------
+// Aligned block header.
+typedef struct {
+    void*           addr_p;     // Allocated block.
+    OS_MemoryPool   pool;
+} MemAlignedHeader;
+
 //------------------------------------------------------------------------------
 static OS_MutexHd os_mem_mutex;
 
@@ -112,6 +119,28 @@ void* p = OS_NULL;
     return p;
 }
 
+/******************************************************************************/
+void* OS_MallocAligned(const Size size, const Size align)
+{
+    return OS_MallocAlignedEx(size, align, OS_MEM_HEAP_SYS);
+}
+
+/******************************************************************************/
+void* OS_MallocAlignedEx(const Size size, const Size align, const OS_MemoryPool pool)
+{
+const Size align_word = MAX(align, sizeof(U32));
+U8* p;
+MemAlignedHeader* header_p;
+    if ((0 == align) || (align & (align - 1))) { return OS_NULL; }
+    // The header is before the aligned block.
+    p = (U8*)OS_MallocEx(size + sizeof(MemAlignedHeader) + align_word - 1, pool);
+    if (OS_NULL == p) { return OS_NULL; }
+    header_p = (MemAlignedHeader*)(((U32)p + sizeof(MemAlignedHeader) + align_word - 1) & ~(align_word - 1)) - 1;
+    header_p->addr_p= p;
+    header_p->pool  = pool;
+    return (void*)(header_p + 1);
+}
+
 /******************************************************************************/
 //void* OS_MPU_Malloc(const TaskId id, const MemoryRegion mem_regions);
 //{
@@ -144,6 +173,15 @@ const OS_MemoryDesc* mem_desc_p = OS_MemoryDescriptorGet(pool);
     }
 }
 
+/******************************************************************************/
+void OS_FreeAligned(void* addr_p)
+{
+    if (addr_p) {
+        const MemAlignedHeader* header_p = (MemAlignedHeader*)addr_p - 1;
+        OS_FreeEx(header_p->addr_p, header_p->pool);
+    }
+}
+
 ///******************************************************************************/
 //void OS_MemCpy(void* dst_p, const void* src_p, SIZE size)
 //{
@@ -227,6 +265,29 @@ OS_MemoryDesc* memory_cfg_p = (OS_MemoryDesc*)&memory_cfg_v[0];
     return S_OK;
 }
 
+/******************************************************************************/
+U32 OS_MemCrc32(const void* addr_p, const Size size)
+{
+#if (HAL_CRC_ENABLED)
+    return CRC_Calculate32((const U32*)addr_p, size / sizeof(U32));
+#else
+// CRC-32 (0x04C11DB7) nibble table.
+static const U32 crc_tab_v[16] = {
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD
+};
+const U32* word_p = (const U32*)addr_p;
+U32 crc = U32_MAX;
+    for (Size i = 0; i < (size / sizeof(U32)); ++i) {
+        crc ^= *word_p++;
+        for (U8 j = 0; j < 8; ++j) {
+            crc = (crc << 4) ^ crc_tab_v[crc >> 28];
+        }
+    }
+    return crc;
+#endif //(HAL_CRC_ENABLED)
+}
+
 //------------------------------------------------------------------------------
 /// @brief ISR specific functions.
 
@@ -9,6 +9,7 @@
 #include "os_network.h"
 #include "os_debug.h"
 #include "os_mutex.h"
+#include "os_profile.h"
 
 #if (OS_NETWORK_ENABLED)
 //-----------------------------------------------------------------------------
@@ -121,11 +122,28 @@ static err_t low_level_output(OS_NetworkItf* net_itf_p, OS_NetworkBuf* p);
 err_t low_level_output(OS_NetworkItf* net_itf_p, OS_NetworkBuf* p)
 {
 const OS_NetworkItfHd net_itf_hd = OS_NetworkItfHdByIdGet(net_itf_p->num);
-    IF_OK(OS_NetworkWrite(net_itf_hd, p, p->tot_len)) {
-        return ERR_OK;
-    } else {
-        return ERR_IF;
+OS_DriverSegment seg_v[OS_NETWORK_TX_SEGMENTS_MAX];
+U32 seg_count = 0;
+err_t err = ERR_IF;
+    OS_PROF_ZONE(low_level_output) {
+        for (OS_NetworkBuf* q = p; OS_NULL != q; q = q->next) {
+            if (OS_NETWORK_TX_SEGMENTS_MAX == seg_count) {
+                seg_count = 0; // Too long chain - let the driver walk it.
+                break;
+            }
+            seg_v[seg_count].data_p = q->payload;
+            seg_v[seg_count].size   = q->len;
+            ++seg_count;
+        }
+        if (0 != seg_count) {
+            IF_OK(OS_NetworkWriteV(net_itf_hd, seg_v, seg_count)) {
+                err = ERR_OK;
+            }
+        } else IF_OK(OS_NetworkWrite(net_itf_hd, p, p->tot_len)) {
+            err = ERR_OK;
+        }
     }
+    return err;
 }
 
 /*****************************************************************************/
@@ -527,6 +545,19 @@ Status s = S_UNDEF;
     return s;
 }
 
+/*****************************************************************************/
+Status OS_NetworkWriteV(const OS_NetworkItfHd net_itf_hd, const OS_DriverSegment* seg_v, U32 seg_count)
+{
+Status s = S_UNDEF;
+    OS_ASSERT_VALUE(OS_NULL != net_itf_hd);
+    const OS_DriverHd dhd = OS_NetworkItfConfigDynGet(net_itf_hd)->dhd;
+    IF_STATUS(s = OS_DriverWriteV(dhd, seg_v, seg_count, OS_NULL)) {
+        OS_LOG_S(D_WARNING, s);
+    }
+    OS_LOG(D_DEBUG, "writev: 0x%X, segments %u", net_itf_hd, seg_count);
+    return s;
+}
+
 /*****************************************************************************/
 Status OS_NetworkMacAddressStrToBin(ConstStrP mac_addr_str_p, OS_NetworkMacAddr mac_addr)
 {
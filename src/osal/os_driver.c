@@ -8,15 +8,22 @@
 #include "osal.h"
 #include "os_debug.h"
 #include "os_mutex.h"
+#include "os_semaphore.h"
+#include "os_supervise.h"
 #include "os_list.h"
 #include "os_memory.h"
 #include "os_mailbox.h"
 #include "os_driver.h"
+#include "os_profile.h"
 
 //------------------------------------------------------------------------------
 typedef struct {
     OS_DriverConfig         cfg;
-    OS_MutexHd              mutex;
+    OS_MutexHd              mutex;      // Control lock.
+    OS_MutexHd              mutex_rx;   // Read lane lock (by the lock policy).
+    OS_MutexHd              mutex_tx;   // Write lane lock (by the lock policy).
+    OS_SemaphoreHd          sync_rx_shd;// Synchronous wrappers over the submit functions.
+    OS_SemaphoreHd          sync_tx_shd;
     OS_DriverStats          stats;
 } OS_DriverConfigDyn;
 
@@ -35,6 +42,213 @@ INLINE OS_DriverConfigDyn* OS_DriverConfigDynGet(const OS_DriverHd dhd)
     return cfg_dyn_p;
 }
 
+/******************************************************************************/
+static Status OS_DriverLaneLock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write);
+Status OS_DriverLaneLock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write)
+{
+const OS_MutexHd mhd = (OS_TRUE == is_write) ? cfg_dyn_p->mutex_tx : cfg_dyn_p->mutex_rx;
+    if (OS_NULL == mhd) { return S_OK; } // OS_DRV_LOCK_NONE
+    return OS_MutexLock(mhd, OS_TIMEOUT_MUTEX_LOCK);
+}
+
+/******************************************************************************/
+static void OS_DriverLaneUnlock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write);
+void OS_DriverLaneUnlock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write)
+{
+const OS_MutexHd mhd = (OS_TRUE == is_write) ? cfg_dyn_p->mutex_tx : cfg_dyn_p->mutex_rx;
+    if (OS_NULL == mhd) { return; }
+    OS_MutexUnlock(mhd);
+}
+
+/******************************************************************************/
+static Status OS_ISR_DriverLaneLock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write);
+Status OS_ISR_DriverLaneLock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write)
+{
+const OS_MutexHd mhd = (OS_TRUE == is_write) ? cfg_dyn_p->mutex_tx : cfg_dyn_p->mutex_rx;
+    if (OS_NULL == mhd) { return S_OK; }
+    return OS_ISR_MutexLock(mhd);
+}
+
+/******************************************************************************/
+static void OS_ISR_DriverLaneUnlock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write);
+void OS_ISR_DriverLaneUnlock(const OS_DriverConfigDyn* cfg_dyn_p, const Bool is_write)
+{
+const OS_MutexHd mhd = (OS_TRUE == is_write) ? cfg_dyn_p->mutex_tx : cfg_dyn_p->mutex_rx;
+    if (OS_NULL == mhd) { return; }
+    OS_ISR_MutexUnlock(mhd);
+}
+
+/******************************************************************************/
+// Control calls (init, open, ioctl, etc.) are exclusive to the both lanes.
+static Status OS_DriverCtlLock(const OS_DriverConfigDyn* cfg_dyn_p);
+Status OS_DriverCtlLock(const OS_DriverConfigDyn* cfg_dyn_p)
+{
+Status s;
+    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        if (OS_DRV_LOCK_RX_TX == cfg_dyn_p->cfg.lock_policy) {
+            IF_STATUS(s = OS_MutexLock(cfg_dyn_p->mutex_tx, OS_TIMEOUT_MUTEX_LOCK)) {
+                OS_MutexUnlock(cfg_dyn_p->mutex);
+            }
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+static void OS_DriverCtlUnlock(const OS_DriverConfigDyn* cfg_dyn_p);
+void OS_DriverCtlUnlock(const OS_DriverConfigDyn* cfg_dyn_p)
+{
+    if (OS_DRV_LOCK_RX_TX == cfg_dyn_p->cfg.lock_policy) {
+        OS_MutexUnlock(cfg_dyn_p->mutex_tx);
+    }
+    OS_MutexUnlock(cfg_dyn_p->mutex);
+}
+
+/******************************************************************************/
+// The lanes could fail at once (OS_DRV_LOCK_RX_TX).
+static void OS_DriverLaneErrorSet(OS_DriverConfigDyn* cfg_dyn_p, const Status s);
+void OS_DriverLaneErrorSet(OS_DriverConfigDyn* cfg_dyn_p, const Status s)
+{
+    OS_CriticalSectionEnter(); {
+        cfg_dyn_p->stats.status_last = s;
+        cfg_dyn_p->stats.errors_cnt++;
+    } OS_CriticalSectionExit();
+}
+
+/******************************************************************************/
+static void OS_DriverRequestComplete(HAL_DriverRequest* hal_req_p, const Bool is_isr);
+void OS_DriverRequestComplete(HAL_DriverRequest* hal_req_p, const Bool is_isr)
+{
+OS_DriverRequest* req_p = (OS_DriverRequest*)hal_req_p;
+OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(req_p->dhd);
+// The request could be released by it's owner right after the callback.
+const OS_QueueHd qhd = req_p->qhd;
+    IF_STATUS(hal_req_p->status) {
+        cfg_dyn_p->stats.status_last = hal_req_p->status;
+        cfg_dyn_p->stats.errors_cnt++;
+    } else {
+        if (OS_TRUE == req_p->is_write) {
+            cfg_dyn_p->stats.sended += hal_req_p->size;
+        } else {
+            cfg_dyn_p->stats.received += hal_req_p->size;
+        }
+    }
+    if (OS_NULL != req_p->Callback) {
+        req_p->Callback(req_p, is_isr);
+    }
+    if (OS_NULL != qhd) {
+        if (OS_TRUE == is_isr) {
+            if (1 == OS_ISR_QueueSend(qhd, &req_p, OS_MSG_PRIO_NORMAL)) {
+                OS_ISR_ContextSwitchForce(OS_TRUE);
+            }
+        } else {
+            OS_QueueSend(qhd, &req_p, OS_NO_BLOCK, OS_MSG_PRIO_NORMAL);
+        }
+    }
+}
+
+/******************************************************************************/
+static void OS_DriverRequestSyncCallback(OS_DriverRequest* req_p, const Bool is_isr);
+void OS_DriverRequestSyncCallback(OS_DriverRequest* req_p, const Bool is_isr)
+{
+const OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(req_p->dhd);
+const OS_SemaphoreHd shd = (OS_TRUE == req_p->is_write) ? cfg_dyn_p->sync_tx_shd : cfg_dyn_p->sync_rx_shd;
+    if (OS_TRUE == is_isr) {
+        if (1 == OS_ISR_SemaphoreUnlock(shd)) {
+            OS_ISR_ContextSwitchForce(OS_TRUE);
+        }
+    } else {
+        OS_SemaphoreUnlock(shd);
+    }
+}
+
+/******************************************************************************/
+static Status OS_DriverSubmit(const OS_DriverHd dhd, OS_DriverRequest* req_p, const Bool is_write);
+Status OS_DriverSubmit(const OS_DriverHd dhd, OS_DriverRequest* req_p, const Bool is_write)
+{
+OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
+const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
+Status (*submit_fn)(HAL_DriverRequest* req_p) = (OS_TRUE == is_write) ? itf_p->SubmitWrite : itf_p->SubmitRead;
+Status (*sync_fn)(void* data_p, Size size, void* args_p) = (OS_TRUE == is_write) ? itf_p->Write : itf_p->Read;
+Bool is_sync_done = OS_FALSE;
+Status s = S_UNDEF;
+    if (OS_NULL == req_p) { return S_INVALID_PTR; }
+    OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
+    OS_ASSERT_VALUE((OS_NULL != submit_fn) || (OS_NULL != sync_fn));
+    req_p->dhd              = dhd;
+    req_p->is_write         = is_write;
+    req_p->hal_req.status   = S_IN_PROGRESS;
+    req_p->hal_req.Complete = OS_DriverRequestComplete;
+    IF_OK(s = OS_DriverLaneLock(cfg_dyn_p, is_write)) {
+        if (OS_NULL != submit_fn) {
+            IF_STATUS(s = submit_fn(&req_p->hal_req)) {
+                OS_DriverLaneErrorSet(cfg_dyn_p, s);
+            }
+        } else {
+            req_p->hal_req.status = sync_fn(req_p->hal_req.data_p, req_p->hal_req.size, req_p->hal_req.args_p);
+            is_sync_done = OS_TRUE;
+        }
+        OS_DriverLaneUnlock(cfg_dyn_p, is_write);
+    }
+    // Complete out of the lock - the callback is free to submit the next request.
+    if (OS_TRUE == is_sync_done) {
+        OS_DriverRequestComplete(&req_p->hal_req, OS_FALSE);
+        s = req_p->hal_req.status;
+    }
+    return s;
+}
+
+/******************************************************************************/
+static Status OS_DriverTransferSync(OS_DriverConfigDyn* cfg_dyn_p, const OS_DriverHd dhd,
+                                    void* data_p, const U32 size, void* args_p, const Bool is_write);
+Status OS_DriverTransferSync(OS_DriverConfigDyn* cfg_dyn_p, const OS_DriverHd dhd,
+                             void* data_p, const U32 size, void* args_p, const Bool is_write)
+{
+const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
+OS_DriverRequest req;
+Status s;
+    // Called with the driver's lane locked - the single sync waiter per lane at a time.
+    OS_MemSet(&req, 0, sizeof(req));
+    req.hal_req.data_p  = data_p;
+    req.hal_req.size    = size;
+    req.hal_req.args_p  = args_p;
+    req.hal_req.status  = S_IN_PROGRESS;
+    req.hal_req.Complete= OS_DriverRequestComplete;
+    req.dhd             = dhd;
+    req.Callback        = OS_DriverRequestSyncCallback;
+    req.is_write        = is_write;
+    if (OS_TRUE == is_write) {
+        s = itf_p->SubmitWrite(&req.hal_req);
+    } else {
+        s = itf_p->SubmitRead(&req.hal_req);
+    }
+    IF_OK(s) {
+        const OS_SemaphoreHd shd = (OS_TRUE == is_write) ? cfg_dyn_p->sync_tx_shd : cfg_dyn_p->sync_rx_shd;
+        IF_OK(s = OS_SemaphoreLock(shd, OS_TIMEOUT_DRIVER)) {
+            s = req.hal_req.status;
+        } else {
+            // The driver should forget the request before it leaves the stack.
+            if ((OS_NULL != itf_p->IoCtl) && (S_OK == itf_p->IoCtl(DRV_REQ_STD_ABORT, &req.hal_req))) {
+                s = S_TIMEOUT;
+            } else {
+                // Completed while aborting or the abort isn't supported - the completion is awaited once more.
+                OS_LOG(D_WARNING, "%s: transfer timeout", cfg_dyn_p->cfg.name);
+                IF_OK(s = OS_SemaphoreLock(shd, OS_TIMEOUT_DRIVER)) {
+                    s = req.hal_req.status;
+                } else {
+                    OS_LOG(D_WARNING, "%s: %s request leaked (size: %u)", cfg_dyn_p->cfg.name,
+                           (OS_TRUE == is_write) ? "write" : "read", size);
+                    s = S_TIMEOUT;
+                }
+            }
+            OS_DriverLaneErrorSet(cfg_dyn_p, s);
+        }
+    } else {
+        OS_DriverLaneErrorSet(cfg_dyn_p, s);
+    }
+    return s;
+}
+
 /******************************************************************************/
 Status OS_DriverInit_(void);
 Status OS_DriverInit_(void)
@@ -87,6 +301,24 @@ exit:
     return (OS_DriverHd)iter_li_p;
 }
 
+/******************************************************************************/
+static void OS_DriverLocksDelete(OS_DriverConfigDyn* cfg_dyn_p);
+void OS_DriverLocksDelete(OS_DriverConfigDyn* cfg_dyn_p)
+{
+    if ((OS_NULL != cfg_dyn_p->mutex_tx) && (cfg_dyn_p->mutex != cfg_dyn_p->mutex_tx)) {
+        OS_MutexDelete(cfg_dyn_p->mutex_tx);
+    }
+    if (OS_NULL != cfg_dyn_p->mutex) {
+        OS_MutexDelete(cfg_dyn_p->mutex);
+    }
+    if (OS_NULL != cfg_dyn_p->sync_rx_shd) {
+        OS_SemaphoreDelete(cfg_dyn_p->sync_rx_shd);
+    }
+    if (OS_NULL != cfg_dyn_p->sync_tx_shd) {
+        OS_SemaphoreDelete(cfg_dyn_p->sync_tx_shd);
+    }
+}
+
 /******************************************************************************/
 Status OS_DriverCreate(const OS_DriverConfig* cfg_p, OS_DriverHd* dhd_p)
 {
@@ -106,8 +338,36 @@ Status s = S_OK;
     cfg_dyn_p->stats.state      = OS_DRV_STATE_UNDEF;
     cfg_dyn_p->stats.power      = PWR_UNDEF;
     cfg_dyn_p->stats.status_last= s;
+    cfg_dyn_p->mutex_rx     = OS_NULL;
+    cfg_dyn_p->mutex_tx     = OS_NULL;
+    cfg_dyn_p->sync_rx_shd  = OS_NULL;
+    cfg_dyn_p->sync_tx_shd  = OS_NULL;
     cfg_dyn_p->mutex = OS_MutexCreate();
     if (OS_NULL == cfg_dyn_p->mutex) { s = S_INVALID_PTR; goto error; }
+    switch (cfg_p->lock_policy) {
+        case OS_DRV_LOCK_SINGLE:
+            cfg_dyn_p->mutex_rx = cfg_dyn_p->mutex;
+            cfg_dyn_p->mutex_tx = cfg_dyn_p->mutex;
+            break;
+        case OS_DRV_LOCK_RX_TX:
+            cfg_dyn_p->mutex_rx = cfg_dyn_p->mutex;
+            cfg_dyn_p->mutex_tx = OS_MutexCreate();
+            if (OS_NULL == cfg_dyn_p->mutex_tx) { s = S_INVALID_PTR; goto error; }
+            break;
+        case OS_DRV_LOCK_NONE:
+            break;
+        default:
+            s = S_INVALID_ARG;
+            goto error;
+    }
+    if (OS_NULL != cfg_p->itf_p->SubmitRead) {
+        cfg_dyn_p->sync_rx_shd = OS_SemaphoreBinaryCreate();
+        if (OS_NULL == cfg_dyn_p->sync_rx_shd) { s = S_INVALID_PTR; goto error; }
+    }
+    if (OS_NULL != cfg_p->itf_p->SubmitWrite) {
+        cfg_dyn_p->sync_tx_shd = OS_SemaphoreBinaryCreate();
+        if (OS_NULL == cfg_dyn_p->sync_tx_shd) { s = S_INVALID_PTR; goto error; }
+    }
     OS_ListItemValueSet(item_l_p, (OS_Value)cfg_dyn_p);
     OS_ListItemOwnerSet(item_l_p, (OS_Owner)OS_TaskGet());
     IF_OK(s = OS_MutexRecursiveLock(os_driver_mutex, OS_TIMEOUT_MUTEX_LOCK)) {  // os_list protection;
@@ -119,6 +379,7 @@ Status s = S_OK;
     }
 error:
     IF_STATUS(s) {
+        OS_DriverLocksDelete(cfg_dyn_p);
         OS_Free(cfg_dyn_p);
         OS_ListItemDelete(item_l_p);
     }
@@ -134,7 +395,7 @@ Status s = S_OK;
         OS_ListItem* item_l_p = (OS_ListItem*)dhd;
         OS_DriverConfigDyn* cfg_dyn_p = (OS_DriverConfigDyn*)OS_ListItemValueGet(item_l_p);
         OS_ListItemDelete(item_l_p);
-        OS_MutexDelete(cfg_dyn_p->mutex);
+        OS_DriverLocksDelete(cfg_dyn_p);
         OS_Free(cfg_dyn_p);
         OS_MutexRecursiveUnlock(os_driver_mutex);
     }
@@ -149,11 +410,11 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     if (OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_INIT))) { return S_OK; }
     OS_ASSERT(OS_NULL != itf_p->Init);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+    IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
         IF_OK(s = itf_p->Init(args_p)) {
             BIT_SET(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_INIT));
         }
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverCtlUnlock(cfg_dyn_p);
     }
     return s;
 }
@@ -169,11 +430,11 @@ Status s = S_UNDEF;
         IF_STATUS(s = OS_DriverClose(dhd, args_p)) { return s; }
     }
     OS_ASSERT(OS_NULL != itf_p->DeInit);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+    IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
         IF_OK(s = itf_p->DeInit(args_p)) {
             BIT_CLEAR(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_INIT));
         }
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverCtlUnlock(cfg_dyn_p);
     }
     return s;
 }
@@ -186,7 +447,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     if (OS_TRUE != BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_INIT))) { return S_INITED; }
     OS_ASSERT(OS_NULL != itf_p->Open);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+    IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
         IF_OK(s) {
             if (0 == cfg_dyn_p->stats.owners) {
                 if (OS_NULL != itf_p->IoCtl) {
@@ -205,7 +466,7 @@ Status s = S_UNDEF;
             BIT_SET(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN));
             cfg_dyn_p->stats.owners++;
         } else {/*TODO(A. Filyanov) Power shutdown!*/}
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverCtlUnlock(cfg_dyn_p);
     }
     return s;
 }
@@ -218,7 +479,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     if (OS_TRUE != BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN))) { return S_OPENED; }
     OS_ASSERT(OS_NULL != itf_p->Close);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+    IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
         if (1 == cfg_dyn_p->stats.owners) {
             IF_OK(s = itf_p->Close(args_p)) {
                 BIT_CLEAR(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN));
@@ -239,7 +500,7 @@ Status s = S_UNDEF;
         IF_OK(s) {
             cfg_dyn_p->stats.owners--;
         }
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverCtlUnlock(cfg_dyn_p);
     }
     return s;
 }
@@ -250,17 +511,21 @@ Status OS_DriverRead(const OS_DriverHd dhd, void* data_in_p, U32 size, void* arg
 OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
 const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
+    OS_PROF_ZONE_BEGIN(drv_read);
     OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
-    OS_ASSERT_VALUE(OS_NULL != itf_p->Read);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
-        IF_STATUS(s = itf_p->Read(data_in_p, size, args_p)) {
+    OS_ASSERT_VALUE((OS_NULL != itf_p->Read) || (OS_NULL != itf_p->SubmitRead));
+    IF_OK(s = OS_DriverLaneLock(cfg_dyn_p, OS_FALSE)) {
+        if (OS_NULL == itf_p->Read) {
+            s = OS_DriverTransferSync(cfg_dyn_p, dhd, data_in_p, size, args_p, OS_FALSE);
+        } else IF_STATUS(s = itf_p->Read(data_in_p, size, args_p)) {
             cfg_dyn_p->stats.status_last = s;
             cfg_dyn_p->stats.errors_cnt++;
         } else {
             cfg_dyn_p->stats.received += size;
         }
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverLaneUnlock(cfg_dyn_p, OS_FALSE);
     }
+    OS_PROF_ZONE_END(drv_read);
     return s;
 }
 
@@ -272,7 +537,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
     OS_ASSERT_VALUE(OS_NULL != itf_p->Read);
-    s = OS_ISR_MutexLock(cfg_dyn_p->mutex);
+    s = OS_ISR_DriverLaneLock(cfg_dyn_p, OS_FALSE);
     if ((S_OK == s) || (1 == s)) {
         IF_STATUS(s = itf_p->Read(data_in_p, size, args_p)) {
             cfg_dyn_p->stats.status_last = s;
@@ -280,7 +545,7 @@ Status s = S_UNDEF;
         } else {
             cfg_dyn_p->stats.received += size;
         }
-        OS_ISR_MutexUnlock(cfg_dyn_p->mutex);
+        OS_ISR_DriverLaneUnlock(cfg_dyn_p, OS_FALSE);
     }
     return s;
 }
@@ -291,20 +556,122 @@ Status OS_DriverWrite(const OS_DriverHd dhd, void* data_out_p, U32 size, void* a
 OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
 const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
+    OS_PROF_ZONE_BEGIN(drv_write);
     OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
-    OS_ASSERT_VALUE(OS_NULL != itf_p->Write);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
-        IF_STATUS(s = itf_p->Write(data_out_p, size, args_p)) {
+    OS_ASSERT_VALUE((OS_NULL != itf_p->Write) || (OS_NULL != itf_p->SubmitWrite));
+    IF_OK(s = OS_DriverLaneLock(cfg_dyn_p, OS_TRUE)) {
+        if (OS_NULL == itf_p->Write) {
+            s = OS_DriverTransferSync(cfg_dyn_p, dhd, data_out_p, size, args_p, OS_TRUE);
+        } else IF_STATUS(s = itf_p->Write(data_out_p, size, args_p)) {
             cfg_dyn_p->stats.status_last = s;
             cfg_dyn_p->stats.errors_cnt++;
         } else {
             cfg_dyn_p->stats.sended += size;
         }
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverLaneUnlock(cfg_dyn_p, OS_TRUE);
+    }
+    OS_PROF_ZONE_END(drv_write);
+    return s;
+}
+
+/******************************************************************************/
+static U32 OS_DriverSegmentsSizeGet(const OS_DriverSegment* seg_v, const U32 seg_count);
+U32 OS_DriverSegmentsSizeGet(const OS_DriverSegment* seg_v, const U32 seg_count)
+{
+U32 size = 0;
+    for (U32 i = 0; i < seg_count; ++i) {
+        size += seg_v[i].size;
+    }
+    return size;
+}
+
+/******************************************************************************/
+Status OS_DriverReadV(const OS_DriverHd dhd, const OS_DriverSegment* seg_v, U32 seg_count, void* args_p)
+{
+OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
+const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
+U32 size;
+Status s = S_UNDEF;
+    if ((OS_NULL == seg_v) || (0 == seg_count)) { return S_INVALID_ARG; }
+    size = OS_DriverSegmentsSizeGet(seg_v, seg_count);
+    OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
+    if (OS_NULL != itf_p->ReadV) {
+        IF_OK(s = OS_DriverLaneLock(cfg_dyn_p, OS_FALSE)) {
+            IF_STATUS(s = itf_p->ReadV(seg_v, seg_count, args_p)) {
+                cfg_dyn_p->stats.status_last = s;
+                cfg_dyn_p->stats.errors_cnt++;
+            } else {
+                cfg_dyn_p->stats.received += size;
+            }
+            OS_DriverLaneUnlock(cfg_dyn_p, OS_FALSE);
+        }
+    } else if (1 == seg_count) {
+        s = OS_DriverRead(dhd, seg_v[0].data_p, seg_v[0].size, args_p);
+    } else {
+        // Generic fallback: read to the temporary buffer and scatter.
+        U8* buf_p = (U8*)OS_Malloc(size);
+        if (OS_NULL == buf_p) { return S_OUT_OF_MEMORY; }
+        IF_OK(s = OS_DriverRead(dhd, buf_p, size, args_p)) {
+            U8* src_p = buf_p;
+            for (U32 i = 0; i < seg_count; ++i) {
+                OS_MemCpy(seg_v[i].data_p, src_p, seg_v[i].size);
+                src_p += seg_v[i].size;
+            }
+        }
+        OS_Free(buf_p);
     }
     return s;
 }
 
+/******************************************************************************/
+Status OS_DriverWriteV(const OS_DriverHd dhd, const OS_DriverSegment* seg_v, U32 seg_count, void* args_p)
+{
+OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
+const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
+U32 size;
+Status s = S_UNDEF;
+    if ((OS_NULL == seg_v) || (0 == seg_count)) { return S_INVALID_ARG; }
+    size = OS_DriverSegmentsSizeGet(seg_v, seg_count);
+    OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
+    if (OS_NULL != itf_p->WriteV) {
+        IF_OK(s = OS_DriverLaneLock(cfg_dyn_p, OS_TRUE)) {
+            IF_STATUS(s = itf_p->WriteV(seg_v, seg_count, args_p)) {
+                cfg_dyn_p->stats.status_last = s;
+                cfg_dyn_p->stats.errors_cnt++;
+            } else {
+                cfg_dyn_p->stats.sended += size;
+            }
+            OS_DriverLaneUnlock(cfg_dyn_p, OS_TRUE);
+        }
+    } else if (1 == seg_count) {
+        s = OS_DriverWrite(dhd, seg_v[0].data_p, seg_v[0].size, args_p);
+    } else {
+        // Generic fallback: gather to the temporary buffer and write at once.
+        U8* buf_p = (U8*)OS_Malloc(size);
+        if (OS_NULL == buf_p) { return S_OUT_OF_MEMORY; }
+        U8* dst_p = buf_p;
+        for (U32 i = 0; i < seg_count; ++i) {
+            OS_MemCpy(dst_p, seg_v[i].data_p, seg_v[i].size);
+            dst_p += seg_v[i].size;
+        }
+        s = OS_DriverWrite(dhd, buf_p, size, args_p);
+        OS_Free(buf_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_DriverReadAsync(const OS_DriverHd dhd, OS_DriverRequest* req_p)
+{
+    return OS_DriverSubmit(dhd, req_p, OS_FALSE);
+}
+
+/******************************************************************************/
+Status OS_DriverWriteAsync(const OS_DriverHd dhd, OS_DriverRequest* req_p)
+{
+    return OS_DriverSubmit(dhd, req_p, OS_TRUE);
+}
+
 /******************************************************************************/
 Status OS_ISR_DriverWrite(const OS_DriverHd dhd, void* data_out_p, U32 size, void* args_p)
 {
@@ -313,7 +680,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
     OS_ASSERT_VALUE(OS_NULL != itf_p->Write);
-    s = OS_ISR_MutexLock(cfg_dyn_p->mutex);
+    s = OS_ISR_DriverLaneLock(cfg_dyn_p, OS_TRUE);
     if ((S_OK == s) || (1 == s)) {
         IF_STATUS(s = itf_p->Write(data_out_p, size, args_p)) {
             cfg_dyn_p->stats.status_last = s;
@@ -321,7 +688,7 @@ Status s = S_UNDEF;
         } else {
             cfg_dyn_p->stats.sended += size;
         }
-        OS_ISR_MutexUnlock(cfg_dyn_p->mutex);
+        OS_ISR_DriverLaneUnlock(cfg_dyn_p, OS_TRUE);
     }
     return s;
 }
@@ -334,7 +701,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_OK;
     OS_ASSERT_VALUE(OS_NULL != itf_p->IoCtl);
     if (OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN))) {
-        IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
             if (DRV_REQ_STD_POWER_SET == request_id) {
                 const OS_PowerState state = *(OS_PowerState*)args_p;
                 if (state != cfg_dyn_p->stats.power) {
@@ -352,7 +719,7 @@ Status s = S_OK;
                     cfg_dyn_p->stats.errors_cnt++;
                 }
             }
-            OS_MutexUnlock(cfg_dyn_p->mutex);
+            OS_DriverCtlUnlock(cfg_dyn_p);
         }
     } else {
         s = S_OPENED;
@@ -369,6 +736,7 @@ const HAL_DriverItf* itf_p = cfg_dyn_p->cfg.itf_p;
 Status s = S_UNDEF;
     OS_ASSERT_VALUE(OS_TRUE == BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_OPEN)));
     OS_ASSERT_VALUE(OS_NULL != itf_p->IoCtl);
+    // Serialized with the control calls only (nested ISR locks are avoided).
     s = OS_ISR_MutexLock(cfg_dyn_p->mutex);
     if ((S_OK == s) || (1 == s)) {
         if (DRV_REQ_STD_POWER_SET == request_id) {
@@ -406,10 +774,10 @@ Status OS_DriverItfSet(const OS_DriverHd dhd, HAL_DriverItf* itf_p)
 Status s = S_OK;
     OS_ASSERT(OS_NULL != itf_p);
     OS_DriverConfigDyn* cfg_dyn_p = OS_DriverConfigDynGet(dhd);
-    IF_OK(s = OS_MutexLock(cfg_dyn_p->mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+    IF_OK(s = OS_DriverCtlLock(cfg_dyn_p)) {
         OS_ASSERT_VALUE(OS_TRUE != BIT_TEST(cfg_dyn_p->stats.state, BIT(OS_DRV_STATE_IS_INIT)));
         OS_MemMov(cfg_dyn_p->cfg.itf_p, itf_p, sizeof(HAL_DriverItf));
-        OS_MutexUnlock(cfg_dyn_p->mutex);
+        OS_DriverCtlUnlock(cfg_dyn_p);
     }
     return s;
 }
@@ -439,6 +807,22 @@ ConstStrP state_str = undef_str;
     return state_str;
 }
 
+/******************************************************************************/
+ConstStrP OS_DriverLockPolicyNameGet(const OS_DriverLockPolicy policy)
+{
+static ConstStr single_str[]= "single";
+static ConstStr rx_tx_str[] = "rx/tx";
+static ConstStr none_str[]  = "none";
+ConstStrP policy_str = single_str;
+
+    if (OS_DRV_LOCK_RX_TX == policy) {
+        policy_str = rx_tx_str;
+    } else if (OS_DRV_LOCK_NONE == policy) {
+        policy_str = none_str;
+    }
+    return policy_str;
+}
+
 /******************************************************************************/
 OS_DriverState OS_DriverStateStateGet(const OS_DriverHd dhd)
 {
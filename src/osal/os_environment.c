@@ -9,16 +9,23 @@
 #include "os_list.h"
 #include "os_debug.h"
 #include "os_mutex.h"
+#include "os_settings.h"
 #include "os_environment.h"
 
 //------------------------------------------------------------------------------
 #define MDL_NAME            "environment"
 
 //------------------------------------------------------------------------------
+enum {
+    ENV_VAR_NAME_MAPPED,    // The strings are owned by the caller (the settings snapshot).
+    ENV_VAR_VALUE_MAPPED,
+};
+
 typedef struct {
     ConstStrP               name_p;
     ConstStrP               value_p;
     OS_EnvVariableHandler   handler_p;
+    U8                      flags;
 } OS_EnvVariable;
 
 //------------------------------------------------------------------------------
@@ -28,6 +35,8 @@ static OS_MutexHd os_env_mutex;
 //------------------------------------------------------------------------------
 Status OS_EnvInit(void);
 static OS_ListItem* OS_EnvVariableListItemByNameGet(ConstStrP name_p);
+static void         OS_EnvVariableFree(OS_EnvVariable* env_var_p);
+static void         OS_EnvChanged(void);
 
 /******************************************************************************/
 Status OS_EnvInit(void)
@@ -108,22 +117,30 @@ const OS_ListItem* item_l_p = OS_EnvVariableListItemByNameGet(variable_name_p);
 Status OS_EnvVariableSet(ConstStrP variable_name_p, ConstStrP variable_value_p,
                          const OS_EnvVariableHandler variable_handler_p)
 {
+OS_ListItem* item_l_p = OS_NULL;
+OS_EnvVariable* env_var_p = OS_NULL;
+ConstStrP value_old_p = OS_NULL;
+Bool is_value_old_mapped = OS_FALSE;
+Bool is_new = OS_FALSE;
+Bool is_changed = OS_TRUE;
 Status s = S_OK;
     if ((OS_NULL == variable_name_p) || (OS_NULL == variable_value_p)) { return S_INVALID_PTR; }
     HAL_LOG(D_DEBUG, "Env var set: %s, %s", variable_name_p, variable_value_p);
     IF_OK(s = OS_MutexRecursiveLock(os_env_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
-        OS_ListItem* item_l_p = OS_EnvVariableListItemByNameGet(variable_name_p);
-        OS_EnvVariable* env_var_p;
+        item_l_p = OS_EnvVariableListItemByNameGet(variable_name_p);
         //Is variable already exists?
         if (OS_NULL == item_l_p) { //No. Create the new one.
             const Size variable_name_len = OS_StrLen((char const*)variable_name_p) + 1;
             const Size variable_value_len= OS_StrLen((char const*)variable_value_p) + 1;
+            is_new = OS_TRUE;
             if ((0 == variable_name_len) || (0 == variable_value_len)) { s = S_INVALID_VALUE; goto error; }
             item_l_p = OS_ListItemCreate();
             env_var_p = (OS_EnvVariable*)OS_Malloc(sizeof(OS_EnvVariable));
+            if ((OS_NULL == item_l_p) || (OS_NULL == env_var_p)) { s = S_OUT_OF_MEMORY; goto error; }
+            env_var_p->handler_p = OS_NULL;
+            env_var_p->flags   = 0;
             env_var_p->name_p  = (ConstStrP)OS_Malloc(variable_name_len);
             env_var_p->value_p = (ConstStrP)OS_Malloc(variable_value_len);
-            if ((OS_NULL == item_l_p) || (OS_NULL == env_var_p)) { s = S_OUT_OF_MEMORY; goto error; }
             if ((OS_NULL == env_var_p->name_p) || (OS_NULL == env_var_p->value_p)) { s = S_OUT_OF_MEMORY; goto error; }
             OS_StrNCpy((char*)env_var_p->name_p,  (char const*)variable_name_p,  variable_name_len);
             OS_StrNCpy((char*)env_var_p->value_p, (char const*)variable_value_p, variable_value_len);
@@ -132,19 +149,29 @@ Status s = S_OK;
             OS_ListAppend(&os_variables_list, item_l_p);
         } else { //Yes.
             env_var_p = (OS_EnvVariable*)OS_ListItemValueGet(item_l_p);
-            OS_Free((void*)env_var_p->value_p); //Delete old value.
+            //The same value is kept.
+            if (!OS_StrCmp((const char*)env_var_p->value_p, (const char*)variable_value_p)) {
+                is_changed = OS_FALSE;
+                goto error;
+            }
             const Size variable_data_len = OS_StrLen((char const*)variable_value_p) + 1;
-            //Create the new one.
-            env_var_p->value_p = (ConstStrP)OS_Malloc(variable_data_len);
-            if (OS_NULL == env_var_p->value_p) { s = S_OUT_OF_MEMORY; goto error; }
-            OS_StrNCpy((char*)env_var_p->value_p, (char const*)variable_value_p, variable_data_len);
+            //Create the new one (the old one is kept until the handler accepts the new one).
+            const ConstStrP value_p = (ConstStrP)OS_Malloc(variable_data_len);
+            if (OS_NULL == value_p) { s = S_OUT_OF_MEMORY; goto error; }
+            OS_StrNCpy((char*)value_p, (char const*)variable_value_p, variable_data_len);
+            value_old_p = env_var_p->value_p;
+            is_value_old_mapped = BIT_TEST(env_var_p->flags, BIT(ENV_VAR_VALUE_MAPPED)) ? OS_TRUE : OS_FALSE;
+            BIT_CLEAR(env_var_p->flags, BIT(ENV_VAR_VALUE_MAPPED));
+            env_var_p->value_p = value_p;
         }
 error:
         IF_STATUS(s) {
-            OS_Free((void*)env_var_p->value_p);
-            OS_Free((void*)env_var_p->name_p);
-            OS_Free(env_var_p);
-            OS_ListItemDelete(item_l_p);
+            if (OS_TRUE == is_new) {
+                OS_EnvVariableFree(env_var_p);
+                if (OS_NULL != item_l_p) {
+                    OS_ListItemDelete(item_l_p);
+                }
+            }
         } else {
             if ((OS_NULL != env_var_p->handler_p) ||
                 (OS_NULL != variable_handler_p)) {
@@ -153,12 +180,127 @@ error:
                 }
                 s = env_var_p->handler_p(env_var_p->value_p);
             }
+            if (OS_NULL != value_old_p) {
+                IF_STATUS(s) {
+                    //The rejected value is never kept (and never saved to the snapshot).
+                    HAL_LOG(D_WARNING, "Env var rejected: %s, %s", variable_name_p, variable_value_p);
+                    OS_Free((void*)env_var_p->value_p);
+                    env_var_p->value_p = value_old_p;
+                    if (OS_TRUE == is_value_old_mapped) {
+                        BIT_SET(env_var_p->flags, BIT(ENV_VAR_VALUE_MAPPED));
+                    }
+                } else if (OS_TRUE != is_value_old_mapped) {
+                    OS_Free((void*)value_old_p); //Delete old value.
+                }
+            }
         }
         OS_MutexRecursiveUnlock(os_env_mutex);
+        // The failed or the same value sets don't rewrite the snapshot.
+        if ((S_OK == s) && (OS_TRUE == is_changed)) {
+            OS_EnvChanged();
+        }
     }
     return s;
 }
 
+/******************************************************************************/
+Status OS_EnvVariableDefaultSet(ConstStrP variable_name_p, ConstStrP variable_value_p,
+                                const OS_EnvVariableHandler variable_handler_p)
+{
+OS_EnvVariable* env_var_p = OS_NULL;
+Status s = S_OK;
+    if ((OS_NULL == variable_name_p) || (OS_NULL == variable_value_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexRecursiveLock(os_env_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
+        const OS_ListItem* item_l_p = OS_EnvVariableListItemByNameGet(variable_name_p);
+        if (OS_NULL != item_l_p) {
+            // Keep the restored value - apply it only.
+            env_var_p = (OS_EnvVariable*)OS_ListItemValueGet(item_l_p);
+            HAL_LOG(D_DEBUG, "Env var keep: %s, %s", variable_name_p, env_var_p->value_p);
+            if (OS_NULL != variable_handler_p) {
+                env_var_p->handler_p = variable_handler_p;
+                IF_STATUS(s = env_var_p->handler_p(env_var_p->value_p)) {
+                    // The restored value doesn't stop the boot: the default is applied instead.
+                    HAL_LOG(D_WARNING, "Env var restored value rejected: %s, %s", variable_name_p, env_var_p->value_p);
+                    env_var_p = OS_NULL;
+                    s = S_OK;
+                }
+            }
+        }
+        OS_MutexRecursiveUnlock(os_env_mutex);
+    }
+    if ((S_OK == s) && (OS_NULL == env_var_p)) {
+        s = OS_EnvVariableSet(variable_name_p, variable_value_p, variable_handler_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_EnvVariableMap(ConstStrP variable_name_p, ConstStrP variable_value_p)
+{
+Status s = S_OK;
+    if ((OS_NULL == variable_name_p) || (OS_NULL == variable_value_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexRecursiveLock(os_env_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
+        if (OS_NULL != OS_EnvVariableListItemByNameGet(variable_name_p)) {
+            s = S_INVALID_STATE;
+        } else {
+            // No strings copies - the caller keeps them.
+            OS_ListItem* item_l_p = OS_ListItemCreate();
+            OS_EnvVariable* env_var_p = (OS_EnvVariable*)OS_Malloc(sizeof(OS_EnvVariable));
+            if ((OS_NULL == item_l_p) || (OS_NULL == env_var_p)) {
+                OS_Free(env_var_p);
+                if (OS_NULL != item_l_p) { OS_ListItemDelete(item_l_p); }
+                s = S_OUT_OF_MEMORY;
+            } else {
+                env_var_p->name_p   = variable_name_p;
+                env_var_p->value_p  = variable_value_p;
+                env_var_p->handler_p= OS_NULL;
+                env_var_p->flags    = BIT(ENV_VAR_NAME_MAPPED) | BIT(ENV_VAR_VALUE_MAPPED);
+                OS_ListItemValueSet(item_l_p, (OS_Value)env_var_p);
+                OS_ListItemOwnerSet(item_l_p, OS_TaskGet());
+                OS_ListAppend(&os_variables_list, item_l_p);
+            }
+        }
+        OS_MutexRecursiveUnlock(os_env_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_EnvVariablesBrowse(const OS_EnvVariableCallback callback_func_p, void* args_p)
+{
+Status s = S_OK;
+    if (OS_NULL == callback_func_p) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexRecursiveLock(os_env_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
+        OS_ListItem* iter_li_p = OS_ListItemNextGet((OS_ListItem*)&OS_ListItemLastGet(&os_variables_list));
+        while (OS_DELAY_MAX != OS_ListItemValueGet(iter_li_p)) {
+            const OS_EnvVariable* env_var_p = (OS_EnvVariable*)OS_ListItemValueGet(iter_li_p);
+            IF_STATUS(s = callback_func_p(env_var_p->name_p, env_var_p->value_p, args_p)) { break; }
+            iter_li_p = OS_ListItemNextGet(iter_li_p);
+        }
+        OS_MutexRecursiveUnlock(os_env_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+void OS_EnvVariableFree(OS_EnvVariable* env_var_p)
+{
+    if (OS_NULL == env_var_p) { return; }
+    if (!BIT_TEST(env_var_p->flags, BIT(ENV_VAR_VALUE_MAPPED))) { OS_Free((void*)env_var_p->value_p); }
+    if (!BIT_TEST(env_var_p->flags, BIT(ENV_VAR_NAME_MAPPED)))  { OS_Free((void*)env_var_p->name_p); }
+    OS_Free(env_var_p);
+}
+
+/******************************************************************************/
+void OS_EnvChanged(void)
+{
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    // Called outside of the environment lock (the snapshot browses the variables).
+    Status s;
+    IF_STATUS(s = OS_SettingsSnapshotWrite()) { OS_LOG_S(D_WARNING, s); }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+}
+
 /******************************************************************************/
 Status OS_EnvVariableDelete(ConstStrP variable_name_p)
 {
@@ -166,13 +308,15 @@ Status s;
     OS_LOG(D_DEBUG, "Env var del: %s", variable_name_p);
     IF_OK(s = OS_MutexRecursiveLock(os_env_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
         OS_ListItem* item_l_p = OS_EnvVariableListItemByNameGet(variable_name_p);
-        if (OS_NULL == item_l_p) { return S_INVALID_PTR; }
+        if (OS_NULL == item_l_p) {
+            OS_MutexRecursiveUnlock(os_env_mutex);
+            return S_INVALID_PTR;
+        }
         OS_EnvVariable* env_var_p = (OS_EnvVariable*)OS_ListItemValueGet(item_l_p);
         OS_ListItemDelete(item_l_p);
-        OS_Free((void*)env_var_p->value_p);
-        OS_Free((void*)env_var_p->name_p);
-        OS_Free(env_var_p);
+        OS_EnvVariableFree(env_var_p);
         OS_MutexRecursiveUnlock(os_env_mutex);
+        OS_EnvChanged();
     }
     return s;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "os_memory.h"
 #include "os_signal.h"
 #include "os_mailbox.h"
+#include "os_profile.h"
 
 //------------------------------------------------------------------------------
 static void SignalSend(const OS_TaskId src_tid, const Status status, const OS_SignalId signal_id);
@@ -88,6 +89,7 @@ Status OS_MessageReceive(const OS_QueueHd qhd, OS_Message** msg_pp, const OS_Tim
 {
 extern Status OS_TaskPowerStateSet(const OS_TaskHd thd, const OS_PowerState state);
 Status s = S_UNDEF;
+    OS_PROF_ZONE_BEGIN(msg_receive); //Includes the blocking time.
 signal_filter: //Prevent recursion calls.
     IF_OK(s = OS_QueueReceive(qhd, msg_pp, timeout)) {
         const OS_Message* msg_p = *msg_pp;
@@ -116,6 +118,7 @@ signal_filter: //Prevent recursion calls.
     } else {
 //        OS_LOG_S(D_DEBUG, s);
     }
+    OS_PROF_ZONE_END(msg_receive);
     return s;
 }
 
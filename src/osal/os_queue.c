@@ -227,6 +227,57 @@ OS_ListItem* iter_li_p = (OS_ListItem*)qhd;
     return (OS_QueueHd)iter_li_p;
 }
 
+#if (OS_TASK_LIGHT_ENABLED)
+/******************************************************************************/
+Status OS_QueueSetCreate(const U16 len, OS_QueueSetHd* qshd_p)
+{
+    if (OS_NULL == qshd_p) { return S_INVALID_PTR; }
+    const QueueSetHandle_t queue_set_hd = xQueueCreateSet(len);
+    if (OS_NULL == queue_set_hd) { return S_INVALID_QUEUE; }
+    *qshd_p = (OS_QueueSetHd)queue_set_hd;
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_QueueSetAdd(const OS_QueueSetHd qshd, const OS_QueueHd qhd)
+{
+    if ((OS_NULL == qshd) || (OS_NULL == qhd)) { return S_INVALID_QUEUE; }
+    QueueHandle_t queue_hd = (QueueHandle_t)OS_ListItemOwnerGet((OS_ListItem*)qhd);
+    if (pdPASS != xQueueAddToSet(queue_hd, (QueueSetHandle_t)qshd)) {
+        return S_INVALID_STATE;
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+Status OS_QueueSetRemove(const OS_QueueSetHd qshd, const OS_QueueHd qhd)
+{
+    if ((OS_NULL == qshd) || (OS_NULL == qhd)) { return S_INVALID_QUEUE; }
+    QueueHandle_t queue_hd = (QueueHandle_t)OS_ListItemOwnerGet((OS_ListItem*)qhd);
+    if (pdPASS != xQueueRemoveFromSet(queue_hd, (QueueSetHandle_t)qshd)) {
+        return S_INVALID_STATE;
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+OS_QueueHd OS_QueueSetSelect(const OS_QueueSetHd qshd, const OS_TimeMs timeout)
+{
+const OS_Tick ticks = ((OS_BLOCK == timeout) || (OS_NO_BLOCK == timeout)) ? timeout : OS_MS_TO_TICKS(timeout);
+OS_ListItem* item_l_p = OS_NULL;
+
+    if (OS_NULL == qshd) { return OS_NULL; }
+    const QueueSetMemberHandle_t queue_hd = xQueueSelectFromSet((QueueSetHandle_t)qshd, ticks);
+    if (OS_NULL == queue_hd) { return OS_NULL; }
+    IF_OK(OS_MutexRecursiveLock(os_queue_mutex, OS_TIMEOUT_MUTEX_LOCK)) {   // os_list protection;
+        //The set may hold the items of the already deleted queue.
+        item_l_p = OS_ListItemByOwnerGet(&os_queues_list, (OS_Owner)queue_hd);
+        OS_MutexRecursiveUnlock(os_queue_mutex);
+    }
+    return (OS_QueueHd)item_l_p;
+}
+#endif //(OS_TASK_LIGHT_ENABLED)
+
 //------------------------------------------------------------------------------
 /// @brief ISR specific functions.
 
@@ -3,47 +3,246 @@
 * @brief   OS Startup.
 * @author  A. Filyanov
 *******************************************************************************/
-#include "os_list.h"
 #include "os_task.h"
 #include "os_memory.h"
+#include "os_signal.h"
+#include "os_mailbox.h"
 #include "os_startup.h"
 
 //------------------------------------------------------------------------------
-static OS_List os_startup_list;
+#define MDL_NAME                "startup"
+
+//Leave a room in the supervisor stdin for the other signals.
+#define OS_STARTUP_PARALLEL_MAX (OS_STDIN_LEN - 1)
+#define OS_STARTUP_IDX_UNDEF    U8_MAX
+
+//------------------------------------------------------------------------------
+enum {
+    OS_STARTUP_STATE_WAIT,
+    OS_STARTUP_STATE_PWR_STARTUP,
+    OS_STARTUP_STATE_PWR_ON,
+    OS_STARTUP_STATE_READY,
+    OS_STARTUP_STATE_FAILED
+};
+typedef U8 OS_StartupState;
+
+typedef struct {
+    const OS_TaskConfig*    cfg_p;
+    OS_TaskHd               thd;
+    U32                     start_cycles;
+    U32                     ready_cycles;
+    U8                      deps_v[OS_STARTUP_DEPS_MAX];
+    U8                      deps_count;
+    U8                      pred;
+    OS_StartupState         state;
+    Bool                    is_critical;
+    Status                  status;
+} OS_StartupItem;
+
+//------------------------------------------------------------------------------
+static OS_StartupItem os_startup_v[OS_STARTUP_TASKS_MAX]; //Keeps the timeline after the startup.
+static U8 os_startup_count;
+static U32 os_startup_cycles_base;
 
 /******************************************************************************/
 Status OS_StartupInit(void)
 {
-    OS_ListInit(&os_startup_list);
-    if (OS_TRUE != OS_ListIsInitialised(&os_startup_list)) { return S_INVALID_VALUE; }
+    OS_MemSet(os_startup_v, 0, sizeof(os_startup_v));
+    os_startup_count = 0;
     return S_OK;
 }
 
 /******************************************************************************/
 Status OS_StartupDeInit(void)
 {
-    OS_ListClear(&os_startup_list);
-    return S_OK;
+    return S_OK; //The timeline is kept for the boot report.
+}
+
+/******************************************************************************/
+static U8 OS_StartupIdxGet(const OS_TaskConfig* task_cfg_p);
+U8 OS_StartupIdxGet(const OS_TaskConfig* task_cfg_p)
+{
+    for (U8 i = 0; i < os_startup_count; ++i) {
+        if (task_cfg_p == os_startup_v[i].cfg_p) {
+            return i;
+        }
+    }
+    return OS_STARTUP_IDX_UNDEF;
+}
+
+/******************************************************************************/
+static OS_StartupItem* OS_StartupItemByTaskIdGet(const OS_TaskId tid);
+OS_StartupItem* OS_StartupItemByTaskIdGet(const OS_TaskId tid)
+{
+    for (U8 i = 0; i < os_startup_count; ++i) {
+        OS_StartupItem* item_p = &os_startup_v[i];
+        if ((OS_NULL != item_p->thd) && (tid == OS_TaskIdGet(item_p->thd))) {
+            return item_p;
+        }
+    }
+    return OS_NULL;
+}
+
+/******************************************************************************/
+static Status OS_StartupItemRun(OS_StartupItem* item_p);
+Status OS_StartupItemRun(OS_StartupItem* item_p)
+{
+Status s;
+    item_p->pred = OS_STARTUP_IDX_UNDEF;
+    for (U8 i = 0; i < item_p->deps_count; ++i) {
+        const U8 dep = item_p->deps_v[i];
+        if ((OS_STARTUP_IDX_UNDEF == item_p->pred) ||
+            ((S32)(os_startup_v[dep].ready_cycles - os_startup_v[item_p->pred].ready_cycles) > 0)) {
+            item_p->pred = dep; //The latest ready dependency gates this task.
+        }
+    }
+    item_p->start_cycles = HAL_CORE_CYCLES;
+    IF_OK(s = OS_TaskCreateAsync(OS_NULL, item_p->cfg_p, &item_p->thd)) {
+        if (OS_NULL == item_p->cfg_p->func_power) {
+            item_p->ready_cycles = HAL_CORE_CYCLES;
+            item_p->state = OS_STARTUP_STATE_READY;
+        } else {
+            const OS_Signal signal = OS_SignalCreate(OS_SIG_PWR, PWR_STARTUP); //Task power "startup" state set.
+            IF_OK(s = OS_SignalSend(OS_TaskStdInGet(item_p->thd), signal, OS_MSG_PRIO_HIGH)) {
+                item_p->state = OS_STARTUP_STATE_PWR_STARTUP;
+            }
+        }
+    }
+    return s;
+}
+
+/******************************************************************************/
+static Status OS_StartupAckHandle(const OS_Message* msg_p, U8* in_flight_p);
+Status OS_StartupAckHandle(const OS_Message* msg_p, U8* in_flight_p)
+{
+OS_StartupItem* item_p = OS_StartupItemByTaskIdGet((OS_TaskId)OS_SignalSrcGet(msg_p));
+Status s;
+    if (OS_NULL == item_p) { return S_INVALID_SIGNAL; }
+    IF_STATUS(s = (Status)OS_SignalDataGet(msg_p)) {
+        item_p->state = OS_STARTUP_STATE_FAILED;
+    } else {
+        if (OS_STARTUP_STATE_PWR_STARTUP == item_p->state) {
+            const OS_Signal signal = OS_SignalCreate(OS_SIG_PWR, PWR_ON); //Task power "on" state set.
+            IF_OK(s = OS_SignalSend(OS_TaskStdInGet(item_p->thd), signal, OS_MSG_PRIO_HIGH)) {
+                item_p->state = OS_STARTUP_STATE_PWR_ON;
+                return s;
+            }
+            item_p->state = OS_STARTUP_STATE_FAILED;
+        } else if (OS_STARTUP_STATE_PWR_ON == item_p->state) {
+            item_p->ready_cycles = HAL_CORE_CYCLES;
+            item_p->state = OS_STARTUP_STATE_READY;
+            OS_LOG(D_DEBUG, "[TID:%03u]%s: Hello world!", OS_TaskIdGet(item_p->thd), item_p->cfg_p->name);
+        } else {
+            return S_INVALID_STATE;
+        }
+    }
+    item_p->status = s;
+    --(*in_flight_p);
+    return s;
+}
+
+/******************************************************************************/
+static void OS_StartupCriticalPathMark(void);
+void OS_StartupCriticalPathMark(void)
+{
+U8 last = OS_STARTUP_IDX_UNDEF;
+    for (U8 i = 0; i < os_startup_count; ++i) {
+        if ((OS_STARTUP_STATE_READY == os_startup_v[i].state) &&
+            ((OS_STARTUP_IDX_UNDEF == last) ||
+             ((S32)(os_startup_v[i].ready_cycles - os_startup_v[last].ready_cycles) > 0))) {
+            last = i;
+        }
+    }
+    while (OS_STARTUP_IDX_UNDEF != last) {
+        os_startup_v[last].is_critical = OS_TRUE;
+        last = os_startup_v[last].pred;
+    }
 }
 
 /******************************************************************************/
 Status OS_StartupApplication(void)
 {
-OS_ListItem* iter_li_p;
+const OS_QueueHd stdin_qhd = OS_TaskStdInGet(OS_THIS_TASK);
+U8 pending = os_startup_count;
+U8 in_flight = 0;
+OS_Message* msg_p;
 Status s = S_OK;
 
     OS_LOG(D_INFO, "OS startup run...");
-    // Create startup tasks.
-    for (iter_li_p = OS_ListItemNextGet((OS_ListItem*)&OS_ListItemLastGet(&os_startup_list));
-         OS_DELAY_MAX != (OS_Value)OS_ListItemValueGet(iter_li_p);
-         iter_li_p = OS_ListItemNextGet(iter_li_p)) {
-        const OS_TaskConfig* task_cfg_p = (const OS_TaskConfig*)OS_ListItemOwnerGet(iter_li_p);
-        OS_TaskHd thd = OS_NULL;
-        IF_STATUS(s = OS_TaskCreate(OS_NULL, task_cfg_p, &thd)) {
-            OS_ASSERT(OS_FALSE);
+    os_startup_cycles_base = HAL_CORE_CYCLES;
+    while (pending) {
+        Bool is_changed;
+        // Create the tasks which dependencies are ready.
+        do {
+            is_changed = OS_FALSE;
+            for (U8 i = 0; (i < os_startup_count) && (OS_STARTUP_PARALLEL_MAX > in_flight); ++i) {
+                OS_StartupItem* item_p = &os_startup_v[i];
+                Bool is_ready = OS_TRUE;
+                if (OS_STARTUP_STATE_WAIT != item_p->state) { continue; }
+                for (U8 j = 0; j < item_p->deps_count; ++j) {
+                    const OS_StartupState dep_state = os_startup_v[item_p->deps_v[j]].state;
+                    if (OS_STARTUP_STATE_FAILED == dep_state) {
+                        item_p->state = OS_STARTUP_STATE_FAILED;
+                        item_p->status= S_INVALID_TASK;
+                    }
+                    if (OS_STARTUP_STATE_READY != dep_state) {
+                        is_ready = OS_FALSE;
+                    }
+                }
+                if (OS_STARTUP_STATE_FAILED == item_p->state) {
+                    OS_LOG(D_WARNING, "%s: dependency failed!", item_p->cfg_p->name);
+                    is_changed = OS_TRUE;
+                    --pending;
+                    continue;
+                }
+                if (OS_TRUE != is_ready) { continue; }
+                IF_STATUS(item_p->status = OS_StartupItemRun(item_p)) {
+                    item_p->state = OS_STARTUP_STATE_FAILED;
+                }
+                is_changed = OS_TRUE;
+                if (OS_STARTUP_STATE_PWR_STARTUP == item_p->state) {
+                    ++in_flight;
+                } else {
+                    --pending;
+                }
+            }
+        } while (OS_TRUE == is_changed);
+        if (!pending) { break; }
+        if (!in_flight) {
+            s = S_INVALID_STATE; //Cyclic dependencies.
+            OS_LOG(D_WARNING, "Startup dependencies deadlock!");
+            break;
+        }
+        // Collect the power acks.
+        IF_OK(s = OS_MessageReceive(stdin_qhd, &msg_p, OS_TIMEOUT_POWER)) {
+            if (OS_SignalIs(msg_p)) {
+                if (OS_SIG_PWR_ACK == OS_SignalIdGet(msg_p)) {
+                    const U8 in_flight_prev = in_flight;
+                    IF_STATUS(s = OS_StartupAckHandle(msg_p, &in_flight)) { OS_LOG_S(D_WARNING, s); }
+                    if (in_flight_prev != in_flight) {
+                        --pending;
+                    }
+                } else {
+                    OS_LOG_S(D_DEBUG, S_INVALID_SIGNAL);
+                }
+            } else {
+                OS_LOG_S(D_DEBUG, S_INVALID_MESSAGE);
+                OS_MessageDelete(msg_p); // free message allocated memory
+            }
+        } else {
+            OS_LOG_S(D_WARNING, s);
+            break;
+        }
+    }
+    OS_StartupCriticalPathMark();
+    for (U8 i = 0; i < os_startup_count; ++i) {
+        IF_STATUS(os_startup_v[i].status) {
+            s = os_startup_v[i].status;
+        } else if (OS_STARTUP_STATE_READY != os_startup_v[i].state) {
+            os_startup_v[i].status = s = S_TIMEOUT;
         }
-        OS_ListItemValueSet(iter_li_p, (OS_Value)thd);
     }
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
     return s;
 }
 
@@ -58,31 +257,79 @@ Status s;
 #if (HAL_USBH_ENABLED) || (HAL_USBD_ENABLED)
     extern const OS_TaskConfig task_usb_cfg;
     IF_STATUS(s = OS_StartupTaskAdd(&task_usb_cfg)) { return s; }
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_usb_cfg, &task_log_cfg)) { return s; }
 #endif //(HAL_USBH_ENABLED) || (HAL_USBD_ENABLED)
 #if (OS_FILE_SYSTEM_ENABLED)
     extern const OS_TaskConfig task_fs_cfg;
     IF_STATUS(s = OS_StartupTaskAdd(&task_fs_cfg)) { return s; }
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_fs_cfg, &task_log_cfg)) { return s; }
+#if (HAL_USBH_ENABLED) || (HAL_USBD_ENABLED)
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_fs_cfg, &task_usb_cfg)) { return s; }
+#endif //(HAL_USBH_ENABLED) || (HAL_USBD_ENABLED)
 #endif //(OS_FILE_SYSTEM_ENABLED)
 #if (OS_NETWORK_ENABLED)
+    //ETH driver is created by the net task itself.
     extern const OS_TaskConfig task_net_cfg;
     IF_STATUS(s = OS_StartupTaskAdd(&task_net_cfg)) { return s; }
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_net_cfg, &task_log_cfg)) { return s; }
 #endif //(OS_NETWORK_ENABLED)
 #if (OS_AUDIO_ENABLED)
     extern const OS_TaskConfig task_audio_cfg;
     IF_STATUS(s = OS_StartupTaskAdd(&task_audio_cfg)) { return s; }
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_audio_cfg, &task_log_cfg)) { return s; }
 #endif //(OS_AUDIO_ENABLED)
     IF_STATUS(s = OS_StartupTaskAdd(&task_shell_cfg)) { return s; }
+    IF_STATUS(s = OS_StartupTaskDependencyAdd(&task_shell_cfg, &task_log_cfg)) { return s; }
     return s;
 }
 
 /******************************************************************************/
 Status OS_StartupTaskAdd(const OS_TaskConfig* task_cfg_p)
 {
-OS_ListItem* item_l_p = OS_ListItemCreate();
+OS_StartupItem* item_p;
 Status s = S_OK;
-    if (OS_NULL == item_l_p) { return S_OUT_OF_MEMORY; }
-    OS_ListItemValueSet(item_l_p, (OS_Value)OS_NULL);
-    OS_ListItemOwnerSet(item_l_p, (OS_Owner)task_cfg_p);
-    OS_ListAppend(&os_startup_list, item_l_p);
+    if (OS_NULL == task_cfg_p) { return S_INVALID_PTR; }
+    if (OS_STARTUP_TASKS_MAX <= os_startup_count) { return S_OVERFLOW; }
+    HAL_BOOT_CHECKPOINT(task_cfg_p->name);
+    item_p = &os_startup_v[os_startup_count++];
+    item_p->cfg_p   = task_cfg_p;
+    item_p->pred    = OS_STARTUP_IDX_UNDEF;
+    item_p->state   = OS_STARTUP_STATE_WAIT;
+    item_p->status  = S_OK;
     return s;
-}
\ No newline at end of file
+}
+
+/******************************************************************************/
+Status OS_StartupTaskDependencyAdd(const OS_TaskConfig* task_cfg_p, const OS_TaskConfig* dep_cfg_p)
+{
+const U8 idx = OS_StartupIdxGet(task_cfg_p);
+const U8 dep = OS_StartupIdxGet(dep_cfg_p);
+    if ((OS_STARTUP_IDX_UNDEF == idx) || (OS_STARTUP_IDX_UNDEF == dep)) { return S_NOT_EXISTS; }
+    if (idx == dep) { return S_INVALID_ARG; }
+    OS_StartupItem* item_p = &os_startup_v[idx];
+    if (OS_STARTUP_DEPS_MAX <= item_p->deps_count) { return S_OVERFLOW; }
+    item_p->deps_v[item_p->deps_count++] = dep;
+    return S_OK;
+}
+
+/******************************************************************************/
+U8 OS_StartupTimelineCountGet(void)
+{
+    return os_startup_count;
+}
+
+/******************************************************************************/
+Status OS_StartupTimelineItemGet(const U8 idx, OS_StartupTimelineItem* item_p)
+{
+    if (OS_NULL == item_p) { return S_INVALID_PTR; }
+    if (os_startup_count <= idx) { return S_OUT_OF_RANGE; }
+    const OS_StartupItem* startup_item_p = &os_startup_v[idx];
+    item_p->name_p      = startup_item_p->cfg_p->name;
+    item_p->start       = CYCLES_TO_US(startup_item_p->start_cycles - os_startup_cycles_base);
+    item_p->ready       = (OS_STARTUP_STATE_READY == startup_item_p->state) ?
+                          CYCLES_TO_US(startup_item_p->ready_cycles - os_startup_cycles_base) : 0;
+    item_p->pred        = startup_item_p->pred;
+    item_p->is_critical = startup_item_p->is_critical;
+    item_p->status      = startup_item_p->status;
+    return S_OK;
+}
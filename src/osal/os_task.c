@@ -18,6 +18,12 @@
 #define OS_TASKS_COUNT_MAX          TYPE_VALUE_MAX(OS_TaskId)
 
 //------------------------------------------------------------------------------
+typedef struct {
+    OS_TaskConfig           cfg;        //User config copy with the periodic main function.
+    const OS_TaskConfig*    cfg_user_p;
+    OS_TaskPeriodicStats    stats;
+} OS_TaskPeriodicDyn;
+
 typedef struct {
     const OS_TaskConfig* cfg_p;
     OS_QueueHd      stdin_qhd;
@@ -28,6 +34,7 @@ typedef struct {
     OS_TaskId       id;
     OS_PowerState   power;
     U8              timeout;
+    OS_TaskPeriodicDyn* periodic_p;
 } OS_TaskConfigDyn;
 
 //------------------------------------------------------------------------------
@@ -42,15 +49,50 @@ Status          OS_TaskPowerStateSet(const OS_TaskHd thd, const OS_PowerState st
 /// @return     Slots list.
 const OS_List*  OS_TaskSlotsGet(const OS_TaskHd thd);
 
+/// @brief      Create a task.
+/// @param[in]  args_p          Task arguments.
+/// @param[in]  cfg_p           Task config.
+/// @param[in]  periodic_p      Periodic task data (OS_NULL - common task).
+/// @param[in]  is_power_sync   Wait for the task power startup/on acks.
+/// @param[out] thd_p           Task handle.
+/// @return     #Status.
+static Status   OS_TaskCreate_(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskPeriodicDyn* periodic_p,
+                               const Bool is_power_sync, OS_TaskHd* thd_p);
+
 /// @brief      Is a single instance task?
 /// @param[in]  cfg_p           Task config.
 /// @return     #Bool.
 static Bool OS_TaskIsSingle(const OS_TaskConfig* cfg_p);
 
+#if (OS_TASK_LIGHT_ENABLED)
+/// @brief      Light tasks executor main function.
+/// @param[in]  args_p          Task arguments.
+/// @return     None.
+static void     OS_TaskLightExecMain(OS_TaskArgs* args_p);
+#endif //(OS_TASK_LIGHT_ENABLED)
+
 //------------------------------------------------------------------------------
 static OS_List os_tasks_list;
 static OS_MutexHd os_task_mutex;
 static volatile OS_TaskId id_curr;
+#if (OS_TASK_LIGHT_ENABLED)
+static OS_QueueSetHd os_task_light_qshd;
+static OS_TaskHd os_task_light_exec_thd;
+static OS_MutexHd os_task_light_mutex; //Light task handler call vs. the light task delete.
+
+static const OS_TaskConfig task_light_exec_cfg = {
+    .name           = "LightExec",
+    .func_main      = OS_TaskLightExecMain,
+    .func_power     = OS_NULL,
+    .args_p         = OS_NULL,
+    .attrs          = BIT(OS_TASK_ATTR_SINGLE),
+    .prio_init      = OS_PRIO_TASK_LIGHT_EXEC,
+    .prio_power     = OS_PWR_PRIO_DEFAULT,
+    .storage_size   = 0,
+    .stack_size     = OS_TASK_LIGHT_EXEC_STACK_SIZE,
+    .stdin_len      = 1
+};
+#endif //(OS_TASK_LIGHT_ENABLED)
 //static volatile OS_TaskId tasks_count;
 
 /******************************************************************************/
@@ -67,12 +109,8 @@ INLINE TaskHandle_t OS_TaskHandleGet(const OS_TaskHd thd)
 OS_TaskHd OS_TaskHdGet(const TaskHandle_t task_hd);
 OS_TaskHd OS_TaskHdGet(const TaskHandle_t task_hd)
 {
-OS_ListItem* iter_li_p;
-    IF_OK(OS_MutexRecursiveLock(os_task_mutex, OS_TIMEOUT_MUTEX_LOCK)) {    // os_list protection;
-        iter_li_p = OS_ListItemByOwnerGet(&os_tasks_list, task_hd);
-        OS_MutexRecursiveUnlock(os_task_mutex);
-    }
-    return (OS_TaskHd)iter_li_p;
+    // The light tasks share the executor handle: the tag is the light task running now (or the executor).
+    return (OS_TaskHd)xTaskGetApplicationTaskTag(task_hd);
 }
 
 /******************************************************************************/
@@ -112,6 +150,18 @@ OS_TaskHd thd = OS_TaskNextGet(OS_NULL); //get first task in the list.
     return OS_TRUE;
 }
 
+/******************************************************************************/
+static Bool OS_TaskIsLight(const OS_TaskConfig* cfg_p);
+INLINE Bool OS_TaskIsLight(const OS_TaskConfig* cfg_p)
+{
+#if (OS_TASK_LIGHT_ENABLED)
+    if (OS_NULL == cfg_p) { return OS_FALSE; }
+    return (BIT_TEST(cfg_p->attrs, BIT(OS_TASK_ATTR_LIGHT))) ? OS_TRUE : OS_FALSE;
+#else
+    return OS_FALSE;
+#endif //(OS_TASK_LIGHT_ENABLED)
+}
+
 /******************************************************************************/
 Status OS_TaskInit_(void);
 Status OS_TaskInit_(void)
@@ -121,6 +171,10 @@ Status s = S_OK;
     //tasks_count = 0;
     os_task_mutex = OS_MutexRecursiveCreate();
     if (OS_NULL == os_task_mutex) { return S_INVALID_PTR; }
+#if (OS_TASK_LIGHT_ENABLED)
+    os_task_light_mutex = OS_MutexRecursiveCreate();
+    if (OS_NULL == os_task_light_mutex) { return S_INVALID_PTR; }
+#endif //(OS_TASK_LIGHT_ENABLED)
     OS_ListInit(&os_tasks_list);
     if (OS_TRUE != OS_ListIsInitialised(&os_tasks_list)) { return S_INVALID_VALUE; }
     return s;
@@ -128,6 +182,19 @@ Status s = S_OK;
 
 /******************************************************************************/
 Status OS_TaskCreate(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskHd* thd_p)
+{
+    return OS_TaskCreate_(args_p, cfg_p, OS_NULL, OS_TRUE, thd_p);
+}
+
+/******************************************************************************/
+Status OS_TaskCreateAsync(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskHd* thd_p)
+{
+    return OS_TaskCreate_(args_p, cfg_p, OS_NULL, OS_FALSE, thd_p);
+}
+
+/******************************************************************************/
+Status OS_TaskCreate_(const void* args_p, const OS_TaskConfig* cfg_p, OS_TaskPeriodicDyn* periodic_p,
+                      const Bool is_power_sync, OS_TaskHd* thd_p)
 {
 Status s = S_UNDEF;
     if (OS_NULL == cfg_p) { return S_INVALID_PTR; }
@@ -137,6 +204,18 @@ Status s = S_UNDEF;
             return S_INVALID_TASK;
         }
     }
+    const Bool is_light = OS_TaskIsLight(cfg_p);
+#if (OS_TASK_LIGHT_ENABLED)
+    if ((OS_TRUE == is_light) && (OS_NULL == os_task_light_exec_thd)) {
+        // The executor is created with the first light task.
+        IF_STATUS(s = OS_QueueSetCreate(OS_TASK_LIGHT_EXEC_QUEUE_LEN, &os_task_light_qshd)) { return s; }
+        IF_STATUS(s = OS_TaskCreate_(OS_NULL, &task_light_exec_cfg, OS_NULL, OS_FALSE, &os_task_light_exec_thd)) {
+            return s;
+        }
+    }
+#else
+    if (OS_TRUE == is_light) { return S_UNSUPPORTED; }
+#endif //(OS_TASK_LIGHT_ENABLED)
     OS_ListItem* item_l_p = OS_ListItemCreate();
     if (OS_NULL == item_l_p) { return S_OUT_OF_MEMORY; }
     const OS_TaskHd thd = (OS_TaskHd)item_l_p;
@@ -172,20 +251,30 @@ Status s = S_UNDEF;
     }
     // Creating StdIo task queues.
     IF_STATUS(s = OS_QueueCreate(&que_cfg, thd, &cfg_dyn_p->stdin_qhd))  { goto error; }
+#if (OS_TASK_LIGHT_ENABLED)
+    if (OS_TRUE == is_light) {
+        IF_STATUS(s = OS_QueueSetAdd(os_task_light_qshd, cfg_dyn_p->stdin_qhd)) { goto error; }
+    }
+#endif //(OS_TASK_LIGHT_ENABLED)
     cfg_dyn_p->cfg_p        = cfg_p;
     cfg_dyn_p->args.args_p  = (OS_NULL != args_p) ? args_p : cfg_p->args_p;
     cfg_dyn_p->id           = id_curr;
     cfg_dyn_p->parent       = OS_TaskGet();
     cfg_dyn_p->slots_l_p    = OS_NULL;
     cfg_dyn_p->timeout      = cfg_dyn_p->cfg_p->timeout;
+    cfg_dyn_p->periodic_p   = periodic_p;
     OS_CriticalSectionEnter(); { // Atomic section to prevent context switch right after task creation by OS Engine.
-        if (pdPASS != xTaskCreate((TaskFunction_t)cfg_p->func_main, cfg_p->name, cfg_p->stack_size,
-                                  (void*)&cfg_dyn_p->args, cfg_p->prio_init, &task_hd)) {
-            OS_CriticalSectionExit();
-            s = S_MODULE;
-            goto error;
+        if (OS_TRUE == is_light) {
+            task_hd = OS_TaskHandleGet(os_task_light_exec_thd); //Light task lives on the executor stack.
+        } else {
+            if (pdPASS != xTaskCreate((TaskFunction_t)cfg_p->func_main, cfg_p->name, cfg_p->stack_size,
+                                      (void*)&cfg_dyn_p->args, cfg_p->prio_init, &task_hd)) {
+                OS_CriticalSectionExit();
+                s = S_MODULE;
+                goto error;
+            }
+            vTaskSetApplicationTaskTag(task_hd, (TaskHookFunction_t)thd);
         }
-        vTaskSetApplicationTaskTag(task_hd, (TaskHookFunction_t)thd);
         OS_ListItemValueSet(item_l_p, (OS_Value)cfg_dyn_p);
         OS_ListItemOwnerSet(item_l_p, (OS_Owner)task_hd);
         OS_ListAppend(&os_tasks_list, item_l_p);
@@ -199,7 +288,7 @@ Status s = S_UNDEF;
     //++tasks_count;
     IF_OK(s) {
         if (OS_NULL != cfg_dyn_p->cfg_p->func_power) {
-            if (OS_NULL != task_hd_curr) {
+            if ((OS_NULL != task_hd_curr) && (OS_TRUE == is_power_sync)) {
                 const OS_QueueHd this_task_qhd = OS_TaskStdInGet(OS_THIS_TASK);
                 OS_Signal signal = OS_SignalCreate(OS_SIG_PWR, PWR_STARTUP); //Task power "startup" state set.
                 IF_OK(s = OS_SignalSend(cfg_dyn_p->stdin_qhd, signal, OS_MSG_PRIO_HIGH)) {
@@ -259,15 +348,33 @@ Status OS_TaskDelete(const OS_TaskHd thd)
 {
 OS_ListItem* item_l_p = (OS_ListItem*)((OS_THIS_TASK == thd) ? OS_TaskGet() : thd);
 OS_TaskConfigDyn* cfg_dyn_p = (OS_TaskConfigDyn*)OS_ListItemValueGet(item_l_p);
+Bool is_light = OS_FALSE;
 Status s = S_OK;
 
     if (OS_NULL == item_l_p) { return S_INVALID_PTR; }
+#if (OS_TASK_LIGHT_ENABLED)
+    //Wait for the light task handler return (recursive: the handler could delete itself).
+    const Bool is_light_locked = OS_TaskIsLight(cfg_dyn_p->cfg_p);
+    if (OS_TRUE == is_light_locked) {
+        IF_STATUS(s = OS_MutexRecursiveLock(os_task_light_mutex, OS_TIMEOUT_MUTEX_LOCK)) { return s; }
+    }
+#endif //(OS_TASK_LIGHT_ENABLED)
     IF_OK(s = OS_MutexRecursiveLock(os_task_mutex, OS_TIMEOUT_MUTEX_LOCK)) {    // os_list protection;
         const OS_TaskConfig* cfg_p = cfg_dyn_p->cfg_p;
+        OS_TaskPeriodicDyn* periodic_p = cfg_dyn_p->periodic_p; //Holds cfg_p of the periodic task.
         const TaskHandle_t task_hd = (TaskHandle_t)OS_ListItemOwnerGet(item_l_p);
         const OS_TaskId tid = cfg_dyn_p->id;
+        is_light = OS_TaskIsLight(cfg_p);
         IF_STATUS(s = OS_TaskPowerStateSet(thd, PWR_SHUTDOWN)) { goto error; } //TODO(A.Filyanov) Status handler!
         if (OS_NULL != cfg_dyn_p->stdin_qhd) {
+#if (OS_TASK_LIGHT_ENABLED)
+            if (OS_TRUE == is_light) {
+                OS_QueueClear(cfg_dyn_p->stdin_qhd);
+                IF_STATUS(s = OS_QueueSetRemove(os_task_light_qshd, cfg_dyn_p->stdin_qhd)) {
+                    OS_LOG_S(D_WARNING, s);
+                }
+            }
+#endif //(OS_TASK_LIGHT_ENABLED)
             IF_STATUS(s = OS_QueueDelete(cfg_dyn_p->stdin_qhd)) {
                 OS_LOG_S(D_WARNING, s);
             }
@@ -286,11 +393,205 @@ Status s = S_OK;
 error:
         OS_MutexRecursiveUnlock(os_task_mutex);
         OS_LOG(D_DEBUG, "[TID:%03u]%s: Goodbye cruel world!", tid, cfg_p->name);
-        vTaskDelete(task_hd); //Task (self-)delete.
+        IF_OK(s) { OS_Free(periodic_p); }
+        if (OS_TRUE != is_light) {
+            vTaskDelete(task_hd); //Task (self-)delete.
+        } //Light task returns to the executor.
     }
+#if (OS_TASK_LIGHT_ENABLED)
+    if (OS_TRUE == is_light_locked) {
+        OS_MutexRecursiveUnlock(os_task_light_mutex);
+    }
+#endif //(OS_TASK_LIGHT_ENABLED)
     return s;
 }
 
+#if (OS_TASK_LIGHT_ENABLED)
+/******************************************************************************/
+void OS_TaskLightExecMain(OS_TaskArgs* args_p)
+{
+const TaskHandle_t task_hd = xTaskGetCurrentTaskHandle();
+const OS_TaskHd exec_thd = OS_TaskGet();
+OS_QueueHd qhd;
+    for(;;) {
+        qhd = OS_QueueSetSelect(os_task_light_qshd, OS_BLOCK);
+        if (OS_NULL == qhd) { continue; }
+        // Do not let the light task to be deleted by the other tasks during the call.
+        // The tasks list is locked for the lookup only: the handler doesn't block the task API.
+        IF_OK(OS_MutexRecursiveLock(os_task_light_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+            OS_TaskHd thd = OS_NULL;
+            const OS_TaskConfigDyn* cfg_dyn_p = OS_NULL;
+            IF_OK(OS_MutexRecursiveLock(os_task_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+                thd = OS_QueueParentGet(qhd);
+                cfg_dyn_p = OS_TaskConfigDynGet(thd);
+                if ((OS_NULL != cfg_dyn_p) && (qhd != cfg_dyn_p->stdin_qhd)) {
+                    cfg_dyn_p = OS_NULL;
+                }
+                OS_MutexRecursiveUnlock(os_task_mutex);
+            }
+            if (OS_NULL != cfg_dyn_p) {
+                // Switch the task context: OS_THIS_TASK, stdin and signals source are of the light task.
+                vTaskSetApplicationTaskTag(task_hd, (TaskHookFunction_t)thd);
+                cfg_dyn_p->cfg_p->func_main((OS_TaskArgs*)&cfg_dyn_p->args);
+                vTaskSetApplicationTaskTag(task_hd, (TaskHookFunction_t)exec_thd);
+            }
+            OS_MutexRecursiveUnlock(os_task_light_mutex);
+        }
+    }
+}
+#endif //(OS_TASK_LIGHT_ENABLED)
+
+/******************************************************************************/
+static void OS_TaskPeriodicMain(OS_TaskArgs* args_p);
+void OS_TaskPeriodicMain(OS_TaskArgs* args_p)
+{
+OS_TaskConfigDyn* cfg_dyn_p = OS_TaskConfigDynGet(OS_THIS_TASK);
+const OS_TaskConfig* cfg_user_p = cfg_dyn_p->periodic_p->cfg_user_p;
+OS_TaskPeriodicStats* stats_p = &cfg_dyn_p->periodic_p->stats;
+const OS_TimeMs period = stats_p->cfg.period;
+const U32 period_cycles = MS_TO_CYCLES(period);
+const U32 deadline_cycles = MS_TO_CYCLES(stats_p->cfg.deadline);
+const U32 budget_cycles = MS_TO_CYCLES(stats_p->cfg.budget);
+const U32 bin_cycles = MAX(1, deadline_cycles / OS_TASK_PERIODIC_HIST_LEN);
+OS_Tick tick_last = OS_TickCountGet();
+OS_Message* msg_p;
+U32 release_cycles;
+
+    OS_TaskDelayUntil(&tick_last, period);
+    release_cycles = HAL_CORE_CYCLES; //The first release is the time base for the next ones.
+    for(;;) {
+        if ((OS_NULL == cfg_user_p->func_power) || (PWR_ON == cfg_dyn_p->power)) {
+            const U32 start_cycles = HAL_CORE_CYCLES;
+            cfg_user_p->func_main(args_p);
+            const U32 end_cycles = HAL_CORE_CYCLES;
+            const S32 jitter_cycles = (S32)(start_cycles - release_cycles);
+            const U32 response_cycles = end_cycles - release_cycles;
+            const U32 response = CYCLES_TO_US(response_cycles);
+            const U8 bin = (response_cycles > deadline_cycles) ? OS_TASK_PERIODIC_HIST_LEN :
+                           MIN(OS_TASK_PERIODIC_HIST_LEN - 1, response_cycles / bin_cycles);
+            if (0 == stats_p->releases) {
+                stats_p->response_min = response;
+            }
+            ++(stats_p->releases);
+            const U32 jitter_abs = CYCLES_TO_US((0 > jitter_cycles) ? -jitter_cycles : jitter_cycles);
+            stats_p->jitter_last    = (0 > jitter_cycles) ? -(S32)jitter_abs : (S32)jitter_abs;
+            stats_p->jitter_max     = MAX(stats_p->jitter_max, jitter_abs);
+            stats_p->response_last  = response;
+            stats_p->response_min   = MIN(stats_p->response_min, response);
+            stats_p->response_max   = MAX(stats_p->response_max, response);
+            ++(stats_p->response_hist_v[bin]);
+            if (response_cycles > deadline_cycles) {
+                ++(stats_p->deadline_misses);
+            }
+            if ((0 != budget_cycles) && ((end_cycles - start_cycles) > budget_cycles)) {
+                ++(stats_p->budget_overruns);
+            }
+        }
+        //Serve the power signals (filtered by OS_MessageReceive) and drop the rest.
+        while (S_OK == OS_MessageReceive(cfg_dyn_p->stdin_qhd, &msg_p, OS_NO_BLOCK)) {
+            if (!OS_SignalIs(msg_p)) {
+                OS_MessageDelete(msg_p); // free message allocated memory
+            }
+        }
+        OS_TaskDelayUntil(&tick_last, period);
+        release_cycles += period_cycles;
+    }
+}
+
+/******************************************************************************/
+static U16 OS_TasksPeriodicUtilizationGet_(const OS_TaskPeriodicConfig* per_cfg_p, const OS_TaskPrio prio, U8* count_p);
+U16 OS_TasksPeriodicUtilizationGet_(const OS_TaskPeriodicConfig* per_cfg_p, const OS_TaskPrio prio, U8* count_p)
+{
+OS_TaskHd thd = OS_TaskNextGet(OS_NULL); //get first task in the list.
+U32 utilization = 0;
+U8 count = 0;
+    if ((OS_NULL != per_cfg_p) && (0 != per_cfg_p->budget)) {
+        utilization += (per_cfg_p->budget * 1000UL) / MIN(per_cfg_p->period, per_cfg_p->deadline);
+        ++count;
+    }
+    while (OS_NULL != thd) {
+        const OS_TaskConfigDyn* cfg_dyn_p = OS_TaskConfigDynGet(thd);
+        if ((OS_NULL != cfg_dyn_p) && (OS_NULL != cfg_dyn_p->periodic_p)) {
+            const OS_TaskPeriodicConfig* cfg_p = &cfg_dyn_p->periodic_p->stats.cfg;
+            if (0 != cfg_p->budget) {
+                utilization += (cfg_p->budget * 1000UL) / MIN(cfg_p->period, cfg_p->deadline);
+                ++count;
+            }
+            //Rate-monotonic order: the shorter period - the higher priority.
+            if ((OS_NULL != per_cfg_p) &&
+                (((per_cfg_p->period < cfg_p->period) && (prio < cfg_dyn_p->cfg_p->prio_init)) ||
+                 ((per_cfg_p->period > cfg_p->period) && (prio > cfg_dyn_p->cfg_p->prio_init)))) {
+                OS_LOG(D_WARNING, "Not rate-monotonic priority vs %s!", OS_TaskNameGet(thd));
+            }
+        }
+        thd = OS_TaskNextGet(thd);
+    }
+    if (OS_NULL != count_p) {
+        *count_p = count;
+    }
+    return (U16)MIN(U16_MAX, utilization);
+}
+
+/******************************************************************************/
+U16 OS_TasksPeriodicUtilizationGet(void)
+{
+    return OS_TasksPeriodicUtilizationGet_(OS_NULL, 0, OS_NULL);
+}
+
+/******************************************************************************/
+Status OS_TaskPeriodicCreate(const void* args_p, const OS_TaskConfig* cfg_p,
+                             const OS_TaskPeriodicConfig* per_cfg_p, OS_TaskHd* thd_p)
+{
+//Liu & Layland utilisation bound n*(2^(1/n) - 1) (permille).
+static const U16 rm_bound_v[] = { 1000, 1000, 828, 779, 756, 743, 734, 728, 724, 720, 717 };
+OS_TaskPeriodicConfig per_cfg;
+OS_TaskPeriodicDyn* periodic_p;
+U16 utilization;
+U8 count;
+Status s = S_UNDEF;
+    if ((OS_NULL == cfg_p) || (OS_NULL == per_cfg_p)) { return S_INVALID_PTR; }
+    if ((OS_NULL == cfg_p->func_main) || (0 == per_cfg_p->period)) { return S_INVALID_VALUE; }
+    if ((OS_NULL != cfg_p->func_power) && (OS_TIMEOUT_POWER <= per_cfg_p->period)) { return S_INVALID_VALUE; }
+    if (OS_TRUE == OS_TaskIsLight(cfg_p)) { return S_UNSUPPORTED; }
+    per_cfg = *per_cfg_p;
+    if ((0 == per_cfg.deadline) || (per_cfg.period < per_cfg.deadline)) {
+        per_cfg.deadline = per_cfg.period;
+    }
+    if (per_cfg.budget > per_cfg.deadline) { return S_INVALID_VALUE; }
+    //Schedulability check (sufficient only, deadline < period uses the task density).
+    utilization = OS_TasksPeriodicUtilizationGet_(&per_cfg, cfg_p->prio_init, &count);
+    if (1000 < utilization) {
+        OS_LOG(D_WARNING, "%s: utilization %u%% > 100%%!", cfg_p->name, utilization / 10);
+        return S_OVERFLOW;
+    }
+    if (((ITEMS_COUNT_GET(rm_bound_v, U16) > count) ? rm_bound_v[count] : 693) < utilization) {
+        OS_LOG(D_WARNING, "%s: utilization %u%% exceeds RM bound!", cfg_p->name, utilization / 10);
+    }
+    periodic_p = OS_Malloc(sizeof(OS_TaskPeriodicDyn));
+    if (OS_NULL == periodic_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(periodic_p, 0, sizeof(OS_TaskPeriodicDyn));
+    periodic_p->cfg             = *cfg_p;
+    periodic_p->cfg.func_main   = OS_TaskPeriodicMain;
+    periodic_p->cfg_user_p      = cfg_p;
+    periodic_p->stats.cfg       = per_cfg;
+    IF_STATUS(s = OS_TaskCreate_(args_p, &periodic_p->cfg, periodic_p, OS_TRUE, thd_p)) {
+        OS_Free(periodic_p);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_TaskPeriodicStatsGet(const OS_TaskHd thd, OS_TaskPeriodicStats* stats_p)
+{
+const OS_TaskConfigDyn* cfg_dyn_p = OS_TaskConfigDynGet(thd);
+    if ((OS_NULL == cfg_dyn_p) || (OS_NULL == stats_p)) { return S_INVALID_PTR; }
+    if (OS_NULL == cfg_dyn_p->periodic_p) { return S_INVALID_TASK; }
+    OS_CriticalSectionEnter(); {
+        *stats_p = cfg_dyn_p->periodic_p->stats;
+    } OS_CriticalSectionExit();
+    return S_OK;
+}
+
 /******************************************************************************/
 void OS_TaskDelay(const OS_TimeMs timeout)
 {
@@ -307,6 +608,7 @@ void OS_TaskDelayUntil(OS_Tick* tick_last_p, const OS_TimeMs timeout)
 void OS_TaskSuspend(const OS_TaskHd thd)
 {
 const TaskHandle_t task_hd = OS_TaskHandleGet(thd);
+    if (OS_TRUE == OS_TaskIsLight(OS_TaskConfigGet(thd))) { return; } //Do not suspend the executor.
     vTaskSuspend(task_hd);
 }
 
@@ -314,6 +616,7 @@ const TaskHandle_t task_hd = OS_TaskHandleGet(thd);
 void OS_TaskResume(const OS_TaskHd thd)
 {
 const TaskHandle_t task_hd = OS_TaskHandleGet(thd);
+    if (OS_TRUE == OS_TaskIsLight(OS_TaskConfigGet(thd))) { return; }
     vTaskResume(task_hd);
 }
 
@@ -364,6 +667,8 @@ ConstStrP OS_TaskNameGet(const OS_TaskHd thd)
 {
 const TaskHandle_t task_hd = OS_TaskHandleGet(thd);
     if (OS_NULL == task_hd) { return ""; }
+    const OS_TaskConfig* cfg_p = OS_TaskConfigGet(thd);
+    if (OS_TRUE == OS_TaskIsLight(cfg_p)) { return cfg_p->name; }
     return pcTaskGetTaskName(task_hd);
 }
 
@@ -618,6 +923,7 @@ Status s = S_OK;
 Status OS_TaskPrioritySet(const OS_TaskHd thd, const OS_TaskPrio prio)
 {
 const TaskHandle_t task_hd = OS_TaskHandleGet(thd);
+    if (OS_TRUE == OS_TaskIsLight(OS_TaskConfigGet(thd))) { return S_UNSUPPORTED; }
     vTaskPrioritySet(task_hd, prio);
     return S_OK;
 }
@@ -91,7 +91,9 @@ Status s;
 void OS_TaskMain(OS_TaskArgs* args_p)
 {
     sv_stdin_qhd = OS_TaskStdInGet(OS_THIS_TASK);
+    HAL_BOOT_CHECKPOINT("os_sv_run");
     OS_ASSERT(S_OK == OS_StartupApplication());
+    HAL_BOOT_CHECKPOINT("os_startup");
     OS_ASSERT(S_OK == OS_StartupDeInit());
 #if (HAL_TIMER_IWDG_ENABLED)
     OS_ASSERT(S_OK == TIMER_IWDG_Start());
@@ -17,6 +17,7 @@
 #include "os_time.h"
 #include "os_file_system.h"
 #include "os_environment.h"
+#include "os_settings.h"
 #include "os_startup.h"
 
 //-----------------------------------------------------------------------------
@@ -64,58 +65,78 @@ Status s;
     is_idle = OS_FALSE;
     // uxCriticalNesting = 0; !!! Variables are created before OS Engine scheduler is started! Affects on drivers interrupts!
     IF_STATUS(s = OS_MemoryInit())      { return s; }
+    HAL_BOOT_CHECKPOINT("os_mem");
 #if (OS_TIMERS_ENABLED)
     IF_STATUS(s = OS_TimerInit())       { return s; }
+    HAL_BOOT_CHECKPOINT("os_timers");
 #endif //(OS_TIMERS_ENABLED)
     IF_STATUS(s = OS_TimeInit())        { return s; }
+    HAL_BOOT_CHECKPOINT("os_time");
     IF_STATUS(s = OS_DriverInit_())     { return s; }
+    HAL_BOOT_CHECKPOINT("os_drivers");
     IF_STATUS(s = OS_DebugInit())       { return s; }
     IF_STATUS(s = OS_QueueInit())       { return s; }
+    HAL_BOOT_CHECKPOINT("os_queues");
     IF_STATUS(s = OS_TaskInit_())       { return s; }
+    HAL_BOOT_CHECKPOINT("os_tasks");
     IF_STATUS(s = OS_ShellInit())       { return s; }
     IF_STATUS(s = OS_EnvInit())         { return s; }
+    HAL_BOOT_CHECKPOINT("os_env");
 #if (OS_EVENTS_ENABLED)
     IF_STATUS(s = OS_EventInit())       { return s; }
 #endif //(OS_EVENTS_ENABLED)
     IF_STATUS(s = OS_SettingsInit())    { return s; }
+    HAL_BOOT_CHECKPOINT("os_settings");
     IF_STATUS(s = OS_PowerInit())       { return s; }
+    HAL_BOOT_CHECKPOINT("os_power");
     IF_STATUS(s = OSAL_DriversCreate()) { return s; }
+    HAL_BOOT_CHECKPOINT("os_drv_crt");
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    // The backup SRAM is enabled by the RTC driver.
+    IF_STATUS(OS_SettingsSnapshotLoad()) { HAL_LOG(D_INFO, "Settings snapshot is missing"); }
+    HAL_BOOT_CHECKPOINT("os_snapshot");
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
     HAL_CRITICAL_SECTION_EXIT();
     HAL_LOG(D_INFO, "OSAL init...");
     HAL_LOG(D_INFO, "-------------------------------");
 #if (OS_FILE_SYSTEM_ENABLED)
     IF_STATUS(s = OS_FileSystemInit())  { return s; }
+    HAL_BOOT_CHECKPOINT("os_fs");
 #endif // OS_FILE_SYSTEM_ENABLED
 #if (OS_AUDIO_ENABLED)
     IF_STATUS(s = OS_AudioInit())       { return s; }
+    HAL_BOOT_CHECKPOINT("os_audio");
 #endif //(OS_AUDIO_ENABLED)
 #if (OS_NETWORK_ENABLED)
     IF_STATUS(s = OS_NetworkInit())     { return s; }
+    HAL_BOOT_CHECKPOINT("os_net");
 #endif //(OS_NETWORK_ENABLED)
     //Create environment variables.
-    IF_STATUS(s = OS_EnvVariableSet("locale", HAL_LOCALE_DEFAULT, OS_LocaleSet))            { return s; }
+    IF_STATUS(s = OS_EnvVariableDefaultSet("locale", HAL_LOCALE_DEFAULT, OS_LocaleSet))        { return s; }
 //    IF_STATUS(s = OS_EnvVariableSet("stdio", "USART6", OS_StdIoSet))                    { return s; }
-    IF_STATUS(s = OS_EnvVariableSet("log_level", OS_LOG_LEVEL_DEFAULT, OS_LogLevelSet)) { return s; }
-    IF_STATUS(s = OS_EnvVariableSet("log_file", OS_LOG_FILE_PATH, OS_NULL))             { return s; }
-    IF_STATUS(s = OS_EnvVariableSet("config_file", OS_SETTINGS_FILE_PATH, OS_NULL))     { return s; }
+    IF_STATUS(s = OS_EnvVariableDefaultSet("log_level", OS_LOG_LEVEL_DEFAULT, OS_LogLevelSet)) { return s; }
+    IF_STATUS(s = OS_EnvVariableDefaultSet("log_file", OS_LOG_FILE_PATH, OS_NULL))             { return s; }
+    IF_STATUS(s = OS_EnvVariableDefaultSet("config_file", OS_SETTINGS_FILE_PATH, OS_NULL))     { return s; }
 #if (OS_FILE_SYSTEM_ENABLED)
-    IF_STATUS(s = OS_EnvVariableSet("media_automount", "on", OS_NULL))                  { return s; }
+    IF_STATUS(s = OS_EnvVariableDefaultSet("media_automount", "on", OS_NULL))                  { return s; }
 #endif // OS_FILE_SYSTEM_ENABLED
 #if (OS_AUDIO_ENABLED)
     Str volume_str[4];
     if (0 > OS_SNPrintF(volume_str, sizeof(volume_str), "%u", OS_AUDIO_OUT_VOLUME_DEFAULT)) {
         return S_INVALID_VALUE;
     }
-    IF_STATUS(s = OS_EnvVariableSet("volume", volume_str, OS_VolumeSet)) {
+    IF_STATUS(s = OS_EnvVariableDefaultSet("volume", volume_str, OS_VolumeSet)) {
         if (S_INVALID_PTR != s) { return s; } //Ignore first attempt. No audio devices are created so far.
     }
 #endif //(OS_AUDIO_ENABLED)
     //Init environment variables.
     const OS_PowerState power = PWR_STARTUP;
     os_env.hal_env_p->power = power;
+    HAL_BOOT_CHECKPOINT("os_env_vars");
     //Create and start system tasks.
     IF_STATUS(s = OS_StartupInit())     { return s; }
     IF_STATUS(s = OS_StartupSystem())   { return s; }
+    HAL_BOOT_CHECKPOINT("os_sys");
     HAL_LOG(D_INFO, "-------------------------------");
     return s;
 }
@@ -13,9 +13,9 @@
 #include "os_settings.h"
 
 //#define INI_READONLY
-#if (!OS_SETTINGS_BROWSE_ENABLED)
+#if (!OS_SETTINGS_BROWSE_ENABLED) && (!OS_SETTINGS_CACHE_ENABLED)
 #define INI_NOBROWSE
-#endif //(OS_SETTINGS_BROWSE_ENABLED)
+#endif //(!OS_SETTINGS_BROWSE_ENABLED) && (!OS_SETTINGS_CACHE_ENABLED)
 #define INI_ANSIONLY                                                /* ignore UNICODE or _UNICODE macros, compile as ASCII/ANSI */
 #define PORTABLE_STRNICMP
 #define INI_BUFFERSIZE                  OS_SETTINGS_BUFFER_LEN      /* maximum line length, maximum path length */
@@ -28,20 +28,57 @@
 #define ini_atof(string) (INI_REAL)strtod((string),NULL)
 #endif // CM4F
 
-#define INI_FILETYPE                    OS_FileHd
-#define ini_openread(filename,file)     (OS_FileOpen((file), (ConstStrP)(filename),\
-                                         (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) == S_OK)
-#define ini_openwrite(filename,file)    (OS_FileOpen((file), (ConstStrP)(filename),\
-                                         (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_OPEN_NEW) |\
-                                          BIT(OS_FS_FILE_OP_MODE_WRITE))) == S_OK)
-#define ini_close(file)                 (OS_FileClose(file) == S_OK)
-#define ini_read(buffer,size,file)      (OS_FileGetS(*(file), (StrP)(buffer), (size)) == S_OK)
-#define ini_write(buffer,file)          (OS_FilePutS(*(file), (StrP)(buffer)) == S_OK)
+/* The read files are parsed by the buffered line reader (not byte-wise f_gets) */
+typedef struct {
+  OS_FileHd           fhd;
+  OS_FileLineReaderHd lrhd;                                         /* read mode only */
+} IniFile;
+
+#define INI_FILETYPE                    IniFile
+#define ini_read(buffer,size,file)      (OS_FileLineGetS((file)->lrhd, (StrP)(buffer), (size)) == S_OK)
+#define ini_write(buffer,file)          (OS_FilePutS((file)->fhd, (StrP)(buffer)) == S_OK)
 #define ini_remove(filename)            (OS_FileDelete(filename) == S_OK)
 
 #define INI_FILEPOS                     UInt
-#define ini_tell(file,pos)              (*(pos) = OS_FileTell(*(file)))
-#define ini_seek(file,pos)              (OS_FileLSeek(*(file), *(pos)) == S_OK)
+#define ini_tell(file,pos)              (*(pos) = (OS_NULL != (file)->lrhd) ? OS_FileLineReaderTell((file)->lrhd) : OS_FileTell((file)->fhd))
+#define ini_seek(file,pos)              (((OS_NULL != (file)->lrhd) ? OS_FileLineReaderSeek((file)->lrhd, *(pos)) :\
+                                                                      OS_FileLSeek((file)->fhd, *(pos))) == S_OK)
+
+static int ini_openread(const TCHAR *filename, INI_FILETYPE *file)
+{
+  file->lrhd = OS_NULL;
+  if (OS_FileOpen(&file->fhd, (ConstStrP)filename,
+                  (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) != S_OK) {
+    OS_Free(file->fhd);
+    return 0;
+  }
+  if (OS_FileLineReaderCreate(file->fhd, INI_BUFFERSIZE * 2, &file->lrhd) != S_OK) {
+    OS_FileClose(&file->fhd);
+    return 0;
+  }
+  return 1;
+}
+
+static int ini_openwrite(const TCHAR *filename, INI_FILETYPE *file)
+{
+  file->lrhd = OS_NULL;
+  if (OS_FileOpen(&file->fhd, (ConstStrP)filename,
+                  (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_OPEN_NEW) |
+                                    BIT(OS_FS_FILE_OP_MODE_WRITE))) != S_OK) {
+    OS_Free(file->fhd);
+    return 0;
+  }
+  return 1;
+}
+
+static int ini_close(INI_FILETYPE *file)
+{
+  if (OS_NULL != file->lrhd) {
+    OS_FileLineReaderDelete(file->lrhd);
+    file->lrhd = OS_NULL;
+  }
+  return (OS_FileClose(&file->fhd) == S_OK);
+}
 
 static int ini_rename(TCHAR *source, const TCHAR *dest)
 {
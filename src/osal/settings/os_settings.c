@@ -4,7 +4,15 @@
 * @author  A. Filyanov
 *******************************************************************************/
 #include "minIni.h"
+#include "hal.h"
 #include "os_debug.h"
+#include "os_memory.h"
+#include "os_mutex.h"
+#include "os_time.h"
+#include "os_timer.h"
+#include "os_task.h"
+#include "os_task_fs.h"
+#include "os_environment.h"
 #include "os_settings.h"
 
 //------------------------------------------------------------------------------
@@ -20,11 +28,124 @@ const StatusItem status_sett_tab[] = {
     {"Sett item write fail"},
 };
 
+#if (OS_SETTINGS_CACHE_ENABLED)
+//------------------------------------------------------------------------------
+enum {
+    SETT_ITEM_DIRTY,
+    SETT_ITEM_DELETED,
+    SETT_ITEM_EMITTED,
+};
+
+// Parsed key (or the section delete mark if the key is empty).
+typedef struct SettItem {
+    struct SettItem*    next_p;     // Hash chain.
+    struct SettItem*    order_p;    // File order.
+    StrP                value_p;
+    U32                 hash;
+    U8                  flags;
+    Str                 names[1];   // Section and key.
+} SettItem;
+
+typedef struct {
+    StrP                path_p;
+    SettItem*           bucket_v[OS_SETTINGS_CACHE_BUCKETS];
+    SettItem*           first_p;
+    SettItem*           last_p;
+    OS_Tick             tick;       // Last access.
+    Bool                is_dirty;
+    Bool                is_parsed;  // The file is read (no file or media - parsed again on the next access).
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    Bool                is_stamped; // The file stamp is valid.
+    Bool                is_stamp_pending; // Loaded from the snapshot before the media mount.
+    U32                 file_size;  // File stamp.
+    U32                 file_time;
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+} SettFile;
+
+typedef struct {
+    SettFile*           file_p;
+    Status              s;
+} SettBrowseArgs;
+
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+#define SETT_SNAP_MAGIC     0x50414E53UL    // "SNAP"
+
+enum {
+    SETT_SNAP_REC_ENV   = 'E',  // Name, value.
+    SETT_SNAP_REC_SETT  = 'S',  // Section, key, value.
+};
+
+enum {
+    SETT_SNAP_FILE,             // The settings file records are valid.
+};
+
+// Snapshot header (followed by the records: the type and the strings).
+typedef struct {
+    U32                 crc;        // The rest of the header and the records.
+    U32                 magic;
+    U16                 version;
+    U16                 flags;
+    U32                 size;       // Records size (4 bytes aligned).
+    U32                 file_size;  // Settings file stamp.
+    U32                 file_time;
+    U32                 build_id;   // Firmware build (the new defaults aren't overridden by the old values).
+} SettSnapHeader;
+
+typedef struct {
+    U8*                 rec_p;
+    const U8*           end_p;
+} SettSnapWriter;
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+
+//------------------------------------------------------------------------------
+static SettFile     sett_files_v[OS_SETTINGS_CACHE_FILES_MAX];
+static OS_MutexHd   sett_mutex;
+static OS_TimerHd   sett_flush_timer_hd;
+
+//------------------------------------------------------------------------------
+static U32          SettHash(ConstStrP section_p, ConstStrP key_p);
+static Bool         SettStrIsEqual(ConstStrP str1_p, ConstStrP str2_p, Size len);
+static SettItem*    SettItemFind(const SettFile* file_p, ConstStrP section_p, ConstStrP key_p);
+static SettItem*    SettItemAdd(SettFile* file_p, ConstStrP section_p, ConstStrP key_p, ConstStrP value_p);
+static Status       SettItemValueSet(SettItem* item_p, ConstStrP value_p);
+static int          SettBrowseCallback(const char* section_p, const char* key_p, const char* value_p, const void* args_p);
+static void         SettFileFree(SettFile* file_p);
+static void         SettFileItemsDrop(SettFile* file_p);
+static Status       SettFileParse(SettFile* file_p, const Bool is_create);
+static Status       SettFileGet(ConstStrP file_path_p, const Bool is_create, SettFile** file_pp);
+static Status       SettFileFlush(SettFile* file_p);
+static void         SettFileRecover(ConstStrP file_path_p);
+static U8           SettFileVolumeGet(ConstStrP file_path_p);
+static Status       SettFileItemsPut(const OS_FileHd fhd, SettFile* file_p, ConstStrP section_p);
+static void         SettFlushSchedule(void);
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+static Bool         SettSnapIsFile(ConstStrP file_path_p);
+static Status       SettSnapValidate(const SettSnapHeader* hdr_p);
+static Size         SettSnapRecordGet(const U8* rec_p, const U8* end_p, U8* type_p, ConstStrP str_v[]);
+static Status       SettSnapRecordPut(SettSnapWriter* writer_p, const U8 type, ConstStrP str_v[]);
+static Status       SettSnapEnvCallback(ConstStrP name_p, ConstStrP value_p, void* args_p);
+static Status       SettSnapFileStampGet(ConstStrP file_path_p, U32* size_p, U32* time_p);
+static Bool         SettSnapFileLoad(SettFile* file_p, const Status s_stamp, const U32 file_size, const U32 file_time);
+static Status       SettSnapFileCheck(SettFile* file_p);
+static Status       SettSnapWrite(void);
+
+//------------------------------------------------------------------------------
+static U8*          sett_snap_p;    // Loaded snapshot (the environment strings are mapped).
+static Bool         sett_snap_is_loaded;
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+#endif //(OS_SETTINGS_CACHE_ENABLED)
+
 /******************************************************************************/
 Status OS_SettingsInit(void)
 {
 Status s = S_OK;
     //D_LOG(D_INFO, "Init: ");
+#if (OS_SETTINGS_CACHE_ENABLED)
+    OS_MemSet(sett_files_v, 0, sizeof(sett_files_v));
+    sett_flush_timer_hd = OS_NULL;
+    sett_mutex = OS_MutexCreate();
+    if (OS_NULL == sett_mutex) { s = S_OUT_OF_MEMORY; }
+#endif //(OS_SETTINGS_CACHE_ENABLED)
     //D_TRACE_S(D_INFO, s);
     return s;
 }
@@ -34,6 +155,19 @@ Status OS_SettingsDeInit(void)
 {
 Status s = S_OK;
     //D_LOG(D_INFO, "DeInit: ");
+#if (OS_SETTINGS_CACHE_ENABLED)
+    s = OS_SettingsFlush(OS_NULL);
+    IF_OK(OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+            SettFileFree(&sett_files_v[i]);
+        }
+        OS_MutexUnlock(sett_mutex);
+    }
+    if (OS_NULL != sett_flush_timer_hd) {
+        OS_TimerDelete(sett_flush_timer_hd, OS_TIMEOUT_DEFAULT);
+        sett_flush_timer_hd = OS_NULL;
+    }
+#endif //(OS_SETTINGS_CACHE_ENABLED)
     //D_TRACE_S(D_INFO, s);
     return s;
 }
@@ -49,11 +183,34 @@ Status OS_SettingsDelete(ConstStrP file_path_p, ConstStrP section_p, ConstStrP k
 Status OS_SettingsRead(ConstStrP file_path_p, ConstStrP section_p, ConstStrP key_p, StrP value_p)
 {
 Status s = S_OK;
+#if (OS_SETTINGS_CACHE_ENABLED)
+    if ((OS_NULL == file_path_p) || (OS_NULL == section_p) || (OS_NULL == key_p) || (OS_NULL == value_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        SettFile* file_p;
+        IF_OK(s = SettFileGet(file_path_p, OS_FALSE, &file_p)) {
+            const SettItem* item_p = SettItemFind(file_p, section_p, key_p);
+            // Missing or empty value - the default (as ini_gets() does).
+            if ((OS_NULL == item_p) || BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED)) || ('\0' == *item_p->value_p)) {
+                s = S_SETT_READ;
+            } else {
+                OS_StrNCpy((char*)value_p, (const char*)item_p->value_p, OS_SETTINGS_VALUE_LEN - 1);
+                value_p[OS_SETTINGS_VALUE_LEN - 1] = '\0'; //EOL
+            }
+        }
+        OS_MutexUnlock(sett_mutex);
+    }
+    IF_STATUS(s) {
+        OS_StrCpy((char*)value_p, OS_SETTINGS_VALUE_DEFAULT);
+        s = S_SETT_READ;
+        OS_LOG_S(D_WARNING, s);
+    }
+#else
     if (!ini_gets((char const*)section_p, (char const*)key_p,
                   OS_SETTINGS_VALUE_DEFAULT, (char*)value_p, OS_SETTINGS_VALUE_LEN, (const char*)file_path_p)) {
         s = S_SETT_READ;
         OS_LOG_S(D_WARNING, s);
     }
+#endif //(OS_SETTINGS_CACHE_ENABLED)
     OS_LOG(D_DEBUG, "Sett read: %s,\nsect: %s, key: %s, val: %s", file_path_p, section_p, key_p, value_p);
     return s;
 }
@@ -63,10 +220,53 @@ Status OS_SettingsWrite(ConstStrP file_path_p, ConstStrP section_p, ConstStrP ke
 {
 Status s = S_OK;
     OS_LOG(D_DEBUG, "Sett write: %s,\nsect: %s, key: %s, val: %s", file_path_p, section_p, key_p, value_p);
+#if (OS_SETTINGS_CACHE_ENABLED)
+    if ((OS_NULL == file_path_p) || (OS_NULL == section_p)) { return S_INVALID_PTR; }
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        SettFile* file_p;
+        IF_OK(s = SettFileGet(file_path_p, OS_TRUE, &file_p)) {
+            // The key == OS_NULL deletes the section, the value == OS_NULL deletes the key.
+            ConstStrP item_key_p = (OS_NULL != key_p) ? key_p : (ConstStrP)"";
+            if (OS_NULL == key_p) {
+                for (SettItem* item_p = file_p->first_p; OS_NULL != item_p; item_p = item_p->order_p) {
+                    if (SettStrIsEqual(item_p->names, section_p, OS_StrLen((const char*)section_p) + 1)) {
+                        BIT_SET(item_p->flags, BIT(SETT_ITEM_DELETED) | BIT(SETT_ITEM_DIRTY));
+                    }
+                }
+            }
+            SettItem* item_p = SettItemFind(file_p, section_p, item_key_p);
+            if (OS_NULL == item_p) {
+                if ((OS_NULL != key_p) && (OS_NULL == value_p)) {
+                    // Nothing to delete.
+                } else {
+                    item_p = SettItemAdd(file_p, section_p, item_key_p, (OS_NULL != value_p) ? value_p : (ConstStrP)"");
+                    if (OS_NULL == item_p) { s = S_OUT_OF_MEMORY; }
+                }
+            }
+            if ((S_OK == s) && (OS_NULL != item_p)) {
+                if ((OS_NULL == key_p) || (OS_NULL == value_p)) {
+                    BIT_SET(item_p->flags, BIT(SETT_ITEM_DELETED));
+                } else {
+                    BIT_CLEAR(item_p->flags, BIT(SETT_ITEM_DELETED));
+                    s = SettItemValueSet(item_p, value_p);
+                }
+                BIT_SET(item_p->flags, BIT(SETT_ITEM_DIRTY));
+                file_p->is_dirty = OS_TRUE;
+            }
+        }
+        IF_OK(s) { SettFlushSchedule(); }
+        OS_MutexUnlock(sett_mutex);
+    }
+    IF_STATUS(s) {
+        s = S_SETT_WRITE;
+        OS_LOG_S(D_WARNING, s);
+    }
+#else
     if (!ini_puts((char const*)section_p, (char const*)key_p, (char*)value_p, (const char*)file_path_p)) {
         s = S_SETT_WRITE;
         OS_LOG_S(D_WARNING, s);
     }
+#endif //(OS_SETTINGS_CACHE_ENABLED)
     return s;
 }
 
@@ -94,6 +294,844 @@ Status s;
     return s;
 }
 
+#if (OS_SETTINGS_CACHE_ENABLED)
+/******************************************************************************/
+Status OS_SettingsFlush(ConstStrP file_path_p)
+{
+Status s;
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+            SettFile* file_p = &sett_files_v[i];
+            if (OS_NULL == file_p->path_p) { continue; }
+            if ((OS_NULL != file_path_p) &&
+                (OS_TRUE != SettStrIsEqual(file_p->path_p, file_path_p, OS_StrLen((const char*)file_path_p) + 1))) { continue; }
+            const Status s_flush = SettFileFlush(file_p);
+            IF_STATUS(s_flush) { s = s_flush; }
+        }
+        OS_MutexUnlock(sett_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SettingsCacheInvalidate(ConstStrP file_path_p)
+{
+Status s;
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+            SettFile* file_p = &sett_files_v[i];
+            if (OS_NULL == file_p->path_p) { continue; }
+            if ((OS_NULL != file_path_p) &&
+                (OS_TRUE != SettStrIsEqual(file_p->path_p, file_path_p, OS_StrLen((const char*)file_path_p) + 1))) { continue; }
+            if (OS_TRUE == file_p->is_dirty) {
+                OS_LOG(D_WARNING, "Sett changes dropped: %s", file_p->path_p);
+            }
+            SettFileFree(file_p);
+        }
+        OS_MutexUnlock(sett_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SettingsCacheVolumeRelease(const U8 volume)
+{
+Status s;
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+            SettFile* file_p = &sett_files_v[i];
+            if (OS_NULL == file_p->path_p) { continue; }
+            if (volume != SettFileVolumeGet(file_p->path_p)) { continue; }
+            // The media could be removed already - the changes are dropped then.
+            const Status s_flush = SettFileFlush(file_p);
+            IF_STATUS(s_flush) {
+                OS_LOG(D_WARNING, "Sett changes dropped: %s", file_p->path_p);
+                s = s_flush;
+            }
+            SettFileFree(file_p);
+        }
+        OS_MutexUnlock(sett_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+U32 SettHash(ConstStrP section_p, ConstStrP key_p)
+{
+U32 hash = 2166136261U;
+Str c;
+    // INI names are case insensitive (FNV-1a).
+    do {
+        c = *section_p++;
+        if (('a' <= c) && ('z' >= c)) { c -= ('a' - 'A'); }
+        hash = (hash ^ (U8)c) * 16777619U;
+    } while ('\0' != c);
+    while ('\0' != (c = *key_p++)) {
+        if (('a' <= c) && ('z' >= c)) { c -= ('a' - 'A'); }
+        hash = (hash ^ (U8)c) * 16777619U;
+    }
+    return hash;
+}
+
+/******************************************************************************/
+Bool SettStrIsEqual(ConstStrP str1_p, ConstStrP str2_p, Size len)
+{
+    while (len--) {
+        Str c1 = *str1_p++;
+        Str c2 = *str2_p++;
+        if (('a' <= c1) && ('z' >= c1)) { c1 -= ('a' - 'A'); }
+        if (('a' <= c2) && ('z' >= c2)) { c2 -= ('a' - 'A'); }
+        if (c1 != c2) { return OS_FALSE; }
+        if ('\0' == c1) { break; }
+    }
+    return OS_TRUE;
+}
+
+/******************************************************************************/
+SettItem* SettItemFind(const SettFile* file_p, ConstStrP section_p, ConstStrP key_p)
+{
+const U32 hash = SettHash(section_p, key_p);
+const Size section_len = OS_StrLen((const char*)section_p) + 1;
+SettItem* item_p = file_p->bucket_v[hash & (OS_SETTINGS_CACHE_BUCKETS - 1)];
+    while (OS_NULL != item_p) {
+        if ((hash == item_p->hash) &&
+            (OS_TRUE == SettStrIsEqual(item_p->names, section_p, section_len)) &&
+            (OS_TRUE == SettStrIsEqual(&item_p->names[section_len], key_p, OS_StrLen((const char*)key_p) + 1))) {
+            break;
+        }
+        item_p = item_p->next_p;
+    }
+    return item_p;
+}
+
+/******************************************************************************/
+SettItem* SettItemAdd(SettFile* file_p, ConstStrP section_p, ConstStrP key_p, ConstStrP value_p)
+{
+const Size section_len = OS_StrLen((const char*)section_p) + 1;
+const Size key_len = OS_StrLen((const char*)key_p) + 1;
+SettItem* item_p = (SettItem*)OS_Malloc(sizeof(SettItem) + section_len + key_len);
+    if (OS_NULL == item_p) { return OS_NULL; }
+    item_p->value_p = OS_NULL;
+    IF_STATUS(SettItemValueSet(item_p, value_p)) {
+        OS_Free(item_p);
+        return OS_NULL;
+    }
+    OS_MemCpy(&item_p->names[0], section_p, section_len);
+    OS_MemCpy(&item_p->names[section_len], key_p, key_len);
+    item_p->hash    = SettHash(section_p, key_p);
+    item_p->flags   = 0;
+    item_p->order_p = OS_NULL;
+    SettItem** bucket_pp = &file_p->bucket_v[item_p->hash & (OS_SETTINGS_CACHE_BUCKETS - 1)];
+    item_p->next_p  = *bucket_pp;
+    *bucket_pp      = item_p;
+    if (OS_NULL == file_p->last_p) {
+        file_p->first_p = item_p;
+    } else {
+        file_p->last_p->order_p = item_p;
+    }
+    file_p->last_p = item_p;
+    return item_p;
+}
+
+/******************************************************************************/
+Status SettItemValueSet(SettItem* item_p, ConstStrP value_p)
+{
+const Size len = OS_StrLen((const char*)value_p) + 1;
+    if ((OS_NULL == item_p->value_p) || (OS_StrLen((const char*)item_p->value_p) + 1 < len)) {
+        const StrP new_value_p = (StrP)OS_Malloc(len);
+        if (OS_NULL == new_value_p) { return S_OUT_OF_MEMORY; }
+        OS_Free(item_p->value_p);
+        item_p->value_p = new_value_p;
+    }
+    OS_MemCpy(item_p->value_p, value_p, len);
+    return S_OK;
+}
+
+/******************************************************************************/
+int SettBrowseCallback(const char* section_p, const char* key_p, const char* value_p, const void* args_p)
+{
+SettBrowseArgs* browse_args_p = (SettBrowseArgs*)args_p;
+    // The first key wins (as ini_gets() does).
+    if (OS_NULL != SettItemFind(browse_args_p->file_p, (ConstStrP)section_p, (ConstStrP)key_p)) { return 1; }
+    // The section is deleted, but not flushed yet (the re-parse).
+    const SettItem* mark_p = SettItemFind(browse_args_p->file_p, (ConstStrP)section_p, "");
+    if ((OS_NULL != mark_p) && BIT_TEST(mark_p->flags, BIT(SETT_ITEM_DELETED))) { return 1; }
+    if (OS_NULL == SettItemAdd(browse_args_p->file_p, (ConstStrP)section_p, (ConstStrP)key_p, (ConstStrP)value_p)) {
+        browse_args_p->s = S_OUT_OF_MEMORY;
+        return 0;
+    }
+    return 1;
+}
+
+/******************************************************************************/
+void SettFileFree(SettFile* file_p)
+{
+SettItem* item_p = file_p->first_p;
+    while (OS_NULL != item_p) {
+        SettItem* order_p = item_p->order_p;
+        OS_Free(item_p->value_p);
+        OS_Free(item_p);
+        item_p = order_p;
+    }
+    OS_Free(file_p->path_p);
+    OS_MemSet(file_p, 0, sizeof(SettFile));
+}
+
+/******************************************************************************/
+// The parsed items are dropped for the re-parse, the changed ones are kept.
+void SettFileItemsDrop(SettFile* file_p)
+{
+SettItem* item_p = file_p->first_p;
+    OS_MemSet(file_p->bucket_v, 0, sizeof(file_p->bucket_v));
+    file_p->first_p = OS_NULL;
+    file_p->last_p  = OS_NULL;
+    while (OS_NULL != item_p) {
+        SettItem* order_p = item_p->order_p;
+        if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DIRTY))) {
+            SettItem** bucket_pp = &file_p->bucket_v[item_p->hash & (OS_SETTINGS_CACHE_BUCKETS - 1)];
+            item_p->next_p  = *bucket_pp;
+            *bucket_pp      = item_p;
+            item_p->order_p = OS_NULL;
+            if (OS_NULL == file_p->last_p) {
+                file_p->first_p = item_p;
+            } else {
+                file_p->last_p->order_p = item_p;
+            }
+            file_p->last_p = item_p;
+        } else {
+            OS_Free(item_p->value_p);
+            OS_Free(item_p);
+        }
+        item_p = order_p;
+    }
+}
+
+/******************************************************************************/
+Status SettFileParse(SettFile* file_p, const Bool is_create)
+{
+SettBrowseArgs browse_args = { .file_p = file_p, .s = S_OK };
+    file_p->is_parsed = OS_TRUE;
+    if (!ini_browse(SettBrowseCallback, &browse_args, (const char*)file_p->path_p)) {
+        // No file (or no media yet) - the write creates it by the flush.
+        file_p->is_parsed = OS_FALSE;
+        if (OS_TRUE != is_create) { browse_args.s = S_SETT_READ; }
+    }
+    return browse_args.s;
+}
+
+/******************************************************************************/
+Status SettFileGet(ConstStrP file_path_p, const Bool is_create, SettFile** file_pp)
+{
+const Size path_len = OS_StrLen((const char*)file_path_p) + 1;
+SettFile* file_p = OS_NULL;
+Status s = S_OK;
+    for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+        SettFile* it_p = &sett_files_v[i];
+        if (OS_NULL == it_p->path_p) {
+            if (OS_NULL == file_p) { file_p = it_p; }
+        } else if (OS_TRUE == SettStrIsEqual(it_p->path_p, file_path_p, path_len)) {
+            it_p->tick = OS_TickCountGet();
+            if (OS_TRUE != it_p->is_parsed) {
+                // The file (or the media) was missing by the previous parse.
+                SettFileItemsDrop(it_p);
+                IF_STATUS(s = SettFileParse(it_p, OS_TRUE)) { return s; }
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+                if (OS_TRUE == it_p->is_parsed) {
+                    it_p->is_stamped = (S_OK == SettSnapFileStampGet(it_p->path_p, &it_p->file_size, &it_p->file_time)) ?
+                                       OS_TRUE : OS_FALSE;
+                    if (OS_TRUE == SettSnapIsFile(it_p->path_p)) {
+                        Status s_snap;
+                        IF_STATUS(s_snap = SettSnapWrite()) { OS_LOG_S(D_WARNING, s_snap); }
+                    }
+                }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+            }
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+            IF_STATUS(s = SettSnapFileCheck(it_p)) { return s; }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+            *file_pp = it_p;
+            return S_OK;
+        }
+    }
+    if (OS_NULL == file_p) {
+        // Evict the least recently used file.
+        file_p = &sett_files_v[0];
+        for (Size i = 1; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+            if ((OS_TickCountGet() - file_p->tick) < (OS_TickCountGet() - sett_files_v[i].tick)) {
+                file_p = &sett_files_v[i];
+            }
+        }
+        IF_STATUS(s = SettFileFlush(file_p)) { return s; }
+        SettFileFree(file_p);
+    }
+    file_p->path_p = (StrP)OS_Malloc(path_len);
+    if (OS_NULL == file_p->path_p) { return S_OUT_OF_MEMORY; }
+    OS_MemCpy(file_p->path_p, file_path_p, path_len);
+    file_p->tick = OS_TickCountGet();
+    SettFileRecover(file_path_p);
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    U32 file_size, file_time;
+    const Status s_stamp = SettSnapFileStampGet(file_path_p, &file_size, &file_time);
+    const Bool is_snap_file = SettSnapIsFile(file_path_p);
+    if ((OS_TRUE == is_snap_file) && (OS_TRUE == SettSnapFileLoad(file_p, s_stamp, file_size, file_time))) {
+        HAL_BOOT_CHECKPOINT("sett_snap");
+        *file_pp = file_p;
+        return s;
+    }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+    // Parse the whole file once.
+    IF_STATUS(s = SettFileParse(file_p, is_create)) {
+        SettFileFree(file_p);
+        return s;
+    }
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    IF_OK(s_stamp) {
+        file_p->is_stamped  = OS_TRUE;
+        file_p->file_size   = file_size;
+        file_p->file_time   = file_time;
+    }
+    if (OS_TRUE == is_snap_file) {
+        HAL_BOOT_CHECKPOINT("sett_ini");
+        // The snapshot is missing or stale.
+        Status s_snap;
+        IF_STATUS(s_snap = SettSnapWrite()) { OS_LOG_S(D_WARNING, s_snap); }
+    }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+    *file_pp = file_p;
+    return s;
+}
+
+/******************************************************************************/
+Status SettFileItemsPut(const OS_FileHd fhd, SettFile* file_p, ConstStrP section_p)
+{
+const Size section_len = OS_StrLen((const char*)section_p) + 1;
+Status s = S_OK;
+    for (SettItem* item_p = file_p->first_p; OS_NULL != item_p; item_p = item_p->order_p) {
+        if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED) | BIT(SETT_ITEM_EMITTED))) { continue; }
+        if ('\0' == item_p->names[section_len]) { continue; } // Section mark.
+        if (OS_TRUE != SettStrIsEqual(item_p->names, section_p, section_len)) { continue; }
+        IF_STATUS(s = OS_FilePutS(fhd, &item_p->names[section_len])) { break; }
+        IF_STATUS(s = OS_FilePutS(fhd, "="))                          { break; }
+        IF_STATUS(s = OS_FilePutS(fhd, item_p->value_p))              { break; }
+        IF_STATUS(s = OS_FilePutS(fhd, "\n"))                         { break; }
+        BIT_SET(item_p->flags, BIT(SETT_ITEM_EMITTED));
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status SettFileFlush(SettFile* file_p)
+{
+const Size path_len = OS_StrLen((const char*)file_p->path_p) + 1;
+OS_FileHd src_fhd = OS_NULL;
+OS_FileLineReaderHd src_lrhd = OS_NULL;
+OS_FileHd dst_fhd = OS_NULL;
+Bool is_skip = OS_FALSE;
+Bool is_eol = OS_TRUE;
+Status s;
+    if (OS_TRUE != file_p->is_dirty) { return S_OK; }
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    // The stale snapshot items aren't merged into the file.
+    IF_STATUS(s = SettSnapFileCheck(file_p)) { return s; }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+    // Line, section and temp file path buffers.
+    StrP line_p = (StrP)OS_Malloc(OS_SETTINGS_BUFFER_LEN * 2 + path_len + 1);
+    if (OS_NULL == line_p) { return S_OUT_OF_MEMORY; }
+    StrP section_p = line_p + OS_SETTINGS_BUFFER_LEN;
+    StrP tmp_path_p = section_p + OS_SETTINGS_BUFFER_LEN;
+    *section_p = '\0'; //EOL
+    OS_MemCpy(tmp_path_p, file_p->path_p, path_len - 1);
+    tmp_path_p[path_len - 1] = '~';
+    tmp_path_p[path_len] = '\0'; //EOL
+    for (SettItem* item_p = file_p->first_p; OS_NULL != item_p; item_p = item_p->order_p) {
+        BIT_CLEAR(item_p->flags, BIT(SETT_ITEM_EMITTED));
+    }
+    IF_STATUS(s = OS_FileOpen(&dst_fhd, tmp_path_p,
+                              (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE)))) {
+        OS_Free(dst_fhd);
+        dst_fhd = OS_NULL;
+        goto error;
+    }
+    // Merge the changes into the original file (comments and order are kept).
+    IF_STATUS(OS_FileOpen(&src_fhd, file_p->path_p,
+                          (OS_FileOpenMode)(BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ)))) {
+        OS_Free(src_fhd);
+        src_fhd = OS_NULL;
+    } else {
+        IF_STATUS(s = OS_FileLineReaderCreate(src_fhd, 0, &src_lrhd)) { goto error; }
+    }
+    while ((OS_NULL != src_lrhd) && (S_OK == OS_FileLineGetS(src_lrhd, line_p, OS_SETTINGS_BUFFER_LEN))) {
+        StrP p = line_p;
+        while ((' ' == *p) || ('\t' == *p)) { ++p; }
+        if ('[' == *p) {
+            // Section - put the new keys of the previous one.
+            StrP end_p = (StrP)OS_StrChr((const char*)++p, ']');
+            if (OS_NULL != end_p) {
+                if (OS_TRUE != is_eol) { IF_STATUS(s = OS_FilePutS(dst_fhd, "\n")) { goto error; } }
+                if (OS_TRUE != is_skip) { IF_STATUS(s = SettFileItemsPut(dst_fhd, file_p, section_p)) { goto error; } }
+                while ((' ' == *p) || ('\t' == *p)) { ++p; }
+                while ((end_p > p) && ((' ' == *(end_p - 1)) || ('\t' == *(end_p - 1)))) { --end_p; }
+                const Size len = MIN((Size)(end_p - p), OS_SETTINGS_BUFFER_LEN - 1);
+                OS_MemCpy(section_p, p, len);
+                section_p[len] = '\0'; //EOL
+                const SettItem* mark_p = SettItemFind(file_p, section_p, "");
+                is_skip = ((OS_NULL != mark_p) && BIT_TEST(mark_p->flags, BIT(SETT_ITEM_DELETED))) ? OS_TRUE : OS_FALSE;
+            }
+        } else if ((OS_TRUE != is_skip) && (';' != *p) && ('#' != *p)) {
+            // Key - put the changed value or drop the deleted one.
+            StrP end_p = p;
+            while (('\0' != *end_p) && ('=' != *end_p) && (':' != *end_p)) { ++end_p; }
+            if (('\0' != *end_p) && (end_p > p)) {
+                const Str sep = *end_p;
+                while ((end_p > p) && ((' ' == *(end_p - 1)) || ('\t' == *(end_p - 1)))) { --end_p; }
+                const Str c = *end_p;
+                *end_p = '\0'; //EOL
+                SettItem* item_p = SettItemFind(file_p, section_p, p);
+                *end_p = c;
+                if ((OS_NULL != item_p) && !BIT_TEST(item_p->flags, BIT(SETT_ITEM_EMITTED))) {
+                    if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED))) {
+                        BIT_SET(item_p->flags, BIT(SETT_ITEM_EMITTED));
+                        continue;
+                    } else if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DIRTY))) {
+                        *end_p = '\0'; //EOL
+                        if ((S_OK != (s = OS_FilePutS(dst_fhd, line_p))) ||
+                            (S_OK != (s = OS_FilePutS(dst_fhd, ('=' == sep) ? "=" : ":"))) ||
+                            (S_OK != (s = OS_FilePutS(dst_fhd, item_p->value_p))) ||
+                            (S_OK != (s = OS_FilePutS(dst_fhd, "\n")))) { goto error; }
+                        BIT_SET(item_p->flags, BIT(SETT_ITEM_EMITTED));
+                        is_eol = OS_TRUE;
+                        continue;
+                    }
+                    BIT_SET(item_p->flags, BIT(SETT_ITEM_EMITTED));
+                }
+            }
+        }
+        if (OS_TRUE == is_skip) { continue; }
+        IF_STATUS(s = OS_FilePutS(dst_fhd, line_p)) { goto error; }
+        const Size len = OS_StrLen((const char*)line_p);
+        is_eol = ((0 < len) && ('\n' == line_p[len - 1])) ? OS_TRUE : OS_FALSE;
+    }
+    if (OS_TRUE != is_eol) { IF_STATUS(s = OS_FilePutS(dst_fhd, "\n")) { goto error; } }
+    if (OS_TRUE != is_skip) { IF_STATUS(s = SettFileItemsPut(dst_fhd, file_p, section_p)) { goto error; } }
+    // The new sections.
+    for (SettItem* item_p = file_p->first_p; OS_NULL != item_p; item_p = item_p->order_p) {
+        if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED) | BIT(SETT_ITEM_EMITTED))) { continue; }
+        const Size section_len = OS_StrLen((const char*)item_p->names) + 1;
+        if ('\0' == item_p->names[section_len]) { continue; } // Section mark.
+        if ((S_OK != (s = OS_FilePutS(dst_fhd, "\n["))) ||
+            (S_OK != (s = OS_FilePutS(dst_fhd, item_p->names))) ||
+            (S_OK != (s = OS_FilePutS(dst_fhd, "]\n"))) ||
+            (S_OK != (s = SettFileItemsPut(dst_fhd, file_p, item_p->names)))) { goto error; }
+    }
+    // The temp file is complete before the original is deleted (see SettFileRecover()).
+    IF_STATUS(s = OS_FileClose(&dst_fhd)) { goto error; }
+    dst_fhd = OS_NULL;
+    if (OS_NULL != src_fhd) {
+        OS_FileLineReaderDelete(src_lrhd);
+        src_lrhd = OS_NULL;
+        IF_STATUS(s = OS_FileClose(&src_fhd)) { goto error; }
+        src_fhd = OS_NULL;
+        IF_STATUS(s = OS_FileDelete(file_p->path_p)) { goto error; }
+    }
+    {
+        // f_rename() does not allow drive letters in the destination path.
+        ConstStrP dst_path_p = (ConstStrP)OS_StrChr((const char*)file_p->path_p, OS_FILE_SYSTEM_DRV_DELIM);
+        dst_path_p = (OS_NULL == dst_path_p) ? file_p->path_p : dst_path_p + 1;
+        IF_STATUS(s = OS_FileRename(tmp_path_p, dst_path_p)) { goto error; }
+    }
+    // Drop the deleted items.
+    {
+        SettItem** order_pp = &file_p->first_p;
+        file_p->last_p = OS_NULL;
+        while (OS_NULL != *order_pp) {
+            SettItem* item_p = *order_pp;
+            BIT_CLEAR(item_p->flags, BIT(SETT_ITEM_DIRTY));
+            if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED))) {
+                SettItem** next_pp = &file_p->bucket_v[item_p->hash & (OS_SETTINGS_CACHE_BUCKETS - 1)];
+                while (item_p != *next_pp) { next_pp = &(*next_pp)->next_p; }
+                *next_pp  = item_p->next_p;
+                *order_pp = item_p->order_p;
+                OS_Free(item_p->value_p);
+                OS_Free(item_p);
+            } else {
+                file_p->last_p = item_p;
+                order_pp = &item_p->order_p;
+            }
+        }
+    }
+    file_p->is_dirty = OS_FALSE;
+    OS_LOG(D_DEBUG, "Sett flush: %s", file_p->path_p);
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+    file_p->is_stamped = (S_OK == SettSnapFileStampGet(file_p->path_p, &file_p->file_size, &file_p->file_time)) ?
+                         OS_TRUE : OS_FALSE;
+    file_p->is_stamp_pending = OS_FALSE;
+    if (OS_TRUE == SettSnapIsFile(file_p->path_p)) {
+        Status s_snap;
+        IF_STATUS(s_snap = SettSnapWrite()) { OS_LOG_S(D_WARNING, s_snap); }
+    }
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+error:
+    if (OS_NULL != src_lrhd) { OS_FileLineReaderDelete(src_lrhd); }
+    if (OS_NULL != src_fhd) { OS_FileClose(&src_fhd); }
+    if (OS_NULL != dst_fhd) {
+        OS_FileClose(&dst_fhd);
+        OS_FileDelete(tmp_path_p);
+    }
+    OS_Free(line_p);
+    IF_STATUS(s) {
+        s = S_SETT_WRITE;
+        OS_LOG_S(D_WARNING, s);
+    }
+    return s;
+}
+
+/******************************************************************************/
+// The flush could be interrupted between the original file delete and the temp file rename:
+// the temp file without the original one is complete, with the original one - partial.
+void SettFileRecover(ConstStrP file_path_p)
+{
+const Size path_len = OS_StrLen((const char*)file_path_p) + 1;
+OS_FileHd fhd = OS_NULL;
+Bool is_file = OS_FALSE;
+Status s;
+    StrP tmp_path_p = (StrP)OS_Malloc(path_len + 1);
+    if (OS_NULL == tmp_path_p) { return; }
+    OS_MemCpy(tmp_path_p, file_path_p, path_len - 1);
+    tmp_path_p[path_len - 1] = '~';
+    tmp_path_p[path_len] = '\0'; //EOL
+    IF_STATUS(OS_FileOpen(&fhd, tmp_path_p, BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) {
+        OS_Free(fhd);
+        OS_Free(tmp_path_p);
+        return;
+    }
+    OS_FileClose(&fhd);
+    IF_OK(OS_FileOpen(&fhd, file_path_p, BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) {
+        OS_FileClose(&fhd);
+        is_file = OS_TRUE;
+    } else {
+        OS_Free(fhd);
+    }
+    if (OS_TRUE == is_file) {
+        s = OS_FileDelete(tmp_path_p);
+    } else {
+        // f_rename() does not allow drive letters in the destination path.
+        ConstStrP dst_path_p = (ConstStrP)OS_StrChr((const char*)file_path_p, OS_FILE_SYSTEM_DRV_DELIM);
+        dst_path_p = (OS_NULL == dst_path_p) ? file_path_p : dst_path_p + 1;
+        IF_OK(s = OS_FileRename(tmp_path_p, dst_path_p)) {
+            OS_LOG(D_WARNING, "Sett recovered: %s", file_path_p);
+        }
+    }
+    IF_STATUS(s) { OS_LOG_S(D_WARNING, s); }
+    OS_Free(tmp_path_p);
+}
+
+/******************************************************************************/
+U8 SettFileVolumeGet(ConstStrP file_path_p)
+{
+    ConstStrP delim_p = (ConstStrP)OS_StrChr((const char*)file_path_p, OS_FILE_SYSTEM_DRV_DELIM);
+    // The default volume.
+    if (OS_NULL == delim_p) { return 0; }
+    return (U8)(file_path_p[0] - '0');
+}
+
+/******************************************************************************/
+void SettFlushSchedule(void)
+{
+#if (OS_SETTINGS_CACHE_FLUSH_MS)
+Status s;
+    if (OS_NULL == sett_flush_timer_hd) {
+        // The file system daemon does the delayed flush.
+        const OS_TaskHd fsd_thd = OS_TaskByNameGet(OS_DAEMON_NAME_FS);
+        if (OS_NULL == fsd_thd) { return; }
+        static ConstStrP tim_name_p = "SettFlush";
+        const OS_TimerConfig tim_cfg = {
+            .name_p = tim_name_p,
+            .slot   = OS_TaskStdInGet(fsd_thd),
+            .id     = OS_TIM_ID_SETTINGS_FLUSH,
+            .period = OS_SETTINGS_CACHE_FLUSH_MS,
+            .options= OS_TIM_OPT_UNDEF  // One-shot.
+        };
+        IF_STATUS(s = OS_TimerCreate(&tim_cfg, &sett_flush_timer_hd)) {
+            sett_flush_timer_hd = OS_NULL;
+            OS_LOG_S(D_WARNING, s);
+            return;
+        }
+    }
+    // Restart the one-shot timer - the writes burst is flushed at once.
+    IF_STATUS(s = OS_TimerReset(sett_flush_timer_hd, OS_TIMEOUT_DEFAULT)) { OS_LOG_S(D_WARNING, s); }
+#endif //(OS_SETTINGS_CACHE_FLUSH_MS)
+}
+
+#if (OS_SETTINGS_SNAPSHOT_ENABLED)
+/******************************************************************************/
+Status OS_SettingsSnapshotLoad(void)
+{
+const SettSnapHeader* hdr_p = (const SettSnapHeader*)OS_SETTINGS_SNAPSHOT_ADDRESS;
+Status s;
+    sett_snap_is_loaded = OS_TRUE;
+    IF_STATUS(s = SettSnapValidate(hdr_p)) { return s; }
+    // One copy of the whole snapshot - no allocations per variable.
+    const Size size = sizeof(SettSnapHeader) + hdr_p->size;
+    sett_snap_p = (U8*)OS_Malloc(size);
+    if (OS_NULL == sett_snap_p) { return S_OUT_OF_MEMORY; }
+    OS_MemCpy(sett_snap_p, hdr_p, size);
+    const U8* rec_p = sett_snap_p + sizeof(SettSnapHeader);
+    const U8* end_p = sett_snap_p + size;
+    ConstStrP str_v[3];
+    U8 type;
+    Size len;
+    while (0 != (len = SettSnapRecordGet(rec_p, end_p, &type, str_v))) {
+        if (SETT_SNAP_REC_ENV == type) {
+            IF_STATUS(s = OS_EnvVariableMap(str_v[0], str_v[1])) { break; }
+        }
+        rec_p += len;
+    }
+    OS_LOG(D_DEBUG, "Sett snapshot loaded: %u bytes", size);
+    return s;
+}
+
+/******************************************************************************/
+Status OS_SettingsSnapshotWrite(void)
+{
+Status s = S_OK;
+    // Nothing is overwritten until the snapshot is loaded at the boot.
+    if (OS_TRUE != sett_snap_is_loaded) { return s; }
+    IF_OK(s = OS_MutexLock(sett_mutex, OS_TIMEOUT_MUTEX_LOCK)) {
+        s = SettSnapWrite();
+        OS_MutexUnlock(sett_mutex);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Bool SettSnapIsFile(ConstStrP file_path_p)
+{
+    return SettStrIsEqual(file_path_p, OS_SETTINGS_FILE_PATH, OS_StrLen(OS_SETTINGS_FILE_PATH) + 1);
+}
+
+/******************************************************************************/
+Status SettSnapValidate(const SettSnapHeader* hdr_p)
+{
+    if ((SETT_SNAP_MAGIC != hdr_p->magic) || (OS_SETTINGS_SNAPSHOT_VERSION != hdr_p->version)) { return S_INVALID_VALUE; }
+    if (HAL_BuildIdGet() != hdr_p->build_id) { return S_INVALID_VALUE; }
+    if (((OS_SETTINGS_SNAPSHOT_SIZE - sizeof(SettSnapHeader)) < hdr_p->size) || (0 != (hdr_p->size % sizeof(U32)))) {
+        return S_INVALID_SIZE;
+    }
+    if (hdr_p->crc != OS_MemCrc32(&hdr_p->magic, sizeof(SettSnapHeader) - sizeof(hdr_p->crc) + hdr_p->size)) {
+        return S_INVALID_CRC;
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+Size SettSnapRecordGet(const U8* rec_p, const U8* end_p, U8* type_p, ConstStrP str_v[])
+{
+const U8* it_p = rec_p;
+    if (it_p >= end_p) { return 0; }
+    *type_p = *it_p++;
+    const U8 count = (SETT_SNAP_REC_ENV == *type_p) ? 2 : (SETT_SNAP_REC_SETT == *type_p) ? 3 : 0;
+    if (0 == count) { return 0; } // Padding.
+    for (U8 i = 0; i < count; ++i) {
+        const U8* eol_p = (const U8*)OS_MemChr(it_p, '\0', end_p - it_p);
+        if (OS_NULL == eol_p) { return 0; }
+        str_v[i] = (ConstStrP)it_p;
+        it_p = eol_p + 1;
+    }
+    return (Size)(it_p - rec_p);
+}
+
+/******************************************************************************/
+Status SettSnapRecordPut(SettSnapWriter* writer_p, const U8 type, ConstStrP str_v[])
+{
+const U8 count = (SETT_SNAP_REC_ENV == type) ? 2 : 3;
+Size size = 1;
+    for (U8 i = 0; i < count; ++i) {
+        size += OS_StrLen((const char*)str_v[i]) + 1;
+    }
+    if ((Size)(writer_p->end_p - writer_p->rec_p) < size) { return S_OVERFLOW; }
+    *writer_p->rec_p++ = type;
+    for (U8 i = 0; i < count; ++i) {
+        const Size len = OS_StrLen((const char*)str_v[i]) + 1;
+        OS_MemCpy(writer_p->rec_p, str_v[i], len);
+        writer_p->rec_p += len;
+    }
+    return S_OK;
+}
+
+/******************************************************************************/
+Status SettSnapEnvCallback(ConstStrP name_p, ConstStrP value_p, void* args_p)
+{
+ConstStrP str_v[] = { name_p, value_p };
+    return SettSnapRecordPut((SettSnapWriter*)args_p, SETT_SNAP_REC_ENV, str_v);
+}
+
+/******************************************************************************/
+Status SettSnapFileStampGet(ConstStrP file_path_p, U32* size_p, U32* time_p)
+{
+OS_FileStats stats;
+Status s;
+#if OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    stats.long_name_p   = OS_NULL;
+    stats.long_name_size= 0;
+#endif // OS_FILE_SYSTEM_LONG_NAMES_ENABLED
+    IF_OK(s = OS_FileStatsGet(file_path_p, &stats)) {
+        *size_p = stats.size;
+        *time_p = (((U32)(stats.date_time.year - OS_FILE_SYSTEM_YEAR_BASE) & 0x7F) << 25) |
+                  (((U32)stats.date_time.month   & 0x0F) << 21) |
+                  (((U32)stats.date_time.day     & 0x1F) << 16) |
+                  (((U32)stats.date_time.hours   & 0x1F) << 11) |
+                  (((U32)stats.date_time.minutes & 0x3F) << 5)  |
+                  ((U32)stats.date_time.seconds  & 0x1F);
+    }
+    return s;
+}
+
+/******************************************************************************/
+Bool SettSnapFileLoad(SettFile* file_p, const Status s_stamp, const U32 file_size, const U32 file_time)
+{
+const SettSnapHeader* hdr_p = (const SettSnapHeader*)OS_SETTINGS_SNAPSHOT_ADDRESS;
+    if (OS_TRUE != sett_snap_is_loaded) { return OS_FALSE; }
+    IF_STATUS(SettSnapValidate(hdr_p)) { return OS_FALSE; }
+    if (!BIT_TEST(hdr_p->flags, BIT(SETT_SNAP_FILE))) { return OS_FALSE; }
+    // The file is changed or deleted - parse it. No media yet - the snapshot is the last known state.
+    IF_OK(s_stamp) {
+        if ((file_size != hdr_p->file_size) || (file_time != hdr_p->file_time)) { return OS_FALSE; }
+    } else if ((S_FS_FILE_NOT_FOUND == s_stamp) || (S_FS_PATH_NOT_FOUND == s_stamp)) {
+        return OS_FALSE;
+    }
+    const U8* rec_p = (const U8*)(hdr_p + 1);
+    const U8* end_p = rec_p + hdr_p->size;
+    ConstStrP str_v[3];
+    U8 type;
+    Size len;
+    while (0 != (len = SettSnapRecordGet(rec_p, end_p, &type, str_v))) {
+        if (SETT_SNAP_REC_SETT == type) {
+            if (OS_NULL == SettItemAdd(file_p, str_v[0], str_v[1], str_v[2])) {
+                // Out of memory - the path is kept for the parse.
+                const StrP path_p = file_p->path_p;
+                file_p->path_p = OS_NULL;
+                SettFileFree(file_p);
+                file_p->path_p = path_p;
+                file_p->tick = OS_TickCountGet();
+                return OS_FALSE;
+            }
+        }
+        rec_p += len;
+    }
+    // No media yet - the stamp is checked on the first access after the mount.
+    file_p->is_parsed   = OS_TRUE;
+    file_p->is_stamped  = (S_OK == s_stamp) ? OS_TRUE : OS_FALSE;
+    file_p->is_stamp_pending = (S_OK == s_stamp) ? OS_FALSE : OS_TRUE;
+    file_p->file_size   = hdr_p->file_size;
+    file_p->file_time   = hdr_p->file_time;
+    OS_LOG(D_DEBUG, "Sett snapshot used: %s", file_p->path_p);
+    return OS_TRUE;
+}
+
+/******************************************************************************/
+Status SettSnapFileCheck(SettFile* file_p)
+{
+U32 file_size, file_time;
+Status s_stamp;
+Status s;
+    if (OS_TRUE != file_p->is_stamp_pending) { return S_OK; }
+    IF_OK(s_stamp = SettSnapFileStampGet(file_p->path_p, &file_size, &file_time)) {
+        if ((file_size == file_p->file_size) && (file_time == file_p->file_time)) {
+            file_p->is_stamped = OS_TRUE;
+            file_p->is_stamp_pending = OS_FALSE;
+            return S_OK;
+        }
+    } else if ((S_FS_FILE_NOT_FOUND != s_stamp) && (S_FS_PATH_NOT_FOUND != s_stamp)) {
+        return S_OK; // No media yet - the snapshot is still the last known state.
+    }
+    // The file is changed or deleted after the snapshot - parse it.
+    OS_LOG(D_DEBUG, "Sett snapshot stale: %s", file_p->path_p);
+    SettFileItemsDrop(file_p);
+    IF_STATUS(s = SettFileParse(file_p, OS_TRUE)) { return s; }
+    file_p->is_stamped = OS_FALSE;
+    file_p->is_stamp_pending = OS_FALSE;
+    IF_OK(s_stamp) {
+        file_p->is_stamped = OS_TRUE;
+        file_p->file_size = file_size;
+        file_p->file_time = file_time;
+    }
+    if (OS_TRUE == SettSnapIsFile(file_p->path_p)) {
+        Status s_snap;
+        IF_STATUS(s_snap = SettSnapWrite()) { OS_LOG_S(D_WARNING, s_snap); }
+    }
+    return s;
+}
+
+/******************************************************************************/
+Status SettSnapWrite(void)
+{
+SettSnapHeader* hdr_p = (SettSnapHeader*)OS_Malloc(OS_SETTINGS_SNAPSHOT_SIZE);
+SettSnapHeader* snap_hdr_p = (SettSnapHeader*)OS_SETTINGS_SNAPSHOT_ADDRESS;
+SettSnapWriter writer;
+Status s;
+    if (OS_NULL == hdr_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(hdr_p, 0, sizeof(SettSnapHeader));
+    writer.rec_p = (U8*)(hdr_p + 1);
+    writer.end_p = (U8*)hdr_p + OS_SETTINGS_SNAPSHOT_SIZE;
+    IF_STATUS(s = OS_EnvVariablesBrowse(SettSnapEnvCallback, &writer)) { goto error; }
+    // The settings file records: the cached file in sync with the media or the previous snapshot ones.
+    const SettFile* file_p = OS_NULL;
+    for (Size i = 0; i < ITEMS_COUNT_GET(sett_files_v, SettFile); ++i) {
+        if ((OS_NULL != sett_files_v[i].path_p) && (OS_TRUE == SettSnapIsFile(sett_files_v[i].path_p))) {
+            file_p = &sett_files_v[i];
+        }
+    }
+    if ((OS_NULL != file_p) && (OS_TRUE != file_p->is_dirty) && (OS_TRUE == file_p->is_parsed) &&
+        (OS_TRUE == file_p->is_stamped)) {
+        for (const SettItem* item_p = file_p->first_p; OS_NULL != item_p; item_p = item_p->order_p) {
+            const Size section_len = OS_StrLen((const char*)item_p->names) + 1;
+            if (BIT_TEST(item_p->flags, BIT(SETT_ITEM_DELETED))) { continue; }
+            if ('\0' == item_p->names[section_len]) { continue; } // Section mark.
+            ConstStrP str_v[] = { item_p->names, &item_p->names[section_len], item_p->value_p };
+            IF_STATUS(s = SettSnapRecordPut(&writer, SETT_SNAP_REC_SETT, str_v)) { goto error; }
+        }
+        BIT_SET(hdr_p->flags, BIT(SETT_SNAP_FILE));
+        hdr_p->file_size = file_p->file_size;
+        hdr_p->file_time = file_p->file_time;
+    } else if ((S_OK == SettSnapValidate(snap_hdr_p)) && BIT_TEST(snap_hdr_p->flags, BIT(SETT_SNAP_FILE))) {
+        const U8* rec_p = (const U8*)(snap_hdr_p + 1);
+        const U8* end_p = rec_p + snap_hdr_p->size;
+        ConstStrP str_v[3];
+        U8 type;
+        Size len;
+        while (0 != (len = SettSnapRecordGet(rec_p, end_p, &type, str_v))) {
+            if (SETT_SNAP_REC_SETT == type) {
+                IF_STATUS(s = SettSnapRecordPut(&writer, type, str_v)) { goto error; }
+            }
+            rec_p += len;
+        }
+        BIT_SET(hdr_p->flags, BIT(SETT_SNAP_FILE));
+        hdr_p->file_size = snap_hdr_p->file_size;
+        hdr_p->file_time = snap_hdr_p->file_time;
+    }
+    // Zero padding (the CRC is calculated by words).
+    while (0 != ((writer.rec_p - (U8*)(hdr_p + 1)) % sizeof(U32))) { *writer.rec_p++ = 0; }
+    hdr_p->magic    = SETT_SNAP_MAGIC;
+    hdr_p->version  = OS_SETTINGS_SNAPSHOT_VERSION;
+    hdr_p->build_id = HAL_BuildIdGet();
+    hdr_p->size     = (U32)(writer.rec_p - (U8*)(hdr_p + 1));
+    hdr_p->crc      = OS_MemCrc32(&hdr_p->magic, sizeof(SettSnapHeader) - sizeof(hdr_p->crc) + hdr_p->size);
+    const Size size = sizeof(SettSnapHeader) + hdr_p->size;
+    if (OS_MemCmp(snap_hdr_p, hdr_p, size)) {
+        OS_MemCpy(snap_hdr_p, hdr_p, size);
+        OS_LOG(D_DEBUG, "Sett snapshot written: %u bytes", size);
+    }
+    OS_Free(hdr_p);
+    return s;
+error:
+    // The stale snapshot must not be restored.
+    snap_hdr_p->magic = 0;
+    OS_Free(hdr_p);
+    return s;
+}
+#endif //(OS_SETTINGS_SNAPSHOT_ENABLED)
+#endif //(OS_SETTINGS_CACHE_ENABLED)
+
 #if (OS_SETTINGS_BROWSE_ENABLED)
 /******************************************************************************/
 //int SettingsCallback(const char* section, const char* key, const char* value, const void* userdata)
@@ -10,6 +10,8 @@
 #include "os_signal.h"
 #include "os_mailbox.h"
 #include "os_file_system.h"
+#include "os_file_copy.h"
+#include "os_fs_bench.h"
 #include "os_shell_commands_fs.h"
 #include "os_shell.h"
 
@@ -20,6 +22,7 @@
 
 //------------------------------------------------------------------------------
 extern const StatusItem status_fs_v[];
+extern OS_DriverHd fs_media_dhd_v[];
 
 //------------------------------------------------------------------------------
 static OS_FileSystemMediaHd fs_media_hd_curr = OS_NULL;
@@ -142,11 +145,19 @@ Status s = S_UNDEF;
         }
     }
     IF_STATUS(s = OS_FileSystemVolumeStatsGet(fs_media_hd_curr, &stats_vol)) { OS_LOG_S(D_WARNING, s); goto error; }
+#if (OS_FILE_SYSTEM_USAGE_ENABLED)
+    {
+        // Cached volume root usage.
+        const Str vol_root[] = { OS_FileSystemVolumeGet(fs_media_hd_curr) + '0', OS_FILE_SYSTEM_DRV_DELIM, OS_ASCII_EOL };
+        IF_STATUS(s = OS_FileSystemUsageGet(vol_root, &stats_fs)) { OS_LOG_S(D_WARNING, s); goto error; }
+    }
+#else
     path_p = (StrP)OS_Malloc(OS_FILE_SYSTEM_LONG_NAMES_LEN * 2);
     if (OS_NULL == path_p) { s = S_OUT_OF_MEMORY; goto error; }
     *path_p = OS_ASCII_EOL;
     OS_MemSet(&stats_fs, 0, sizeof(stats_fs));
     IF_STATUS(s = OS_FileSystemVolumeScan(path_p, &stats_fs)) { OS_LOG_S(D_WARNING, s); goto error; }
+#endif //(OS_FILE_SYSTEM_USAGE_ENABLED)
     printf("\nMedia name            :%s"
            "\nVolume name           :%s"
            "\nVolume serial         :0x%X"
@@ -404,6 +415,11 @@ Bool is_exists = OS_FALSE;
                 case 'x':
                     is_exists = OS_TRUE;
                     break;
+#if (OS_FILE_SYSTEM_FASTSEEK)
+                case 's':
+                    BIT_SET(op_mode, BIT(OS_FS_FILE_OP_MODE_FAST_SEEK));
+                    break;
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
                 default:
                     break;
             }
@@ -522,6 +538,497 @@ const S8 volume = OS_AtoI((const char*)argv[0]);
 }
 #endif // (OS_FILE_SYSTEM_MAKE_ENABLED)
 
+#if (OS_BLK_SCHED_ENABLED)
+//------------------------------------------------------------------------------
+#define OS_SHELL_BLK_TRACE_ITEMS_MAX    64
+#define OS_SHELL_BLK_TRACE_SECTORS_MAX  256
+#define OS_SHELL_BLK_TRACE_SPAN_MAX     8192
+#define OS_SHELL_BLK_TRACE_SCRATCH      "fq.tmp"
+#define OS_SHELL_BLK_TRACE_PASSES       2
+
+static ConstStr cmd_fq[]            = "fq";
+static ConstStr cmd_help_brief_fq[] = "Block I/O trace replay on the scratch file (direct vs. scheduler). Trace line: 'r|w lba count'.";
+/******************************************************************************/
+static Status OS_ShellCmdFqPass(const OS_FileSystemMediaHd fs_media_hd, const OS_DriverHd dhd,
+                                OS_BlkSchedIo* io_v, const U32 io_count, const Bool is_sched, OS_Tick* ticks_p);
+Status OS_ShellCmdFqPass(const OS_FileSystemMediaHd fs_media_hd, const OS_DriverHd dhd,
+                         OS_BlkSchedIo* io_v, const U32 io_count, const Bool is_sched, OS_Tick* ticks_p)
+{
+Status s = S_OK;
+#if (OS_SEC_CACHE_ENABLED)
+    // Every pass starts cold: the cached lines are written back and dropped.
+    const OS_SecCacheHd schd = OS_FileSystemMediaSecCacheGet(fs_media_hd);
+    if (OS_NULL != schd) {
+        IF_STATUS(s = OS_SecCacheInvalidate(schd)) { return s; }
+    }
+#endif //(OS_SEC_CACHE_ENABLED)
+    const OS_Tick tick_start = OS_TickCountGet();
+    if (OS_TRUE == is_sched) {
+        // Scheduled: the whole trace is queued at once.
+        s = OS_BlkSchedBatch(OS_FileSystemMediaBlkSchedGet(fs_media_hd), io_v, io_count);
+    } else {
+        // Direct: one driver transfer per request in the trace order.
+        for (U32 i = 0; i < io_count; ++i) {
+            U32 sector = io_v[i].sector;
+            if (OS_TRUE == io_v[i].is_write) {
+                IF_STATUS(s = OS_DriverWrite(dhd, io_v[i].data_p, io_v[i].count, &sector)) { break; }
+            } else {
+                IF_STATUS(s = OS_DriverRead(dhd, io_v[i].data_p, io_v[i].count, &sector)) { break; }
+            }
+        }
+    }
+    *ticks_p += OS_TickCountGet() - tick_start;
+    return s;
+}
+
+/******************************************************************************/
+static Status OS_ShellCmdFqHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFqHandler(const U32 argc, ConstStrP argv[])
+{
+OS_BlkSchedIo* io_v = OS_NULL;
+U8* data_p = OS_NULL;
+OS_FileHd trace_fhd = OS_NULL;
+OS_FileHd scratch_fhd = OS_NULL;
+OS_FileLineReaderHd trace_lrhd = OS_NULL;
+OS_BlkSchedStats stats;
+Str scratch_path[OS_FILE_SYSTEM_VOLUME_STR_LEN + sizeof(OS_SHELL_BLK_TRACE_SCRATCH)];
+OS_Tick ticks_direct = 0;
+OS_Tick ticks_sched = 0;
+StrP line_p;
+Size line_len;
+U32 io_count = 0;
+U32 writes = 0;
+U32 sectors = 0;
+U32 lba_min = U32_MAX;
+U32 lba_end = 0;
+U32 span;
+U32 scratch_sector;
+U32 scratch_sectors;
+Status s = S_OK;
+const S8 volume = OS_AtoI((const char*)argv[0]);
+    const OS_FileSystemMediaHd fs_media_hd = OS_FileSystemMediaByVolumeGet(volume);
+    if (OS_NULL == fs_media_hd) {
+        s = S_FS_MEDIA_INVALID;
+        OS_LOG_S(D_WARNING, s);
+        return s;
+    }
+    const OS_BlkSchedHd bshd = OS_FileSystemMediaBlkSchedGet(fs_media_hd);
+    const OS_DriverHd dhd = fs_media_dhd_v[volume];
+    io_v = (OS_BlkSchedIo*)OS_Malloc(OS_SHELL_BLK_TRACE_ITEMS_MAX * sizeof(OS_BlkSchedIo));
+    if (OS_NULL == io_v) { s = S_OUT_OF_MEMORY; goto error; }
+    IF_STATUS(s = OS_FileOpen(&trace_fhd, argv[1], BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) { goto error; }
+    IF_STATUS(s = OS_FileLineReaderCreate(trace_fhd, 0, &trace_lrhd)) { goto error; }
+    while ((io_count < OS_SHELL_BLK_TRACE_ITEMS_MAX) &&
+           (S_OK == OS_FileLineRead(trace_lrhd, &line_p, &line_len))) {
+        char* end_p = (char*)&line_p[1];
+        if ((0 == line_len) || (('r' != line_p[0]) && ('w' != line_p[0]))) { continue; }
+        OS_BlkSchedIo* io_p = &io_v[io_count];
+        io_p->sector    = (U32)OS_StrToL(end_p, &end_p, 10);
+        io_p->count     = (U32)OS_StrToL(end_p, &end_p, 10);
+        io_p->is_write  = ('w' == line_p[0]) ? OS_TRUE : OS_FALSE;
+        io_p->status    = S_UNDEF;
+        if ((0 == io_p->count) || (OS_SHELL_BLK_TRACE_SECTORS_MAX < (sectors + io_p->count))) { break; }
+        lba_min = MIN(lba_min, io_p->sector);
+        lba_end = MAX(lba_end, io_p->sector + io_p->count);
+        sectors += io_p->count;
+        writes += (OS_TRUE == io_p->is_write) ? 1 : 0;
+        ++io_count;
+    }
+    OS_FileLineReaderDelete(trace_lrhd);
+    trace_lrhd = OS_NULL;
+    OS_FileClose(&trace_fhd);
+    if (0 == io_count) { s = S_INVALID_VALUE; goto error; }
+    // The trace is replayed inside the contiguous scratch file (the wide traces are folded).
+    span = MIN(lba_end - lba_min, OS_SHELL_BLK_TRACE_SPAN_MAX);
+    snprintf((char*)scratch_path, sizeof(scratch_path), "%u%c%c%s",
+             volume, OS_FILE_SYSTEM_DRV_DELIM, OS_FILE_SYSTEM_DIR_DELIM, OS_SHELL_BLK_TRACE_SCRATCH);
+    IF_STATUS(s = OS_FileOpen(&scratch_fhd, scratch_path, BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE))) {
+        OS_Free(scratch_fhd);
+        scratch_fhd = OS_NULL;
+        goto error;
+    }
+    IF_STATUS(s = OS_FileAllocate(scratch_fhd, span * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_TRUE)) { goto error; }
+    IF_STATUS(s = OS_FileExtentGet(scratch_fhd, &scratch_sector, &scratch_sectors)) { goto error; }
+    if (scratch_sectors < span) { s = S_FS_ALLOCATION; goto error; }
+    for (U32 i = 0; i < io_count; ++i) {
+        U32 offset = (io_v[i].sector - lba_min) % span;
+        if ((offset + io_v[i].count) > span) {
+            offset = span - io_v[i].count;
+        }
+        io_v[i].sector = scratch_sector + offset;
+    }
+    data_p = (U8*)OS_MallocEx(sectors * OS_FILE_SYSTEM_SECTOR_SIZE_MAX, OS_BLK_SCHED_MEM);
+    if (OS_NULL == data_p) { s = S_OUT_OF_MEMORY; goto error; }
+    OS_MemSet(data_p, 0xA5, sectors * OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+    {
+        U8* buf_p = data_p;
+        for (U32 i = 0; i < io_count; ++i) {
+            io_v[i].data_p = buf_p;
+            buf_p += io_v[i].count * OS_FILE_SYSTEM_SECTOR_SIZE_MAX;
+        }
+    }
+    // The pass order alternates: neither of the methods gets the media warmed by the other one.
+    OS_BlkSchedStatsReset(bshd);
+    for (U8 pass = 0; pass < OS_SHELL_BLK_TRACE_PASSES; ++pass) {
+        for (U8 i = 0; i < 2; ++i) {
+            const Bool is_sched = ((pass + i) & 1) ? OS_TRUE : OS_FALSE;
+            IF_STATUS(s = OS_ShellCmdFqPass(fs_media_hd, dhd, io_v, io_count, is_sched,
+                                            (OS_TRUE == is_sched) ? &ticks_sched : &ticks_direct)) { goto error; }
+        }
+    }
+    IF_STATUS(s = OS_BlkSchedStatsGet(bshd, &stats)) { goto error; }
+    printf("\nRequests: %u (%u writes), sectors: %u, passes: %u"
+           "\nDirect   : %u ms, %u commands"
+           "\nScheduled: %u ms, %u commands, %u merged, %u deadlines",
+           io_count, writes, sectors, OS_SHELL_BLK_TRACE_PASSES,
+           OS_TICKS_TO_MS(ticks_direct) / OS_SHELL_BLK_TRACE_PASSES, io_count,
+           OS_TICKS_TO_MS(ticks_sched) / OS_SHELL_BLK_TRACE_PASSES, stats.dispatches / OS_SHELL_BLK_TRACE_PASSES,
+           stats.merged / OS_SHELL_BLK_TRACE_PASSES, stats.deadlines);
+error:
+    IF_STATUS(s) {
+        OS_LOG_S(D_WARNING, s);
+    }
+    if (OS_NULL != trace_lrhd) {
+        OS_FileLineReaderDelete(trace_lrhd);
+    }
+    if (OS_NULL != trace_fhd) {
+        OS_FileClose(&trace_fhd);
+    }
+    if (OS_NULL != scratch_fhd) {
+        OS_FileClose(&scratch_fhd);
+        OS_FileDelete(scratch_path);
+    }
+    OS_FreeEx(data_p, OS_BLK_SCHED_MEM);
+    OS_Free(io_v);
+    return s;
+}
+#endif //(OS_BLK_SCHED_ENABLED)
+
+#if (OS_FILE_SYSTEM_FASTSEEK)
+//------------------------------------------------------------------------------
+#define OS_SHELL_SEEK_BENCH_COUNT_DEFAULT   100
+
+static ConstStr cmd_fsk[]           = "fsk";
+static ConstStr cmd_help_brief_fsk[]= "Random seek benchmark (normal vs. fast seek). Args: file [seeks].";
+/******************************************************************************/
+static Status OS_ShellCmdFskHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFskHandler(const U32 argc, ConstStrP argv[])
+{
+const OS_FileOpenMode op_mode = BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ);
+const U32 seeks = (2 == argc) ? (U32)OS_AtoI((const char*)argv[1]) : OS_SHELL_SEEK_BENCH_COUNT_DEFAULT;
+OS_FileHd bench_fhd = OS_NULL;
+Status s = S_OK;
+    if (0 == seeks) { return S_INVALID_VALUE; }
+    U8* data_p = (U8*)OS_Malloc(OS_FILE_SYSTEM_SECTOR_SIZE_MAX);
+    if (OS_NULL == data_p) { return S_OUT_OF_MEMORY; }
+    for (U8 is_fast = 0; is_fast <= 1; ++is_fast) {
+        OS_Tick tick_start = OS_TickCountGet();
+        IF_STATUS(s = OS_FileOpen(&bench_fhd, argv[0], op_mode | ((is_fast) ? BIT(OS_FS_FILE_OP_MODE_FAST_SEEK) : 0))) {
+            OS_Free(bench_fhd);
+            bench_fhd = OS_NULL;
+            break;
+        }
+        const OS_Tick ticks_open = OS_TickCountGet() - tick_start;
+        const U32 size = OS_FileSizeGet(bench_fhd);
+        if (0 == size) { s = S_INVALID_SIZE; break; }
+        // The same offsets for the both runs.
+        U32 seed = 1;
+        tick_start = OS_TickCountGet();
+        for (U32 i = 0; i < seeks; ++i) {
+            seed = seed * 1103515245UL + 12345UL;
+            const U32 offset = (seed >> 8) % size;
+            IF_STATUS(s = OS_FileLSeek(bench_fhd, offset)) { break; }
+            IF_STATUS(s = OS_FileRead(bench_fhd, data_p, MIN(OS_FILE_SYSTEM_SECTOR_SIZE_MAX, size - offset))) { break; }
+        }
+        const OS_Tick ticks_seek = OS_TickCountGet() - tick_start;
+        OS_FileClose(&bench_fhd);
+        IF_STATUS(s) { break; }
+        printf("\n%-10s: open %u ms, %u seeks %u ms, %u us/seek",
+               (is_fast) ? "Fast seek" : "Normal",
+               OS_TICKS_TO_MS(ticks_open),
+               seeks,
+               OS_TICKS_TO_MS(ticks_seek),
+               (OS_TICKS_TO_MS(ticks_seek) * 1000) / seeks);
+    }
+    if (OS_NULL != bench_fhd) {
+        OS_FileClose(&bench_fhd);
+    }
+    IF_STATUS(s) {
+        OS_LOG_S(D_WARNING, s);
+    }
+    OS_Free(data_p);
+    return s;
+}
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+
+//------------------------------------------------------------------------------
+#define OS_SHELL_ALLOC_BENCH_CHUNK_DEFAULT  0x1000
+
+static ConstStr cmd_fpa[]           = "fpa";
+static ConstStr cmd_help_brief_fpa[]= "Streaming write benchmark (no/normal/contiguous preallocation). Args: file size_kb [chunk].";
+/******************************************************************************/
+static Status OS_ShellCmdFpaHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFpaHandler(const U32 argc, ConstStrP argv[])
+{
+const OS_FileOpenMode op_mode = BIT(OS_FS_FILE_OP_MODE_CREATE_EXISTS) | BIT(OS_FS_FILE_OP_MODE_WRITE);
+const U32 size = (U32)OS_AtoI((const char*)argv[1]) * 1024;
+const U32 chunk = (3 == argc) ? (U32)OS_AtoI((const char*)argv[2]) : OS_SHELL_ALLOC_BENCH_CHUNK_DEFAULT;
+static ConstStrP mode_str_v[] = { "None", "Allocate", "Contiguous" };
+OS_FileHd bench_fhd = OS_NULL;
+Status s = S_OK;
+    if ((0 == size) || (0 == chunk)) { return S_INVALID_VALUE; }
+    U8* data_p = (U8*)OS_Malloc(chunk);
+    if (OS_NULL == data_p) { return S_OUT_OF_MEMORY; }
+    OS_MemSet(data_p, 0x5A, chunk);
+    for (U8 mode = 0; mode < ITEMS_COUNT_GET(mode_str_v, ConstStrP); ++mode) {
+        OS_Tick ticks_alloc = 0;
+        OS_Tick ticks_write_max = 0;
+        IF_STATUS(s = OS_FileOpen(&bench_fhd, argv[0], op_mode)) {
+            OS_Free(bench_fhd);
+            bench_fhd = OS_NULL;
+            break;
+        }
+        OS_Tick tick_start = OS_TickCountGet();
+        if (0 != mode) {
+            IF_STATUS(s = OS_FileAllocate(bench_fhd, size, (2 == mode) ? OS_TRUE : OS_FALSE)) { break; }
+            ticks_alloc = OS_TickCountGet() - tick_start;
+        }
+        tick_start = OS_TickCountGet();
+        for (U32 offset = 0; offset < size; offset += chunk) {
+            const OS_Tick tick_write = OS_TickCountGet();
+            IF_STATUS(s = OS_FileWrite(bench_fhd, data_p, MIN(chunk, size - offset))) { break; }
+            ticks_write_max = MAX(ticks_write_max, OS_TickCountGet() - tick_write);
+        }
+        IF_OK(s) { s = OS_FileTruncate(bench_fhd); }
+        OS_FileClose(&bench_fhd);
+        const OS_Tick ticks_write = OS_TickCountGet() - tick_start;
+        IF_STATUS(s) { break; }
+        IF_STATUS(s = OS_FileDelete(argv[0])) { break; }
+        printf("\n%-10s: alloc %u ms, write %u ms, %u KB/s, max latency %u ms",
+               mode_str_v[mode],
+               OS_TICKS_TO_MS(ticks_alloc),
+               OS_TICKS_TO_MS(ticks_write),
+               (size / 1024 * 1000) / MAX(1, OS_TICKS_TO_MS(ticks_write)),
+               OS_TICKS_TO_MS(ticks_write_max));
+    }
+    if (OS_NULL != bench_fhd) {
+        OS_FileClose(&bench_fhd);
+    }
+    IF_STATUS(s) {
+        OS_LOG_S(D_WARNING, s);
+    }
+    OS_Free(data_p);
+    return s;
+}
+
+//------------------------------------------------------------------------------
+static ConstStr cmd_fgl[]           = "fgl";
+static ConstStr cmd_help_brief_fgl[]= "Text file parse benchmark (OS_FileGetS vs. line reader). Args: file.";
+/******************************************************************************/
+static Status OS_ShellCmdFglHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFglHandler(const U32 argc, ConstStrP argv[])
+{
+const OS_FileOpenMode op_mode = BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ);
+static ConstStrP mode_str_v[] = { "GetS", "LineReader" };
+OS_FileHd bench_fhd = OS_NULL;
+OS_FileLineReaderHd bench_lrhd = OS_NULL;
+Status s = S_OK;
+    StrP str_p = (StrP)OS_Malloc(OS_SETTINGS_BUFFER_LEN);
+    if (OS_NULL == str_p) { return S_OUT_OF_MEMORY; }
+    for (U8 mode = 0; mode < ITEMS_COUNT_GET(mode_str_v, ConstStrP); ++mode) {
+        U32 lines = 0;
+        IF_STATUS(s = OS_FileOpen(&bench_fhd, argv[0], op_mode)) {
+            OS_Free(bench_fhd);
+            bench_fhd = OS_NULL;
+            break;
+        }
+        const U32 size = OS_FileSizeGet(bench_fhd);
+        const OS_Tick tick_start = OS_TickCountGet();
+        if (0 == mode) {
+            while (S_OK == (s = OS_FileGetS(bench_fhd, str_p, OS_SETTINGS_BUFFER_LEN))) { ++lines; }
+        } else {
+            IF_OK(s = OS_FileLineReaderCreate(bench_fhd, 0, &bench_lrhd)) {
+                StrP line_p;
+                Size line_len;
+                while (S_OK == (s = OS_FileLineRead(bench_lrhd, &line_p, &line_len))) { ++lines; }
+                OS_FileLineReaderDelete(bench_lrhd);
+            }
+        }
+        const OS_Tick ticks = OS_TickCountGet() - tick_start;
+        OS_FileClose(&bench_fhd);
+        if (S_FS_EOF != s) { break; }
+        s = S_OK;
+        printf("\n%-10s: %u lines, %u ms, %u KB/s",
+               mode_str_v[mode], lines,
+               OS_TICKS_TO_MS(ticks),
+               (size / 1024 * 1000) / MAX(1, OS_TICKS_TO_MS(ticks)));
+    }
+    if (OS_NULL != bench_fhd) {
+        OS_FileClose(&bench_fhd);
+    }
+    IF_STATUS(s) {
+        OS_LOG_S(D_WARNING, s);
+    }
+    OS_Free(str_p);
+    return s;
+}
+
+#if (OS_FILE_COPY_ENABLED)
+//------------------------------------------------------------------------------
+static ConstStr cmd_fcp[]           = "fcp";
+static ConstStr cmd_help_brief_fcp[]= "File copy (multiple buffered). Args: src dst [verify] [buf_kb] [bufs].";
+/******************************************************************************/
+static Status OS_ShellCmdFcpHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFcpHandler(const U32 argc, ConstStrP argv[])
+{
+OS_FileCopyConfig cfg;
+OS_FileCopyStats stats;
+Status s;
+    cfg.is_verify   = ((3 <= argc) && (0 != OS_AtoI((const char*)argv[2]))) ? OS_TRUE : OS_FALSE;
+    cfg.buf_size    = (4 <= argc) ? (Size)OS_AtoI((const char*)argv[3]) * 1024 : 0;
+    cfg.bufs_count  = (5 <= argc) ? (U8)OS_AtoI((const char*)argv[4]) : 0;
+    IF_STATUS(s = OS_FileCopy(argv[0], argv[1], &cfg, &stats)) { return s; }
+    // Hundredths of MB/s.
+    const U32 rate = (U32)(((U64)stats.size * 1000 * 100) / ((U64)MAX(1, stats.time) * 1024 * 1024));
+    printf("\n%u bytes, %u ms, %u.%02u MB/s"
+           "\nRead       : %u ms"
+           "\nWrite stall: %u ms"
+           "\nFlush      : %u ms"
+           "\nMax write latency: %u ms",
+           stats.size, stats.time, rate / 100, rate % 100,
+           stats.read_ms,
+           stats.stall_ms,
+           stats.flush_ms,
+           stats.write_latency_max);
+    if (OS_TRUE == cfg.is_verify) {
+        printf("\nVerify     : %u ms, CRC 0x%08X", stats.verify_ms, stats.crc);
+    }
+    return s;
+}
+#endif //(OS_FILE_COPY_ENABLED)
+
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+//------------------------------------------------------------------------------
+static ConstStr cmd_ftrim[]         = "ftrim";
+static ConstStr cmd_help_brief_ftrim[]= "Erase the volume free space (the volume is locked). Args: volume.";
+/******************************************************************************/
+static Status OS_ShellCmdFtrimHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFtrimHandler(const U32 argc, ConstStrP argv[])
+{
+U32 sectors;
+Status s;
+    const S8 volume = OS_AtoI((const char*)argv[0]);
+    const OS_FileSystemMediaHd fs_media_hd = OS_FileSystemMediaByVolumeGet(volume);
+    if (OS_NULL == fs_media_hd) {
+        s = S_FS_MEDIA_INVALID;
+        OS_LOG_S(D_WARNING, s);
+        return s;
+    }
+    const OS_Tick tick_start = OS_TickCountGet();
+    IF_STATUS(s = OS_FileSystemTrim(fs_media_hd, &sectors)) {
+        OS_LOG_S(D_WARNING, s);
+        return s;
+    }
+    printf("\nTrimmed: %u KB, %u ms",
+           sectors / (1024 / OS_FILE_SYSTEM_SECTOR_SIZE_MAX),
+           OS_TICKS_TO_MS(OS_TickCountGet() - tick_start));
+    return s;
+}
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+
+//------------------------------------------------------------------------------
+static ConstStr cmd_fdr[]           = "fdr";
+static ConstStr cmd_help_brief_fdr[]= "File read bench (buffered vs direct). Args: file [buf_kb].";
+/******************************************************************************/
+static Status OS_ShellCmdFdrHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFdrHandler(const U32 argc, ConstStrP argv[])
+{
+const Size buf_size = (2 == argc) ? (Size)OS_AtoI((const char*)argv[1]) * 1024 : OS_FILE_COPY_BUF_SIZE;
+static ConstStrP mode_str_v[] = { "Buffered", "Direct" };
+OS_FileDirectStats stats_start;
+OS_FileDirectStats stats;
+OS_FileHd bench_fhd = OS_NULL;
+U32 size = 0;
+Status s = S_OK;
+    if (0 == buf_size) { return S_INVALID_VALUE; }
+    U8* data_p = (U8*)OS_MallocAlignedEx(buf_size, OS_FILE_SYSTEM_DMA_ALIGN, OS_FILE_SYSTEM_DMA_MEM);
+    if (OS_NULL == data_p) { return S_OUT_OF_MEMORY; }
+    for (U8 mode = 0; mode < ITEMS_COUNT_GET(mode_str_v, ConstStrP); ++mode) {
+        IF_STATUS(s = OS_FileOpen(&bench_fhd, argv[0], BIT(OS_FS_FILE_OP_MODE_OPEN_EXISTS) | BIT(OS_FS_FILE_OP_MODE_READ))) {
+            OS_Free(bench_fhd);
+            bench_fhd = OS_NULL;
+            break;
+        }
+        size = OS_FileSizeGet(bench_fhd);
+        OS_FileDirectStatsGet(&stats_start);
+        const OS_Tick tick_start = OS_TickCountGet();
+        for (U32 offset = 0; offset < size; offset += buf_size) {
+            const Size len = MIN(buf_size, size - offset);
+            IF_STATUS(s = (0 == mode) ? OS_FileRead(bench_fhd, data_p, len) :
+                                        OS_FileReadDirect(bench_fhd, data_p, len)) { break; }
+        }
+        const OS_TimeMs time = OS_TICKS_TO_MS(OS_TickCountGet() - tick_start);
+        OS_FileClose(&bench_fhd);
+        IF_STATUS(s) { break; }
+        OS_FileDirectStatsGet(&stats);
+        // Hundredths of MB/s.
+        const U32 rate = (U32)(((U64)size * 1000 * 100) / ((U64)MAX(1, time) * 1024 * 1024));
+        printf("\n%-8s: %u ms, %u.%02u MB/s", mode_str_v[mode], time, rate / 100, rate % 100);
+        if (0 != mode) {
+            printf(", commands %u, bounces %u",
+                   stats.commands - stats_start.commands,
+                   stats.bounces - stats_start.bounces);
+        }
+    }
+    IF_OK(s) {
+        U32 bounces_total = 0;
+        for (U8 volume = 0; volume < OS_FILE_SYSTEM_VOLUMES_MAX; ++volume) {
+            U32 bounces;
+            if (OS_NULL == fs_media_dhd_v[volume]) { continue; }
+            IF_OK(OS_DriverIoCtl(fs_media_dhd_v[volume], DRV_REQ_MEDIA_DMA_BOUNCES_GET, &bounces)) {
+                bounces_total += bounces;
+            }
+        }
+        printf("\nDriver DMA bounces: %u", bounces_total);
+    }
+    OS_FreeAligned(data_p);
+    return s;
+}
+
+#if (OS_FS_BENCH_ENABLED)
+//------------------------------------------------------------------------------
+static ConstStr cmd_fbench[]        = "fbench";
+static ConstStr cmd_help_brief_fbench[]= "File system bench (JSON). Args: dir [json|-] [lat_r_ms] [lat_w_ms] [romfs_file].";
+/******************************************************************************/
+static Status OS_ShellCmdFbenchHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdFbenchHandler(const U32 argc, ConstStrP argv[])
+{
+OS_FsBenchConfig cfg;
+Status s;
+    OS_MemSet(&cfg, 0, sizeof(cfg));
+    cfg.dir_path_p      = argv[0];
+    cfg.json_path_p     = ((2 <= argc) && OS_StrCmp((const char*)argv[1], "-")) ? argv[1] : OS_NULL;
+    cfg.latency.read_ms = (3 <= argc) ? OS_AtoI((const char*)argv[2]) : 0;
+    cfg.latency.write_ms= (4 <= argc) ? OS_AtoI((const char*)argv[3]) : 0;
+    cfg.romfs_path_p    = (5 <= argc) ? argv[4] : OS_NULL;
+    cfg.seed            = 1;
+    OS_FsBenchResult* results_p = (OS_FsBenchResult*)OS_Malloc(OS_FS_BENCH_LAST * sizeof(OS_FsBenchResult));
+    if (OS_NULL == results_p) { return S_OUT_OF_MEMORY; }
+    s = OS_FsBenchRun(&cfg, results_p);
+    // The JSON is in the file - the summary to the console.
+    if (OS_NULL != cfg.json_path_p) {
+        for (OS_FsBenchScenario scenario = 0; scenario < OS_FS_BENCH_LAST; ++scenario) {
+            const OS_FsBenchResult* result_p = &results_p[scenario];
+            if (S_FS_NOT_ENABLED == result_p->status) { continue; }
+            printf("\n%-16s: %6u ops, %6u ms, max %4u ms", OS_FsBenchNameGet(scenario),
+                   result_p->ops, result_p->time, result_p->latency_max);
+        }
+    }
+    OS_Free(results_p);
+    return s;
+}
+#endif //(OS_FS_BENCH_ENABLED)
+
 //------------------------------------------------------------------------------
 static ConstStr empty_str[] = "";
 static const OS_ShellCommandConfig cmd_cfg_fs[] = {
@@ -541,6 +1048,24 @@ static const OS_ShellCommandConfig cmd_cfg_fs[] = {
     { cmd_fn,       cmd_help_brief_fn,      empty_str,              OS_ShellCmdFnHandler,       2,    2,      OS_SHELL_OPT_UNDEF  },
     { cmd_fa,       cmd_help_brief_fa,      empty_str,              OS_ShellCmdFaHandler,       2,    2,      OS_SHELL_OPT_UNDEF  },
     { cmd_ft,       cmd_help_brief_ft,      empty_str,              OS_ShellCmdFtHandler,       3,    3,      OS_SHELL_OPT_UNDEF  },
+    { cmd_fpa,      cmd_help_brief_fpa,     empty_str,              OS_ShellCmdFpaHandler,      2,    3,      OS_SHELL_OPT_UNDEF  },
+    { cmd_fgl,      cmd_help_brief_fgl,     empty_str,              OS_ShellCmdFglHandler,      1,    1,      OS_SHELL_OPT_UNDEF  },
+#if (OS_FILE_SYSTEM_ERASE_SEC_EN)
+    { cmd_ftrim,    cmd_help_brief_ftrim,   empty_str,              OS_ShellCmdFtrimHandler,    1,    1,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_FILE_SYSTEM_ERASE_SEC_EN)
+    { cmd_fdr,      cmd_help_brief_fdr,     empty_str,              OS_ShellCmdFdrHandler,      1,    2,      OS_SHELL_OPT_UNDEF  },
+#if (OS_FILE_COPY_ENABLED)
+    { cmd_fcp,      cmd_help_brief_fcp,     empty_str,              OS_ShellCmdFcpHandler,      2,    5,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_FILE_COPY_ENABLED)
+#if (OS_FS_BENCH_ENABLED)
+    { cmd_fbench,   cmd_help_brief_fbench,  empty_str,              OS_ShellCmdFbenchHandler,   1,    5,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_FS_BENCH_ENABLED)
+#if (OS_FILE_SYSTEM_FASTSEEK)
+    { cmd_fsk,      cmd_help_brief_fsk,     empty_str,              OS_ShellCmdFskHandler,      1,    2,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_FILE_SYSTEM_FASTSEEK)
+#if (OS_BLK_SCHED_ENABLED)
+    { cmd_fq,       cmd_help_brief_fq,      empty_str,              OS_ShellCmdFqHandler,       2,    2,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_BLK_SCHED_ENABLED)
 };
 
 /******************************************************************************/
@@ -17,6 +17,9 @@
 #include "os_driver.h"
 #include "os_mailbox.h"
 #include "os_environment.h"
+#include "os_profile.h"
+#include "os_startup.h"
+#include "os_file_system.h"
 #include "os_shell_commands_std.h"
 #include "os_shell.h"
 
@@ -259,6 +262,64 @@ error:
     OS_Free(run_stats_buf_p);
 }
 
+/******************************************************************************/
+static void OS_ShellCmdStHandlerPerHelper(void);
+void OS_ShellCmdStHandlerPerHelper(void)
+{
+OS_TaskHd thd = OS_NULL;
+
+    printf("\n%-12s %-6s %-6s %-6s %-8s %-6s %-6s %-8s %-8s %-8s %s",
+           "Name", "Period", "DLine", "Budget", "Releases", "Misses", "Overs", "JitMax", "RespMin", "RespMax", "Hist(D/8)");
+    while (OS_NULL != (thd = OS_TaskNextGet(thd))) {
+        OS_TaskPeriodicStats per_stats;
+        IF_STATUS(OS_TaskPeriodicStatsGet(thd, &per_stats)) { continue; }
+        printf("\n%-12s %-6d %-6d %-6d %-8d %-6d %-6d %-8d %-8d %-8d",
+               OS_TaskNameGet(thd),
+               per_stats.cfg.period,
+               per_stats.cfg.deadline,
+               per_stats.cfg.budget,
+               per_stats.releases,
+               per_stats.deadline_misses,
+               per_stats.budget_overruns,
+               per_stats.jitter_max,
+               per_stats.response_min,
+               per_stats.response_max);
+        for (Size i = 0; i < ITEMS_COUNT_GET(per_stats.response_hist_v, U32); ++i) {
+            printf(" %d", per_stats.response_hist_v[i]);
+        }
+    }
+    printf("\nUtilization: %d%%", OS_TasksPeriodicUtilizationGet() / 10);
+}
+
+/******************************************************************************/
+static void OS_ShellCmdStHandlerStaHelper(void);
+void OS_ShellCmdStHandlerStaHelper(void)
+{
+OS_StartupTimelineItem item;
+U32 time_total = 0;
+
+    printf("\n%-3s %-12s %-8s %-8s %-8s %-12s %-4s %s",
+           "Idx", "Name", "Start", "Ready", "Dur", "After", "Crit", "Status");
+    for (U8 i = 0; i < OS_StartupTimelineCountGet(); ++i) {
+        IF_STATUS(OS_StartupTimelineItemGet(i, &item)) { return; }
+        OS_StartupTimelineItem pred_item = { "-" };
+        if (OS_STARTUP_PRED_NONE != item.pred) {
+            IF_STATUS(OS_StartupTimelineItemGet(item.pred, &pred_item)) { return; }
+        }
+        printf("\n%-3d %-12s %-8d %-8d %-8d %-12s %-4s %s",
+               i,
+               item.name_p,
+               item.start,
+               item.ready,
+               (item.ready >= item.start) ? (item.ready - item.start) : 0,
+               pred_item.name_p,
+               (OS_TRUE == item.is_critical) ? "*" : "",
+               StatusStringGet(item.status, STATUS_ITEMS_COMMON));
+        time_total = MAX(time_total, item.ready);
+    }
+    printf("\nTotal(us): %d", time_total);
+}
+
 /******************************************************************************/
 static void OS_ShellCmdStHandlerQueHelper(void);
 void OS_ShellCmdStHandlerQueHelper(void)
@@ -294,18 +355,19 @@ void OS_ShellCmdStHandlerDrvHelper(void)
 {
 OS_DriverHd dhd = OS_NULL;
 
-    printf("\n%-8s %-6s %-7s %-4s %-6s %-12s %-12s %-8s %-9s",
-           "Name", "State", "Power", "PriP", "Owners", "Sended", "Received", "Errors", "Status");
+    printf("\n%-8s %-6s %-7s %-4s %-5s %-6s %-12s %-12s %-8s %-9s",
+           "Name", "State", "Power", "PriP", "Lock", "Owners", "Sended", "Received", "Errors", "Status");
     while (OS_NULL != (dhd = OS_DriverNextGet(dhd))) {
         OS_DriverStats drv_stats;
         IF_STATUS(OS_DriverStatsGet(dhd, &drv_stats)) { return; }
         const OS_DriverConfig* drv_cfg_p = OS_DriverConfigGet(dhd);
         if (OS_NULL == drv_cfg_p) { return; }
-        printf("\n%-8s %-6s %-7s %-4d %-6d %-12d %-12d %-8d %-9s",
+        printf("\n%-8s %-6s %-7s %-4d %-5s %-6d %-12d %-12d %-8d %-9s",
                drv_cfg_p->name,
                OS_DriverStateNameGet(drv_stats.state),
                OS_PowerStateNameGet(drv_stats.power),
                drv_cfg_p->prio_power,
+               OS_DriverLockPolicyNameGet(drv_cfg_p->lock_policy),
                drv_stats.owners,
                drv_stats.sended,
                drv_stats.received,
@@ -367,6 +429,58 @@ OS_TriggerHd tigger_hd = OS_NULL;
 }
 #endif //(OS_TRIGGERS_ENABLED)
 
+/******************************************************************************/
+#if (OS_FILE_SYSTEM_ENABLED)
+static void OS_ShellCmdStHandlerFsHelper(void);
+void OS_ShellCmdStHandlerFsHelper(void)
+{
+    printf("\n%-3s %-12s %-10s %-10s %-6s %-6s %-6s %-10s %-8s",
+           "Vol", "Name", "Requests", "Commands", "Merge%", "DepMax", "DepAvg", "Deadlines", "Errors");
+    for (U8 volume = 0; volume < OS_FILE_SYSTEM_VOLUMES_MAX; ++volume) {
+        const OS_FileSystemMediaHd fs_media_hd = OS_FileSystemMediaByVolumeGet(volume);
+        if (OS_NULL == fs_media_hd) { continue; }
+#if (OS_BLK_SCHED_ENABLED)
+        OS_BlkSchedStats sched_stats;
+        IF_STATUS(OS_BlkSchedStatsGet(OS_FileSystemMediaBlkSchedGet(fs_media_hd), &sched_stats)) { return; }
+        printf("\n%-3d %-12s %-10u %-10u %-6u %-6u %-6u %-10u %-8u",
+               volume,
+               OS_FileSystemMediaNameGet(fs_media_hd),
+               sched_stats.requests,
+               sched_stats.dispatches,
+               sched_stats.requests ? ((sched_stats.merged * 100) / sched_stats.requests) : 0,
+               sched_stats.depth_max,
+               sched_stats.requests ? (sched_stats.depth_sum / sched_stats.requests) : 0,
+               sched_stats.deadlines,
+               sched_stats.errors);
+#else
+        printf("\n%-3d %-12s", volume, OS_FileSystemMediaNameGet(fs_media_hd));
+#endif //(OS_BLK_SCHED_ENABLED)
+    }
+#if (OS_SEC_CACHE_ENABLED)
+    printf("\n\n%-3s %-12s %-10s %-6s %-10s %-10s %-10s %-8s %-6s",
+           "Vol", "Name", "Reads", "Hit%", "Writes", "WrBacks", "Evictions", "Bypass", "Dirty");
+    for (U8 volume = 0; volume < OS_FILE_SYSTEM_VOLUMES_MAX; ++volume) {
+        const OS_FileSystemMediaHd fs_media_hd = OS_FileSystemMediaByVolumeGet(volume);
+        if (OS_NULL == fs_media_hd) { continue; }
+        OS_SecCacheStats cache_stats;
+        IF_STATUS(OS_SecCacheStatsGet(OS_FileSystemMediaSecCacheGet(fs_media_hd), &cache_stats)) { return; }
+        const U32 accesses = cache_stats.reads + cache_stats.writes;
+        printf("\n%-3d %-12s %-10u %-6u %-10u %-10u %-10u %-8u %u/%u",
+               volume,
+               OS_FileSystemMediaNameGet(fs_media_hd),
+               cache_stats.reads,
+               accesses ? ((cache_stats.hits * 100) / accesses) : 0,
+               cache_stats.writes,
+               cache_stats.write_backs,
+               cache_stats.evictions,
+               cache_stats.bypasses,
+               cache_stats.dirty,
+               cache_stats.lines);
+    }
+#endif //(OS_SEC_CACHE_ENABLED)
+}
+#endif //(OS_FILE_SYSTEM_ENABLED)
+
 /******************************************************************************/
 #if (OS_NETWORK_ENABLED)
 static void OS_ShellCmdStHandlerNetHelper(void);
@@ -386,6 +500,8 @@ typedef struct {
 CommandHandler cmd_handlers_v[] = {
     { "mem", OS_ShellCmdStHandlerMemHelper }, //memory
     { "tsk", OS_ShellCmdStHandlerTskHelper }, //tasks
+    { "per", OS_ShellCmdStHandlerPerHelper }, //periodic tasks
+    { "sta", OS_ShellCmdStHandlerStaHelper }, //startup timeline
     { "que", OS_ShellCmdStHandlerQueHelper }, //queues
     { "drv", OS_ShellCmdStHandlerDrvHelper }, //drivers
 #if (OS_TIMERS_ENABLED)
@@ -394,7 +510,9 @@ CommandHandler cmd_handlers_v[] = {
 #if (OS_TRIGGERS_ENABLED)
     { "tri", OS_ShellCmdStHandlerTriHelper }, //triggers
 #endif //(OS_TRIGGERS_ENABLED)
-//    { "fs",  OS_ShellCmdStHandlerFsHelper  }, //file system
+#if (OS_FILE_SYSTEM_ENABLED)
+    { "fs",  OS_ShellCmdStHandlerFsHelper  }, //file system
+#endif //(OS_FILE_SYSTEM_ENABLED)
 #if (OS_NETWORK_ENABLED)
     { "net", OS_ShellCmdStHandlerNetHelper }, //network itf
 #endif //(OS_NETWORK_ENABLED)
@@ -409,6 +527,69 @@ CommandHandler cmd_handlers_v[] = {
     return S_INVALID_VALUE;
 }
 
+#if (OS_PROFILE_ENABLED)
+//------------------------------------------------------------------------------
+static ConstStr cmd_prof[]              = "prof";
+static ConstStr cmd_help_brief_prof[]   = "Profile zones statistics (us). Use 'reset' to clear.";
+/******************************************************************************/
+static Status OS_ShellCmdProfHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdProfHandler(const U32 argc, ConstStrP argv[])
+{
+OS_ProfileZoneHd zhd = OS_NULL;
+
+    if (1 == argc) {
+        if (!OS_StrCmp("reset", (char const*)argv[0])) {
+            OS_ProfileReset();
+            return S_OK;
+        }
+        return S_INVALID_VALUE;
+    }
+    printf("\n%-16s %-10s %-10s %-10s %-10s %-10s",
+           "Zone", "Count", "Min", "Max", "Mean", "P99");
+    while (OS_NULL != (zhd = OS_ProfileZoneNextGet(zhd))) {
+        OS_ProfileZoneStats zone_stats;
+        IF_STATUS(OS_ProfileZoneStatsGet(zhd, &zone_stats)) { return S_INVALID_VALUE; }
+        printf("\n%-16s %-10u %-10u %-10u %-10u %-10u",
+               zone_stats.name_p,
+               zone_stats.count,
+               OS_ProfileCyclesToUs(zone_stats.min),
+               OS_ProfileCyclesToUs(zone_stats.max),
+               OS_ProfileCyclesToUs(zone_stats.mean),
+               OS_ProfileCyclesToUs(zone_stats.p99));
+    }
+    return S_OK;
+}
+#endif //(OS_PROFILE_ENABLED)
+
+//------------------------------------------------------------------------------
+static ConstStr cmd_boot[]              = "boot";
+static ConstStr cmd_help_brief_boot[]   = "Boot checkpoints (us). Use 'prev' for the previous boot.";
+/******************************************************************************/
+static Status OS_ShellCmdBootHandler(const U32 argc, ConstStrP argv[]);
+Status OS_ShellCmdBootHandler(const U32 argc, ConstStrP argv[])
+{
+HAL_Boot boot = HAL_BOOT_CURRENT;
+HAL_BootCheckpointItem item;
+U32 cycles_prev = 0;
+
+    if (1 == argc) {
+        if (OS_StrCmp("prev", (char const*)argv[0])) { return S_INVALID_VALUE; }
+        boot = HAL_BOOT_PREVIOUS;
+    }
+    printf("\nBoot: %u", (HAL_BOOT_CURRENT == boot) ? HAL_BootCountGet() : HAL_BootCountGet() - 1);
+    printf("\n%-3s %-12s %-10s %-10s", "Idx", "Checkpoint", "Time", "Delta");
+    for (U8 i = 0; i < HAL_BootCheckpointsCountGet(boot); ++i) {
+        IF_STATUS(HAL_BootCheckpointGet(boot, i, &item)) { return S_INVALID_VALUE; }
+        printf("\n%-3d %-12s %-10u %-10u",
+               i,
+               item.name,
+               CYCLES_TO_US(item.cycles),
+               CYCLES_TO_US(item.cycles - cycles_prev));
+        cycles_prev = item.cycles;
+    }
+    return S_OK;
+}
+
 //------------------------------------------------------------------------------
 static ConstStr cmd_kill[]              = "kill";
 static ConstStr cmd_help_brief_kill[]   = "Kill the task.";
@@ -561,7 +742,11 @@ static const OS_ShellCommandConfig cmd_cfg_std[] = {
     { cmd_setenv,   cmd_help_brief_setenv,      empty_str,        OS_ShellCmdSetEnvHandler,   2,    3,      OS_SHELL_OPT_UNDEF  },
     { cmd_unsetenv, cmd_help_brief_unsetenv,    empty_str,        OS_ShellCmdUnsetEnvHandler, 1,    1,      OS_SHELL_OPT_UNDEF  },
     { cmd_st,       cmd_help_brief_st,          empty_str,        OS_ShellCmdStHandler,       1,    1,      OS_SHELL_OPT_UNDEF  },
+    { cmd_boot,     cmd_help_brief_boot,        empty_str,        OS_ShellCmdBootHandler,     0,    1,      OS_SHELL_OPT_UNDEF  },
     { cmd_kill,     cmd_help_brief_kill,        empty_str,        OS_ShellCmdKillHandler,     1,    1,      OS_SHELL_OPT_UNDEF  },
+#if (OS_PROFILE_ENABLED)
+    { cmd_prof,     cmd_help_brief_prof,        empty_str,        OS_ShellCmdProfHandler,     0,    1,      OS_SHELL_OPT_UNDEF  },
+#endif //(OS_PROFILE_ENABLED)
     { cmd_time,     cmd_help_brief_time,        empty_str,        OS_ShellCmdTimeHandler,     0,    2,      OS_SHELL_OPT_UNDEF  },
     { cmd_date,     cmd_help_brief_date,        empty_str,        OS_ShellCmdDateHandler,     0,    2,      OS_SHELL_OPT_UNDEF  },
     { cmd_reboot,   cmd_help_brief_reboot,      empty_str,        OS_ShellCmdRebootHandler,   0,    0,      OS_SHELL_OPT_UNDEF  },
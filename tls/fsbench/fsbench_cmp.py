@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    fsbench_cmp.py
+@brief   File system benchmark results compare.
+@author  A. Filyanov
+
+The results are the 'fbench' shell command JSON (src/osal/filesystem/os_fs_bench.c):
+the JSON file copied from the media or the console log with the JSON printed.
+The scenario rate is kb_s for the transfers and ops_s for the others (bytes == 0).
+
+Usage:
+    fsbench_cmp.py <base> [new] [-t pct]    print (and compare) the results;
+                                            the exit code is 1 if a scenario of
+                                            the new run is slower than pct %.
+"""
+import argparse
+import json
+import sys
+
+def results_load(path):
+    with open(path, "r", encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    # The console log: the JSON object is between the first '{' and the last '}'.
+    start = text.find("{")
+    end = text.rfind("}")
+    if (start < 0) or (end < start):
+        raise ValueError("%s: no JSON results" % path)
+    doc = json.loads(text[start:end + 1])
+    if "fsbench" != doc.get("suite"):
+        raise ValueError("%s: not the fsbench results" % path)
+    return doc
+
+def rate_get(result):
+    if "ok" != result["status"]:
+        return None
+    if 0 != result["bytes"]:
+        return result["kb_s"], "KB/s"
+    return result["ops_s"], "ops/s"
+
+def config_str(doc):
+    cfg = doc["config"]
+    return ("file %u, io %u, files %u, ops %u, latency r/w %u/%u ms" %
+            (cfg["file_size"], cfg["io_size"], cfg["files"], cfg["ops"],
+             cfg["latency_read_ms"], cfg["latency_write_ms"]))
+
+def main():
+    parser = argparse.ArgumentParser(description="File system benchmark results compare.")
+    parser.add_argument("base", help="base results (JSON or console log)")
+    parser.add_argument("new", nargs="?", help="new results (JSON or console log)")
+    parser.add_argument("-t", "--threshold", type=float, default=10.0,
+                        help="regression threshold (%%, default 10)")
+    args = parser.parse_args()
+    try:
+        base = results_load(args.base)
+        new = results_load(args.new) if args.new else None
+    except (OSError, ValueError) as e:
+        print(e, file=sys.stderr)
+        return 2
+    print("base: %s (%s)" % (args.base, config_str(base)))
+    if new:
+        print("new : %s (%s)" % (args.new, config_str(new)))
+        if base["config"] != new["config"]:
+            print("warning: the configs differ", file=sys.stderr)
+    new_results = {r["name"]: r for r in new["results"]} if new else {}
+    regressions = 0
+    print()
+    print("%-16s %14s %14s %8s %10s" % ("scenario", "base", "new", "delta", "max ms"))
+    for result in base["results"]:
+        name = result["name"]
+        if "skipped" == result["status"]:
+            continue
+        base_rate = rate_get(result)
+        if not base_rate:
+            print("%-16s %14s" % (name, result["status"]))
+            continue
+        line = "%-16s %8u %-5s" % (name, base_rate[0], base_rate[1])
+        new_result = new_results.get(name)
+        if new_result:
+            new_rate = rate_get(new_result)
+            if not new_rate:
+                line += " %14s" % new_result["status"]
+                regressions += 1
+            else:
+                delta = ((float(new_rate[0]) - base_rate[0]) * 100.0 / base_rate[0]) if base_rate[0] else 0.0
+                line += " %8u %-5s %+7.1f%%" % (new_rate[0], new_rate[1], delta)
+                if delta < -args.threshold:
+                    line += " <-"
+                    regressions += 1
+            line += " %4u/%-4u" % (result["latency_max_ms"], new_result["latency_max_ms"])
+        else:
+            line += " %4u" % result["latency_max_ms"]
+        print(line)
+    if new:
+        print()
+        print("regressions: %u (threshold %.1f%%)" % (regressions, args.threshold))
+    return 1 if regressions else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
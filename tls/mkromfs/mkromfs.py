@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    mkromfs.py
+@brief   Read-only asset file system (romfs) image packer.
+@author  A. Filyanov
+
+The image layout (little-endian, the offsets are from the image start).
+Should match src/osal/filesystem/os_romfs.c:
+    header      magic "RMFS", version, data alignment, image size,
+                entries count, buckets count, seed, index size, index CRC;
+    disp[]      perfect hash displacements (buckets count);
+    entries[]   path offset, data offset, size, date/time (sorted by path);
+    slots[]     perfect hash slot -> entry index (entries count);
+    strings     NUL terminated paths (relative to the volume root);
+    data        files data (aligned).
+The index (header..strings) CRC is the STM32 CRC unit CRC-32 (words).
+
+Usage:
+    mkromfs.py <dir> -o romfs.bin           raw image (the media driver region)
+    mkromfs.py <dir> -c romfs_image.c       C array (linked into the flash)
+"""
+import argparse
+import os
+import struct
+import sys
+import time
+
+MAGIC           = b"RMFS"
+VERSION         = 1
+HEADER_FMT      = "<4sHHIIIIII"
+HEADER_SIZE     = struct.calcsize(HEADER_FMT)
+ENTRY_FMT       = "<IIII"
+ENTRY_SIZE      = struct.calcsize(ENTRY_FMT)
+SLOT_DIRECT     = 0x80000000
+BUCKET_LOAD     = 4         # Keys per bucket (average).
+DISP_MAX        = 0x100000  # Displacement search limit (the seed is changed then).
+SEEDS_MAX       = 64
+
+def hash32(data, seed):
+    """FNV-1a with the seeded basis and the murmur3 finalizer."""
+    h = (0x811C9DC5 ^ seed) & 0xFFFFFFFF
+    for c in data:
+        h ^= c
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & 0xFFFFFFFF
+    h ^= h >> 16
+    return h
+
+def crc32_stm32(data):
+    """CRC-32 (0x04C11DB7, init 0xFFFFFFFF, no reflection) over the 32-bit words."""
+    crc = 0xFFFFFFFF
+    for (word,) in struct.iter_unpack("<I", data):
+        crc ^= word
+        for _ in range(32):
+            crc = ((crc << 1) ^ 0x04C11DB7) if (crc & 0x80000000) else (crc << 1)
+            crc &= 0xFFFFFFFF
+    return crc
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def fattime(mtime):
+    t = time.localtime(mtime)
+    year = min(max(t.tm_year, 1980), 2107) - 1980
+    return (year << 25) | (t.tm_mon << 21) | (t.tm_mday << 16) | \
+           (t.tm_hour << 11) | (t.tm_min << 5) | (t.tm_sec // 2)
+
+def files_collect(root):
+    files = []
+    for dir_path, dir_names, file_names in os.walk(root):
+        dir_names.sort()
+        for name in sorted(file_names):
+            path = os.path.join(dir_path, name)
+            rel = os.path.relpath(path, root).replace(os.sep, "/")
+            files.append((rel.encode("utf-8"), path))
+    # Bytewise order: the directory items are contiguous (listing by the range).
+    files.sort(key=lambda f: f[0])
+    return files
+
+def phf_build(keys):
+    """Hash and displace: disp[H(key, seed) % m] gives the slot H(key, d) % n."""
+    n = len(keys)
+    m = max(1, (n + BUCKET_LOAD - 1) // BUCKET_LOAD)
+    for seed in range(1, SEEDS_MAX + 1):
+        buckets = [[] for _ in range(m)]
+        for i, key in enumerate(keys):
+            buckets[hash32(key, seed) % m].append(i)
+        disp = [0] * m
+        slots = [None] * n
+        order = sorted(range(m), key=lambda b: len(buckets[b]), reverse=True)
+        is_fail = False
+        for b in order:
+            items = buckets[b]
+            if len(items) <= 1:
+                break
+            for d in range(1, DISP_MAX):
+                taken = set()
+                for i in items:
+                    slot = hash32(keys[i], d) % n
+                    if (slots[slot] is not None) or (slot in taken):
+                        break
+                    taken.add(slot)
+                else:
+                    for i in items:
+                        slots[hash32(keys[i], d) % n] = i
+                    disp[b] = d
+                    break
+            else:
+                is_fail = True
+                break
+        if is_fail:
+            continue
+        # Single key buckets take the free slots directly.
+        free = [s for s in range(n) if slots[s] is None]
+        for b in order:
+            if 1 == len(buckets[b]):
+                slot = free.pop()
+                slots[slot] = buckets[b][0]
+                disp[b] = SLOT_DIRECT | slot
+        return seed, disp, slots
+    sys.exit("mkromfs: perfect hash build fail")
+
+def image_build(root, alignment, sector_size):
+    files = files_collect(root)
+    if not files:
+        sys.exit("mkromfs: no files in %s" % root)
+    keys = [f[0] for f in files]
+    seed, disp, slots = phf_build(keys)
+    n = len(keys)
+    m = len(disp)
+    strings = bytearray()
+    path_offsets = []
+    strings_base = HEADER_SIZE + 4 * m + ENTRY_SIZE * n + 4 * n
+    for key in keys:
+        path_offsets.append(strings_base + len(strings))
+        strings += key + b"\0"
+    index_size = align(strings_base + len(strings), 4)
+    strings += b"\0" * (index_size - strings_base - len(strings))
+    data = bytearray()
+    data_base = align(index_size, alignment)
+    entries = bytearray()
+    for (key, path), path_offset in zip(files, path_offsets):
+        with open(path, "rb") as f:
+            content = f.read()
+        data += b"\0" * (align(len(data), alignment) - len(data))
+        entries += struct.pack(ENTRY_FMT, path_offset, data_base + len(data), len(content),
+                               fattime(os.path.getmtime(path)))
+        data += content
+    size = align(data_base + len(data), sector_size)
+    index = bytearray()
+    index += struct.pack("<%dI" % m, *disp)
+    index += entries
+    index += struct.pack("<%dI" % n, *slots)
+    index += strings
+    crc = crc32_stm32(bytes(index))
+    header = struct.pack(HEADER_FMT, MAGIC, VERSION, alignment, size, n, m, seed, index_size, crc)
+    image = header + index
+    image += b"\0" * (data_base - len(image))
+    image += data
+    image += b"\0" * (size - len(image))
+    return bytes(image), n
+
+def c_array_write(path, image, symbol, alignment):
+    with open(path, "w") as f:
+        f.write("/* Generated by mkromfs.py. Don't edit. */\n")
+        f.write('#include "typedefs.h"\n\n')
+        f.write("#if defined(__ICCARM__)\n#pragma data_alignment=%d\n#endif\n" % max(alignment, 4))
+        f.write("const U8 %s[%d] = {\n" % (symbol, len(image)))
+        for i in range(0, len(image), 16):
+            f.write("    " + ", ".join("0x%02X" % b for b in image[i:i + 16]) + ",\n")
+        f.write("};\n")
+        f.write("const U32 %s_size = sizeof(%s);\n" % (symbol, symbol))
+
+def main():
+    parser = argparse.ArgumentParser(description="romfs image packer")
+    parser.add_argument("dir", help="assets directory (the volume root)")
+    parser.add_argument("-o", "--output", help="raw image file")
+    parser.add_argument("-c", "--c-array", help="C source file with the image array")
+    parser.add_argument("-s", "--symbol", default="romfs_image", help="C array name")
+    parser.add_argument("-a", "--align", type=int, default=32, help="files data alignment")
+    parser.add_argument("--sector", type=int, default=512, help="image size granularity")
+    args = parser.parse_args()
+    if (args.align < 4) or (args.align & (args.align - 1)):
+        sys.exit("mkromfs: alignment should be a power of 2 (>= 4)")
+    if not (args.output or args.c_array):
+        sys.exit("mkromfs: no output")
+    image, count = image_build(args.dir, args.align, args.sector)
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(image)
+    if args.c_array:
+        c_array_write(args.c_array, image, args.symbol, args.align)
+    print("mkromfs: %d files, %d bytes" % (count, len(image)))
+
+if __name__ == "__main__":
+    main()